@@ -60,7 +60,10 @@ name: FoxGlynn
 @member right: The right truncation point
 @member total_weight: total weight based on input underflow and overflow
 @member weights: array of double: weights - poisson probabilities*total_weight
+@member ref_count: the number of holders of the structure, the cache of
+		fox_glynn(...) included, see freeFG(...)
 remark: number of elements in weights = right - left.
+	The structure may be shared, it must not be modified by its holders.
 ******************************************************************************/
 typedef struct FoxGlynn
 {
@@ -68,6 +71,7 @@ typedef struct FoxGlynn
 	int right;
 	double total_weight;
 	double *weights;
+	int ref_count;
 } FoxGlynn;
 
 /*****************************************************************************
@@ -79,16 +83,47 @@ Role		: get poisson probabilities.
 @param		: double epsilon: error bound
 @param		: FoxGlynn **: return a new FoxGlynn structure by reference
 @return	: TRUE if it worked fine, otherwise false
-remark		:
+remark		: The results are cached, the same structure is returned for
+		  the same parameters. It has to be freed by freeFG(...).
+		  NOTE: The cache and the reference counts are not
+		  thread-safe, do not call fox_glynn(...) or freeFG(...)
+		  from within an OpenMP parallel region.
 ******************************************************************************/
 extern
 BOOL fox_glynn(const double lambda, const double tau, const double omega, const double epsilon, FoxGlynn **ppFG);
 
+/*****************************************************************************
+Name		: fox_glynn_multi
+Role		: get poisson probabilities for several time points at once.
+@param		: int num: the number of time points
+@param		: double *lambdas: (rate of uniformization)*(mission time)
+		  for every time point
+@param		: double tau: underflow
+@param		: double omega: overflow
+@param		: double epsilon: error bound
+@param		: FoxGlynn **: the num structures are returned here, NULL for
+		  the time points where fox_glynn(...) failed
+@return	: TRUE if it worked fine for all time points, otherwise false
+remark		: Time points with the same lambda share one structure, it is
+		  computed once, the others come from the cache of fox_glynn(...).
+		  Every returned structure has to be freed by freeFG(...).
+******************************************************************************/
+extern
+BOOL fox_glynn_multi(const int num, const double *lambdas, const double tau,
+		const double omega, const double epsilon, FoxGlynn **ppFG);
+
 /**
 * Frees the memory allocated for the FoxGlynn structure
+* NOTE: The memory is released only when the last holder frees it
 * @param fg the structure to free
 */
 extern
 void freeFG(FoxGlynn * fg);
 
+/**
+* Frees the cache of the Fox-Glynn results
+*/
+extern
+void free_fox_glynn_cache(void);
+
 #endif
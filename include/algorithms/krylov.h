@@ -0,0 +1,79 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Maneesh Khattri, Ivan Zapreev, Tim Kemna
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description: Compute the product of a matrix exponential
+*		and a vector by Krylov subspace projection.
+*	Uses: Definition of the sparse matrix - sparse.h
+*	Reference: "Expokit: A Software Package for Computing Matrix
+*			Exponentials", Roger B. Sidje,
+*			ACM Transactions on Mathematical Software, vol. 24,
+*			pp. 130-156 (1998).
+*/
+
+#ifndef KRYLOV_H
+#define KRYLOV_H
+
+#include "macro.h"
+#include "sparse.h"
+
+/*****************************************************************************
+Name		: krylov_expv
+Role		: compute w = exp(t*A)*v by Krylov subspace projection.
+@param		: sparse *pA: the matrix A, e.g. the generator matrix Q.
+@param		: int *valid_rows: the rows of A that are used, valid_rows[0]
+		  is their number, the other rows are taken as zero rows.
+@param		: double t: the time.
+@param		: double *v: the vector v.
+@param		: double tol: the error tolerance per unit of time, the local
+		  error of a time step t_step is at most t_step*tol, so the
+		  error of w is at most t*tol.
+@param		: double *w: the result w is returned here.
+@return	: TRUE if it worked fine, otherwise false
+remark		: The time steps adapt to the error estimate, so stiff
+		  matrices do not cost more steps than the slow modes need.
+		  The small exponentials are computed by Pade approximation.
+******************************************************************************/
+extern
+BOOL krylov_expv(const sparse * pA, const int * valid_rows, const double t,
+		const double * v, const double tol, double * w);
+
+#endif
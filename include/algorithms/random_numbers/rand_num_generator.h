@@ -42,7 +42,7 @@
 *
 *	Source description: This file contains functions for generating random numbers.
 *
-*	WARNING: For all RNG methods, except for ones using GSL the discrete and exponential
+*	WARNING: For all RNG methods, except for the GSL and the built-in ones, the discrete and exponential
 *	random variables are based on the same seed. We do not know whether it has any
 *	influence on the distribution of the generated random variables.
 */
@@ -60,6 +60,11 @@
 * (5) Version of the RANLUX algorithm of Lüscher from GNU Scientific Library
 * (6) A Lagged Fibonacci generator (LFG) from GNU Scientific Library
 * (7) A Tausworthe generator from GNU Scientific Library
+* (8) The built-in xoshiro128** generator of Blackman and Vigna
+* (9) The built-in PCG32 generator of O'Neill
+* (10) The built-in Philox4x32-10 counter-based generator of Salmon et al.
+* The built-in generators produce their numbers in buffered blocks and
+* compute the exponentially distributed ones by the ziggurat method.
 */
 #define RNG_APP_CRYPT_METHOD	1
 #define RNG_METHOD_APP_CRYPT_STR "Appl. Crypt."
@@ -82,6 +87,15 @@
 #define RNG_GSL_TAUS_METHOD	7
 #define RNG_METHOD_GSL_TAUS_STR "GSL Taus"
 
+#define RNG_XOSHIRO_METHOD	8
+#define RNG_METHOD_XOSHIRO_STR "Xoshiro128**"
+
+#define RNG_PCG_METHOD		9
+#define RNG_METHOD_PCG_STR "PCG32"
+
+#define RNG_PHILOX_METHOD	10
+#define RNG_METHOD_PHILOX_STR "Philox4x32-10"
+
 #define RNG_METHOD_UNKNOWN_STR "????"
 
 /************************************************************************/
@@ -93,7 +107,7 @@
 * the discrete distribution.
 * @param _method one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 */
 extern void setRNGMethodDiscrete(int _method);
 
@@ -102,7 +116,7 @@ extern void setRNGMethodDiscrete(int _method);
 * numbers for the discrete distribution.
 * NOTE: method should be one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 */
 extern int getRNGMethodDiscrete(void);
 
@@ -110,8 +124,8 @@ extern int getRNGMethodDiscrete(void);
 * This functions generates a new seed for the selected method for
 * non-uniformly distributed random numbers for discrete distribution.
 * NOTE: The stream for generating random numbers is seeded by the system clock!
-* WARNING: Unless GSL is used this regenerates the seed for the exp. distr. rand.
-* variables as well!
+* WARNING: Unless GSL or a built-in generator is used this regenerates the seed
+* for the exp. distr. rand. variables as well!
 */
 extern void generateNewSeedDiscrete(void);
 
@@ -125,6 +139,57 @@ extern void generateNewSeedDiscrete(void);
 extern int generateRandNumberDiscrete(const int * values_local,
                 const double * distribution, int size);
 
+/**
+* This function chooses a value from the given array according to the
+* related probability distribution, using the given uniformly distributed
+* random number instead of drawing one. This allows to sample with random
+* numbers from another source, e.g. a stream of the parallel simulation.
+* @param values the range of values one would like to choose from
+* @param distribution the related probability distribution
+* @param size the size of the values and distribution arrays
+* @param unif_rand a uniformly distributed random number in [0,1)
+*/
+extern int chooseRandNumberDiscrete(const int * values,
+                const double * distribution, int size, double unif_rand);
+
+/**
+* This function builds the Walker/Vose alias table of the given probability
+* distribution. The distribution is truncated at a cumulative probability
+* of 1 and its last entry takes the missing mass, like in
+* generateRandNumberDiscrete.
+* @param distribution the probability distribution
+* @param size the size of the distribution, prob, alias and work arrays
+* @param prob the return array for the acceptance probabilities
+* @param alias the return array for the alias entries
+* @param work an array used as the work list while building the table
+*/
+extern void buildAliasTable(const double * distribution, int size,
+                double * prob, int * alias, int * work);
+
+/**
+* This function chooses a random value from the given array according to
+* the alias table built by buildAliasTable in constant time.
+* @param values the range of values one would like to choose from
+* @param prob the acceptance probabilities of the alias table
+* @param alias the alias entries of the alias table
+* @param size the size of the values, prob and alias arrays
+*/
+extern int generateRandNumberAlias(const int * values, const double * prob,
+                const int * alias, int size);
+
+/**
+* This function chooses a value from the given array according to the
+* alias table built by buildAliasTable, using the given uniformly
+* distributed random number instead of drawing one.
+* @param values the range of values one would like to choose from
+* @param prob the acceptance probabilities of the alias table
+* @param alias the alias entries of the alias table
+* @param size the size of the values, prob and alias arrays
+* @param unif_rand a uniformly distributed random number in [0,1)
+*/
+extern int chooseRandNumberAlias(const int * values, const double * prob,
+                const int * alias, int size, double unif_rand);
+
 /**
 * This function frees all memory allocated for the random number generator
 * used for the discrete distribution.
@@ -140,7 +205,7 @@ extern void freeRNGDiscrete(void);
 * the exponential distribution.
 * @param _method one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 */
 extern void setRNGMethodExp(int _method);
 
@@ -149,7 +214,7 @@ extern void setRNGMethodExp(int _method);
 * numbers for the exponential distribution.
 * NOTE: method should be one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 */
 extern int getRNGMethodExp(void);
 
@@ -157,8 +222,8 @@ extern int getRNGMethodExp(void);
 * This functions generates a new seed for the selected method for
 * non-uniformly distributed random numbers for exponential distribution.
 * NOTE: The stream for generating random numbers is seeded by the system clock!
-* WARNING: Unless GSL is used this regenerates the seed for the discrete
-* rand. variables as well!
+* WARNING: Unless GSL or a built-in generator is used this regenerates the seed
+* for the discrete rand. variables as well!
 */
 extern void generateNewSeedExp(void);
 
@@ -0,0 +1,137 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description:
+*		Blocks of random 32-bit words and the variates computed from
+*		them. A word source buffers RNG_BLOCK_SIZE words of a built-in
+*		generator, so the hot simulation loops pay one call of the
+*		generator per block instead of one indirect call per number.
+*		The exponential variates are computed by the ziggurat method
+*		of G. Marsaglia and W. W. Tsang, "The Ziggurat Method for
+*		Generating Random Variables", Journal of Statistical Software
+*		5(8), 2000, which needs a logarithm only in rare cases.
+*/
+
+#ifndef RNG_BLOCK_H
+#define RNG_BLOCK_H
+
+/* The number of words a word source buffers */
+#define RNG_BLOCK_SIZE 256
+
+/**
+* The typedef for the type of a function that fills an array with random
+* 32-bit words (stored in unsigned long) of a built-in generator.
+* @param pState the state of the generator
+* @param pWords the array to be filled
+* @param size the number of words to generate
+*/
+typedef void (*PTFFillRandWords)(void * pState, unsigned long * pWords, int size);
+
+/**
+* A buffered source of random 32-bit words.
+*/
+typedef struct SRandWordSource{
+	/* The generator and its state */
+	PTFFillRandWords pFFillRandWords;
+	void * pState;
+	/* The buffered words, the ones from words[next] on are unused */
+	unsigned long words[RNG_BLOCK_SIZE];
+	int next;
+} TRandWordSource;
+
+/**
+* Initializes the word source with an empty buffer.
+* @param pSource the word source
+* @param pFFillRandWords the function generating the words
+* @param pState the state of the generator
+*/
+extern void initRandWordSource(TRandWordSource * pSource,
+		PTFFillRandWords pFFillRandWords, void * pState);
+
+/**
+* Refills the buffer of the word source and returns its first word.
+* Use nextRandWord instead.
+* @param pSource the word source
+* @return a random number in [0, 2^32 - 1]
+*/
+extern unsigned long refillRandWords(TRandWordSource * pSource);
+
+/**
+* Returns the next random word of the word source.
+* @param pSource the word source
+* @return a random number in [0, 2^32 - 1]
+*/
+#define nextRandWord(pSource) \
+	((pSource)->next < RNG_BLOCK_SIZE \
+		? (pSource)->words[(pSource)->next++] \
+		: refillRandWords(pSource))
+
+/**
+* Fills the given array with uniformly distributed random numbers.
+* @param pSource the word source
+* @param pUnif the array to be filled with random numbers in [0,1)
+* @param size the number of random numbers to generate
+*/
+extern void fillRandUnifWords(TRandWordSource * pSource, double * pUnif, int size);
+
+/**
+* Fills the given array with exponentially distributed random numbers with
+* rate 1 by the ziggurat method. Dividing them by lambda gives the rate
+* lambda.
+* @param pSource the word source
+* @param pExp the array to be filled with the random numbers
+* @param size the number of random numbers to generate
+*/
+extern void fillRandExpWords(TRandWordSource * pSource, double * pExp, int size);
+
+/**
+* Multiplies two 32-bit words.
+* @param a the first factor in [0, 2^32 - 1]
+* @param b the second factor in [0, 2^32 - 1]
+* @param pHi the return value for the upper 32 bits of the product
+* @param pLo the return value for the lower 32 bits of the product
+*/
+extern void mulRandWords(unsigned long a, unsigned long b,
+		unsigned long * pHi, unsigned long * pLo);
+
+#endif /* RNG_BLOCK_H */
@@ -0,0 +1,89 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description:
+*		The PCG32 random number generator of M. E. O'Neill (XSH RR
+*		output of a 64-bit linear congruential generator, Apache
+*		License 2.0, http://www.pcg-random.org/). The 64-bit state
+*		is kept in two 32-bit words stored in unsigned long
+*		variables, so the code is ANSI C.
+*/
+
+#ifndef RNG_PCG_H
+#define RNG_PCG_H
+
+/**
+* The state of the PCG32 generator: the 64-bit state and the 64-bit
+* increment of the linear congruential generator, split into words.
+*/
+typedef struct SPCGState{
+	unsigned long state_hi, state_lo;
+	unsigned long inc_hi, inc_lo;
+} TPCGState;
+
+/**
+* Seeds the generator the way pcg32_srandom_r does.
+* @param pState the state of the generator
+* @param seed the seed
+* @param stream the stream selector, different selectors give different
+*		sequences for the same seed
+*/
+extern void seedRNGPCG(TPCGState * pState, unsigned long seed, unsigned long stream);
+
+/**
+* Generates the next 32-bit random word.
+* @param pState the state of the generator
+* @return a random number in [0, 2^32 - 1]
+*/
+extern unsigned long generateRandWordPCG(TPCGState * pState);
+
+/**
+* Fills the given array with the next 32-bit random words, the function has
+* the PTFFillRandWords type of rng_block.h.
+* @param pState the state of the generator, a TPCGState
+* @param pWords the array to be filled
+* @param size the number of words to generate
+*/
+extern void fillRandWordsPCG(void * pState, unsigned long * pWords, int size);
+
+#endif /* RNG_PCG_H */
@@ -0,0 +1,95 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description:
+*		The Philox4x32-10 counter-based random number generator of
+*		J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+*		"Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011.
+*		Every 128-bit counter value is encrypted into four random
+*		words under a 64-bit key, the seed. The words are stored
+*		in unsigned long variables, so the code is ANSI C.
+*/
+
+#ifndef RNG_PHILOX_H
+#define RNG_PHILOX_H
+
+/**
+* The state of the Philox4x32-10 generator: the key, the counter of the
+* next block and the words of the current block from block[next] on.
+*/
+typedef struct SPhiloxState{
+	unsigned long key[2];
+	unsigned long counter[4];
+	unsigned long block[4];
+	int next;
+} TPhiloxState;
+
+/**
+* Seeds the generator: the seed and the stream become the key and the
+* counter is reset.
+* @param pState the state of the generator
+* @param seed the seed
+* @param stream the stream, different streams give different sequences
+*		for the same seed
+*/
+extern void seedRNGPhilox(TPhiloxState * pState, unsigned long seed, unsigned long stream);
+
+/**
+* Computes the Philox4x32-10 block of the given counter and key.
+* @param counter the counter
+* @param key the key
+* @param block the return value for the four random words
+*/
+extern void computeBlockPhilox(const unsigned long counter[4],
+		const unsigned long key[2], unsigned long block[4]);
+
+/**
+* Fills the given array with the next 32-bit random words, the function has
+* the PTFFillRandWords type of rng_block.h.
+* @param pState the state of the generator, a TPhiloxState
+* @param pWords the array to be filled
+* @param size the number of words to generate
+*/
+extern void fillRandWordsPhilox(void * pState, unsigned long * pWords, int size);
+
+#endif /* RNG_PHILOX_H */
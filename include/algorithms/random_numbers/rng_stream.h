@@ -0,0 +1,96 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description:
+*		Independent streams of random numbers for the parallel
+*		simulation engine. The streams use the xoshiro128**
+*		generator of D. Blackman and S. Vigna (public domain,
+*		http://prng.di.unimi.it/). Its jump function advances a
+*		generator by 2^64 steps, so the streams obtained by
+*		repeatedly jumping one seeded generator do not overlap.
+*		The generator works on 32-bit words which are stored in
+*		unsigned long variables, so the code is ANSI C.
+*/
+
+#ifndef RNG_STREAM_H
+#define RNG_STREAM_H
+
+/**
+* The state of one stream of random numbers.
+*/
+typedef struct SRNGStream{
+	unsigned long s[4];
+} TRNGStream;
+
+/**
+* Seeds the stream, the four state words are obtained from the seed
+* by a 32-bit variant of the SplitMix generator.
+* @param pStream the stream to be seeded
+* @param seed the seed
+*/
+extern void seedRNGStream(TRNGStream * pStream, unsigned long seed);
+
+/**
+* Advances the stream by 2^64 steps. Calling it k times on a copy of one
+* seeded stream gives the k-th of a set of non-overlapping streams.
+* @param pStream the stream to be advanced
+*/
+extern void jumpRNGStream(TRNGStream * pStream);
+
+/**
+* Generates the next 32-bit random word of the stream.
+* @param pStream the stream
+* @return a random number in [0, 2^32 - 1]
+*/
+extern unsigned long generateRandWordStream(TRNGStream * pStream);
+
+/**
+* Fills the given array with the next 32-bit random words of the stream,
+* the function has the PTFFillRandWords type of rng_block.h.
+* @param pStream the stream, a TRNGStream
+* @param pWords the array to be filled
+* @param size the number of words to generate
+*/
+extern void fillRandWordsStream(void * pStream, unsigned long * pWords, int size);
+
+#endif /* RNG_STREAM_H */
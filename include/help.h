@@ -58,7 +58,7 @@
 " help HT - display a help info on a given topic.\n" \
 " print\t - print run-time settings.\n" \
 " print tree - print the formula tree with the results and supplementary information.\n" \
-" $RESULT[N] - access the computed results of U, X, L, S, E, C, Y operators by a state index.\n" \
+" $RESULT[N] - access the computed results of U, X, L, S, E, C, Y, R operators by a state index.\n" \
 " $STATE[N]  - access the state-formula satisfiability set by a state index.\n"
 #define HELP_GENERAL_MSG2 " set *\t - Where * is one of the following:\n" \
 "\t print L\t - Turn on/off most of the resulting output, see '$RESULT[I]' and '$STATE[I]' commands.\n" \
@@ -69,20 +69,26 @@
 "\t N is a natural number.\n"
 
 #define HELP_COMMON_MSG1 " set *\t - Where * is one of the following:\n" \
-"\t ssd L\t\t - Turn on/off the steady-state detection for time bounded until (CTMC model).\n" \
+"\t ssd L\t\t - Turn on/off the steady-state detection for transient analyses.\n" \
 "\t error_bound R\t - Error Bound for all iterative methods.\n" \
 "\t max_iter N\t - Number of Max Iterations for all iterative methods.\n" \
 "\t overflow R\t - Overflow for the Fox-Glynn algorithm.\n" \
 "\t underflow R\t - Underflow for the Fox-Glynn algorithm.\n" \
-"\t method_path M\t - Method for path formulas.\n"
+"\t method_path M\t - Method for path formulas.\n" \
+"\t method_transient MT - Method for time-bounded until formulas (CTMC model).\n"
 #define HELP_COMMON_MSG2 "\t method_steady M - Method for steady state formulas.\n" \
 "\t method_bscc MB\t - Method for BSCC search.\n" \
-"\t method_ctmdpi_transient CB - Method for CTMDPI bounded reachability.\n" \
-" Here:\n" \
+"\t method_lumping ML - Method for partition refinement in formula dependent lumping.\n" \
+"\t lumping_reuse L - Turn on/off the reuse of the labelling quotient in formula dependent lumping.\n" \
+"\t lumping_weak L\t - Turn on/off weak bisimulation lumping for CTMCs (no next operator).\n" \
+"\t method_ctmdpi_transient CB - Method for CTMDPI bounded reachability.\n"
+#define HELP_COMMON_MSG3 " Here:\n" \
 "\t L is one of {on, off}.\n" \
 "\t R is a real value.\n" \
 "\t M is one of {gauss_jacobi, gauss_seidel}.\n" \
+"\t MT is one of {uniformization, krylov}.\n" \
 "\t MB is one of {recursive, non_recursive}.\n" \
+"\t ML is one of {splitter, signature}.\n" \
 "\t CB is one of {hd_uni, hd_non_uni, hd_auto}.\n"
 #define HELP_REWARDS_MSG " set *\t - Where * is one of the following:\n" \
 "\t method_until_rewards MU - Method for time-reward-bounded until formula.\n" \
@@ -105,15 +111,28 @@
 "\t sample_size_step N - The sample-size increase step.\n" \
 "\t sim_method_disc RNG - The random-number generator for a discrete distribution.\n" \
 "\t sim_method_exp RNG - The random-number generator for an exponential distribution (time-interval until, CSL).\n"
+#define HELP_SIMULATION_PAR_MSG "\t sim_threads N\t - The number of simulation threads (unbounded and time-interval until), 0 for sequential.\n" \
+"\t sim_seed N\t - The seed of the parallel simulation streams, 0 for the system clock.\n"
+#define HELP_SIMULATION_TEST_MSG "\t sim_test TS\t - The test of the probability bound (time-interval until).\n" \
+"\t sim_test_alpha R - The error of a sequential test to decide for below the bound, 0 for 1 - confidence.\n" \
+"\t sim_test_beta R - The error of a sequential test to decide for above the bound, 0 for 1 - confidence.\n"
+#define HELP_SIMULATION_SPLIT_MSG "\t sim_split_effort N - The trajectories per level of importance splitting (unbounded and time-interval until), 0 for off.\n" \
+"\t sim_split_runs N - The independent runs of importance splitting giving the conf. int.\n"
+#define HELP_SIMULATION_IS_MSG "\t sim_is IS\t - The importance sampling of time-interval until.\n" \
+"\t sim_is_bias R\t - The failure probability (bfb) or the factor per distance to Psi (zva), in (0,1).\n" \
+"\t sim_is_failure_rate R - The rate up to which a transition is a failure (bfb), 0 for going towards Psi.\n"
 #define HELP_SIMULATION_MSG3 " For the simulation of unbounded until and the pure simulation of steady-state (long-run) operator:\n" \
 "\t max_sim_depth N - The maximum simulation depth.\n" \
 "\t min_sim_depth N - The minimum simulation depth.\n" \
 "\t sim_depth_step N - The simulation-depth increase step.\n" \
 "\t bscc_dim_multiplier N - The BSCC dimension multiplier for the sample-based regeneration state choice.\n"
 #define HELP_SIMULATION_MSG4 " Here:\n" \
-"\t RNG is one of {app_crypt, ciardo, prism, ymer, gsl_ranlux, gsl_lfg, gsl_taus}\n" \
+"\t RNG is one of {app_crypt, ciardo, prism, ymer, gsl_ranlux, gsl_lfg, gsl_taus,\n" \
+"\t\t xoshiro, pcg, philox}\n" \
 "\t ST is one of {one, all}.\n" \
 "\t SS is one of {auto, manual}.\n" \
+"\t TS is one of {conf_int, sprt, bayes}.\n" \
+"\t IS is one of {off, bfb, zva}.\n" \
 "\t MS is one of {pure, hybrid}.\n" \
 "\t RM is one of {pure_reg, heuristic}.\n" \
 "\t R is a real value.\n" \
@@ -164,7 +183,9 @@
 #define HELP_PRCTL_LOGIC_COMMON_SF_MSG HELP_ALL_LOGIC_COMMON_SF_MSG "\t\t| E [ R, R] [ SFL ] \n" \
 "\t\t| E [N][ R, R] [ SFL ] \n" \
 "\t\t| C [N][ R, R] [ SFL ] \n" \
-"\t\t| Y [N][ R, R] [ SFL ] \n"
+"\t\t| Y [N][ R, R] [ SFL ] \n" \
+"\t\t| Y [N, R][ R, R] [ SFL ] \n" \
+"\t\t| R [ R, R] [ SFL ] \n"
 
 /* The path formulas common for PRCTL */
 #define HELP_PRCTL_LOGIC_COMMON_PF_MSG HELP_ALL_LOGIC_COMMON_PF_MSG "\t\t| SFL U[ N, N ][ R, R ] SFL\n"
@@ -191,7 +212,9 @@
 /**********************************/
 
 /* The state formulas common for CSRL */
-#define HELP_CSRL_LOGIC_COMMON_SF_MSG HELP_CSL_LOGIC_COMMON_SF_MSG
+#define HELP_CSRL_LOGIC_COMMON_SF_MSG HELP_CSL_LOGIC_COMMON_SF_MSG "\t\t| C [R][ R, R] [ SFL ] \n" \
+"\t\t| Y [R][ R, R] [ SFL ] \n" \
+"\t\t| R [ R, R] [ SFL ] \n"
 
 /* The path formulas common for CSRL */
 #define HELP_CSRL_LOGIC_COMMON_PF_MSG HELP_CSL_LOGIC_COMMON_PF_MSG "\t\t| X [R, R][R, R] SFL\n" \
@@ -119,12 +119,12 @@
 	/**
 	* This function is used for model checking the formulas:
 	* PURE_REWARD_SF_EXPECTED_RR, PURE_REWARD_SF_INSTANT_R,
-	* PURE_REWARD_SF_EXPECTED_AR.
+	* PURE_REWARD_SF_EXPECTED_AR, PURE_REWARD_SF_REACHABILITY_R.
 	* @param before TRUE if the method is called before model checking
 	*		the subnodes, FALSE otherwise.
 	*NOTE: We expect the method is called only after the model checking
 	*	of the subformulas, so we do not check for the value of "before".
-	* @param pPureRewardF the pure-reward state formula: E, C, Y
+	* @param pPureRewardF the pure-reward state formula: E, C, Y, R
 	* @return FALSE, is needed for the doFormulaTreeTraversal method
 	*/
         extern
@@ -48,6 +48,7 @@
 #define PARSER_TO_TREE
 
 #include "bitset.h"
+#include "partition.h"
 
 	/*Define the result names for printing*/
 #       define FORMULA_STR "$FORMULA"
@@ -114,12 +115,13 @@
 #               define LONG_STEADY_F_LONG_RUN 1
 #               define LONG_STEADY_F_STEADY_STATE 2
 
-	/* The pure reward-oriented formula is either a E, C, or Y operators */
+	/* The pure reward-oriented formula is either a E, C, Y, or R operators */
 #       define PURE_REWARD_SF 6
 		/*The sub-types for the PURE_REWARD_SF type*/
 #               define PURE_REWARD_SF_EXPECTED_RR 1
 #               define PURE_REWARD_SF_INSTANT_R 2
 #               define PURE_REWARD_SF_EXPECTED_AR 3
+#               define PURE_REWARD_SF_REACHABILITY_R 4
 
 	/* The next formula X */
 #       define NEXT_PF 7
@@ -166,6 +168,11 @@
 	* pErrorBound - in case every result in pProbRewardResult has it's own error
 	*		bound we should fill in the pErrorBound array with them
 	* pProbRewardResult - the vector of doubles, the probability/rewards results
+	* pResultPartition - the partition of the formula dependent lumping if
+	*		pProbRewardResult and pErrorBound are kept per block (then
+	*		prob_result_size is the number of blocks and the value of
+	*		the state i is at part_lump_state_id_nt(pResultPartition, i)),
+	*		NULL if they are given for every state
 	*/
 	typedef struct SFTypeRes{
 		/* The general formula-related fields */
@@ -190,6 +197,7 @@
 		double error_bound;
 		double * pErrorBound;
 		double * pProbRewardResult;
+		partition * pResultPartition;
 	} TFTypeRes;
 	typedef TFTypeRes* PTFTypeRes;
 
@@ -292,17 +300,20 @@
 	typedef BOOL ( * TPFunctOnPTBinaryOp ) ( BOOL, BOOL, PTBinaryOp );
 
 	/**
-	* This is a pure reward-oriented state formula (PURE_REWARD_SF): C, E, Y
+	* This is a pure reward-oriented state formula (PURE_REWARD_SF): C, E, Y, R
 	* without the reward bounds that have to be defined in the form of TCompStateF.
 	* unary_op - the unary operator part of the simple formula, where the
 	*		unary_type - contains a type of the operator, that can be one of:
 	*			PURE_REWARD_SF_EXPECTED_RR, PURE_REWARD_SF_INSTANT_R,
-	*			PURE_REWARD_SF_EXPECTED_AR
+	*			PURE_REWARD_SF_EXPECTED_AR, PURE_REWARD_SF_REACHABILITY_R
 	* time - the time instance
+	* discount - the discount of the reward of step k, discount^k, of the
+	*		Y formula of a DMRM, 1.0 for none
 	*/
 	typedef struct SPureRewardF{
                 TUnaryOp unary_op; /* WARNING: MUST BE THE FIRST FIELD */
 		double time;
+		double discount;
 	} TPureRewardF;
 	typedef TPureRewardF* PTPureRewardF;
 
@@ -449,12 +460,13 @@
 	* For the reward bounds should be wrapped with the COMPARATOR_SF structure of unary_type:
 	*	COMPARATOR_SF_REWARD_INTERVAL.
 	* @param time the time instance
+	* @param discount the discount of the Y formula, 1.0 for none
 	* @param pSubForm the subformula for the reward formula
 	* @param unary_type one of: PURE_REWARD_SF_EXPECTED_RR, PURE_REWARD_SF_INSTANT_R,
-	*					PURE_REWARD_SF_EXPECTED_AR
+	*					PURE_REWARD_SF_EXPECTED_AR, PURE_REWARD_SF_REACHABILITY_R
 	* @return returns the pointer to the newly created TPureRewardF node casted to (void *)
 	*/
-        extern void * allocatePureRewardFormula(double time_local,
+        extern void * allocatePureRewardFormula(double time_local, double discount,
                         void * pSubForm, const int unary_type);
 
 	/**
@@ -0,0 +1,81 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Maneesh Khattri, Ivan Zapreev
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description: Read and write partition (.part) files.
+*	Uses: DEF: partition.h, sparse.h
+*		LIB: partition.c, sparse.c
+*		Definition of read_part_file, write_part_file - part_file.h
+*/
+
+#ifndef PART_FILE_H
+#define PART_FILE_H
+
+#include "sparse.h"
+#include "partition.h"
+
+/**
+* Reads a .part file that has been written by write_part_file() for the
+* transition matrix Q. The file has the format
+*	STATES n
+*	BLOCKS m
+*	TRANSITIONS t
+* followed by n lines "state block" (both starting from 1). The numbers of
+* states and transitions must fit Q, otherwise the file is rejected. Whether
+* the partition is a lumping of Q is checked by part_is_stable().
+* @param	: sparse *Q: the transition matrix the partition belongs to.
+* @param	: char *filename: input .part file's name.
+* @return	: the partition or NULL if the file was not found or is invalid.
+*/
+extern /*@only@*/ /*@null@*/ partition * read_part_file(
+                /*@observer@*/ const sparse * Q, const char * filename);
+
+/**
+* Writes the (numbered) partition of the transition matrix Q into a .part file.
+* @param	: partition *P: the partition, e.g. computed by lump().
+* @param	: sparse *Q: the transition matrix the partition belongs to.
+* @param	: char *filename: output .part file's name.
+* @return	: err_OK if the file was written, err_ERROR otherwise.
+*/
+extern err_state write_part_file(/*@observer@*/ const partition * P,
+                /*@observer@*/ const sparse * Q, const char * filename);
+
+#endif
@@ -55,6 +55,12 @@
 
 /**
 * This method computes the optimal lumped matrix of the input matrix.
+* In CMRM mode, the partition also respects the impulse rewards (see
+* change_impulse_rewards()). If is_lump_weak_on() and the model is a CTMC or a
+* CMRM, the method computes weak bisimulation instead of ordinary lumpability:
+* transitions within a block that earn no impulse reward are ignored, so the
+* result is coarser and preserves all formulas except those with the next
+* operator. In both cases the signature-based refinement is used.
 * @param	: partition *P: The initial partition.
 * @param	: sparse *Q: The matrix to lump.
 * @return	: The lumped matrix.
@@ -67,6 +73,69 @@ extern /*@only@*/ /*@null@*/ sparse * lump(partition * P,
                         P->pos@*/
                 /*@modifies *P@*/;
 
+/**
+* This method computes the lumped matrix for a partition that is already stable,
+* e.g. a partition that has been read from a file. No refinement is done.
+* @param	: partition *P: The partition.
+* @param	: sparse *Q: The matrix to lump.
+* @return	: The lumped matrix.
+*/
+extern /*@only@*/ /*@null@*/ sparse * lump_quotient(partition * P,
+                /*@observer@*/ const sparse * Q)
+                /*@requires notnull P->blocks@*/
+                /*@requires isnull P->first_Sp, P->first_PredCl, P->sum,
+                        P->pos@*/
+                /*@modifies *P@*/;
+
+/**
+* This method computes the lumped matrix for formula-dependent lumping, i.e. it
+* replaces the sequence init_partition_formula(phi, psi, interval); lump(P, Q).
+* If is_lump_reuse_on(), the quotient of Q w.r.t. the labelling is computed once
+* and cached; each formula then only refines this (smaller) quotient. Otherwise,
+* or if phi or psi do not respect the cached quotient, Q is lumped directly.
+* @param	: partition **pP: returns the partition; NULL on error.
+* @param	: sparse *Q: The matrix to lump.
+* @param	: bitset *phi, *psi, BOOL interval: see init_partition_formula().
+* @return	: The lumped matrix.
+*/
+extern /*@only@*/ /*@null@*/ sparse * lump_formula(
+                /*@out@*/ partition ** pP, /*@observer@*/ const sparse * Q,
+                /*@observer@*/ const bitset * phi,
+                /*@observer@*/ const bitset * psi, BOOL interval)
+                /*@modifies *pP@*/;
+
+/**
+* This method frees the cached quotient used by lump_formula().
+*/
+extern void free_lump_cache(void);
+
+/**
+* This method checks whether the partition is consistent with the labelling and
+* the state rewards, i.e. whether it can be used as initial partition for
+* formula-independent lumping. It does not check whether the partition is stable.
+* @param	: partition *P: the partition.
+* @param	: labelling *labellin: the labelling.
+* @param	: double *rewards: the state rewards or NULL.
+* @return	: TRUE if all labels and rewards are constant on each block.
+*/
+extern BOOL part_respects_labelling(/*@observer@*/ const partition * P,
+                /*@observer@*/ const labelling * labellin,
+                /*@observer@*/ /*@null@*/ const double * rewards)
+                /*@modifies nothing@*/;
+
+/**
+* This method checks whether the partition is stable for the matrix, i.e.
+* whether all states of a block have the same total rate (up to EPSILON) to
+* every block, with the same impulse rewards if these have to be respected.
+* Only then can lump_quotient() be used. It needs one pass over the matrix.
+* @param	: partition *P: the partition, its blocks have to be numbered.
+* @param	: sparse *Q: the matrix.
+* @return	: TRUE if P is a lumping of Q.
+*/
+extern BOOL part_is_stable(/*@observer@*/ const partition * P,
+                /*@observer@*/ const sparse * Q)
+                /*@modifies nothing@*/;
+
 /**
 * This method changes the labelling structure such that it corresponds to the partition.
 * @param	: labelling *labellin: the labelling structure.
@@ -98,6 +167,29 @@ extern /*@only@*/ /*@null@*/ double * change_state_rewards(
                         P->pos@*/
                 /*@modifies nothing@*/;
 
+/**
+* This method computes the impulse rewards of the lumped model. The impulse
+* reward of the lumped transition from block B to block C is the impulse reward
+* of the transitions from an arbitrary state of B to the states in C; the
+* partition has to be computed by lump() while the impulse rewards were set.
+* If the transitions from a state of B to C earn different impulse rewards,
+* they cannot be lumped and the method returns NULL.
+* NOTE:		We do not free the old impulse rewards structure because
+*		it should be done on the outer level.
+* @param	: sparse *rewi: the impulse rewards of the original model.
+* @param	: partition *P: the partition.
+* @param	: sparse *Q: the original transition matrix.
+* @return	: The impulse rewards after lumping or NULL.
+*/
+extern /*@only@*/ /*@null@*/ sparse * change_impulse_rewards(
+                /*@observer@*/ const sparse * rewi,
+                /*@observer@*/ const partition * P,
+                /*@observer@*/ const sparse * Q)
+                /*@requires notnull P->blocks@*/
+                /*@requires isnull P->first_Sp, P->first_PredCl, P->sum,
+                        P->pos@*/
+                /*@modifies nothing@*/;
+
 /**
 * Unlump a probability vector with respect to the partition.
 * @param	: partition *P: the partition of the original state space.
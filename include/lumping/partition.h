@@ -55,6 +55,15 @@
 #define ABSORBING	0x04
 
 typedef state_index pos_index;
+typedef state_index block_index;
+
+/**
+* The blocks of a partition are kept in a pool of chunks of PART_POOL_CHUNK
+* blocks each. Chunks are never moved, so pointers to blocks stay valid, and a
+* block can be addressed by its 32-bit index in the pool as well.
+*/
+#define PART_POOL_CHUNK_BITS 10
+#define PART_POOL_CHUNK (1 << PART_POOL_CHUNK_BITS)
 
 /**
 *	STRUCTURE
@@ -71,8 +80,9 @@ typedef state_index pos_index;
 *                         position in P->id that does not belong to this block;
 *                         the beginning of the block is the end of this->next.
 *                         So, the block contains the states
-*                         P->ib[next->end ... end-1].id.
+*                         P->id[next->end ... end-1].
 * @member next		: pointer to next block.
+* @member idx		: index of the block in the block pool of the partition.
 */
 typedef struct block_elem block;
 struct block_elem {
@@ -85,8 +95,9 @@ struct block_elem {
         } u;
 	int flags;
         pos_index end;
-        /*@null@*/ /*@owned@*/
+        /*@null@*/ /*@dependent@*/
 	block *next;
+        block_index idx;
 };
 
 
@@ -101,12 +112,16 @@ struct block_elem {
 * @member num_blocks	: number of blocks in the partition.
 * sum                   : pointer to array of doubles that contains, for each
 *                         state, the probability to enter the splitter.
-* ib[pos].id            : array that contains state indexes in a special order,
+* id[pos]               : array that contains state indexes in a special order,
 *                         as explained with struct block_elem.
-* ib[state].b           : array that contains, for each state, the block to
-*                         which it belongs.
-* Note that the order of the two subarrays of ib is different; they are put
-* together anyway to make optimal use of the struct hack.
+* b[state]              : array that contains, for each state, the index of the
+*                         block to which it belongs (see part_block_nt()).
+* Both arrays are allocated together, b == id + number of states.
+* pool                  : array of chunks that contain the blocks.
+* pool_chunks           : number of entries in the array pool.
+* pool_used             : number of blocks taken from the pool so far.
+* pool_free             : list of released blocks (linked by next), they are
+*                         reused before new blocks are taken from the pool.
 */
 typedef struct{
         /*@owned@*/
@@ -116,16 +131,25 @@ typedef struct{
         state_count num_blocks;
         /*@only@*/ /*@null@*/ double * sum;
         /*@only@*/ /*@null@*/ pos_index * pos;
-
-        /* struct hack: saves one pointer dereference. In practice, the
-           following array contains an element for each state, not only one
-           element. */
-        struct id_block {
-                state_index id;
-                /*@dependent@*/ block * b;
-        } ib[1];
+        /*@only@*/ state_index * id;
+        /*@dependent@*/ block_index * b;
+        /*@only@*/ block ** pool;
+        state_count pool_chunks;
+        block_index pool_used;
+        /*@dependent@*/ /*@null@*/ block * pool_free;
 } partition;
 
+/**
+* This macro returns the block with index idx in the block pool of P.
+* The suffix "_nt" indicates that the macro does not test its parameters for
+* validity.
+*/
+extern /*@dependent@*/ block * part_block_nt(
+                /*@observer@*/ /*@temp@*/ /*@sef@*/ const partition * P,
+                block_index idx) /*@modifies nothing@*/;
+#define part_block_nt(P,idx) ((block * const) ((P)->pool[(idx) >> \
+                PART_POOL_CHUNK_BITS] + ((idx) & (PART_POOL_CHUNK - 1))))
+
 /**
 * This macro returns the position index of the last state in the block PLUS ONE.
 * Parameter: B = block
@@ -173,8 +197,8 @@ extern /*@nullwhentrue@*/ BOOL part_is_invalid(
 #define part_is_invalid(P) (sizeof(partition) != sizeof(*(P)) || NULL == (P) \
                 || NULL == (P)->blocks || ((void) (P)->blocks->u.next_Sp, \
                 (void) (P)->first_Sp, (void) (P)->first_PredCl, \
-                (void) ((P)->num_blocks + (P)->ib[0].id), (void) (P)->sum, \
-                (void) (P)->pos, (void) (P)->ib[0].b->flags, \
+                (void) ((P)->num_blocks + (P)->id[0] + (P)->b[0]), (void) (P)->sum, \
+                (void) (P)->pos, (void) (P)->pool[0]->flags, \
                 FALSE))
 
 /**
@@ -189,11 +213,11 @@ extern state_index part_unlump_state_block_nt(
                 /*@modifies nothing@*/;
 #define part_unlump_state_block_nt(P,B) ((void) (P)->blocks->u.next_Sp, \
                 (void) (P)->first_Sp, (void) (P)->first_PredCl, \
-                (void) ((P)->num_blocks + (P)->ib[0].id), (void) (P)->sum, \
-                (void) (P)->pos, (void) (P)->ib[0].b->flags, \
+                (void) ((P)->num_blocks + (P)->id[0] + (P)->b[0]), (void) (P)->sum, \
+                (void) (P)->pos, (void) (P)->pool[0]->flags, \
                 (void) (B)->u.next_Sp, (void) (B)->u.next_PredCl, \
                 (void) ((B)->u.row + (B)->flags), (void) (B)->next, \
-                (const state_index) (P)->ib[(B)->end - 1].id)
+                (const state_index) (P)->id[(B)->end - 1])
 
 extern state_index part_unlump_state_block(
                 /*@observer@*/ /*@temp@*/ /*@sef@*/ const partition * P,
@@ -217,9 +241,9 @@ extern /*@dependent@*/ block * block_of(
                 /*@modifies nothing@*/;
 #define block_of(P,state) ((void) (P)->blocks->u.next_Sp, \
                 (void) (P)->first_Sp, (void) (P)->first_PredCl, \
-                (void) ((P)->num_blocks + (P)->ib[0].id), (void) (P)->sum, \
-                (void) (P)->pos, (void) (P)->ib[0].b->flags, \
-                (block * const) (P)->ib[(state)].b)
+                (void) ((P)->num_blocks + (P)->id[0] + (P)->b[0]), (void) (P)->sum, \
+                (void) (P)->pos, (void) (P)->pool[0]->flags, \
+                part_block_nt((P), (P)->b[(state)]))
 
 /**
 * This macro finds the number of block B. (It is not used internally because it
@@ -233,8 +257,8 @@ extern state_index part_lump_state_block_nt(
                 /*@modifies nothing@*/;
 #define part_lump_state_block_nt(P,B) ((void) (P)->blocks->u.next_Sp, \
                 (void) (P)->first_Sp, (void) (P)->first_PredCl, \
-                (void) ((P)->num_blocks + (P)->ib[0].id), (void) (P)->sum, \
-                (void) (P)->pos, (void) (P)->ib[0].b->flags, \
+                (void) ((P)->num_blocks + (P)->id[0] + (P)->b[0]), (void) (P)->sum, \
+                (void) (P)->pos, (void) (P)->pool[0]->flags, \
                 (void) (B)->u.next_Sp, (void) (B)->u.next_PredCl, \
                 (void) ((B)->u.row + (B)->flags), (void) (B)->next, \
                 (const state_index) (B)->u.row)
@@ -324,11 +348,11 @@ extern err_state print_state_prob_partition(/*@observer@*/ const partition * P,
 
 /**
 * The function splits a block into two parts. It creates a new block and moves
-* the states in ib[block_begin(B) ... pos-1].id to the new block.
+* the states in id[block_begin(B) ... pos-1] to the new block.
 * Parameters: P = partition
 *               B = block
 *               pos = position where the block has to be split.
-*               set_b = if TRUE, block_split also sets P->ib[...].b to the
+*               set_b = if TRUE, block_split also sets P->b[...] to the
 *                       new block.
 * Result: err_OK if everything went fine; err_ERROR if some error has happened.
 */
@@ -346,7 +370,7 @@ extern /*@dependent@*/ /*@null@*/ block * part_split_block(partition * P,
 extern err_state part_refine_rewards(partition * P,
                 /*@observer@*/ const double * reward)
                 /*@requires notnull P->blocks, P->pos@*/
-                /*@modifies P->first_Sp, *P->blocks, P->ib, P->num_blocks,
+                /*@modifies P->first_Sp, *P->blocks, P->id, P->b, P->num_blocks,
                         *P->pos @*/;
 
 /**
@@ -368,6 +392,23 @@ extern /*@only@*/ /*@null@*/ partition * init_partition_formula(
                 /*@ensures isnull result->first_PredCl, result->sum@*/
                 /*@modifies nothing@*/;
 
+/**
+* The function creates a partition from an array that assigns a block number to
+* every state. Block i gets the number i, no block is absorbing.
+* Parameters: number = array with number[s] = block of state s, where every
+*               number in 0 ... num_blocks - 1 has to be used at least once
+*       size = number of states
+*       num_blocks = number of blocks
+* Result: Pointer to a new partition; NULL if some error has happened.
+*/
+extern /*@only@*/ /*@null@*/ partition * part_from_block_numbers(
+                /*@observer@*/ const state_index * number,
+                state_count size, state_count num_blocks)
+                /*@ensures notnull result->blocks@*/
+                /*@ensures isnull result->first_Sp, result->first_PredCl,
+                        result->sum, result->pos@*/
+                /*@modifies nothing@*/;
+
 /**
 * This method frees the partition.
 * @param	: partition *P: The partition.
@@ -376,20 +417,18 @@ extern err_state free_partition(/*@only@*/ partition * P)
                 /*@requires notnull P->blocks@*/ /*@modifies *P@*/;
 
 /**
-* This method frees the block.
+* This method returns the block to the block pool of the partition.
+* @param	: partition *P: The partition.
 * @param	: block *B: The block.
 */
-extern err_state free_block(/*@only@*/ /*@sef@*/ block *B) /*@modifies B@*/;
-#define free_block(B) (sizeof(block) != sizeof(*(B)) || NULL == (B) \
-                        || ((void) (B)->u.next_Sp, (void) (B)->u.next_PredCl, \
-                            (void) ((B)->u.row + (B)->flags), (void) (B)->next,\
-                            FALSE) \
-                ? err_macro_1(err_PARAM,"free_block(%p)",(void*)(B),err_ERROR) \
-                : (free((B)), err_OK))
+extern err_state part_free_block(partition * P, /*@dependent@*/ block * B)
+                /*@modifies P->pool_free, B->next@*/;
 
 /**
 * The function numbers the blocks in partition P. As many states as possible get
-* a number n such that state n is also a member of the block.
+* a number n such that state n is also a member of the block. Afterwards, every
+* block is stored in the pool slot with its number, so the block number of a
+* state can be read directly from P->b; pointers to blocks become invalid.
 * Parameter: P = partition
 * Result: err_OK if everything went fine; err_ERROR otherwise.
 */
@@ -397,7 +436,7 @@ extern err_state part_number_blocks(partition * P)
                 /*@requires notnull P->blocks@*/
                 /*@requires isnull P->first_Sp, P->first_PredCl@*/
                 /*@ensures notnull P->blocks@*/
-                /*@modifies P->ib[].b->u, *P->blocks->next@*/;
+                /*@modifies *P->blocks@*/;
 
 /**
 * This method prints the blocks and states of the partition.
@@ -418,8 +457,8 @@ extern state_count part_lumped_state_space_size_nt(
                 /*@modifies nothing@*/;
 #define part_lumped_state_space_size_nt(P) ((void) (P)->blocks->u.next_Sp, \
                 (void) (P)->first_Sp, (void) (P)->first_PredCl, \
-                (void) ((P)->num_blocks + (P)->ib[0].id), (void) (P)->sum, \
-                (void) (P)->pos, (void) (P)->ib[0].b->flags, \
+                (void) ((P)->num_blocks + (P)->id[0] + (P)->b[0]), (void) (P)->sum, \
+                (void) (P)->pos, (void) (P)->pool[0]->flags, \
                 (const state_count) (P)->num_blocks)
 
 /**
@@ -435,8 +474,8 @@ extern state_count part_unlumped_state_space_size_nt(
                 /*@modifies nothing@*/;
 #define part_unlumped_state_space_size_nt(P) ((void) (P)->blocks->u.next_Sp, \
                 (void) (P)->first_Sp, (void) (P)->first_PredCl, \
-                (void) ((P)->num_blocks + (P)->ib[0].id), (void) (P)->sum, \
-                (void) (P)->pos, (void) (P)->ib[0].b->flags, \
+                (void) ((P)->num_blocks + (P)->id[0] + (P)->b[0]), (void) (P)->sum, \
+                (void) (P)->pos, (void) (P)->pool[0]->flags, \
                 (const state_count) (P)->blocks->end)
 
 extern state_count get_unlumped_state_space_size(
@@ -450,8 +489,9 @@ extern state_count get_unlumped_state_space_size(
 
 /**
 * This method is used to retrieve the state index in the lumped state space.
-* The suffix "_nt" indicates that the macro does not test its parameters for
-* validity.
+* The partition has to be numbered by part_number_blocks(), which makes this a
+* single array access. The suffix "_nt" indicates that the macro does not test
+* its parameters for validity.
 * @param pPartition the state-space partition
 * @param state_idx the state index in the unlumped state space
 * @return "-1" if "state_idx" is not within the state-index range of
@@ -465,9 +505,9 @@ extern state_index part_lump_state_id_nt(
                 /*@modifies nothing@*/;
 #define part_lump_state_id_nt(P,state_idx) ((void) (P)->blocks->u.next_Sp, \
                 (void) (P)->first_Sp, (void) (P)->first_PredCl, \
-                (void) ((P)->num_blocks + (P)->ib[0].id), (void) (P)->sum, \
-                (void) (P)->pos, (void) (P)->ib[0].b->flags, \
-                (const state_index) (P)->ib[(state_idx)].b->u.row)
+                (void) ((P)->num_blocks + (P)->id[0] + (P)->b[0]), (void) (P)->sum, \
+                (void) (P)->pos, (void) (P)->pool[0]->flags, \
+                (const state_index) (P)->b[(state_idx)])
 
 extern state_index getLumpedStateIndex(
                 /*@observer@*/ /*@temp@*/ /*@sef@*/ const partition *pPartition,
@@ -44,6 +44,12 @@
 
 #include "partition.h"
 
+/**
+* What is the maximum difference between two elements to put them into the same
+* equivalence class?
+*/
+#define EPSILON 3E-12
+
 /**
 * The function refines a block according to the floating point numbers in key.
 * It splits the block into subsets; each subset consists of states that have
@@ -51,7 +57,7 @@
 * Parameters: P = partition
 *	B = block to be refined;
 *	key = array of doubles (key[s] = value for state s).
-*	set_b = TRUE if the array P->states[...].b has to be set to the correct
+*	set_b = TRUE if the array P->b[...] has to be set to the correct
 *		value;
 *	largest = largest block found until now. may be NULL.
 * Result: the largest block found (either the parameter largest or a larger
@@ -60,7 +66,7 @@
 extern err_state sort_and_split_block(partition * P, /*@dependent@*/ block * B,
 		/*@observer@*/ const double * key, BOOL set_b)
 		/*@requires notnull P->blocks, P->first_Sp, P->pos@*/
-		/*@modifies P->num_blocks, P->ib[], B->u.next_Sp, B->next,
+		/*@modifies P->num_blocks, P->id[], P->b[], B->u.next_Sp, B->next,
 			*P->pos@*/;
 
 #endif
@@ -0,0 +1,115 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Maneesh Khattri, Ivan Zapreev, Tim Kemna
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*
+*	Source description: Expected rewards of CTMRM and DTMRM: the
+*				 instantaneous reward, the cumulative reward and
+*				 the reachability reward.
+*/
+
+#ifndef EXPECTED_REWARDS_H
+#define EXPECTED_REWARDS_H
+
+#include "bitset.h"
+
+/**
+* Computes the expected instantaneous reward at time supi and the expected
+* cumulative reward up to time supi of a CTMRM, for all the initial states,
+* by uniformization. Both are computed from the same iterates, by the fused
+* matrix-vector product and accumulation, see multiply_mtx_MV_acc(...).
+* The instantaneous reward only depends on the state rewards, the
+* cumulative reward also contains the expected impulse rewards.
+* @param supi the time bound
+* @param phi only the rewards of the phi states (and of the transitions
+*	leaving them) are taken into account, if NULL then all of them are
+* @param ppInstant if not NULL then the instantaneous rewards are
+*	allocated here and returned by this pointer
+* @param ppCumulative if not NULL then the cumulative rewards are
+*	allocated here and returned by this pointer
+* @return err_OK if everything went fine; err_ERROR otherwise.
+* NOTE: 1. W.K. Grassmann. Means and variances of time averages in Markovian
+*	environments. European Journal of Operational Research 31(1),
+*	pp. 132-139, 1987.
+*/
+extern err_state ctmrm_expected_rewards(double supi, const bitset * phi,
+                double ** ppInstant, double ** ppCumulative);
+
+/**
+* Computes the expected instantaneous reward at step steps and the expected
+* cumulative reward of the first steps steps of a DTMRM, for all the initial
+* states, in one sweep.
+* The reward of a state and the impulse reward of a transition are earned
+* when leaving the state, so the cumulative reward of steps steps is
+* sum_{k=0}^{steps-1} P^k (rho + P.iota).
+* @param steps the number of steps
+* @param phi only the rewards of the phi states (and of the transitions
+*	leaving them) are taken into account, if NULL then all of them are
+* @param ppInstant if not NULL then the instantaneous rewards are
+*	allocated here and returned by this pointer
+* @param ppCumulative if not NULL then the cumulative rewards are
+*	allocated here and returned by this pointer
+* @return err_OK if everything went fine; err_ERROR otherwise.
+*/
+extern err_state dtmrm_expected_rewards(int steps, const bitset * phi,
+                double ** ppInstant, double ** ppCumulative);
+
+/**
+* Computes the expected reward accumulated until a psi state is reached in
+* a CTMRM, for all the initial states. The system of linear equations of the
+* embedded DTMC is solved by the linear solver set by get_method_path().
+* @param psi SAT(psi).
+* @return the expected rewards, HUGE_VAL for the states that reach psi
+*	with a probability less than one.
+*/
+extern double * ctmrm_reachability_reward(const bitset * psi);
+
+/**
+* Computes the expected reward accumulated until a psi state is reached in
+* a DTMRM, for all the initial states. The system of linear equations is
+* solved by the linear solver set by get_method_path().
+* @param psi SAT(psi).
+* @return the expected rewards, HUGE_VAL for the states that reach psi
+*	with a probability less than one.
+*/
+extern double * dtmrm_reachability_reward(const bitset * psi);
+
+#endif
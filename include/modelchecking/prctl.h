@@ -78,4 +78,23 @@ remark		:
 ******************************************************************************/
 extern double * yf(int, const bitset *);
 
+/*****************************************************************************
+name		: yf_discounted
+role		: solve the discounted Y formula in DMRM
+@param		: int steps: n.
+@param		: bitset *phi: satisfaction relation for phi formula.
+@param		: double discount: the reward of step k is discounted by
+		  discount^k, 0 < discount <= 1.
+@return		: double *: result of N-R bounded discounted Y formula in DMRM.
+remark		:
+******************************************************************************/
+extern double * yf_discounted(int, const bitset *, double);
+
+/*****************************************************************************
+name		: free_reward_sweep
+role		: free the state of the reward sweep of the C and Y formulas.
+remark		: Has to be called before model checking a new model.
+******************************************************************************/
+extern void free_reward_sweep(void);
+
 #endif
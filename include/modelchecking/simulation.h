@@ -312,6 +312,234 @@ extern inline void setSampleBSCCDimensionMultiplier(int _sampleBSCCDimensionMult
 */
 extern int getSampleBSCCDimensionMultiplier(void);
 
+/****************************************************************************/
+/*****************MANAGE THE PARALLEL SIMULATION PARAMETERS******************/
+/****************************************************************************/
+
+/* The minimum and maximum number of simulation threads */
+#define MIN_SIM_THREADS 0
+#define MAX_SIM_THREADS 1024
+
+/* The default number of simulation threads, 0 stands for the sequential */
+/* simulation with the generators set by sim_method_disc and sim_method_exp */
+#define DEF_SIM_THREADS 0
+
+/* The default seed of the simulation streams, 0 means the system clock */
+#define DEF_SIM_SEED 0
+
+/**
+* Sets the number of simulation threads. For one or more threads the
+* observations are simulated by lanes of SIM_LANES observations, each
+* thread with its own xoshiro128** stream instead of the generators set
+* by sim_method_disc and sim_method_exp. The result only depends on the
+* seed and the number of threads, not on the thread scheduling.
+* @param _threads the number of threads, 0 for the sequential simulation
+*		with the generators set by sim_method_disc and sim_method_exp
+*/
+extern void setSimThreads(int _threads);
+
+/**
+* Gets the number of simulation threads.
+* @return the number of simulation threads
+*/
+extern int getSimThreads(void);
+
+/**
+* Sets the seed of the parallel simulation streams.
+* @param _seed the seed, 0 for seeding by the system clock
+*/
+extern void setSimSeed(unsigned long _seed);
+
+/**
+* Gets the seed of the parallel simulation streams.
+* @return the seed, 0 stands for seeding by the system clock
+*/
+extern unsigned long getSimSeed(void);
+
+/****************************************************************************/
+/**************MANAGE THE HYPOTHESIS TEST FOR THE PROBABILITY BOUND**********/
+/****************************************************************************/
+
+/* The tests deciding on the probability bound of time-interval until: */
+/* the conf. int. of the Thesis of Ivan S. Zapreev, Wald's sequential */
+/* probability ratio test and the sequential Bayesian test */
+#define SIM_TEST_CONF_INT	0
+#define SIM_TEST_SPRT		1
+#define SIM_TEST_BAYES		2
+
+#define DEF_SIM_TEST SIM_TEST_CONF_INT
+
+/* The min/max error probability of the sequential tests */
+/* 0 stands for the error 1 - confidence */
+#define MIN_SIM_TEST_ERROR 0.0
+#define MAX_SIM_TEST_ERROR 0.5
+
+/* The default error probabilities of the sequential tests */
+#define DEF_SIM_TEST_ERROR 0.0
+
+/**
+* Sets the test deciding on the probability bound. The conf. int. test
+* starts with the minimum sample size and checks the conf. int. after every
+* sample-size step. The sequential tests start with one sample-size step
+* and decide after every step whether the probability lies above or below
+* the indifference region "prob_bound -/+ indiff_width/2".
+* @param _test one from {SIM_TEST_CONF_INT, SIM_TEST_SPRT, SIM_TEST_BAYES}
+*/
+extern void setSimTestMethod(int _test);
+
+/**
+* Gets the test deciding on the probability bound.
+* @return one from {SIM_TEST_CONF_INT, SIM_TEST_SPRT, SIM_TEST_BAYES}
+*/
+extern int getSimTestMethod(void);
+
+/**
+* Sets the probability of the sequential tests to decide that the
+* probability lies below the indifference region while it lies above.
+* @param _alpha the error probability, 0 for 1 - confidence
+*/
+extern void setSimTestAlpha(double _alpha);
+
+/**
+* Gets the probability of the sequential tests to decide that the
+* probability lies below the indifference region while it lies above.
+* @return the error probability, 0 stands for 1 - confidence
+*/
+extern double getSimTestAlpha(void);
+
+/**
+* Sets the probability of the sequential tests to decide that the
+* probability lies above the indifference region while it lies below.
+* @param _beta the error probability, 0 for 1 - confidence
+*/
+extern void setSimTestBeta(double _beta);
+
+/**
+* Gets the probability of the sequential tests to decide that the
+* probability lies above the indifference region while it lies below.
+* @return the error probability, 0 stands for 1 - confidence
+*/
+extern double getSimTestBeta(void);
+
+/****************************************************************************/
+/******************MANAGE THE IMPORTANCE SPLITTING PARAMETERS****************/
+/****************************************************************************/
+
+/* The min/max number of trajectories per level of importance splitting, */
+/* 0 switches the splitting off */
+#define MIN_SIM_SPLIT_EFFORT 0
+#define MAX_SIM_SPLIT_EFFORT 10000000
+
+/* The default number of trajectories per level, the splitting is off */
+#define DEF_SIM_SPLIT_EFFORT 0
+
+/* The min/max number of independent splitting runs, the runs give */
+/* the conf. int. of the estimate so there have to be two at least */
+#define MIN_SIM_SPLIT_RUNS 2
+#define MAX_SIM_SPLIT_RUNS 100000
+
+/* The default number of independent splitting runs */
+#define DEF_SIM_SPLIT_RUNS 20
+
+/**
+* Sets the number of trajectories per level of the fixed-effort importance
+* splitting. If it is positive, the unbounded and the time-interval until
+* are estimated by splitting instead of crude Monte Carlo simulation, this
+* is meant for very small probabilities that the crude simulation never
+* observes within the maximum sample size.
+* @param _effort the number of trajectories per level, 0 for no splitting
+*/
+extern void setSimSplitEffort(int _effort);
+
+/**
+* Gets the number of trajectories per level of the importance splitting.
+* @return the number of trajectories per level, 0 stands for no splitting
+*/
+extern int getSimSplitEffort(void);
+
+/**
+* Sets the number of independent runs of the importance splitting.
+* @param _runs the number of runs
+*/
+extern void setSimSplitRuns(int _runs);
+
+/**
+* Gets the number of independent runs of the importance splitting.
+* @return the number of runs
+*/
+extern int getSimSplitRuns(void);
+
+/****************************************************************************/
+/*****************MANAGE THE IMPORTANCE SAMPLING PARAMETERS******************/
+/****************************************************************************/
+
+/* The importance sampling methods of time-interval until: none, the */
+/* balanced failure biasing and the zero-variance approximation */
+#define SIM_IS_NONE	0
+#define SIM_IS_BFB	1
+#define SIM_IS_ZVA	2
+
+#define DEF_SIM_IS SIM_IS_NONE
+
+/* The bias of the importance sampling should be in (0,1) */
+#define MIN_SIM_IS_BIAS 0.0
+#define MAX_SIM_IS_BIAS 1.0
+
+/* The default bias of the importance sampling */
+#define DEF_SIM_IS_BIAS 0.5
+
+/* The default rate threshold of the failure transitions, 0 stands for */
+/* the transitions that go down the distance to the Psi states */
+#define DEF_SIM_IS_FAILURE_RATE 0.0
+
+/**
+* Sets the importance sampling method of time-interval until. The paths
+* are simulated with biased successor probabilities and the probability
+* is estimated by the mean of their likelihood ratios, the conf. int. is
+* checked after every sample-size step. The balanced failure biasing takes
+* the failure transitions with the probability given by the bias, all of
+* them with the same probability. The zero-variance approximation takes
+* every successor proportionally to its probability times bias^d, where d
+* is its distance to the Psi states.
+* @param _method one from {SIM_IS_NONE, SIM_IS_BFB, SIM_IS_ZVA}
+*/
+extern void setSimISMethod(int _method);
+
+/**
+* Gets the importance sampling method of time-interval until.
+* @return one from {SIM_IS_NONE, SIM_IS_BFB, SIM_IS_ZVA}
+*/
+extern int getSimISMethod(void);
+
+/**
+* Sets the bias of the importance sampling: the probability of a failure
+* transition for the balanced failure biasing and the factor per distance
+* to the Psi states for the zero-variance approximation.
+* @param _bias the bias in (0,1)
+*/
+extern void setSimISBias(double _bias);
+
+/**
+* Gets the bias of the importance sampling.
+* @return the bias in (0,1)
+*/
+extern double getSimISBias(void);
+
+/**
+* Sets the rate threshold of the failure transitions of the balanced
+* failure biasing: the transitions with a rate not above it are failures.
+* @param _rate the rate threshold, 0 for the transitions that go down the
+*		distance to the Psi states
+*/
+extern void setSimISFailureRate(double _rate);
+
+/**
+* Gets the rate threshold of the failure transitions.
+* @return the rate threshold, 0 stands for the transitions that go down the
+*		distance to the Psi states
+*/
+extern double getSimISFailureRate(void);
+
 /****************************************************************************/
 /*******************PRINT THE SIMULATION RUNTIME PARAMETERS******************/
 /****************************************************************************/
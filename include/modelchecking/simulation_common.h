@@ -50,6 +50,8 @@
 #include "sample_vec.h"
 #include "sparse.h"
 #include "rand_num_generator.h"
+#include "rng_stream.h"
+#include "rng_block.h"
 
 #include <stdarg.h>
 
@@ -152,9 +154,12 @@
 	* @param pNoBitSet contains curr_state if it does not satisfy the formula
 	* @param pNumUsedObserv the pointer to the return-value variable that will store the
 	*		number of observations used for simulating this one state.
-	* @param pTransAndGoodStatesArguments contain the two bitsets in the following order:
+	* @param pTransAndGoodStatesArguments contain the two bitsets and the level
+	*		function in the following order:
 	*		1. pTransientStates the bitsets containing all the transient states
 	*		2. pGoodStates the bitsets containing all the good absorbing states
+	*		3. pLevels the level function of the importance splitting, if it
+	*			is NULL the state is model checked by crude simulation
 	*/
         extern
 	void modelCheckOneStateUUCommon( const sparse* pStateSpace, const int initial_state, const double indiff_width,
@@ -177,6 +182,64 @@
 	PTSampleVecSteady * prepareSSSimulationSample(const sparse * pStateSpace, const int numberOfNonTrivBSCCs,
 													bitset ** const ppNonTrivBSCCBitSets, int * pNumberOfNonTrivBSCCStates );
 
+	/**
+	 * The minimum number of off-diagonal entries of a row for which the
+	 * sampling index holds an alias table. Narrower rows are sampled by
+	 * the cumulative scan, which is cheaper for them.
+	 */
+#       define SAMPLING_ALIAS_MIN_ROW_SIZE 8
+
+	/**
+	 * This function builds the sampling index of the given (embedded)
+	 * DTMC: an alias table for every row with at least
+	 * SAMPLING_ALIAS_MIN_ROW_SIZE off-diagonal entries. Until the index is
+	 * freed, computeNextState samples these rows in constant time.
+	 * WARNING: The index is valid only as long as the values of pM do not
+	 * change, so it has to be freed before the embedded DTMC is restored.
+	 * If there is not enough memory, no index is built and the rows are
+	 * sampled by the cumulative scan.
+	 * NOTE: Only getSimulationModel builds the index. This covers all the
+	 * unbiased successor sampling: the unbounded-until samplers (the
+	 * *DTMC functions of simulation_utils.c), the steady-state and
+	 * interval-until samplers and the importance splitting all walk the
+	 * embedded DTMC of the simulation model; MRMC has no simulation of
+	 * DTMC or DMRM models. The importance sampling is excluded on purpose:
+	 * its successor probabilities are biased anew in every step, so it
+	 * scans the rows itself.
+	 * @param pM the sparse matrix of the embedded DTMC to be simulated
+	 */
+        extern void buildSamplingIndex(/*@dependent@*/ const sparse * pM);
+
+	/**
+	 * This function frees the sampling index built by buildSamplingIndex.
+	 */
+        extern void freeSamplingIndex(void);
+
+	/**
+	 * This function computes to which state we will go from a state that
+	 * has outgoing off-diagonal transitions. It uses the sampling index
+	 * if it has been built for pM and falls back to the cumulative scan
+	 * otherwise.
+         * @param pM                the sparse matrix describing the state space
+         * @param current_obs_state the current state index
+	 * @return the next state
+	 */
+        extern state_index sampleNextState(/*@observer@*/ const sparse * pM,
+                        state_index current_obs_state);
+
+	/**
+	 * This function computes to which state we will go with the given
+	 * uniformly distributed random number. This is what the lane
+	 * simulators use, they draw the random numbers of all lanes at once.
+         * @param pM                the sparse matrix describing the state space
+         * @param current_obs_state the current state index
+	 * @param unif_rand a uniformly distributed random number in [0,1)
+	 * WARNING: The self loops are not taken into account, we expect there to be NONE
+	 * @return the next state, current_obs_state if it is absorbing
+	 */
+        extern state_index chooseNextState(/*@observer@*/ const sparse * pM,
+                        state_index current_obs_state, double unif_rand);
+
 	/**
 	 * This function computes to which state we will go.
          * @param pM                the sparse matrix describing the state space
@@ -192,12 +255,84 @@
                 /* If we are not in an absorbing state */ \
                 (0 != mtx_next_num((pM), (current_obs_state)) \
                         ? /* Compute to what state we will go */ \
-                          generateRandNumberDiscrete( \
-                                (pM)->valstruc[(current_obs_state)].col, \
-                                (pM)->valstruc[(current_obs_state)].val, \
-                                mtx_next_num((pM), (current_obs_state))) \
+                          sampleNextState((pM), (current_obs_state)) \
                         : (current_obs_state))
 
+	/**
+	 * The simulation-ready form of a CTMC. It is derived from the rate
+	 * matrix once and shared by the simulations of all formulas until the
+	 * state space is set anew.
+	 * NOTE: A state is absorbing iff it has no off-diagonal transitions,
+	 * its row in pEmbeddedDTMC is then empty and its exit rate and mean
+	 * holding time are 0.0.
+	 */
+	typedef struct SSimulationModel {
+		/* The rate matrix and the row sums the model was derived from */
+		/*@dependent@*/ const sparse * pRateMatrix;
+		/*@dependent@*/ const double * pRowSums;
+		/* The embedded DTMC without the self loops, an ncolse matrix */
+		/* that has the sampling index built for it */
+		/*@only@*/ sparse * pEmbeddedDTMC;
+		/* The exit rates of all states */
+		/*@only@*/ double * pExitRates;
+		/* The mean holding times, i.e. the inverse exit rates, of all states */
+		/*@only@*/ double * pHoldingTimes;
+	} TSimulationModel;
+
+	/**
+	 * This function returns the simulation model of the given CTMC. It is
+	 * built on the first call and kept until freeSimulationModel is called,
+	 * which set_state_space does whenever the state space changes.
+	 * WARNING: The rate matrix may not change while the model is kept.
+	 * @param pRateMatrix the rate matrix of the CTMC
+	 * @param pRowSums the row sums of pRateMatrix
+	 * @return the simulation model
+	 */
+        extern /*@observer@*/ const TSimulationModel * getSimulationModel(
+                        /*@dependent@*/ const sparse * pRateMatrix,
+                        /*@dependent@*/ const double * pRowSums);
+
+	/**
+	 * This function frees the simulation model built by
+	 * getSimulationModel together with its sampling index.
+	 */
+        extern void freeSimulationModel(void);
+
+	/**
+	 * This function returns the streams of the parallel simulation, one
+	 * for each of the getSimThreads() threads, and one stream for the
+	 * sequential importance splitting if there are no simulation
+	 * threads. On the first call after
+	 * freeSimulationStreams the streams are seeded from getSimSeed(), or
+	 * from the system clock if the seed is 0; the k-th stream is the
+	 * seeded stream jumped k times. Afterwards every call returns the
+	 * streams in the state the previous simulation left them.
+	 * @return the array of streams
+	 */
+        extern /*@observer@*/ TRNGStream * getSimulationStreams(void);
+
+	/**
+	 * This function frees the streams of the parallel simulation, the
+	 * next call of getSimulationStreams creates them anew.
+	 */
+        extern void freeSimulationStreams(void);
+
+	/**
+	 * The number of observations a lane simulator advances together. The
+	 * states, clocks and flags of the lanes are kept in separate arrays
+	 * and all lanes make one step before the next step starts.
+	 */
+#       define SIM_LANES 64
+
+	/**
+	 * The first observation of the given thread if num_obs observations
+	 * are divided in contiguous chunks among the threads. Thread t
+	 * simulates the observations from SIM_CHUNK_START(num_obs,threads,t)
+	 * to SIM_CHUNK_START(num_obs,threads,t+1) - 1 with the t-th stream.
+	 */
+#       define SIM_CHUNK_START(num_obs,threads,t) \
+                MIN((t) * (((num_obs) + (threads) - 1) / (threads)), (num_obs))
+
 	/**
          * This function simulates the unbounded reachability samples for model
          * checking the
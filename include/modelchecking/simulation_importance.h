@@ -0,0 +1,96 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description: This is a header file for the simulation engine
+*	here we intend to define the importance sampling of time-interval
+*	until: the balanced failure biasing of A. Goyal, P. Shahabuddin,
+*	P. Heidelberger, V. F. Nicola and P. W. Glynn, "A unified framework
+*	for simulating Markovian models of highly dependable systems", IEEE
+*	Trans. on Computers 41(1), 1992, and the zero-variance approximation
+*	of P. L'Ecuyer and B. Tuffin, "Approximating zero-variance importance
+*	sampling in a reliability setting", Annals of Operations Research
+*	189, 2011.
+*/
+
+#ifndef SIMULATION_IMPORTANCE_H
+#define SIMULATION_IMPORTANCE_H
+
+#include "simulation_splitting.h"
+
+	/**
+	* The change of measure of the importance sampling.
+	*/
+	typedef struct SImportanceBias{
+		/* One from {SIM_IS_BFB, SIM_IS_ZVA} */
+		int method;
+		/* The probability of the failure transitions (SIM_IS_BFB) or */
+		/* the factor per level (SIM_IS_ZVA) */
+		double bias;
+		/* The transitions with a rate up to it are failures, if it is 0 */
+		/* the transitions that go down a level are failures (SIM_IS_BFB) */
+		double failure_rate;
+	} TImportanceBias;
+
+	/**
+	* This function simulates num_obs paths of "Phi U[tl, tr] Psi" from
+	* initial_state with the successor probabilities changed by the bias.
+	* A path that fulfills the formula is weighted by its likelihood ratio,
+	* the product of the original over the biased probabilities of its
+	* steps, other paths by 0. The mean of the weights is an unbiased
+	* estimate of the probability. The holding times are not biased.
+	* The paths are divided in contiguous chunks among the simulation
+	* threads, each simulates with its own stream.
+	* WARNING: We simulate the states ASSUMING there are no self loops!
+	* @param pModel the model of the until formula, the zero-variance
+	*		approximation and the failures by level use its levels
+	* @param pBias the change of measure
+	* @param initial_state the state the paths start in
+	* @param num_obs the number of paths to simulate
+	* @param pSumWeights the sum of the weights, it is increased
+	* @param pSumSqWeights the sum of the squared weights, it is increased
+	* @param pVisitedStates the counter of simulated states, it is increased
+	*/
+	extern void simulateImportanceSample( const TSplittingModel * pModel, const TImportanceBias * pBias,
+						const int initial_state, const int num_obs, double * pSumWeights,
+						double * pSumSqWeights, unsigned int * pVisitedStates );
+
+#endif
@@ -0,0 +1,123 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description: This is a header file for the simulation engine
+*	here we intend to define the importance splitting of the until
+*	operators. The fixed-effort splitting follows M. J. J. Garvels, "The
+*	splitting method in rare event simulation", PhD Thesis, University of
+*	Twente, 2000.
+*/
+
+#ifndef SIMULATION_SPLITTING_H
+#define SIMULATION_SPLITTING_H
+
+#include "bitset.h"
+#include "sparse.h"
+
+	/**
+	* The model of an until formula "Phi U[tl, tr] Psi" as seen by the
+	* importance splitting. The level of a state is the level function
+	* the splitting is driven by: the paths have to go down the levels one
+	* by one and the Psi states are on level 0. A state with a negative
+	* level can not reach a Psi state, the paths entering it are stopped.
+	*/
+	typedef struct SSplittingModel{
+		/* The embedded DTMC */
+		const sparse * pStateSpace;
+		/* The states the paths may go through */
+		const bitset * pPhiBitSet;
+		/* The states the paths have to reach */
+		const bitset * pPsiBitSet;
+		/* The level of every state */
+		const int * pLevels;
+		/* The exit rates of the states of a CTMC, for a DTMC it is NULL */
+		/* and every step takes one time unit, so the time bounds count */
+		/* the steps */
+		const double * pExitRates;
+		/* The time bounds "tl" and "tr" */
+		double left_time_bound;
+		double right_time_bound;
+	} TSplittingModel;
+
+	/**
+	* This function computes the level function of the importance splitting
+	* which is used if no other one is given: the length of the shortest
+	* path from a state via Phi states to a Psi state, so every step can go
+	* down one level at most. It is obtained by the same backward search
+	* as get_exist_until.
+	* @param pStateSpace the state space
+	* @param pPhiBitSet the states the paths may go through
+	* @param pPsiBitSet the states the paths have to reach
+	* @return the level of every state, -1 if Psi is not reachable via Phi
+	*/
+	extern int * computeSplittingLevels( const sparse * pStateSpace, const bitset * pPhiBitSet,
+						const bitset * pPsiBitSet );
+
+	/**
+	* This function estimates the probability of "Phi U[tl, tr] Psi" in
+	* initial_state by fixed-effort importance splitting. Each of the runs
+	* starts effort paths on every level, spread evenly over the states
+	* where the paths of the level above entered the level. A path stops
+	* when it enters the next level, leaves the Phi states or exceeds the
+	* time bound. The product of the fractions of the paths that enter the
+	* next level is an unbiased estimate. The runs are independent, their
+	* mean and sample variance give the conf. int. of the probability.
+	* The runs are simulated with the streams of the parallel simulation,
+	* divided in contiguous chunks among the simulation threads.
+	* WARNING: We simulate the states ASSUMING there are no self loops!
+	* @param pModel the model of the until formula
+	* @param initial_state the state the paths start in
+	* @param effort the number of paths per level
+	* @param runs the number of independent runs
+	* @param conf_zeta the zeta value of the conf. int.
+	* @param pCiLeftBorder the return value for the left conf. int. border
+	* @param pCiRightBorder the return value for the right conf. int. border
+	* @param pVisitedStates the counter of simulated states, it is increased
+	* NOTE: If Psi can not be reached from initial_state, i.e. its level is
+	*	negative, the probability is exactly 0 and nothing is simulated.
+	*/
+	extern void estimateBySplitting( const TSplittingModel * pModel, const int initial_state,
+					const int effort, const int runs, const double conf_zeta,
+					double * pCiLeftBorder, double * pCiRightBorder,
+					unsigned int * pVisitedStates );
+
+#endif
@@ -168,6 +168,29 @@
 	TV_LOGIC checkBoundVSConfInt( const int comparator, const double prob_bound, const double ciLeftBorder,
 					const double ciRightBorder, const double indiff_width );
 
+	/**
+	* This function decides on the probability bound by a sequential test:
+	* either Wald's sequential probability ratio test or the Bayesian test
+	* with the posterior odds under the uniform prior. Both weigh the hypothesis
+	* "p >= prob_bound + indiff_width/2" against "p <= prob_bound - indiff_width/2"
+	* and decide as soon as the evidence for one of them exceeds Wald's bound.
+	* @param test one from {SIM_TEST_SPRT, SIM_TEST_BAYES}
+	* @param comparator the comparator, one of:
+	*	COMPARATOR_SF_GREATER, COMPARATOR_SF_GREATER_OR_EQUAL,
+	*	COMPARATOR_SF_LESS, COMPARATOR_SF_LESS_OR_EQUAL
+	* @param prob_bound the probability bound
+	* @param sample_size the number of observations
+	* @param sum_good the number of successful observations
+	* @param indiff_width the indifference-region width
+	* @param alpha the probability to decide for "p below" while p lies above
+	* @param beta the probability to decide for "p above" while p lies below
+	* @return returns one of: TVL_TT, TVL_FF, TVL_NN
+	*/
+        extern
+	TV_LOGIC checkBoundSequentialTest( const int test, const int comparator, const double prob_bound,
+					const int sample_size, const int sum_good, const double indiff_width,
+					const double alpha, const double beta );
+
 	/**
 	* This function checks the precondition of the conf. int. like it is done in checkBoundVSConfInt(...)
 	* Namely we check if the width of the confidence interval ( ciRightBorder - ciLeftBorder ) for the state
@@ -246,6 +269,26 @@
 					double * pCiRightBorder, const PTSampleVecUntil pSampleVecUntil,
 					const int theConfIntType );
 
+	/**
+	* This method computes the standard conf. int. borders of the mean of a
+	* sample of real-valued observations, such as the likelihood ratios of
+	* importance sampling or the estimates of independent splitting runs.
+	* NOTE: The borders that do not fit into the interval R[0,1] are truncated.
+	* NOTE: If all observations are zero, i.e. the event has not been seen yet,
+	*	the borders are 0 and the zero-success bound 1 - alpha^(1/sample_size)
+	*	with alpha the error of one side of the conf. int.; this assumes that
+	*	an observation is non-zero with a probability of at least the mean.
+	* @param conf_zeta the zeta value derived from the confidence
+	* @param pCiLeftBorder the pointer to the left conf. int. border
+	* @param pCiRightBorder the pointer to the right conf. int. border
+	* @param sample_size the number of observations, at least 2
+	* @param sum the sum of the observations
+	* @param sum_sq the sum of the squared observations
+	*/
+	extern void computeBordersWeighted( const double conf_zeta, double * pCiLeftBorder,
+					double * pCiRightBorder, const int sample_size, const double sum,
+					const double sum_sq );
+
 	/**
 	* This method computes the conf. int. borders of steady-state simulation for
 	* the given sample, i.e. we compute and set: (*pCiLeftBorder), (*pCiRightBorder).
@@ -270,6 +313,9 @@
 	* or it increases the simulation depth of every observation in the sample.
 	* NOTE: This method can increase the sample size and the simulation depth at the same time.
 	* WARNING: We simulate the states ASSUMING there are no self loops!
+	* NOTE: The successors are sampled with the sampling index only if
+	*	pStateSpace is the embedded DTMC of getSimulationModel, which is
+	*	what all callers pass, see buildSamplingIndex.
 	* @param pStateSpace the sparse matrix of the embedded DTMC with good ad bad
 	*			states made absorbing
 	* @param pSampleVecUntil the sample vector obtained on the previous iteration
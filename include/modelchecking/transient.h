@@ -48,6 +48,7 @@
 #define TRANSIENT_H
 
 #include "bitset.h"
+#include "partition.h"
 
 /* These macro definitions are helping us to invoke the right model checking method. */
 #define TIME_UNBOUNDED_FORM 1
@@ -79,11 +80,14 @@ extern double * next_rewards(const bitset * phi, double subi, double supi,
 * @param ppResultError  the pointer to the array of doubles. This array will
 *                       store the errors
 *			for the resulting probabilities. (This is the return variable)
+* @param ppP if not NULL, receives the partition the result is kept over (one
+*	value per block) when formula dependent lumping is done, NULL otherwise
 * @return result of the until formula for all states.
 */
 extern double * until_rewards(const bitset * phi, const bitset * psi,
                 double subi, double supi, double subj, double supj,
-                BOOL isIgnoreFLumping, double ** ppResultError);
+                BOOL isIgnoreFLumping, double ** ppResultError,
+                partition ** ppP);
 
 /**
 * Solve next formula.
@@ -103,9 +107,12 @@ extern double *next(const int type, const bitset*phi, double subi, double supi);
 * @param subi sub I (time).
 * @param supi sup I (time).
 * @param isIgnoreFLumping if we want the formula dependent lumping to be ignored
+* @param ppP if not NULL, receives the partition the result is kept over (one
+*	value per block) when formula dependent lumping is done, NULL otherwise
 * @return result of the until formula for all states.
 */
 extern
-double * until(const int type, const bitset *phi, const bitset *psi, double subi, double supi, BOOL isIgnoreFLumping);
+double * until(const int type, const bitset *phi, const bitset *psi, double subi, double supi, BOOL isIgnoreFLumping,
+                partition ** ppP);
 
 #endif
@@ -142,4 +142,67 @@ sparse * ab_state_space(const sparse * state_space, const bitset *n_absorbing, d
 extern void free_abs(sparse * abs_local);
 #define free_abs(abs_local) (free_mtx_wrap((abs_local)))
 
+/* The number of iterations between two checks of the steady-state detection */
+#define SSD_CHECK_PERIOD 10
+
+/**
+* The weights of the iterates still to come, for the steady-state detection
+* of the transient analyses. For the current iterate k:
+* @member mass: sum_{j>k} w_j
+* @member moment: sum_{j>k} (j-k)*w_j
+* NOTE: If the iterates come from a map that is non-expansive in the maximum
+*	norm, e.g. a stochastic matrix, and ||x_k - x_{k-1}|| <= delta then
+*	||x_j - x_k|| <= (j-k)*delta. So replacing all the iterates after k by
+*	x_k costs at most delta*moment, see is_ssd_reached(...).
+*/
+typedef struct TSSDTail
+{
+	double mass;
+	double moment;
+} TSSDTail;
+
+/**
+* Initializes the tail of the weights for the iterate k.
+* @param pTail the tail to initialize
+* @param pWeights the weights w_first, ..., w_last
+* @param first the index of the first weight
+* @param last the index of the last weight
+* @param k the current iterate
+*/
+extern void init_ssd_tail(TSSDTail * pTail, const double * pWeights,
+		int first, int last, int k);
+
+/**
+* Moves the tail of the weights from the iterate k to the iterate k+1.
+* @param pTail the tail to update
+* @param w_next the weight of the iterate k+1
+*/
+extern void step_ssd_tail(TSSDTail * pTail, double w_next);
+
+/**
+* Computes the maximum norm of the change between two iterates.
+* @param pOld the previous iterate
+* @param pNew the current iterate
+* @param pRows the rows that change, pRows[0] is their number, or NULL for
+*		all of the size rows
+* @param size the size of the iterates
+* @return max_i |pNew[i] - pOld[i]|
+*/
+extern double get_max_change(const double * pOld, const double * pNew,
+		const int * pRows, int size);
+
+/**
+* Checks whether the remaining iterates can be replaced by the current one.
+* @param pTail the tail of the weights for the current iterate
+* @param pOld the previous iterate
+* @param pNew the current iterate
+* @param pRows the rows that change, pRows[0] is their number, or NULL for
+*		all of the size rows
+* @param size the size of the iterates
+* @param budget the error that may be spent on the remaining iterates
+* @return TRUE if the remaining iterates cost at most budget
+*/
+extern BOOL is_ssd_reached(const TSSDTail * pTail, const double * pOld,
+		const double * pNew, const int * pRows, int size, double budget);
+
 #endif
@@ -47,6 +47,7 @@
 #define TRANSIENT_CTMC_H
 
 #include "bitset.h"
+#include "partition.h"
 
 /**
 * Solve the unbounded until operator for all states.
@@ -66,10 +67,14 @@ double * unbounded_until(const bitset *phi, const bitset *psi);
 * Solve the unbounded until operator for all states with lumping.
 * @param: bitset *phi: SAT(phi).
 * @param: bitset *psi: SAT(psi).
+* @param ppP if not NULL, receives the partition of the lumped model and the
+*	result is kept per block (look it up via part_lump_state_id_nt()),
+*	otherwise the result is unlumped to the original states.
 * @return: double *: result of the unbounded until operator for all states.
 */
 extern
-double * unbounded_until_lumping(const bitset *phi, const bitset *psi);
+double * unbounded_until_lumping(const bitset *phi, const bitset *psi,
+                partition ** ppP);
 
 /**
 * Solve the bounded until operator.
@@ -90,10 +95,14 @@ double * bounded_until(const bitset *phi, const bitset *psi, double supi);
 * @param: bitset *phi: SAT(phi).
 * @param: bitset *psi: SAT(psi).
 * @param: double supi: sup I
+* @param ppP if not NULL, receives the partition of the lumped model and the
+*	result is kept per block (look it up via part_lump_state_id_nt()),
+*	otherwise the result is unlumped to the original states.
 * @return: double *: result of the unbounded until operator for all states.
 */
 extern
-double * bounded_until_lumping(const bitset *phi, const bitset *psi, double supi);
+double * bounded_until_lumping(const bitset *phi, const bitset *psi, double supi,
+                partition ** ppP);
 
 /**
 * @param: bitset *phi: SAT(phi).
@@ -115,10 +124,14 @@ double * interval_until(const bitset *phi, const bitset *psi, double subi, doubl
 * @param: bitset *psi: SAT(psi).
 * @param: double subi: sub I
 * @param: double supi: sup I
+* @param ppP if not NULL, receives the partition of the lumped model and the
+*	result is kept per block (look it up via part_lump_state_id_nt()),
+*	otherwise the result is unlumped to the original states.
 * @return: double *: result of the interval until operator for all states.
 */
 extern
-double * interval_until_lumping(const bitset *phi, const bitset *psi, double subi, double supi);
+double * interval_until_lumping(const bitset *phi, const bitset *psi, double subi, double supi,
+                partition ** ppP);
 
 /**
 * Solve the unbounded next operator.
@@ -113,6 +113,7 @@
 #define TRANSIENT_CTMRM_H
 
 #include "bitset.h"
+#include "partition.h"
 
 /**
 * Solve bounded until formula with rewards.
@@ -143,10 +144,14 @@ extern double * ctmrm_bounded_until(const bitset * phi, const bitset * psi,
 * @param ppResultError  the pointer to the array of doubles. This array will
 *                       store the errors
 *			for the resulting probabilities. (This is the return variable)
+* @param ppP if not NULL, receives the partition of the lumped model and the
+*	result and the errors are kept per block (look them up via
+*	part_lump_state_id_nt()), otherwise they are unlumped.
 * @return the result of the until formula for all states.
 */
 extern double *ctmrm_bounded_until_lumping(const bitset *phi, const bitset *psi,
-                double supi, double supj, double ** ppResultError);
+                double supi, double supj, double ** ppResultError,
+                partition ** ppP);
 
 /**
 * Solve next_rewards formula.
@@ -47,6 +47,7 @@
 #define TRANSIENT_DTMC_H
 
 #include "bitset.h"
+#include "partition.h"
 
 /**
 * Solve the unbounded until operator for all states for DTMC.
@@ -65,10 +66,14 @@ double * dtmc_unbounded_until(const bitset *phi, const bitset *psi);
 * Solve the unbounded until operator for all states for DTMC with lumping.
 * @param		: bitset *phi: SAT(phi).
 * @param		: bitset *psi: SAT(psi).
+* @param ppP if not NULL, receives the partition of the lumped model and the
+*	result is kept per block (look it up via part_lump_state_id_nt()),
+*	otherwise the result is unlumped to the original states.
 * @return		: double *: result of unbounded until operator for all states.
 */
 extern
-double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi);
+double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi,
+                partition ** ppP);
 
 /**
 * Solve the bounded until operator for DTMC.
@@ -89,10 +94,14 @@ double * dtmc_bounded_until(const bitset *phi, const bitset *psi, double supi);
 * @param		: bitset *phi: SAT(phi).
 * @param		: bitset *psi: SAT(psi).
 * @param		: double supi: sup I should contain the Natural number
+* @param ppP if not NULL, receives the partition of the lumped model and the
+*	result is kept per block (look it up via part_lump_state_id_nt()),
+*	otherwise the result is unlumped to the original states.
 * @return		: double *: result of the unbounded until operator for all states.
 */
 extern
-double * dtmc_bounded_until_lumping(const bitset *phi, const bitset *psi, double supi);
+double * dtmc_bounded_until_lumping(const bitset *phi, const bitset *psi, double supi,
+                partition ** ppP);
 
 /**
 * This method modelchecks the Xphi formula for the DTMC
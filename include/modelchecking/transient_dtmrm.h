@@ -47,6 +47,7 @@
 #define TRANSIENT_DTMRM_H
 
 #include "bitset.h"
+#include "partition.h"
 
 /**
 * Solve the N-J-bounded until operator for DTMRM.
@@ -76,6 +77,9 @@ extern double * dtmrm_bounded_until(const bitset * phi, const bitset * psi,
 * @param supi upper time bound
 * @param subj lower reward bound
 * @param supj upper reward bound
+* @param ppP if not NULL, receives the partition of the lumped model and the
+*	result is kept per block (look it up via part_lump_state_id_nt()),
+*	otherwise the result is unlumped to the original states.
 * @return result of the N-J-bounded until operator for all states.
 * NOTE: see (slightly modified path_graph):
 *	1. S. Andova, H. Hermanns and J.-P. Katoen.
@@ -83,6 +87,7 @@ extern double * dtmrm_bounded_until(const bitset * phi, const bitset * psi,
 *	FORMATS 2003, LNCS, Vol. 2791, Springer, pp. 88 - 103, 2003.
 */
 extern double *dtmrm_bounded_until_lumping(const bitset *phi, const bitset *psi,
-                double subi, double supi, double subj, double supj);
+                double subi, double supi, double subj, double supj,
+                partition ** ppP);
 
 #endif
@@ -75,6 +75,10 @@
 #define DTV 15 /* discretization Tijms & Veldman */
 #define REC 16 /* recursive version of BSCC search */
 #define NON_REC 17 /* non-recursive version of BSCC search */
+#define LUMP_SPLITTER 18 /* splitter-based partition refinement for lumping */
+#define LUMP_SIGNATURE 19 /* signature-based partition refinement for lumping */
+#define UNIFORM 20 /* uniformization for time-bounded until */
+#define KRYLOV 21 /* Krylov subspace projection for time-bounded until */
 
 /* The comparator status */
 #define C_LESS 1
@@ -249,6 +253,14 @@ extern const sparse * getImpulseRewards(void);
 */
 extern void setImpulseRewards(sparse *);
 
+/**
+* Replace the impulse rewards temporarily, e.g. by the lumped ones. Unlike
+* setImpulseRewards() this does not change the method for the until formula.
+* @param sparse* _pImpulseRewards the new impulse rewards
+* @return the previous impulse rewards
+*/
+extern sparse * exchangeImpulseRewards(sparse *);
+
 /**
 * This method is used to free the impulse reward structure.
 */
@@ -422,6 +434,22 @@ role		: get method_path
 ******************************************************************************/
 extern int get_method_path(void);
 
+/*****************************************************************************
+name		: set_method_transient
+role		: set the method for the time-bounded until of CTMCs.
+@param          : int: method_transient
+remark		: should be either UNIFORM or KRYLOV
+******************************************************************************/
+extern void set_method_transient(int);
+
+/*****************************************************************************
+name		: get_method_transient
+role		: get method_transient
+@param		:
+@return         : int: method_transient
+******************************************************************************/
+extern int get_method_transient(void);
+
 /*****************************************************************************
 name		: set_method_steady
 role		: set method_steady for global access.
@@ -501,6 +529,47 @@ extern void set_method_bscc(int);
 */
 extern int get_method_bscc(void);
 
+/************************************************************************************/
+/******************************THE LUMPING SETTINGS**********************************/
+/************************************************************************************/
+
+/**
+* Set method for the partition refinement in lumping
+* @param the method to be set
+* NOTE: The method should be either LUMP_SPLITTER or LUMP_SIGNATURE
+*/
+extern void set_method_lumping(int);
+
+/**
+* Get method for the partition refinement in lumping
+* @return the method, either LUMP_SPLITTER or LUMP_SIGNATURE
+*/
+extern int get_method_lumping(void);
+
+/**
+* This method is used to switch on and off the reuse of the quotient w.r.t. the
+* labelling for formula-dependent lumping (see lump_formula() in lump.h).
+* @param _on_off TRUE for reusing the quotient, otherwise FALSE.
+*/
+extern void set_lump_reuse(BOOL _on_off);
+
+/**
+* @return TRUE if the quotient w.r.t. the labelling is reused, otherwise FALSE
+*/
+extern BOOL is_lump_reuse_on(void);
+
+/**
+* This method is used to switch on and off weak bisimulation lumping. It only
+* has an effect for CTMCs and CMRMs, see lump() in lump.h.
+* @param _on_off TRUE for weak bisimulation, FALSE for ordinary lumpability.
+*/
+extern void set_lump_weak(BOOL _on_off);
+
+/**
+* @return TRUE if lumping computes weak bisimulation, otherwise FALSE
+*/
+extern BOOL is_lump_weak_on(void);
+
 /************************************************************************************/
 /***************************THE STEADY-STATE DETECTION SETTINGS**********************/
 /************************************************************************************/
@@ -513,12 +582,12 @@ extern
 void set_ssd(BOOL _on_off);
 
 /**
-* Enables steady-state detection for uniformization (CSL)
+* Enables steady-state detection for the transient analyses
 */
 extern void set_ssd_on(void);
 
 /**
-* Disables steady-state detection for uniformization (CSL)
+* Disables steady-state detection for the transient analyses
 */
 extern void set_ssd_off(void);
 
@@ -641,9 +710,12 @@ extern void print_state( const bitset * pBitset, const int index, const char * n
 * @param size the size of the probability-error vector
 * @param pErrorValues the vector of probability errors
 * @param pName the name string
+* @param pResultPartition the partition of the formula dependent lumping if the
+*	values are kept per block, NULL otherwise
 */
 extern
-void print_error_probs( const int size, const double * pErrorValues, const char * pName );
+void print_error_probs( const int size, const double * pErrorValues, const char * pName,
+                        const partition * pResultPartition );
 
 /**
 * This method is used for printing the state probabilities
@@ -654,11 +726,14 @@ void print_error_probs( const int size, const double * pErrorValues, const char
 * @param name the bitset name string
 * @param error_bound the error bound for all probabilities
 * @param pErrorBounds the error bounds for all probabilities
+* @param pResultPartition the partition of the formula dependent lumping if the
+*	values are kept per block, NULL otherwise
 * NOTE: Either we have pErrorBounds != NULL, or the error bound is defined by error_bound
 */
 extern void print_state_probs(int size, const double * probs, const char * name,
                         const double error_bound,
-			const double * pErrorBounds );
+			const double * pErrorBounds,
+                        const partition * pResultPartition );
 
 /**
 * This function prints the probability for the state with the given index.
@@ -669,11 +744,14 @@ extern void print_state_probs(int size, const double * probs, const char * name,
 * @param name the bitset name string
 * @param error_bound the error bound for the given state probability
 * @param pErrorBounds the error bounds for all probabilities
+* @param pResultPartition the partition of the formula dependent lumping if the
+*	values are kept per block, NULL otherwise
 * NOTE: Either we have pErrorBounds != NULL, or the error bound is defined by error_bound
 */
 extern
 inline void print_state_prob( const int index, const int size, const double * probs, const char * name,
-				const double error_bound, const double * pErrorBounds );
+				const double error_bound, const double * pErrorBounds,
+				const partition * pResultPartition );
 
 /**
 * This function prints the states, that have confidence intervals not tighter
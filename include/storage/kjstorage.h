@@ -55,6 +55,8 @@ purpose		: store a node containing k-vector, accumulated impulse rewards and the
 @member acir	: the accumulated impulse reward
 @member prob	: probability of paths represented by the k-vector and acir.
 @member next	: next node in the list.
+@member hash_next	: next node in the same bucket of the hash table.
+@member hash	: the hash value of the k-vector and acir.
 remark		:
 *******************************************************************************/
 typedef struct kjnode
@@ -63,8 +65,26 @@ typedef struct kjnode
 	double acir;
 	double prob;
 	struct kjnode *next;
+	struct kjnode *hash_next;
+	unsigned long hash;
 }kjnode;
 
+/*******************************************************************************
+				STRUCTURE
+name		: kjblock
+purpose		: a block of the arena the KJ-nodes of a kjstruc and their k-vectors are allocated from.
+@member next	: the next block of the arena.
+@member used	: the number of nodes of this block in use.
+@member nodes	: the KJ_BLOCK_SIZE nodes of this block.
+@member ks	: the KJ_BLOCK_SIZE k-vectors of this block, ndsr elements each.
+*******************************************************************************/
+typedef struct kjblock
+{
+	struct kjblock *next;
+	int used;
+	kjnode *nodes;
+	int *ks;
+}kjblock;
 
 /*******************************************************************************
                                 STRUCTURE
@@ -72,11 +92,24 @@ name            : kjstruc
 purpose         : stores number of distict state-based reward rates+a list of kjnodes.
 @member	ndsr	: number of distinct state-based reward rates
 @member kjnodes	: a list of kjnodes
+@member last	: the last node of the kjnodes list
+@member buckets	: the hash table of the nodes, keyed by the k-vector and acir
+@member num_buckets	: the size of the hash table, a power of two
+@member num_nodes	: the number of nodes in the list
+@member blocks	: the arena blocks
+@member current	: the arena block the nodes are allocated from
+remark		: The nodes are only freed all together, by free_kjstorage or reset_kjstorage.
 *******************************************************************************/
 typedef struct kjstruc
 {
         int ndsr;
 	kjnode *kjnodes;
+	kjnode *last;
+	kjnode **buckets;
+	int num_buckets;
+	int num_nodes;
+	kjblock *blocks;
+	kjblock *current;
 }kjstruc;
 
 /*****************************************************************************
@@ -97,6 +130,18 @@ remark          :
 ******************************************************************************/
 extern kjstruc *get_new_kjstruc(int);
 
+/*****************************************************************************
+name            : get_kj_hash
+role            : computes the hash value of a k vector and an accumulated
+		  impulse reward.
+@param          : int ndsr: number of distinct state-based reward rates
+@param          : int *k: the k vector.
+@param          : double acir: the accumulated impulse reward.
+@return         : unsigned long: the hash value.
+remark          : equal k vectors and rewards give equal hash values.
+******************************************************************************/
+extern unsigned long get_kj_hash(int, const int *, double);
+
 /*****************************************************************************
 name            : add_new_kjnode
 role            : add a new KJ node to a KJ structure.
@@ -104,7 +149,8 @@ role            : add a new KJ node to a KJ structure.
 @param          : int *k: the new k vector.
 @param          : double acir: the accumulated impulse reward on a given path.
 @param          : double prob: the prob. of the path repr. by given k & acir.
-remark          :
+remark          : The node with the same k vector and acir is found through
+		  the hash table, the new nodes are appended to the list.
 ******************************************************************************/
 extern void add_new_kjnode(kjstruc *, int *, double, double);
 
@@ -116,6 +162,15 @@ remark          :
 ******************************************************************************/
 extern void free_kjstorage(kjstruc *);
 
+/*****************************************************************************
+name            : reset_kjstorage
+role            : removes all KJ nodes from a given KJ-structure, the
+		  memory of the nodes is kept for the new ones.
+@param          : kjstruc *: the KJ structure to be emptied.
+remark          :
+******************************************************************************/
+extern void reset_kjstorage(kjstruc *);
+
 /*****************************************************************************
 name            : print_kjstorage
 role            : prints a given KJ-structure.
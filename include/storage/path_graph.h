@@ -42,7 +42,8 @@
 *
 *	Source description: This is a simple ds for path graph gen. for
 *		DTMRMs
-*		NOT SMART AT ALL - using a hashmap might be better for
+*		The rewards of a state are found through a hash index
+*		once the state has more than a few of them, for
 *		detatils see (NOTE: slightly modified path_graph):
 *		1. S. Andova, H. Hermanns and J.-P. Katoen.
 *		Discrete-time rewards model-checked.
@@ -71,6 +72,9 @@ typedef struct
 {
 	int num;		/* A number of elements in the pge array */
 	path_graph_ele *pge;	/* (reward,prob) tuples */
+	int capacity;		/* The allocated size of the pge array */
+	int index_size;		/* The size of the index, a power of two, or 0 if there is no index */
+	int *index;		/* The hash index of the rewards, 1 + position in pge or 0 if empty */
 } path_graph;
 
 /* Create an array of length size of path graph nodes. Indexes of array correspond to the state ids */
@@ -86,7 +90,6 @@ path_graph* get_new_path_graph(int size);
 */
 extern void insert_into_pg(path_graph *, int, double, double);
 
-/* SLOW */
 extern double get_prob(const path_graph *, int, double);
 
 /* For Iterations */
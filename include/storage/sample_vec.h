@@ -57,7 +57,7 @@
 	/**
 	* This is the common base of all sample vectors presented here
 	* initial_state - the initial observation state index
-	* curr_sample_size - the current sample size, i.e. the length of the pObservationsVec array
+	* curr_sample_size - the current sample size, i.e. the number of observations in the sample
 	* num_visited_states - the number of states visited during simulation of this sample
 	*			we should also take into account the initial states (initial observations)
 	*/
@@ -70,13 +70,13 @@
 
 	/**
 	* This is a sample-vector structure, this one is used for the unbounded-until simulation.
+	* Only the observations that are still in transient states are stored, the
+	* others are accounted for in sum_good and do not need to be simulated any further.
 	* sampleVecBase - the common part of all sample vectors
 	* curr_simulation_depth - the current simulation depth needed or the unbounded until
 	* sum_good - the current number of good absorbing states in the sample
 	* sum_trans - the current number of transient states in the sample
-	* pObservationsVec - the vector of observations, of size sampleVecBase.curr_sample_size
-	* pTransStateInd - the bitset that contains the indexes of the transient states
-	*			in the pObservationsVec vector.
+	* pObservationsVec - the vector of the transient observations, of size sum_trans
 	*/
 	typedef struct SSampleVecUntil{
 		TSampleVec sampleVecBase;	/* WARNING: Has to be the first field! */
@@ -84,7 +84,6 @@
 		int sum_good;
 		int sum_trans;
 		int * pObservationsVec;
-		bitset * pTransStateInd;
 	} TSampleVecUntil;
 	typedef TSampleVecUntil * PTSampleVecUntil;
 
@@ -99,19 +98,38 @@
 	} TSampleVecIntUntil;
 	typedef TSampleVecIntUntil * PTSampleVecIntUntil;
 
+	/**
+	* These are the sufficient statistics of a number of regeneration cycles,
+	* they are all we need for the conf. int. of the steady-state simulation.
+	* The moments are updated by Welford's method, so that the variances do
+	* not suffer from the cancellation of the large sums of squares.
+	* cycles - the number of regeneration cycles
+	* mean_time - the mean expected time spent in the cycles
+	* mean_good - the mean expected time spent in "good" states in the cycles
+	* m2_time - the sum of the squared deviations of the time from its mean
+	* m2_good - the sum of the squared deviations of the good time from its mean
+	* co_time_good - the sum of the products of the deviations of the two times
+	*/
+	typedef struct SCycleStats{
+		int cycles;
+		double mean_time;
+		double mean_good;
+		double m2_time;
+		double m2_good;
+		double co_time_good;
+	} TCycleStats;
+
 	/**
 	* This is a sample-vector structure, this one is used for steady-state simulation.
 	* NOTE: this structure is needed for every reachable BSCC!
 	* sampleVecBase - the common part of all sample vectors
 	*			Note that, sampleVecBase.curr_sample_size stores the number of regeneration cycles
-	* pTimeObservationsVec - The vector of the expected time spent in the i'th regeneration cycle
-	* pGoodObservationsVec - The vector of the accumulated number of "good" states divided by exit rates
-	*			 in the i'th regeneration cycle.
+	* cycleStats - the statistics of the simulated regeneration cycles, the
+	*			cycles are not stored one by one
 	*/
 	typedef struct SSampleVecSteady{
 		TSampleVec sampleVecBase;	/* WARNING: Has to be the first field! */
-		double * pTimeObservationsVec;
-		double * pGoodObservationsVec;
+		TCycleStats cycleStats;
 	} TSampleVecSteady;
 	typedef TSampleVecSteady * PTSampleVecSteady;
 
@@ -126,8 +144,7 @@
 	* We set "curr_simulation_depth" to zero.
 	* We set "sum_good" to zero.
 	* We set "sum_trans" to "sample_size".
-	* We allocate "pTransStateInd" and "pObservationsVec" of size "sample_size".
-	* We set "pTransStateInd" to all ones.
+	* We allocate "pObservationsVec" of size "sample_size".
 	* We fill "pObservationsVec" with "initial_state".
 	* @param sample_size the initial sample size
 	* @param initial_state the initial observation.
@@ -154,9 +171,7 @@
 	* steady-state simulations CTMC:
 	* We set "initial_state" to "initial_state".
 	* We set "curr_reg_cycles" to reg_cycles.
-	* We set "pRegenerationPoints" to all zeros.
-	* We set "pTimeObservationsVec" to all zeros.
-	* We set "pGoodObservationsVec" to all zeros.
+	* We set "cycleStats" to all zeros.
 	* @param reg_cycles the initial number of regeneration cycles.
 	* @param initial_state the regeneration point (the state index).
 	* @return the newly-created sample vector.
@@ -196,6 +211,21 @@
 	*/
 	extern inline void extendSampleVectorSteady( PTSampleVecSteady pSampleVecSteady, const int new_reg_cycles );
 
+	/**
+	* This method adds one regeneration cycle to the statistics.
+	* @param pCycleStats the statistics
+	* @param time the expected time spent in the cycle
+	* @param good the expected time spent in "good" states in the cycle
+	*/
+	extern inline void addCycleStats( TCycleStats * pCycleStats, const double time, const double good );
+
+	/**
+	* This method adds the regeneration cycles of one statistics to another.
+	* @param pCycleStats the statistics to add to
+	* @param pOtherStats the statistics to be added
+	*/
+	extern inline void mergeCycleStats( TCycleStats * pCycleStats, const TCycleStats * pOtherStats );
+
 	/****************************************************************************/
 	/***************FREE THE MEMORY ALLOCATED FOR THE SAMPLE VECTOR**************/
 	/****************************************************************************/
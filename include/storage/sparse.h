@@ -650,6 +650,25 @@ typedef /*@abstract@*/ struct sparse
                         /*@observer@*/ const double * vec,
                         /*@out@*/ double * res) /*@modifies *res@*/;
 
+	/*****************************************************************************
+	name		: multiply_mtx_MV_acc
+	role		: multiply a matrix with a vector and add weighted copies of
+			  the result to accumulators, in one pass over the matrix.
+	@param		: sparse * pM: operand matrix.
+	@param		: double *vec: The operand vector.
+	@param		: double *res: The resulting vector, res = pM * vec.
+	@param		: int num_acc: the number of accumulators.
+	@param		: double *weights: the weights of the accumulators.
+	@param		: double **acc: the accumulators, acc[a] += weights[a] * res.
+        @return         : err_ERROR: fail, err_OK: success
+	remark		: size should be correct.
+	******************************************************************************/
+        extern err_state multiply_mtx_MV_acc(/*@observer@*/ const sparse * pM,
+                        /*@observer@*/ const double * vec,
+                        /*@out@*/ double * res, int num_acc,
+                        /*@observer@*/ const double * weights,
+                        double ** acc) /*@modifies *res, **acc@*/;
+
 	/*****************************************************************************
 	name		: multiply_mtx_cer_MV
 	role		: multiply certain rows of a matrix with a vector.
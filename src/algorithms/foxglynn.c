@@ -61,6 +61,75 @@ static const double pi = 3.14159265358979323846264;
 static const double lambda_25 = 25.0;
 static const double lambda_400 = 400.0;
 
+/* The number of Fox-Glynn results kept in the cache */
+#define FG_CACHE_SIZE 8
+
+/*****************************************************************************
+			STRUCTURE
+name: TFGCacheEntry
+@member lambda, tau, omega, epsilon: the parameters of fox_glynn(...)
+@member pFG: the result, NULL if the entry is empty
+@member last_use: the time of the last use, for the LRU replacement
+******************************************************************************/
+typedef struct TFGCacheEntry
+{
+	double lambda;
+	double tau;
+	double omega;
+	double epsilon;
+	FoxGlynn * pFG;
+	unsigned long last_use;
+} TFGCacheEntry;
+
+/* The cache of the Fox-Glynn results, the least recently used one is replaced. */
+/* It is not thread-safe, see fox_glynn(...) */
+static TFGCacheEntry fg_cache[FG_CACHE_SIZE];
+/* The clock of the cache */
+static unsigned long fg_cache_clock = 0;
+
+/**
+* Looks up the Fox-Glynn result for the given parameters in the cache.
+* @return the cache entry, or NULL if there is none
+*/
+static TFGCacheEntry * get_fg_cache_entry(const double lambda, const double tau,
+		const double omega, const double epsilon)
+{
+	int i;
+	for( i = 0; i < FG_CACHE_SIZE; i++ ){
+		if( NULL != fg_cache[i].pFG && fg_cache[i].lambda == lambda
+		    && fg_cache[i].epsilon == epsilon && fg_cache[i].tau == tau
+		    && fg_cache[i].omega == omega ){
+			fg_cache[i].last_use = ++fg_cache_clock;
+			return &fg_cache[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+* Stores the Fox-Glynn result in the cache, in place of an empty or the
+* least recently used entry. The cache becomes a holder of the result.
+*/
+static void add_fg_cache_entry(const double lambda, const double tau,
+		const double omega, const double epsilon, FoxGlynn * pFG)
+{
+	TFGCacheEntry * pEntry = &fg_cache[0];
+	int i;
+	for( i = 1; i < FG_CACHE_SIZE && NULL != pEntry->pFG; i++ ){
+		if( NULL == fg_cache[i].pFG || fg_cache[i].last_use < pEntry->last_use ){
+			pEntry = &fg_cache[i];
+		}
+	}
+	freeFG(pEntry->pFG);
+	pEntry->lambda = lambda;
+	pEntry->tau = tau;
+	pEntry->omega = omega;
+	pEntry->epsilon = epsilon;
+	pEntry->pFG = pFG;
+	pEntry->last_use = ++fg_cache_clock;
+	pFG->ref_count++;
+}
+
 /*****************************************************************************
 Name		: finder
 Role		: The FINDER function from the Fox-Glynn algorithm
@@ -313,24 +382,94 @@ remark		:
 ******************************************************************************/
 BOOL fox_glynn(const double lambda, const double tau, const double omega, const double epsilon, FoxGlynn **ppFG)
 {
+	TFGCacheEntry * pEntry;
+	BOOL result;
+
 	/* printf("Fox-Glynn: lambda = %3.3le, epsilon = %1.8le\n",lambda, epsilon); */
 
+	/* The same weights are often needed by several formulas or time bounds */
+	pEntry = get_fg_cache_entry(lambda, tau, omega, epsilon);
+	if( NULL != pEntry ){
+		pEntry->pFG->ref_count++;
+		*ppFG = pEntry->pFG;
+		return TRUE;
+	}
+
         *ppFG = (FoxGlynn *) calloc((size_t) 1, sizeof(FoxGlynn));
 	(*ppFG)->weights = NULL;
+	(*ppFG)->ref_count = 1;
 
-	return weighter(lambda, tau, omega, epsilon, *ppFG);
+	result = weighter(lambda, tau, omega, epsilon, *ppFG);
+	if( result ){
+		add_fg_cache_entry(lambda, tau, omega, epsilon, *ppFG);
+	}
+	return result;
 }
 
+/*****************************************************************************
+Name		: fox_glynn_multi
+Role		: get poisson probabilities for several time points at once.
+@param		: int num: the number of time points
+@param		: double *lambdas: (rate of uniformization)*(mission time)
+		  for every time point
+@param		: double tau: underflow
+@param		: double omega: overflow
+@param		: double epsilon: error bound
+@param		: FoxGlynn **: the num structures are returned here, NULL for
+		  the time points where fox_glynn(...) failed
+@return	: TRUE if it worked fine for all time points, otherwise false
+remark		: Time points with the same lambda share one structure, it is
+		  computed once, the others come from the cache of fox_glynn(...).
+		  Every returned structure has to be freed by freeFG(...).
+******************************************************************************/
+BOOL fox_glynn_multi(const int num, const double *lambdas, const double tau,
+		const double omega, const double epsilon, FoxGlynn **ppFG)
+{
+	BOOL result = TRUE;
+	int i, j;
+
+	for( i = 0; i < num; i++ ){
+		ppFG[i] = NULL;
+		/* An earlier time point may have been evicted from the cache since */
+		for( j = 0; j < i; j++ ){
+			if( lambdas[j] == lambdas[i] && NULL != ppFG[j] ){
+				ppFG[i] = ppFG[j];
+				ppFG[i]->ref_count++;
+				break;
+			}
+		}
+		if( NULL == ppFG[i] && ! fox_glynn(lambdas[i], tau, omega, epsilon, &ppFG[i]) ){
+			/* fox_glynn(...) allocates the structure even if it fails */
+			freeFG(ppFG[i]);
+			ppFG[i] = NULL;
+			result = FALSE;
+		}
+	}
+	return result;
+}
 
 /**
 * Fries the memory allocated for the FoxGlynn structure
+* NOTE: The memory is released only when the last holder frees it
 * @param fg the structure to free
 */
 void freeFG(FoxGlynn * fg)
 {
-	if( fg ){
+	if( fg && --fg->ref_count <= 0 ){
 		if( fg->weights )
 			free(fg->weights);
 		free(fg);
 	}
 }
+
+/**
+* Frees the cache of the Fox-Glynn results
+*/
+void free_fox_glynn_cache(void)
+{
+	int i;
+	for( i = 0; i < FG_CACHE_SIZE; i++ ){
+		freeFG(fg_cache[i].pFG);
+		fg_cache[i].pFG = NULL;
+	}
+}
@@ -0,0 +1,452 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Maneesh Khattri, Ivan Zapreev, Tim Kemna
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description: Compute the product of a matrix exponential
+*		and a vector by Krylov subspace projection.
+*	Uses: Definition of krylov - krylov.h
+*	Reference: "Expokit: A Software Package for Computing Matrix
+*			Exponentials", Roger B. Sidje,
+*			ACM Transactions on Mathematical Software, vol. 24,
+*			pp. 130-156 (1998).
+*/
+
+# include "krylov.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+/* The dimension of the Krylov subspace */
+#define KRYLOV_DIM 30
+/* The degree of the Pade approximation */
+#define PADE_DEGREE 6
+/* The maximum number of rejected time steps in a row */
+#define MAX_REJECTIONS 10
+/* The tolerance of the happy breakdown of the Arnoldi process */
+static const double break_tol = 1.0e-7;
+/* The safety factors of the step size control */
+static const double gamma_safe = 0.9;
+static const double delta_safe = 1.2;
+
+/**
+* Rounds the step size to two significant digits, as Expokit does.
+*/
+static double round_step(const double step)
+{
+	const double s = pow(10.0, floor(log10(step)) - 1.0);
+	return ceil(step / s) * s;
+}
+
+/**
+* Multiplies the dense n x n matrices: C = A * B
+*/
+static void dense_mult(const int n, const double * A, const double * B, double * C)
+{
+	int i, j, k;
+	for( i = 0; i < n; i++ ){
+		for( j = 0; j < n; j++ ){
+			C[i * n + j] = 0.0;
+		}
+		for( k = 0; k < n; k++ ){
+			const double a = A[i * n + k];
+			if( 0.0 != a ){
+				for( j = 0; j < n; j++ ){
+					C[i * n + j] += a * B[k * n + j];
+				}
+			}
+		}
+	}
+}
+
+/**
+* Solves the dense system D * X = N with partial pivoting, X is returned in N.
+* @return FALSE if D is singular
+*/
+static BOOL dense_solve(const int n, double * D, double * N)
+{
+	int i, j, k, p;
+	double tmp, f;
+
+	for( k = 0; k < n; k++ ){
+		p = k;
+		for( i = k + 1; i < n; i++ ){
+			if( fabs(D[i * n + k]) > fabs(D[p * n + k]) ){
+				p = i;
+			}
+		}
+		if( 0.0 == D[p * n + k] ){
+			return FALSE;
+		}
+		if( p != k ){
+			for( j = 0; j < n; j++ ){
+				tmp = D[k * n + j]; D[k * n + j] = D[p * n + j]; D[p * n + j] = tmp;
+				tmp = N[k * n + j]; N[k * n + j] = N[p * n + j]; N[p * n + j] = tmp;
+			}
+		}
+		for( i = k + 1; i < n; i++ ){
+			f = D[i * n + k] / D[k * n + k];
+			if( 0.0 != f ){
+				for( j = k; j < n; j++ ){
+					D[i * n + j] -= f * D[k * n + j];
+				}
+				for( j = 0; j < n; j++ ){
+					N[i * n + j] -= f * N[k * n + j];
+				}
+			}
+		}
+	}
+	for( k = n - 1; k >= 0; k-- ){
+		for( j = 0; j < n; j++ ){
+			tmp = N[k * n + j];
+			for( i = k + 1; i < n; i++ ){
+				tmp -= D[k * n + i] * N[i * n + j];
+			}
+			N[k * n + j] = tmp / D[k * n + k];
+		}
+	}
+	return TRUE;
+}
+
+/**
+* Computes E = exp(t * H) for the small dense n x n matrix H, by the
+* diagonal Pade approximation with scaling and squaring.
+* @return FALSE if the Pade denominator is singular
+*/
+static BOOL pade_expm(const int n, const double t, const double * H, double * E)
+{
+	const size_t nn = (size_t) n * n;
+	double * A = (double *) malloc(nn * sizeof(double));
+	double * A2 = (double *) malloc(nn * sizeof(double));
+	double * U = (double *) malloc(nn * sizeof(double));
+	double * V = (double *) malloc(nn * sizeof(double));
+	double * T = (double *) malloc(nn * sizeof(double));
+	double c[PADE_DEGREE + 1], norm = 0.0, row, scale;
+	BOOL result = TRUE;
+	int i, j, k, ns = 0;
+
+	if( NULL == A || NULL == A2 || NULL == U || NULL == V || NULL == T ){
+		printf("ERROR: Krylov: not enough memory for the Pade approximation.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* The coefficients of the Pade approximation */
+	c[0] = 1.0;
+	for( k = 1; k <= PADE_DEGREE; k++ ){
+		c[k] = c[k - 1] * ( PADE_DEGREE + 1 - k ) / ( k * ( 2.0 * PADE_DEGREE + 1 - k ) );
+	}
+
+	/* Scale t*H such that its norm is below 1/2 */
+	for( i = 0; i < n; i++ ){
+		row = 0.0;
+		for( j = 0; j < n; j++ ){
+			row += fabs(t * H[i * n + j]);
+		}
+		if( row > norm ){
+			norm = row;
+		}
+	}
+	if( norm > 0.0 ){
+		ns = (int) ( log(norm) / log(2.0) ) + 2;
+		if( ns < 0 ){
+			ns = 0;
+		}
+	}
+	scale = t / pow(2.0, (double) ns);
+	for( i = 0; i < (int) nn; i++ ){
+		A[i] = scale * H[i];
+	}
+	dense_mult(n, A, A, A2);
+
+	/* The even part V and the odd part U of the numerator, by Horner */
+	for( i = 0; i < (int) nn; i++ ){
+		V[i] = c[PADE_DEGREE] * A2[i];
+		U[i] = c[PADE_DEGREE - 1] * A2[i];
+	}
+	for( k = PADE_DEGREE - 2; k >= 2; k -= 2 ){
+		for( i = 0; i < n; i++ ){
+			V[i * n + i] += c[k];
+		}
+		dense_mult(n, V, A2, T); memcpy(V, T, nn * sizeof(double));
+	}
+	for( k = PADE_DEGREE - 3; k >= 3; k -= 2 ){
+		for( i = 0; i < n; i++ ){
+			U[i * n + i] += c[k];
+		}
+		dense_mult(n, U, A2, T); memcpy(U, T, nn * sizeof(double));
+	}
+	for( i = 0; i < n; i++ ){
+		V[i * n + i] += c[0];
+		U[i * n + i] += c[1];
+	}
+	dense_mult(n, A, U, T); memcpy(U, T, nn * sizeof(double));
+
+	/* exp(A) ~ (V - U)^{-1} (V + U) */
+	for( i = 0; i < (int) nn; i++ ){
+		E[i] = V[i] + U[i];
+		V[i] -= U[i];
+	}
+	if( dense_solve(n, V, E) ){
+		/* Undo the scaling by squaring */
+		for( k = 0; k < ns; k++ ){
+			dense_mult(n, E, E, T);
+			memcpy(E, T, nn * sizeof(double));
+		}
+	}else{
+		result = FALSE;
+	}
+
+	free(A); free(A2); free(U); free(V); free(T);
+	return result;
+}
+
+/**
+* Computes res = A * vec for the valid rows, and zero for the other rows.
+*/
+static void valid_mult(const sparse * pA, const int * valid_rows, const double * vec,
+		double * res)
+{
+	memset(res, 0, (size_t) mtx_rows(pA) * sizeof(double));
+	if( err_state_iserror(multiply_mtx_cer_MV(pA, vec, res, valid_rows[0],
+					&valid_rows[1])) ){
+		exit(err_macro_4(err_CALLBY, "valid_mult(%p[%dx%d],%p)",
+			(const void *) pA, mtx_rows(pA), mtx_cols(pA),
+			(const void *) valid_rows, EXIT_FAILURE));
+	}
+}
+
+/**
+* Computes the dot product of two vectors of length n.
+*/
+static double dot(const int n, const double * a, const double * b)
+{
+	double sum = 0.0;
+	int i;
+	for( i = 0; i < n; i++ ){
+		sum += a[i] * b[i];
+	}
+	return sum;
+}
+
+/*****************************************************************************
+Name		: krylov_expv
+Role		: compute w = exp(t*A)*v by Krylov subspace projection.
+@param		: sparse *pA: the matrix A, e.g. the generator matrix Q.
+@param		: int *valid_rows: the rows of A that are used, valid_rows[0]
+		  is their number, the other rows are taken as zero rows.
+@param		: double t: the time.
+@param		: double *v: the vector v.
+@param		: double tol: the error tolerance per unit of time, the local
+		  error of a time step t_step is at most t_step*tol, so the
+		  error of w is at most t*tol.
+@param		: double *w: the result w is returned here.
+@return	: TRUE if it worked fine, otherwise false
+remark		: This is the expv algorithm of Expokit. Every time step
+		  builds an Arnoldi basis of dimension KRYLOV_DIM and takes
+		  the exponential of the small Hessenberg matrix. The step
+		  size follows the local error estimate.
+******************************************************************************/
+BOOL krylov_expv(const sparse * pA, const int * valid_rows, const double t,
+		const double * v, const double tol, double * w)
+{
+	const int n = mtx_rows(pA);
+	const int m = ( n < KRYLOV_DIM ? n : KRYLOV_DIM );
+	const int mh = m + 2;
+	double ** V = (double **) calloc((size_t) m + 1, sizeof(double *));
+	double * H = (double *) malloc((size_t) mh * mh * sizeof(double));
+	double * F = (double *) malloc((size_t) mh * mh * sizeof(double));
+	double * Hx = (double *) malloc((size_t) mh * mh * sizeof(double));
+	double * p = (double *) malloc((size_t) n * sizeof(double));
+	double anorm = 0.0, row, beta, fact, xm = 1.0, t_now = 0.0, t_new = t, t_step;
+	double avnorm = 0.0, err_loc = 0.0, phi1, phi2, s;
+	int i, j, l, k1, mb, mx, ireject, num_steps = 0, num_mv = 0;
+	BOOL result = TRUE;
+
+	if( NULL == V || NULL == H || NULL == F || NULL == Hx || NULL == p ){
+		printf("ERROR: Krylov: not enough memory for the Krylov subspace.\n");
+		exit(EXIT_FAILURE);
+	}
+	for( j = 0; j <= m; j++ ){
+		if( NULL == ( V[j] = (double *) malloc((size_t) n * sizeof(double)) ) ){
+			printf("ERROR: Krylov: not enough memory for the Krylov subspace.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	/* The infinity norm of A */
+	for( i = 1; i <= valid_rows[0]; i++ ){
+		row = 0.0;
+		mtx_walk_row(pA, valid_rows[i], col, val)
+		{
+			row += fabs(val);
+		}
+		end_mtx_walk_row;
+		if( row > anorm ){
+			anorm = row;
+		}
+	}
+
+	memcpy(w, v, n * sizeof(double));
+	beta = sqrt(dot(n, w, w));
+	if( 0.0 == anorm || 0.0 == beta || 0.0 == t ){
+		t_now = t;
+	}else{
+		/* The initial step size estimate of Expokit */
+		xm = 1.0 / m;
+		fact = pow(( m + 1 ) / exp(1.0), (double) m + 1) * sqrt(2.0 * 3.14159265358979323846 * ( m + 1 ));
+		t_new = round_step(( 1.0 / anorm ) * pow(( fact * tol ) / ( 4.0 * beta * anorm ), xm));
+	}
+
+	while( t_now < t ){
+		num_steps++;
+		t_step = ( t - t_now < t_new ? t - t_now : t_new );
+		k1 = 2;
+		mb = m;
+		memset(H, 0, (size_t) mh * mh * sizeof(double));
+
+		/* The Arnoldi process, modified Gram-Schmidt */
+		for( i = 0; i < n; i++ ){
+			V[0][i] = w[i] / beta;
+		}
+		for( j = 0; j < m; j++ ){
+			valid_mult(pA, valid_rows, V[j], p);
+			num_mv++;
+			for( i = 0; i <= j; i++ ){
+				const double h = dot(n, V[i], p);
+				H[i * mh + j] = h;
+				for( l = 0; l < n; l++ ){
+					p[l] -= h * V[i][l];
+				}
+			}
+			s = sqrt(dot(n, p, p));
+			if( s < break_tol ){
+				/* Happy breakdown: the subspace is invariant */
+				k1 = 0;
+				mb = j + 1;
+				t_step = t - t_now;
+				break;
+			}
+			H[( j + 1 ) * mh + j] = s;
+			for( i = 0; i < n; i++ ){
+				V[j + 1][i] = p[i] / s;
+			}
+		}
+		if( 0 != k1 ){
+			H[( m + 1 ) * mh + m] = 1.0;
+			valid_mult(pA, valid_rows, V[m], p);
+			num_mv++;
+			avnorm = sqrt(dot(n, p, p));
+		}
+
+		/* Find an acceptable step size */
+		for( ireject = 0; ; ireject++ ){
+			mx = mb + k1;
+			for( i = 0; i < mx; i++ ){
+				for( j = 0; j < mx; j++ ){
+					Hx[i * mx + j] = H[i * mh + j];
+				}
+			}
+			if( ! pade_expm(mx, t_step, Hx, F) ){
+				printf("ERROR: Krylov: the Pade approximation failed.\n");
+				result = FALSE;
+				break;
+			}
+			if( 0 == k1 ){
+				err_loc = break_tol;
+				break;
+			}
+			phi1 = fabs(beta * F[m * mx]);
+			phi2 = fabs(beta * F[( m + 1 ) * mx] * avnorm);
+			if( phi1 > 10.0 * phi2 ){
+				err_loc = phi2;
+				xm = 1.0 / m;
+			}else if( phi1 > phi2 ){
+				err_loc = ( phi1 * phi2 ) / ( phi1 - phi2 );
+				xm = 1.0 / m;
+			}else{
+				err_loc = phi1;
+				xm = 1.0 / ( m - 1 > 0 ? m - 1 : 1 );
+			}
+			if( err_loc <= delta_safe * t_step * tol ){
+				break;
+			}
+			if( ireject == MAX_REJECTIONS ){
+				printf("ERROR: Krylov: the requested tolerance is too high.\n");
+				result = FALSE;
+				break;
+			}
+			t_step = round_step(gamma_safe * t_step * pow(t_step * tol / err_loc, xm));
+		}
+		if( ! result ){
+			break;
+		}
+
+		/* w = beta * V * F(:,1) */
+		mx = mb + ( k1 > 1 ? k1 - 1 : 0 );
+		memset(w, 0, n * sizeof(double));
+		for( j = 0; j < mx; j++ ){
+			const double f = beta * F[j * ( mb + k1 )];
+			for( i = 0; i < n; i++ ){
+				w[i] += f * V[j][i];
+			}
+		}
+		beta = sqrt(dot(n, w, w));
+		t_now += t_step;
+		if( 0.0 == beta ){
+			break;
+		}
+		if( 0.0 < err_loc ){
+			t_new = round_step(gamma_safe * t_step * pow(t_step * tol / err_loc, xm));
+		}else{
+			t_new = t - t_now;
+		}
+	}
+
+	printf("Krylov: steps = %d, matrix-vector products = %d\n", num_steps, num_mv);
+
+	for( j = 0; j <= m; j++ ){
+		free(V[j]);
+	}
+	free(V); free(H); free(F); free(Hx); free(p);
+	return result;
+}
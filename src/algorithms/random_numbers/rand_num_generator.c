@@ -51,6 +51,10 @@
 #include "rng_ciardo.h"
 #include "rng_ymer.h"
 #include "rng_gsl.h"
+#include "rng_stream.h"
+#include "rng_pcg.h"
+#include "rng_philox.h"
+#include "rng_block.h"
 
 #include "macro.h"
 
@@ -82,17 +86,152 @@ typedef double (*PTFGenExpRandNum)(void *, double lambda);
 /* A predeclaration, needed for the initRNG method */
 static double generateExpRandNumberNonGSL( void * pMethodGSLExp, double lambda);
 
+/* 2^-32, converts a 32-bit word into a number in [0,1) */
+#define WORD_TO_UNIF (1.0 / 4294967296.0)
+
+/**
+* The state of a built-in generator together with the buffered blocks of
+* its words and of the exponentially distributed numbers computed from them.
+* Unlike the other non-GSL methods, every built-in generator used for the
+* discrete or the exponential distribution has a state of its own.
+*/
+typedef struct SBuiltInRNG{
+	/* One from {RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD} */
+	int method;
+	/* The generators for the two distributions use different streams, */
+	/* such that they do not produce the same numbers for the same seed */
+	int stream;
+	union{
+		TRNGStream xoshiro;
+		TPCGState pcg;
+		TPhiloxState philox;
+	} generator;
+	TRandWordSource source;
+	/* The exponentially distributed numbers with rate 1, */
+	/* the ones from exp_block[exp_next] on are unused */
+	double exp_block[RNG_BLOCK_SIZE];
+	int exp_next;
+} TBuiltInRNG;
+
+/**
+* Allocates the state of a built-in generator, the generator has to be
+* seeded by generateSeedBuiltIn before it is used.
+* @param _method one from {RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
+* @param stream the stream of the generator
+* @return the state of the generator, to be freed by free
+*/
+static void * allocBuiltInRNG(const int _method, const int stream){
+	TBuiltInRNG * pRNG = (TBuiltInRNG *) malloc( sizeof(TBuiltInRNG) );
+	PTFFillRandWords pFFillRandWords = NULL;
+	void * pState = NULL;
+
+	if( pRNG == NULL ){
+		printf("ERROR: Unable to allocate the random-number generator.\n");
+		exit(EXIT_FAILURE);
+	}
+	switch( _method ){
+		case RNG_XOSHIRO_METHOD:
+			pFFillRandWords = fillRandWordsStream;
+			pState = &pRNG->generator.xoshiro;
+			break;
+		case RNG_PCG_METHOD:
+			pFFillRandWords = fillRandWordsPCG;
+			pState = &pRNG->generator.pcg;
+			break;
+		default:
+			pFFillRandWords = fillRandWordsPhilox;
+			pState = &pRNG->generator.philox;
+	}
+	pRNG->method = _method;
+	pRNG->stream = stream;
+	initRandWordSource( &pRNG->source, pFFillRandWords, pState );
+	pRNG->exp_next = RNG_BLOCK_SIZE;
+	return pRNG;
+}
+
+/**
+* Seeds a built-in generator and empties its buffers.
+* @param pBuiltInRNG the state of the generator
+* @param seed the seed
+*/
+static void generateSeedBuiltIn(void * pBuiltInRNG, unsigned long seed){
+	TBuiltInRNG * pRNG = (TBuiltInRNG *) pBuiltInRNG;
+	int i;
+
+	switch( pRNG->method ){
+		case RNG_XOSHIRO_METHOD:
+			seedRNGStream( &pRNG->generator.xoshiro, seed );
+			for( i = 0; i < pRNG->stream; i++ ){
+				jumpRNGStream( &pRNG->generator.xoshiro );
+			}
+			break;
+		case RNG_PCG_METHOD:
+			seedRNGPCG( &pRNG->generator.pcg, seed, (unsigned long) pRNG->stream );
+			break;
+		default:
+			seedRNGPhilox( &pRNG->generator.philox, seed, (unsigned long) pRNG->stream );
+	}
+	pRNG->source.next = RNG_BLOCK_SIZE;
+	pRNG->exp_next = RNG_BLOCK_SIZE;
+}
+
+/**
+* Generates a uniformly distributed random number from the buffered words
+* of a built-in generator.
+* @param pBuiltInRNG the state of the generator
+* @return a random number in the interval [0,1)
+*/
+static double generateRandUnifBuiltIn(void * pBuiltInRNG){
+	return nextRandWord( &( (TBuiltInRNG *) pBuiltInRNG )->source ) * WORD_TO_UNIF;
+}
+
+/**
+* Generates an exponentially distributed random number from the buffered
+* block of a built-in generator. The block is refilled by the ziggurat
+* method, so no logarithm is computed per number.
+* @param pBuiltInRNG the state of the generator
+* @param lambda the lambda parameter of the exponential distribution
+*/
+static double generateExpRandNumberBuiltIn(void * pBuiltInRNG, double lambda){
+	TBuiltInRNG * pRNG = (TBuiltInRNG *) pBuiltInRNG;
+
+	if( pRNG->exp_next >= RNG_BLOCK_SIZE ){
+		fillRandExpWords( &pRNG->source, pRNG->exp_block, RNG_BLOCK_SIZE );
+		pRNG->exp_next = 0;
+	}
+	return pRNG->exp_block[pRNG->exp_next++] / lambda;
+}
+
+/**
+* Frees the state of the given RNG method.
+* @param _method the method the state was created for
+* @param pMethodGSL the GSL method structure or the state of a built-in
+*			generator, not NULL
+*/
+static void freeRNGState(const int _method, void * pMethodGSL){
+	switch( _method ){
+		case RNG_XOSHIRO_METHOD:
+		case RNG_PCG_METHOD:
+		case RNG_PHILOX_METHOD:
+			free( pMethodGSL );
+			break;
+		default:
+			freeRNGGSL( pMethodGSL );
+	}
+}
+
 /**
 * The method initializes the main variables for any given RNG method.
 * @param _method one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 * @param ppFGenRandNum the pointer to pointer to random number generation function
 * @param ppFGenExpRandNum the pointer to pointer to exp. rand number generation function
 *				Should be set only when this function is used to define the method
 *				for exp dist rand number. Otherwise should be NULL.
 * @param ppFGenSeed the pointer to pointer to seed generation function
-* @param pMethodGSL the pointer to pointer to GSL method structure
+* @param pMethodGSL the pointer to pointer to GSL method structure or to the
+*				state of a built-in generator
 */
 static void initRNG(const int _method, PTFGenRandNum * ppFGenRandNum, PTFGenSeed * ppFGenSeed,
 			PTFGenExpRandNum * ppFGenExpRandNum, void ** ppMethodGSL){
@@ -136,6 +275,17 @@ static void initRNG(const int _method, PTFGenRandNum * ppFGenRandNum, PTFGenSeed
 				*ppFGenExpRandNum = generateExpRandNumberGSL;
 			}
 			break;
+		case RNG_XOSHIRO_METHOD:
+		case RNG_PCG_METHOD:
+		case RNG_PHILOX_METHOD:
+			*ppFGenRandNum = generateRandUnifBuiltIn;
+			*ppFGenSeed = generateSeedBuiltIn;
+			/* WARNING: Has to be freed before to avoid memory leaks */
+			*ppMethodGSL = allocBuiltInRNG( _method, ppFGenExpRandNum != NULL );
+			if ( ppFGenExpRandNum != NULL ){
+				*ppFGenExpRandNum = generateExpRandNumberBuiltIn;
+			}
+			break;
 		default:
 			printf("ERROR: Invalid method for computing non-uniformly distributed random numbers!\n");
                         exit(EXIT_FAILURE);
@@ -175,7 +325,7 @@ static PTFGenSeed pFGenRandSeedDiscrete = NULL;
 * the discrete distribution.
 * @param _method one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 */
 void setRNGMethodDiscrete(const int _method){
 	/* Free the previously allocated memory etc. */
@@ -196,7 +346,7 @@ void setRNGMethodDiscrete(const int _method){
 * numbers for the discrete distribution.
 * NOTE: method should be one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 */
 int getRNGMethodDiscrete(void) {
 	return method_discrete;
@@ -206,8 +356,8 @@ int getRNGMethodDiscrete(void) {
 * This functions generates a new seed for the selected method for
 * non-uniformly distributed random numbers for discrete distribution.
 * NOTE: The stream for generating random numbers is seeded by the system clock!
-* WARNING: Unless GSL is used this regenerates the seed for the exp. distr. rand.
-* variables as well!
+* WARNING: Unless GSL or a built-in generator is used this regenerates the seed
+* for the exp. distr. rand. variables as well!
 */
 void generateNewSeedDiscrete(void) {
 	IF_SAFETY( pFGenRandSeedDiscrete != NULL )
@@ -220,12 +370,14 @@ void generateNewSeedDiscrete(void) {
 
 /**
 * Helper function for choosing non-uniformly distributed random state.
+* @param distribution the probability distribution
+* @param size the size of the distribution array
+* @param unif_rand the uniformly distributed random number that decides
 */
-static int returnDistribStateIndex(const double * distribution, int size) {
+static int returnDistribStateIndex(const double * distribution, int size,
+                const double unif_rand) {
 	/* The cumulative probabilities form already considered states */
 	double cumulative_prob = 0;
-	/* Uniform distributed random number */
-	double unif_rand = pFGenRandNumDiscrete( pMethodGSLDiscrete );
 	int i = 0;
 
 	do {
@@ -236,6 +388,21 @@ static int returnDistribStateIndex(const double * distribution, int size) {
 	return i - 1;
 }
 
+/**
+* This function chooses a value from the given array according to the
+* related probability distribution, using the given uniformly distributed
+* random number instead of drawing one.
+* @param values the range of values one would like to choose from
+* @param distribution the related probability distribution
+* @param size the size of the values and distribution arrays
+* @param unif_rand a uniformly distributed random number in [0,1)
+*/
+int chooseRandNumberDiscrete(const int * values, const double * distribution,
+                const int size, const double unif_rand)
+{
+	return values[returnDistribStateIndex(distribution, size, unif_rand)];
+}
+
 /**
 * This function chooses a random value from the given array according
 * to the related probability distribution.
@@ -248,8 +415,9 @@ int generateRandNumberDiscrete(const int * values, const double * distribution,
 {
 	IF_SAFETY( ( values != NULL ) && ( distribution != NULL )  && ( size != 0 ) )
 		IF_SAFETY( pFGenRandNumDiscrete != NULL )
-                        return values[returnDistribStateIndex(distribution,
-                                                size)];
+                        return chooseRandNumberDiscrete(values, distribution,
+                                        size, pFGenRandNumDiscrete(
+                                                pMethodGSLDiscrete));
 		ELSE_SAFETY
 			printf("ERROR: The random-number generator for the discrete distribution is not set.\n");
                         exit(EXIT_FAILURE);
@@ -260,12 +428,117 @@ int generateRandNumberDiscrete(const int * values, const double * distribution,
 	ENDIF_SAFETY
 }
 
+/**
+* This function builds the Walker/Vose alias table of the given probability
+* distribution. The distribution is truncated at a cumulative probability
+* of 1 and its last entry takes the missing mass, such that sampling from
+* the table gives the same distribution as the cumulative scan of
+* generateRandNumberDiscrete.
+* @param distribution the probability distribution
+* @param size the size of the distribution, prob, alias and work arrays
+* @param prob the return array for the acceptance probabilities
+* @param alias the return array for the alias entries
+* @param work an array used as the work list while building the table
+*/
+void buildAliasTable(const double * distribution, const int size,
+                double * prob, int * alias, int * work)
+{
+	/* The cumulative probabilities form already considered entries */
+	double cumulative_prob = 0.0, p;
+	/* The work list holds the under-full entries from the front */
+	/* and the over-full entries from the back */
+	int small = 0, large = size, i, s, l;
+
+	for( i = 0; i < size; i++ ){
+		p = distribution[i];
+		if( i == size - 1 || cumulative_prob + p > 1.0 ){
+			p = 1.0 - cumulative_prob;
+		}
+		if( p < 0.0 ){
+			p = 0.0;
+		}
+		cumulative_prob += p;
+		prob[i] = p * size;
+		alias[i] = i;
+		if( prob[i] < 1.0 ){
+			work[small++] = i;
+		}else{
+			work[--large] = i;
+		}
+	}
+
+	/* Fill every under-full entry up with an over-full one */
+	while( small > 0 && large < size ){
+		s = work[--small];
+		l = work[large];
+		alias[s] = l;
+		prob[l] -= 1.0 - prob[s];
+		if( prob[l] < 1.0 ){
+			large++;
+			work[small++] = l;
+		}
+	}
+
+	/* The remaining entries are full up to rounding errors */
+	while( small > 0 ){
+		prob[work[--small]] = 1.0;
+	}
+	while( large < size ){
+		prob[work[large++]] = 1.0;
+	}
+}
+
+/**
+* This function chooses a value from the given array according to the
+* alias table built by buildAliasTable, using the given uniformly
+* distributed random number. It takes constant time, while
+* chooseRandNumberDiscrete is linear in the size of the distribution.
+* @param values the range of values one would like to choose from
+* @param prob the acceptance probabilities of the alias table
+* @param alias the alias entries of the alias table
+* @param size the size of the values, prob and alias arrays
+* @param unif_rand a uniformly distributed random number in [0,1)
+*/
+int chooseRandNumberAlias(const int * values, const double * prob,
+                const int * alias, const int size, const double unif_rand)
+{
+	/* The integral part of the scaled random number selects the */
+	/* entry and its fractional part decides about the alias */
+	const double scaled_rand = unif_rand * size;
+	int i = (int) scaled_rand;
+
+	if( i >= size ){
+		i = size - 1;
+	}
+	return values[ scaled_rand - i < prob[i] ? i : alias[i] ];
+}
+
+/**
+* This function chooses a random value from the given array according to
+* the alias table built by buildAliasTable in constant time.
+* @param values the range of values one would like to choose from
+* @param prob the acceptance probabilities of the alias table
+* @param alias the alias entries of the alias table
+* @param size the size of the values, prob and alias arrays
+*/
+int generateRandNumberAlias(const int * values, const double * prob,
+                const int * alias, const int size)
+{
+	IF_SAFETY( pFGenRandNumDiscrete != NULL )
+		return chooseRandNumberAlias(values, prob, alias, size,
+				pFGenRandNumDiscrete( pMethodGSLDiscrete ));
+	ELSE_SAFETY
+		printf("ERROR: The random-number generator for the discrete distribution is not set.\n");
+                exit(EXIT_FAILURE);
+	ENDIF_SAFETY
+}
+
 /**
 * This function frees all memory allocated for the random number generator.
 */
 void freeRNGDiscrete(void) {
 	if( pMethodGSLDiscrete != NULL ){
-		freeRNGGSL(pMethodGSLDiscrete);
+		freeRNGState(method_discrete, pMethodGSLDiscrete);
 		pMethodGSLDiscrete = NULL;
 	}
 }
@@ -326,7 +599,7 @@ static double generateExpRandNumberNonGSL(void * pMethodGSLExp_local,
 * the exponential distribution.
 * @param _method one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 */
 void setRNGMethodExp(int _method){
 	/* Free the previously allocated memory etc. */
@@ -347,7 +620,7 @@ void setRNGMethodExp(int _method){
 * numbers for the exponential distribution.
 * NOTE: method should be one from {RNG_APP_CRYPT_METHOD, RNG_PRISM_METHOD,
 * RNG_CIARDO_METHOD, RNG_YMER_METHOD, RNG_GSL_RANLUX_METHOD, RNG_GSL_LFG_METHOD,
-* RNG_GSL_TAUS_METHOD}
+* RNG_GSL_TAUS_METHOD, RNG_XOSHIRO_METHOD, RNG_PCG_METHOD, RNG_PHILOX_METHOD}
 */
 int getRNGMethodExp(void) {
 	return method_exp;
@@ -356,8 +629,8 @@ int getRNGMethodExp(void) {
 * This functions generates a new seed for the selected method for
 * non-uniformly distributed random numbers for exponential distribution.
 * NOTE: The stream for generating random numbers is seeded by the system clock!
-* WARNING: Unless GSL is used this regenerates the seed for the discrete
-* rand. variables as well!
+* WARNING: Unless GSL or a built-in generator is used this regenerates the seed
+* for the discrete rand. variables as well!
 */
 void generateNewSeedExp(void) {
 	IF_SAFETY( pFGenRandSeedExp != NULL )
@@ -393,7 +666,7 @@ inline double generateRandNumberExp(double lambda){
 */
 void freeRNGExp(void) {
 	if( pMethodGSLExp != NULL ){
-		freeRNGGSL(pMethodGSLExp);
+		freeRNGState(method_exp, pMethodGSLExp);
 		pMethodGSLExp = NULL;
 	}
 }
@@ -427,6 +700,15 @@ static const char * getTheRNGMethodName(int rng_method_type) {
 		case RNG_GSL_TAUS_METHOD:
 			result_name = RNG_METHOD_GSL_TAUS_STR;
 			break;
+		case RNG_XOSHIRO_METHOD:
+			result_name = RNG_METHOD_XOSHIRO_STR;
+			break;
+		case RNG_PCG_METHOD:
+			result_name = RNG_METHOD_PCG_STR;
+			break;
+		case RNG_PHILOX_METHOD:
+			result_name = RNG_METHOD_PHILOX_STR;
+			break;
 		default :
 			result_name = RNG_METHOD_UNKNOWN_STR;
 	}
@@ -0,0 +1,425 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description:
+*		Blocks of random 32-bit words and the variates computed from
+*		them, see rng_block.h.
+*/
+
+#include "rng_block.h"
+
+#include "macro.h"
+
+#include <math.h>
+#include <limits.h>
+
+/* The 32-bit mask, unsigned long may be wider than 32 bits */
+#define WORD_MASK ((unsigned long) 0xffffffffUL)
+
+/* 2^-32, converts a 32-bit word into a number in [0,1) */
+#define WORD_TO_UNIF (1.0 / 4294967296.0)
+
+/* The number of layers of the ziggurat */
+#define ZIGGURAT_LAYERS 256
+
+/* The right end of the base layer of the ziggurat for 256 layers */
+#define ZIGGURAT_R 7.697117470131487
+
+/* The area of every layer of the ziggurat for 256 layers */
+#define ZIGGURAT_V 3.949659822581572e-3
+
+/* The tables of the ziggurat, see Marsaglia and Tsang: the word bounds of */
+/* the rectangles that lie completely under the density, the widths of the */
+/* layers per word unit and the density at the layer bounds. They are */
+/* constant, so the simulation threads may share them without any */
+/* initialization. With m = 2^32, d_255 = ZIGGURAT_R and */
+/* d_i = -log( ZIGGURAT_V / d_(i+1) + exp( -d_(i+1) ) ) for i = 254..1: */
+/*	zig_k[0] = d_255 exp( d_255 ) / ZIGGURAT_V * m, zig_k[1] = 0, */
+/*	zig_k[i+1] = d_i / d_(i+1) * m, */
+/*	zig_w[0] = ZIGGURAT_V exp( d_255 ) / m, zig_w[i] = d_i / m, */
+/*	zig_f[0] = 1, zig_f[i] = exp( -d_i ). */
+static const unsigned long zig_k[ZIGGURAT_LAYERS] = {
+	3801129273UL, 0UL, 2615860924UL, 3279400049UL,
+	3571300752UL, 3733536696UL, 3836274812UL, 3906990442UL,
+	3958562475UL, 3997804264UL, 4028649213UL, 4053523342UL,
+	4074002619UL, 4091154507UL, 4105727352UL, 4118261130UL,
+	4129155133UL, 4138710916UL, 4147160435UL, 4154685009UL,
+	4161428406UL, 4167506077UL, 4173011791UL, 4178022498UL,
+	4182601930UL, 4186803325UL, 4190671498UL, 4194244443UL,
+	4197554582UL, 4200629752UL, 4203493986UL, 4206168142UL,
+	4208670408UL, 4211016720UL, 4213221098UL, 4215295924UL,
+	4217252177UL, 4219099625UL, 4220846988UL, 4222502074UL,
+	4224071896UL, 4225562770UL, 4226980400UL, 4228329951UL,
+	4229616109UL, 4230843138UL, 4232014925UL, 4233135020UL,
+	4234206673UL, 4235232866UL, 4236216336UL, 4237159604UL,
+	4238064994UL, 4238934652UL, 4239770563UL, 4240574564UL,
+	4241348362UL, 4242093539UL, 4242811568UL, 4243503822UL,
+	4244171579UL, 4244816032UL, 4245438297UL, 4246039419UL,
+	4246620374UL, 4247182079UL, 4247725394UL, 4248251127UL,
+	4248760037UL, 4249252839UL, 4249730206UL, 4250192773UL,
+	4250641138UL, 4251075867UL, 4251497493UL, 4251906522UL,
+	4252303431UL, 4252688672UL, 4253062674UL, 4253425844UL,
+	4253778565UL, 4254121205UL, 4254454110UL, 4254777611UL,
+	4255092022UL, 4255397640UL, 4255694750UL, 4255983622UL,
+	4256264513UL, 4256537670UL, 4256803325UL, 4257061702UL,
+	4257313014UL, 4257557464UL, 4257795244UL, 4258026541UL,
+	4258251531UL, 4258470383UL, 4258683258UL, 4258890309UL,
+	4259091685UL, 4259287526UL, 4259477966UL, 4259663135UL,
+	4259843154UL, 4260018142UL, 4260188212UL, 4260353470UL,
+	4260514019UL, 4260669958UL, 4260821380UL, 4260968374UL,
+	4261111028UL, 4261249421UL, 4261383632UL, 4261513736UL,
+	4261639802UL, 4261761900UL, 4261880092UL, 4261994441UL,
+	4262105003UL, 4262211835UL, 4262314988UL, 4262414513UL,
+	4262510454UL, 4262602857UL, 4262691764UL, 4262777212UL,
+	4262859239UL, 4262937878UL, 4263013162UL, 4263085118UL,
+	4263153776UL, 4263219158UL, 4263281289UL, 4263340187UL,
+	4263395872UL, 4263448358UL, 4263497660UL, 4263543789UL,
+	4263586755UL, 4263626565UL, 4263663224UL, 4263696735UL,
+	4263727099UL, 4263754314UL, 4263778377UL, 4263799282UL,
+	4263817020UL, 4263831582UL, 4263842955UL, 4263851124UL,
+	4263856071UL, 4263857776UL, 4263856218UL, 4263851370UL,
+	4263843206UL, 4263831695UL, 4263816804UL, 4263798497UL,
+	4263776735UL, 4263751476UL, 4263722676UL, 4263690284UL,
+	4263654251UL, 4263614520UL, 4263571032UL, 4263523724UL,
+	4263472530UL, 4263417377UL, 4263358192UL, 4263294892UL,
+	4263227394UL, 4263155608UL, 4263079437UL, 4262998781UL,
+	4262913534UL, 4262823581UL, 4262728804UL, 4262629075UL,
+	4262524261UL, 4262414220UL, 4262298801UL, 4262177846UL,
+	4262051187UL, 4261918645UL, 4261780032UL, 4261635148UL,
+	4261483780UL, 4261325704UL, 4261160681UL, 4260988457UL,
+	4260808763UL, 4260621313UL, 4260425802UL, 4260221905UL,
+	4260009277UL, 4259787550UL, 4259556329UL, 4259315195UL,
+	4259063697UL, 4258801357UL, 4258527656UL, 4258242044UL,
+	4257943926UL, 4257632664UL, 4257307571UL, 4256967906UL,
+	4256612870UL, 4256241598UL, 4255853155UL, 4255446525UL,
+	4255020608UL, 4254574202UL, 4254106002UL, 4253614578UL,
+	4253098370UL, 4252555662UL, 4251984571UL, 4251383021UL,
+	4250748722UL, 4250079132UL, 4249371435UL, 4248622490UL,
+	4247828790UL, 4246986404UL, 4246090910UL, 4245137315UL,
+	4244119963UL, 4243032411UL, 4241867296UL, 4240616155UL,
+	4239269214UL, 4237815118UL, 4236240596UL, 4234530035UL,
+	4232664930UL, 4230623176UL, 4228378137UL, 4225897409UL,
+	4223141146UL, 4220059768UL, 4216590757UL, 4212654085UL,
+	4208145538UL, 4202926710UL, 4196809522UL, 4189531420UL,
+	4180713890UL, 4169789475UL, 4155865042UL, 4137444620UL,
+	4111806704UL, 4073393724UL, 4008685917UL, 3873074895UL
+};
+static const double zig_w[ZIGGURAT_LAYERS] = {
+	2.02495545850481980e-09, 1.48667403997342052e-11, 2.44096171962570190e-11,
+	3.19688070891424339e-11, 3.84467706466503472e-11, 4.42282039724341116e-11,
+	4.95164447070465966e-11, 5.44335886509311809e-11, 5.90594400153271921e-11,
+	6.34494203791155243e-11, 6.76438108764642668e-11, 7.16729449748353145e-11,
+	7.55603231994674261e-11, 7.93245809769357410e-11, 8.29807855790452098e-11,
+	8.65413214382508860e-11, 9.00165126521871088e-11, 9.34150719307996961e-11,
+	9.67444315553529193e-11, 1.00010992080300487e-10, 1.03220312407600555e-10,
+	1.06377257251044571e-10, 1.09486113088709356e-10, 1.12550680444915113e-10,
+	1.15574348140197469e-10, 1.18560153628617981e-10, 1.21510832475528755e-10,
+	1.24428859268585542e-10, 1.27316481704662224e-10, 1.30175749191906476e-10,
+	1.33008537006700567e-10, 1.35816566820434745e-10, 1.38601424240390641e-10,
+	1.41364573878305221e-10, 1.44107372359110216e-10, 1.46831079603519099e-10,
+	1.49536868656178298e-10, 1.52225834282036393e-10, 1.54899000514455800e-10,
+	1.57557327307183251e-10, 1.60201716416921707e-10, 1.62833016622632086e-10,
+	1.65452028370847082e-10, 1.68059507922444877e-10, 1.70656171064908347e-10,
+	1.73242696444621670e-10, 1.75819728565863289e-10, 1.78387880496548568e-10,
+	1.80947736315226038e-10, 1.83499853329148684e-10, 1.86044764089278167e-10,
+	1.88582978224711507e-10, 1.91114984116146712e-10, 1.93641250425547125e-10,
+	1.96162227497055774e-10, 1.98678348642394702e-10, 2.01190031322418334e-10,
+	2.03697678235132030e-10, 2.06201678319310194e-10, 2.08702407681822788e-10,
+	2.11200230455884796e-10, 2.13695499596661495e-10, 2.16188557619976024e-10,
+	2.18679737289263960e-10, 2.21169362255389355e-10, 2.23657747653467725e-10,
+	2.26145200660429335e-10, 2.28632021016688278e-10, 2.31118501514958686e-10,
+	2.33604928458969798e-10, 2.36091582094574045e-10, 2.38578737015513623e-10,
+	2.41066662545904282e-10, 2.43555623101313285e-10, 2.46045878530142334e-10,
+	2.48537684436879663e-10, 2.51031292488651991e-10, 2.53526950706389094e-10,
+	2.56024903741803842e-10, 2.58525393141296053e-10, 2.61028657597798953e-10,
+	2.63534933191509105e-10, 2.66044453620368345e-10, 2.68557450421101587e-10,
+	2.71074153181555947e-10, 2.73594789745032299e-10, 2.76119586407253617e-10,
+	2.78648768106568911e-10, 2.81182558607952568e-10, 2.83721180681322834e-10,
+	2.86264856274669885e-10, 2.88813806682453676e-10, 2.91368252709706073e-10,
+	2.93928414832245041e-10, 2.96494513353388660e-10, 2.99066768557534341e-10,
+	3.01645400860952039e-10, 3.04230630960122762e-10, 3.06822679977939225e-10,
+	3.09421769608071722e-10, 3.12028122257791299e-10, 3.14641961189530239e-10,
+	3.17263510661452361e-10, 3.19892996067295089e-10, 3.22530644075740231e-10,
+	3.25176682769563185e-10, 3.27831341784804679e-10, 3.30494852450206384e-10,
+	3.33167447927146816e-10, 3.35849363350312084e-10, 3.38540835969334598e-10,
+	3.41242105291631181e-10, 3.43953413226672676e-10, 3.46675004231917013e-10,
+	3.49407125460639615e-10, 3.52150026911896750e-10, 3.54903961582860349e-10,
+	3.57669185623766721e-10, 3.60445958495725140e-10, 3.63234543131638183e-10,
+	3.66035206100491118e-10, 3.68848217775274121e-10, 3.71673852504809091e-10,
+	3.74512388789760348e-10, 3.77364109463118356e-10, 3.80229301875455046e-10,
+	3.83108258085260865e-10, 3.86001275054684914e-10, 3.88908654851012787e-10,
+	3.91830704854231718e-10, 3.94767737971045522e-10, 3.97720072855720709e-10,
+	4.00688034138161526e-10, 4.03671952659630116e-10, 4.06672165716549942e-10,
+	4.09689017312851447e-10, 4.12722858421342830e-10, 4.15774047254614069e-10,
+	4.18842949546010020e-10, 4.21929938841236492e-10, 4.25035396801196044e-10,
+	4.28159713516682427e-10, 4.31303287835599854e-10, 4.34466527703411043e-10,
+	4.37649850517560692e-10, 4.40853683496664438e-10, 4.44078464065303142e-10,
+	4.47324640255311729e-10, 4.50592671124509645e-10, 4.53883027193878272e-10,
+	4.57196190904255357e-10, 4.60532657093685533e-10, 4.63892933496641508e-10,
+	4.67277541266409656e-10, 4.70687015522021685e-10, 4.74121905921206564e-10,
+	4.77582777260939153e-10, 4.81070210107270828e-10, 4.84584801456245239e-10,
+	4.88127165427831084e-10, 4.91697933994942232e-10, 4.95297757749764626e-10,
+	4.98927306709774615e-10, 5.02587271166007809e-10, 5.06278362576331946e-10,
+	5.10001314506684746e-10, 5.13756883623466173e-10, 5.17545850740521715e-10,
+	5.21369021924424536e-10, 5.25227229662058071e-10, 5.29121334094823370e-10,
+	5.33052224324147863e-10, 5.37020819793357777e-10, 5.41028071751398431e-10,
+	5.45074964804350435e-10, 5.49162518561198166e-10, 5.53291789380866759e-10,
+	5.57463872228157835e-10, 5.61679902646893833e-10, 5.65941058859327322e-10,
+	5.70248564001697110e-10, 5.74603688506727814e-10, 5.79007752644878737e-10,
+	5.83462129237269109e-10, 5.87968246554450656e-10, 5.92527591416582613e-10,
+	5.97141712512101027e-10, 6.01812223953693969e-10, 6.06540809092307051e-10,
+	6.11329224612049665e-10, 6.16179304931269193e-10, 6.21092966937755833e-10,
+	6.26072215089064018e-10, 6.31119146912343043e-10, 6.36235958941910432e-10,
+	6.41424953137140034e-10, 6.46688543828148631e-10, 6.52029265242335904e-10,
+	6.57449779671160439e-10, 6.62952886343745806e-10, 6.68541531082135814e-10,
+	6.74218816822428784e-10, 6.79988015096808250e-10, 6.85852578583883831e-10,
+	6.91816154849039259e-10, 6.97882601412976351e-10, 7.04056002305746739e-10,
+	7.10340686285742972e-10, 7.16741246928949115e-10, 7.23262564823923433e-10,
+	7.29909832143328967e-10, 7.36688579904376628e-10, 7.43604708279540725e-10,
+	7.50664520376890933e-10, 7.57874759978255797e-10, 7.65242653805547757e-10,
+	7.72775958983869609e-10, 7.80483016488170059e-10, 7.88372811502849493e-10,
+	7.96455041796697801e-10, 8.04740195426338084e-10, 8.13239639339519364e-10,
+	8.21965720767470752e-10, 8.30931883689097364e-10, 8.40152803139975747e-10,
+	8.49644540753417334e-10, 8.59424725695846637e-10, 8.69512766143263118e-10,
+	8.79930097705610579e-10, 8.90700476831372687e-10, 9.01850329339393467e-10,
+	9.13409167000908806e-10, 9.25410088774237240e-10, 9.37890388222400687e-10,
+	9.50892295317798034e-10, 9.64463889986293158e-10, 9.78660237448105049e-10,
+	9.93544813310119545e-10, 1.00919131196972378e-09, 1.02568596915192877e-09,
+	1.04313058464984629e-09, 1.06164651496973370e-09, 1.08138003512754039e-09,
+	1.10250967475626984e-09, 1.12525647064325172e-09, 1.14989864777338066e-09,
+	1.17679324233470279e-09, 1.20640901878977971e-09, 1.23937858868261276e-09,
+	1.27658495389067821e-09, 1.31931392649517226e-09, 1.36954344711161566e-09,
+	1.43054981384719528e-09, 1.50836503455246049e-09, 1.61608532755110556e-09,
+	1.79212481485015877e-09
+};
+static const double zig_f[ZIGGURAT_LAYERS] = {
+	1.00000000000000000e+00, 9.38143680862196350e-01, 9.00469929925761803e-01,
+	8.71704332381215918e-01, 8.47785500624000044e-01, 8.26993296643059428e-01,
+	8.08421651523016482e-01, 7.91527636972503057e-01, 7.75956852040122436e-01,
+	7.61463388849902612e-01, 7.47868621985201099e-01, 7.35038092431429146e-01,
+	7.22867659593577350e-01, 7.11274760805081008e-01, 7.00192655082792936e-01,
+	6.89566496117082539e-01, 6.79350572264769692e-01, 6.69506316731928841e-01,
+	6.60000841079003586e-01, 6.50805833414574764e-01, 6.41896716427269642e-01,
+	6.33251994214369507e-01, 6.24852738703669197e-01, 6.16682180915210765e-01,
+	6.08725382079625121e-01, 6.00968966365235224e-01, 5.93400901691736316e-01,
+	5.86010318477270808e-01, 5.78787358602847690e-01, 5.71723048664828370e-01,
+	5.64809192912402724e-01, 5.58038282262589891e-01, 5.51403416540643621e-01,
+	5.44898237672441832e-01, 5.38516872002864022e-01, 5.32253880263045320e-01,
+	5.26104213983621727e-01, 5.20063177368235485e-01, 5.14126393814750449e-01,
+	5.08289776410644656e-01, 5.02549501841349500e-01, 4.96901987241551268e-01,
+	4.91343869594034199e-01, 4.85871987341886524e-01, 4.80483363930455765e-01,
+	4.75175193037378873e-01, 4.69944825283961476e-01, 4.64789756250427621e-01,
+	4.59707615642139078e-01, 4.54696157474616836e-01, 4.49753251162756329e-01,
+	4.44876873414549845e-01, 4.40065100842355172e-01, 4.35316103215637851e-01,
+	4.30628137288460056e-01, 4.25999541143035565e-01, 4.21428728997617796e-01,
+	4.16914186433004041e-01, 4.12454465997162290e-01, 4.08048183152033450e-01,
+	4.03694012530531332e-01, 3.99390684475232127e-01, 3.95136981833291157e-01,
+	3.90931736984798106e-01, 3.86773829084138654e-01, 3.82662181496010778e-01,
+	3.78595759409581734e-01, 3.74573567615903047e-01, 3.70594648435146889e-01,
+	3.66658079781515045e-01, 3.62762973354818663e-01, 3.58908472948750557e-01,
+	3.55093752866788182e-01, 3.51318016437484004e-01, 3.47580494621637648e-01,
+	3.43880444704503074e-01, 3.40217149066780689e-01, 3.36589914028678272e-01,
+	3.32998068761809651e-01, 3.29440964264137048e-01, 3.25917972393556910e-01,
+	3.22428484956089834e-01, 3.18971912844957906e-01, 3.15547685227129560e-01,
+	3.12155248774180161e-01, 3.08794066934560740e-01, 3.05463619244590812e-01,
+	3.02163400675694083e-01, 2.98892921015582291e-01, 2.95651704281261696e-01,
+	2.92439288161893074e-01, 2.89255223489678193e-01, 2.86099073737077270e-01,
+	2.82970414538781190e-01, 2.79868833236973313e-01, 2.76793928448517745e-01,
+	2.73745309652803359e-01, 2.70722596799060466e-01, 2.67725419932045239e-01,
+	2.64753418835062593e-01, 2.61806242689363311e-01, 2.58883549749016562e-01,
+	2.55985007030415712e-01, 2.53110290015629791e-01, 2.50259082368862629e-01,
+	2.47431075665327932e-01, 2.44625969131892357e-01, 2.41843469398877464e-01,
+	2.39083290262449372e-01, 2.36345152457059837e-01, 2.33628783437433485e-01,
+	2.30933917169627551e-01, 2.28260293930716812e-01, 2.25607660116684150e-01,
+	2.22975768058120277e-01, 2.20364375843359578e-01, 2.17773247148700611e-01,
+	2.15202151075378767e-01, 2.12650861992978363e-01, 2.10119159388988369e-01,
+	2.07606827724222121e-01, 2.05113656293837793e-01, 2.02639439093709101e-01,
+	2.00183974691911348e-01, 1.97747066105098929e-01, 1.95328520679563272e-01,
+	1.92928149976771407e-01, 1.90545769663195447e-01, 1.88181199404254346e-01,
+	1.85834262762197139e-01, 1.83504787097767436e-01, 1.81192603475496261e-01,
+	1.78897546572478278e-01, 1.76619454590494829e-01, 1.74358169171353411e-01,
+	1.72113535315319977e-01, 1.69885401302527550e-01, 1.67673618617250081e-01,
+	1.65478041874935894e-01, 1.63298528751901678e-01, 1.61134939917591896e-01,
+	1.58987138969314074e-01, 1.56854992369365093e-01, 1.54738369384467944e-01,
+	1.52637142027442718e-01, 1.50551185001039756e-01, 1.48480375643866624e-01,
+	1.46424593878344750e-01, 1.44383722160634581e-01, 1.42357645432472008e-01,
+	1.40346251074862260e-01, 1.38349428863580010e-01, 1.36367070926428635e-01,
+	1.34399071702213407e-01, 1.32445327901387327e-01, 1.30505738468330607e-01,
+	1.28580204545228005e-01, 1.26668629437510505e-01, 1.24770918580830767e-01,
+	1.22886979509544941e-01, 1.21016721826674625e-01, 1.19160057175327488e-01,
+	1.17316899211555373e-01, 1.15487163578633339e-01, 1.13670767882744134e-01,
+	1.11867631670056131e-01, 1.10077676405185218e-01, 1.08300825451033603e-01,
+	1.06537004050001480e-01, 1.04786139306570006e-01, 1.03048160171257563e-01,
+	1.01322997425953493e-01, 9.96105836706370068e-02, 9.79108533114920743e-02,
+	9.62237425504326588e-02, 9.45491893760556923e-02, 9.28871335560433609e-02,
+	9.12375166310399610e-02, 8.96002819100326781e-02, 8.79753744672700372e-02,
+	8.63627411407567325e-02, 8.47623305323679521e-02, 8.31740930096322162e-02,
+	8.15979807092372389e-02, 8.00339475423197250e-02, 7.84819492016062270e-02,
+	7.69419431704803092e-02, 7.54138887340582015e-02, 7.38977469923645519e-02,
+	7.23934808757085296e-02, 7.09010551623715929e-02, 6.94204364987285050e-02,
+	6.79515934219363654e-02, 6.64944963853395521e-02, 6.50491177867535408e-02,
+	6.36154319998070983e-02, 6.21934154085407587e-02, 6.07830464454793898e-02,
+	5.93843056334200162e-02, 5.79971756312004025e-02, 5.66216412837426200e-02,
+	5.52576896766967876e-02, 5.39053101960458164e-02, 5.25644945930714078e-02,
+	5.12352370551259831e-02, 4.99175342827060664e-02, 4.86113855733791983e-02,
+	4.73167929131812492e-02, 4.60337610761748714e-02, 4.47622977329429905e-02,
+	4.35024135688878918e-02, 4.22541224133159352e-02, 4.10174413804145280e-02,
+	3.97923910233738201e-02, 3.85789955030745452e-02, 3.73772827729590487e-02,
+	3.61872847819311103e-02, 3.50090376973970913e-02, 3.38425821508740107e-02,
+	3.26879635089592224e-02, 3.15452321728932894e-02, 3.04144439104662850e-02,
+	2.92956602246370705e-02, 2.81889487639783061e-02, 2.70943837809554666e-02,
+	2.60120466451338843e-02, 2.49420264197314535e-02, 2.38844205115578447e-02,
+	2.28393354063849141e-02, 2.18068875042832615e-02, 2.07872040725778015e-02,
+	1.97804243380094238e-02, 1.87867007446957078e-02, 1.78062004109110390e-02,
+	1.68391068260396251e-02, 1.58856218399728473e-02, 1.49459680116908293e-02,
+	1.40203914031816184e-02, 1.31091649312546771e-02, 1.22125924262550638e-02,
+	1.13310135978342882e-02, 1.04648101810296754e-02, 9.61441364250190458e-03,
+	8.78031498580867341e-03, 7.96307743801673990e-03, 7.16335318363468549e-03,
+	6.38190593731888332e-03, 5.61964220720518898e-03, 4.87765598354210524e-03,
+	4.15729512083351255e-03, 3.46026477783663040e-03, 2.78879879357381072e-03,
+	2.14596774371865169e-03, 1.53629978030132971e-03, 9.67269282326948371e-04,
+	4.54134353841298139e-04
+};
+
+/**
+* Initializes the word source with an empty buffer.
+* @param pSource the word source
+* @param pFFillRandWords the function generating the words
+* @param pState the state of the generator
+*/
+void initRandWordSource(TRandWordSource * pSource,
+		PTFFillRandWords pFFillRandWords, void * pState){
+	pSource->pFFillRandWords = pFFillRandWords;
+	pSource->pState = pState;
+	pSource->next = RNG_BLOCK_SIZE;
+}
+
+/**
+* Refills the buffer of the word source and returns its first word.
+* @param pSource the word source
+* @return a random number in [0, 2^32 - 1]
+*/
+unsigned long refillRandWords(TRandWordSource * pSource){
+	pSource->pFFillRandWords( pSource->pState, pSource->words, RNG_BLOCK_SIZE );
+	pSource->next = 1;
+	return pSource->words[0];
+}
+
+/**
+* Fills the given array with uniformly distributed random numbers.
+* @param pSource the word source
+* @param pUnif the array to be filled with random numbers in [0,1)
+* @param size the number of random numbers to generate
+*/
+void fillRandUnifWords(TRandWordSource * pSource, double * pUnif, const int size){
+	int i;
+
+	for( i = 0; i < size; i++ ){
+		pUnif[i] = nextRandWord( pSource ) * WORD_TO_UNIF;
+	}
+}
+
+/**
+* Fills the given array with exponentially distributed random numbers with
+* rate 1 by the ziggurat method.
+* @param pSource the word source
+* @param pExp the array to be filled with the random numbers
+* @param size the number of random numbers to generate
+*/
+void fillRandExpWords(TRandWordSource * pSource, double * pExp, const int size){
+	unsigned long word;
+	double x;
+	int i, layer;
+
+	for( i = 0; i < size; i++ ){
+		for( ; ; ){
+			word = nextRandWord( pSource );
+			layer = (int) ( word & ( ZIGGURAT_LAYERS - 1 ) );
+			x = word * zig_w[layer];
+			/* The point lies in the rectangle under the density */
+			if( word < zig_k[layer] ){
+				break;
+			}
+			/* The point lies in the tail, which is exponential again */
+			if( layer == 0 ){
+				x = ZIGGURAT_R - log( 1.0 - nextRandWord( pSource ) * WORD_TO_UNIF );
+				break;
+			}
+			/* The point lies in the wedge of the layer, check the density */
+			if( zig_f[layer] + nextRandWord( pSource ) * WORD_TO_UNIF
+					* ( zig_f[layer - 1] - zig_f[layer] ) < exp( -x ) ){
+				break;
+			}
+		}
+		pExp[i] = x;
+	}
+}
+
+/**
+* Multiplies two 32-bit words.
+* @param a the first factor in [0, 2^32 - 1]
+* @param b the second factor in [0, 2^32 - 1]
+* @param pHi the return value for the upper 32 bits of the product
+* @param pLo the return value for the lower 32 bits of the product
+*/
+void mulRandWords(const unsigned long a, const unsigned long b,
+		unsigned long * pHi, unsigned long * pLo){
+#if ULONG_MAX > 0xffffffffUL
+	/* The product fits into unsigned long */
+	const unsigned long product = a * b;
+
+	*pLo = product & WORD_MASK;
+	*pHi = product >> 32;
+#else
+	const unsigned long a_lo = a & 0xffffUL, a_hi = a >> 16;
+	const unsigned long b_lo = b & 0xffffUL, b_hi = b >> 16;
+	/* The four 16x16-bit partial products fit into 32 bits */
+	const unsigned long lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+	const unsigned long lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+	/* The middle column including the carry from the lower half */
+	const unsigned long middle = ( lo_lo >> 16 ) + ( hi_lo & 0xffffUL ) + ( lo_hi & 0xffffUL );
+
+	*pLo = ( ( middle << 16 ) | ( lo_lo & 0xffffUL ) ) & WORD_MASK;
+	*pHi = ( hi_hi + ( hi_lo >> 16 ) + ( lo_hi >> 16 ) + ( middle >> 16 ) ) & WORD_MASK;
+#endif
+}
@@ -0,0 +1,136 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description:
+*		The PCG32 random number generator, see rng_pcg.h.
+*/
+
+#include "rng_pcg.h"
+#include "rng_block.h"
+
+/* The 32-bit mask, unsigned long may be wider than 32 bits */
+#define WORD_MASK ((unsigned long) 0xffffffffUL)
+
+/* The multiplier of the linear congruential generator */
+#define PCG_MULT_HI ((unsigned long) 0x5851f42dUL)
+#define PCG_MULT_LO ((unsigned long) 0x4c957f2dUL)
+
+/* The offset of the stream selectors, the selector of the PCG examples */
+#define PCG_STREAM 54
+
+/**
+* Makes one step of the linear congruential generator:
+* state = state * PCG_MULT + inc (mod 2^64).
+* @param pState the state of the generator
+*/
+static void stepRNGPCG(TPCGState * pState){
+	unsigned long hi, lo;
+
+	mulRandWords( pState->state_lo, PCG_MULT_LO, &hi, &lo );
+	hi = ( hi + pState->state_hi * PCG_MULT_LO + pState->state_lo * PCG_MULT_HI ) & WORD_MASK;
+	lo = ( lo + pState->inc_lo ) & WORD_MASK;
+	/* The carry of the lower word */
+	if( lo < pState->inc_lo ){
+		hi++;
+	}
+	pState->state_hi = ( hi + pState->inc_hi ) & WORD_MASK;
+	pState->state_lo = lo;
+}
+
+/**
+* Seeds the generator the way pcg32_srandom_r does.
+* @param pState the state of the generator
+* @param seed the seed
+* @param stream the stream selector, different selectors give different
+*		sequences for the same seed
+*/
+void seedRNGPCG(TPCGState * pState, unsigned long seed, unsigned long stream){
+	/* inc = ( ( PCG_STREAM + stream ) << 1 ) | 1 */
+	stream = ( PCG_STREAM + stream ) & WORD_MASK;
+	pState->inc_hi = stream >> 31;
+	pState->inc_lo = ( ( stream << 1 ) | 1 ) & WORD_MASK;
+	pState->state_hi = 0;
+	pState->state_lo = 0;
+	stepRNGPCG( pState );
+	/* state += seed, the seed is at most 32 bits wide here */
+	seed &= WORD_MASK;
+	pState->state_lo = ( pState->state_lo + seed ) & WORD_MASK;
+	if( pState->state_lo < seed ){
+		pState->state_hi = ( pState->state_hi + 1 ) & WORD_MASK;
+	}
+	stepRNGPCG( pState );
+}
+
+/**
+* Generates the next 32-bit random word.
+* @param pState the state of the generator
+* @return a random number in [0, 2^32 - 1]
+*/
+unsigned long generateRandWordPCG(TPCGState * pState){
+	const unsigned long hi = pState->state_hi, lo = pState->state_lo;
+	/* ( ( state >> 18 ) ^ state ) >> 27, truncated to 32 bits */
+	const unsigned long x_hi = hi ^ ( hi >> 18 );
+	const unsigned long x_lo = lo ^ ( ( ( lo >> 18 ) | ( hi << 14 ) ) & WORD_MASK );
+	const unsigned long xorshifted = ( ( x_lo >> 27 ) | ( x_hi << 5 ) ) & WORD_MASK;
+	/* state >> 59 */
+	const unsigned long rot = hi >> 27;
+
+	stepRNGPCG( pState );
+
+	return ( ( xorshifted >> rot ) | ( xorshifted << ( ( 32 - rot ) & 31 ) ) ) & WORD_MASK;
+}
+
+/**
+* Fills the given array with the next 32-bit random words.
+* @param pState the state of the generator, a TPCGState
+* @param pWords the array to be filled
+* @param size the number of words to generate
+*/
+void fillRandWordsPCG(void * pState, unsigned long * pWords, const int size){
+	TPCGState * pPCGState = (TPCGState *) pState;
+	int i;
+
+	for( i = 0; i < size; i++ ){
+		pWords[i] = generateRandWordPCG( pPCGState );
+	}
+}
@@ -0,0 +1,154 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description:
+*		The Philox4x32-10 random number generator, see rng_philox.h.
+*/
+
+#include "rng_philox.h"
+#include "rng_block.h"
+
+/* The 32-bit mask, unsigned long may be wider than 32 bits */
+#define WORD_MASK ((unsigned long) 0xffffffffUL)
+
+/* The multipliers of the rounds */
+#define PHILOX_M0 ((unsigned long) 0xd2511f53UL)
+#define PHILOX_M1 ((unsigned long) 0xcd9e8d57UL)
+
+/* The Weyl constants the key is bumped by after every round */
+#define PHILOX_W0 ((unsigned long) 0x9e3779b9UL)
+#define PHILOX_W1 ((unsigned long) 0xbb67ae85UL)
+
+/* The number of rounds */
+#define PHILOX_ROUNDS 10
+
+/**
+* Seeds the generator: the seed and the stream become the key and the
+* counter is reset.
+* @param pState the state of the generator
+* @param seed the seed
+* @param stream the stream, different streams give different sequences
+*		for the same seed
+*/
+void seedRNGPhilox(TPhiloxState * pState, unsigned long seed, unsigned long stream){
+	pState->key[0] = seed & WORD_MASK;
+	pState->key[1] = stream & WORD_MASK;
+	pState->counter[0] = pState->counter[1] = 0;
+	pState->counter[2] = pState->counter[3] = 0;
+	/* The block is empty */
+	pState->next = 4;
+}
+
+/**
+* Computes the Philox4x32-10 block of the given counter and key.
+* @param counter the counter
+* @param key the key
+* @param block the return value for the four random words
+*/
+void computeBlockPhilox(const unsigned long counter[4],
+		const unsigned long key[2], unsigned long block[4]){
+	unsigned long k0 = key[0], k1 = key[1];
+	unsigned long hi0, lo0, hi1, lo1;
+	int round;
+
+	block[0] = counter[0];
+	block[1] = counter[1];
+	block[2] = counter[2];
+	block[3] = counter[3];
+	for( round = 0; round < PHILOX_ROUNDS; round++ ){
+		mulRandWords( PHILOX_M0, block[0], &hi0, &lo0 );
+		mulRandWords( PHILOX_M1, block[2], &hi1, &lo1 );
+		block[0] = hi1 ^ block[1] ^ k0;
+		block[1] = lo1;
+		block[2] = hi0 ^ block[3] ^ k1;
+		block[3] = lo0;
+		k0 = ( k0 + PHILOX_W0 ) & WORD_MASK;
+		k1 = ( k1 + PHILOX_W1 ) & WORD_MASK;
+	}
+}
+
+/**
+* Increments the 128-bit counter of the generator.
+* @param counter the counter
+*/
+static void incrementCounterPhilox(unsigned long counter[4]){
+	int i;
+
+	for( i = 0; i < 4; i++ ){
+		counter[i] = ( counter[i] + 1 ) & WORD_MASK;
+		if( counter[i] != 0 ){
+			break;
+		}
+	}
+}
+
+/**
+* Fills the given array with the next 32-bit random words.
+* @param pState the state of the generator, a TPhiloxState
+* @param pWords the array to be filled
+* @param size the number of words to generate
+*/
+void fillRandWordsPhilox(void * pState, unsigned long * pWords, const int size){
+	TPhiloxState * pPhilox = (TPhiloxState *) pState;
+	int i = 0;
+
+	/* The rest of the current block */
+	while( i < size && pPhilox->next < 4 ){
+		pWords[i++] = pPhilox->block[pPhilox->next++];
+	}
+	/* Whole blocks go directly into the array */
+	while( size - i >= 4 ){
+		computeBlockPhilox( pPhilox->counter, pPhilox->key, &pWords[i] );
+		incrementCounterPhilox( pPhilox->counter );
+		i += 4;
+	}
+	/* A new block for the last words */
+	if( i < size ){
+		computeBlockPhilox( pPhilox->counter, pPhilox->key, pPhilox->block );
+		incrementCounterPhilox( pPhilox->counter );
+		pPhilox->next = 0;
+		while( i < size ){
+			pWords[i++] = pPhilox->block[pPhilox->next++];
+		}
+	}
+}
@@ -0,0 +1,141 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description:
+*		Independent streams of random numbers for the parallel
+*		simulation engine, based on the xoshiro128** generator.
+*/
+
+#include "rng_stream.h"
+
+/* The 32-bit mask, unsigned long may be wider than 32 bits */
+#define WORD_MASK ((unsigned long) 0xffffffffUL)
+
+/* Rotates the 32-bit word x left by k bits, 0 < k < 32 */
+#define ROTL(x,k) ((((x) << (k)) | ((x) >> (32 - (k)))) & WORD_MASK)
+
+/**
+* Seeds the stream, the four state words are obtained from the seed
+* by a 32-bit variant of the SplitMix generator.
+* @param pStream the stream to be seeded
+* @param seed the seed
+*/
+void seedRNGStream(TRNGStream * pStream, unsigned long seed){
+	unsigned long z;
+	int i;
+
+	for( i = 0; i < 4; i++ ){
+		seed = ( seed + (unsigned long) 0x9e3779b9UL ) & WORD_MASK;
+		z = seed;
+		z = ( ( z ^ ( z >> 16 ) ) * (unsigned long) 0x85ebca6bUL ) & WORD_MASK;
+		z = ( ( z ^ ( z >> 13 ) ) * (unsigned long) 0xc2b2ae35UL ) & WORD_MASK;
+		pStream->s[i] = z ^ ( z >> 16 );
+	}
+	/* The all-zero state is the only invalid one */
+	if( 0 == ( pStream->s[0] | pStream->s[1] | pStream->s[2] | pStream->s[3] ) ){
+		pStream->s[0] = 1;
+	}
+}
+
+/**
+* Generates the next 32-bit random word of the stream.
+* @param pStream the stream
+* @return a random number in [0, 2^32 - 1]
+*/
+unsigned long generateRandWordStream(TRNGStream * pStream){
+	unsigned long * s = pStream->s;
+	const unsigned long result = ( ROTL( ( s[1] * 5 ) & WORD_MASK, 7 ) * 9 ) & WORD_MASK;
+	const unsigned long t = ( s[1] << 9 ) & WORD_MASK;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = ROTL( s[3], 11 );
+
+	return result;
+}
+
+/**
+* Advances the stream by 2^64 steps. Calling it k times on a copy of one
+* seeded stream gives the k-th of a set of non-overlapping streams.
+* @param pStream the stream to be advanced
+*/
+void jumpRNGStream(TRNGStream * pStream){
+	static const unsigned long JUMP[4] = { 0x8764000bUL, 0xf542d2d3UL,
+						0x6fa035c3UL, 0x77f2db5bUL };
+	unsigned long s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	int i, b;
+
+	for( i = 0; i < 4; i++ ){
+		for( b = 0; b < 32; b++ ){
+			if( JUMP[i] & ( (unsigned long) 1 << b ) ){
+				s0 ^= pStream->s[0];
+				s1 ^= pStream->s[1];
+				s2 ^= pStream->s[2];
+				s3 ^= pStream->s[3];
+			}
+			(void) generateRandWordStream( pStream );
+		}
+	}
+	pStream->s[0] = s0;
+	pStream->s[1] = s1;
+	pStream->s[2] = s2;
+	pStream->s[3] = s3;
+}
+
+/**
+* Fills the given array with the next 32-bit random words of the stream.
+* @param pStream the stream, a TRNGStream
+* @param pWords the array to be filled
+* @param size the number of words to generate
+*/
+void fillRandWordsStream(void * pStream, unsigned long * pWords, const int size){
+	TRNGStream * pRNGStream = (TRNGStream *) pStream;
+	int i;
+
+	for( i = 0; i < size; i++ ){
+		pWords[i] = generateRandWordStream( pRNGStream );
+	}
+}
@@ -51,6 +51,7 @@
 #include "transient.h"
 #include "steady.h"
 #include "prctl.h"
+#include "expected_rewards.h"
 #include "simulation.h"
 #include "simulation_ctmc.h"
 #include "transient_common.h"
@@ -623,6 +624,28 @@ static inline void computeTrueConstraintValue( const double val_bound_left, cons
 	}
 }
 
+/**
+* The results of formulas model checked on the formula dependent lumped model
+* are kept per block. This gives the size of such a result vector.
+* @param P the partition of the lumping or NULL if the result is given for
+*	every state
+* @return the number of blocks of P or the number of states
+*/
+static inline int getResultSize( const partition * P ){
+	return ( P != NULL ? part_lumped_state_space_size_nt(P) : get_labeller()->ns );
+}
+
+/**
+* This gives the position of the value of the state i in a result vector
+* that is kept per block of P, see getResultSize(...).
+* @param P the partition of the lumping or NULL
+* @param i the state index
+* @return the block of i or i itself if P is NULL
+*/
+static inline int getResultIndex( const partition * P, const int i ){
+	return ( P != NULL ? part_lump_state_id_nt(P, i) : i );
+}
+
 /**
 * This is a local method just for sorting the probab./reward results and
 * creation of the satisfyability set.
@@ -634,6 +657,7 @@ static inline void computeTrueConstraintValue( const double val_bound_left, cons
 *	COMPARATOR_SF_GREATER_OR_EQUAL, COMPARATOR_SF_LESS,
 *	COMPARATOR_SF_LESS_OR_EQUAL
 * @param error_bound the error bound that should be takein into account
+* @param P the partition if pProbRewardResult is kept per block, or NULL
 * @return the set filled with the states 'i' that satisfy:
 *	1) COMPARATOR_SF_REWARD_INTERVAL:
 *		val_bound_left - error_bound <= pProbRewardResult[i] <= val_bound_right + error_bound
@@ -646,7 +670,7 @@ static inline void computeTrueConstraintValue( const double val_bound_left, cons
 */
 static inline bitset * sortOutStatesAccordingToProbsSingleError( const double *pProbRewardResult, const double val_bound_left,
 								const double val_bound_right, const int comparator,
-								const double error_bound ){
+								const double error_bound, const partition * P ){
 	int i = 0;
 	double theProbRewardResult;
 	const int size = get_labeller()->ns;
@@ -664,7 +688,7 @@ static inline bitset * sortOutStatesAccordingToProbsSingleError( const double *p
 
 		/* Do the state-wise probability/reward vs. constrains check */
 		for( i=0; i < size; i++ ){
-			theProbRewardResult = pProbRewardResult[i];
+			theProbRewardResult = pProbRewardResult[getResultIndex(P, i)];
 			/* If the value is exactly 0.0 or 1.0 then it was computed precisely, */
 			/* so no error bound should be taken into account */
 			if( ( theProbRewardResult == 0.0 ) || ( theProbRewardResult == 1.0 ) ){
@@ -678,8 +702,8 @@ static inline bitset * sortOutStatesAccordingToProbsSingleError( const double *p
 	} else {
 		/* In this case things are simple, we just assume the exact computations */
 		for( i=0; i < size; i++ ){
-			sortOutSingleValue( pProbRewardResult[i], i, val_bound_left, val_bound_right,
-						comparator, pYesBitsetResult);
+			sortOutSingleValue( pProbRewardResult[getResultIndex(P, i)], i, val_bound_left,
+						val_bound_right, comparator, pYesBitsetResult);
 		}
 	}
 	return pYesBitsetResult;
@@ -696,7 +720,9 @@ static inline bitset * sortOutStatesAccordingToProbsSingleError( const double *p
 *	COMPARATOR_SF_GREATER_OR_EQUAL, COMPARATOR_SF_LESS,
 *	COMPARATOR_SF_LESS_OR_EQUAL
 * @param pErrorBound the array of error bounds for the model states
-*	NOTE: we assume that the size of pErrorBound equals to get_labeller()->ns;
+*	NOTE: we assume that the size of pErrorBound equals to getResultSize(P);
+* @param P the partition if pProbRewardResult and pErrorBound are kept per
+*	block, or NULL
 * @return the set filled with the states 'i' that satisfy:
 *	1) COMPARATOR_SF_REWARD_INTERVAL:
 *		val_bound_left - error_bound <= pProbRewardResult[i] <= val_bound_right + error_bound
@@ -709,22 +735,23 @@ static inline bitset * sortOutStatesAccordingToProbsSingleError( const double *p
 */
 static inline bitset * sortOutStatesAccordingToProbsPluralError( const double *pProbRewardResult, const double val_bound_left,
 								const double val_bound_right, const int comparator,
-								const double * pErrorBound ){
-	int i = 0;
+								const double * pErrorBound, const partition * P ){
+	int i = 0, j;
 	const int size = get_labeller()->ns;
 	bitset * pYesBitsetResult = get_new_bitset( size );
 	double val_bound_left_error = 0.0, val_bound_right_error = 0.0;
 
 	IF_SAFETY( pErrorBound != NULL )
 		for( i=0; i < size; i++ ){
+			j = getResultIndex(P, i);
 			/* Recompute the probability-reward constraint, taking into account the given error */
-			computeTrueConstraintValue( val_bound_left, val_bound_right, comparator, pErrorBound[i],
+			computeTrueConstraintValue( val_bound_left, val_bound_right, comparator, pErrorBound[j],
 						&val_bound_left_error, &val_bound_right_error );
 
 			/* Note that, unline in sortOutStatesAccordingToProbsSingleError(...), here we do not */
 			/* check for pProbRewardResult[i] == 0.0 or == 1.0  because all error bounds, including */
 			/* the zero onse, are supposed to be in pErrorBound */
-			sortOutSingleValue( pProbRewardResult[i], i, val_bound_left_error, val_bound_right_error,
+			sortOutSingleValue( pProbRewardResult[j], i, val_bound_left_error, val_bound_right_error,
 						comparator, pYesBitsetResult);
 		}
 	ELSE_SAFETY
@@ -749,6 +776,8 @@ static inline bitset * sortOutStatesAccordingToProbsPluralError( const double *p
 * @param pErrorBound the array of error bounds for the model states
 *			If this array is not NULL then we use it, otherwise
 *			we use the "all states" error bound given by error_bound
+* @param P the partition if pProbRewardResult and pErrorBound are kept per
+*	block of the formula dependent lumping, or NULL
 * @return the set filled with the states 'i' that satisfy:
 *	1) COMPARATOR_SF_REWARD_INTERVAL:
 *		val_bound_left - error_bound <= pProbRewardResult[i] <= val_bound_right + error_bound
@@ -769,7 +798,8 @@ static inline bitset * sortOutStatesAccordingToProbsPluralError( const double *p
 */
 static inline bitset * sortOutStatesAccordingToProbs( const double *pProbRewardResult, const double val_bound_left,
 							const double val_bound_right, const int comparator,
-							const double error_bound, const double * pErrorBound ){
+							const double error_bound, const double * pErrorBound,
+							const partition * P ){
 	/* TODO: Since probabilistic results are computed with a certain error bound for  */
         /* the until and steady-state (long-run) operators of PRCTL, PCTL, CSL
            and CSRL, */
@@ -784,11 +814,11 @@ static inline bitset * sortOutStatesAccordingToProbs( const double *pProbRewardR
 	if( pErrorBound == NULL ){
 		/* If we do not have separate error bounds for each state then use error_bound */
 		pYesBitsetResult = sortOutStatesAccordingToProbsSingleError( pProbRewardResult, val_bound_left,
-										val_bound_right, comparator, error_bound );
+										val_bound_right, comparator, error_bound, P );
 	}else{
 		/* If we have separate error bounds for every state then use pErrorBound */
 		pYesBitsetResult = sortOutStatesAccordingToProbsPluralError( pProbRewardResult, val_bound_left,
-										val_bound_right, comparator, pErrorBound );
+										val_bound_right, comparator, pErrorBound, P );
 	}
 
 	return pYesBitsetResult;
@@ -827,7 +857,8 @@ BOOL modelCheckComparatorFormula( BOOL UNUSED(before), PTCompStateF pCompStateF
 											pCompStateF->val_bound_right,
 											pCompStateF->unary_op.unary_type,
 											pFTypeResSubForm->error_bound,
-											pFTypeResSubForm->pErrorBound );
+											pFTypeResSubForm->pErrorBound,
+											pFTypeResSubForm->pResultPartition );
 			}
 		ELSE_SAFETY
 			printf("ERROR: The comparator subformula is NULL, unexpected!");
@@ -856,7 +887,7 @@ BOOL modelCheckComparatorFormula( BOOL UNUSED(before), PTCompStateF pCompStateF
 */
 static double * numericalUnbUntilCTMCDTMC( const bitset * pPhiBitset, const bitset * pPsiBitset ){
         double * result = until(TIME_UNBOUNDED_FORM, pPhiBitset, pPsiBitset,
-                        0.0, 0.0, TRUE);
+                        0.0, 0.0, TRUE, NULL);
         if ( NULL == result ) {
                 err_msg_4(err_CALLBY,"numericalUnbUntilCTMCDTMC(%p[%d],%p[%d])",
                         (const void *) pPhiBitset, bitset_size(pPhiBitset),
@@ -1002,7 +1033,7 @@ BOOL modelCheckLongSteadyFormula( BOOL UNUSED(before), PTLongSteadyF pLongSteady
 }
 
 /*******************************************************************/
-/*********Model checking (computing probs) E, C, Y formulas*********/
+/********Model checking (computing probs) E, C, Y, R formulas*******/
 /*******************************************************************/
 
 /* TODO: It looks like it would be a good idea to split this into a Comparator */
@@ -1012,19 +1043,23 @@ BOOL modelCheckLongSteadyFormula( BOOL UNUSED(before), PTLongSteadyF pLongSteady
 /* TODO: The Y,C,Y rewards are computed with some error bound, which is not taken */
 /* into account then the reward constraints are applied! */
 /**
-* Universal method for E,C and Y formula
+* Universal method for E,C,Y and R formula
 * NOTE: It stores the probability result, if any, in runtime.c using set_result_probs(...)
 * NOTE: the pBitset is freed here
 * @param type the type which defines what formula it is:
-* @param pBitset the bitset of states phi if 'X[t_bound_1,t_bound_2] phi' is checked
-* @param epoch the epoch, for the long run expected reward rate should be set to 0 (ZERO)
+* @param pBitset the bitset of states phi if 'X[t_bound_1,t_bound_2] phi' is checked,
+*		for the R formula the states to be reached
+* @param time the epoch (DMRM) or the time (CMRM), for the long run expected
+*		reward rate should be set to 0 (ZERO)
+* @param discount the discount of the Y formula of a DMRM, 1.0 for none
 * @param p_prob_result_size the pointer to the variable that willl store the size of the
 *				returned vector;
 * @return the bitset of states that satisfy the formula
 */
-static double * getEECY(const int TYPE, const bitset * pBitset, int epoch,
-                int * p_prob_result_size)
+static double * getEECY(const int TYPE, const bitset * pBitset, double time,
+                double discount, int * p_prob_result_size)
 {
+	const int epoch = (int) time;
 	const int size = get_labeller()->ns;
 	double *pProbRewardResult = NULL;
 
@@ -1038,15 +1073,36 @@ static double * getEECY(const int TYPE, const bitset * pBitset, int epoch,
 				pProbRewardResult = cf(epoch, pBitset);
 				break;
 			case PURE_REWARD_SF_EXPECTED_AR:
-				pProbRewardResult = yf(epoch, pBitset);
+				pProbRewardResult = yf_discounted(epoch, pBitset, discount);
+				break;
+			case PURE_REWARD_SF_REACHABILITY_R:
+				pProbRewardResult = dtmrm_reachability_reward(pBitset);
 				break;
 			default:
 				printf("ERROR: Undefined EECY type. This should not be happening!\n");
                                 exit(EXIT_FAILURE);
 		}
+		if( NULL == pProbRewardResult ){
+			printf("ERROR: The expected reward could not be computed, the discount of the Y formula has to be in (0,1].\n");
+			exit(EXIT_FAILURE);
+		}
 
+	}else if( isRunMode(CMRM_MODE) && TYPE != PURE_REWARD_SF_EXPECTED_RR && 1.0 == discount )
+	{
+		/* The instantaneous reward at and the accumulated reward up to the time */
+		if( TYPE == PURE_REWARD_SF_INSTANT_R ){
+			ctmrm_expected_rewards(time, pBitset, &pProbRewardResult, NULL);
+		}else if( TYPE == PURE_REWARD_SF_EXPECTED_AR ){
+			ctmrm_expected_rewards(time, pBitset, NULL, &pProbRewardResult);
+		}else{
+			pProbRewardResult = ctmrm_reachability_reward(pBitset);
+		}
+		if( NULL == pProbRewardResult ){
+			printf("ERROR: The expected reward of the C, Y or R formula could not be computed.\n");
+			exit(EXIT_FAILURE);
+		}
 	}else{
-		printf("ERROR: The expected reward rate formula E, instantaneous reward formula C and expected accumulated reward formula Y are valid only for DMRM.\n");
+		printf("ERROR: The expected reward rate formula E and the discounted expected accumulated reward formula Y are valid only for DMRM, the instantaneous reward formula C, expected accumulated reward formula Y and reachability reward formula R are valid only for DMRM and CMRM.\n");
                 pProbRewardResult = (double *) calloc((size_t) size,
                                 sizeof(double));
 	}
@@ -1060,12 +1116,12 @@ static double * getEECY(const int TYPE, const bitset * pBitset, int epoch,
 /**
 * This function is used for model checking the formulas:
 * PURE_REWARD_SF_EXPECTED_RR, PURE_REWARD_SF_INSTANT_R,
-* PURE_REWARD_SF_EXPECTED_AR.
+* PURE_REWARD_SF_EXPECTED_AR, PURE_REWARD_SF_REACHABILITY_R.
 * @param before TRUE if the method is called before model checking
 *		the subnodes, FALSE otherwise.
 *NOTE: We expect the method is called only after the model checking
 *	of the subformulas, so we do not check for the value of "before".
-* @param pPureRewardF the pure-reward state formula: E, C, Y
+* @param pPureRewardF the pure-reward state formula: E, C, Y, R
 * @return FALSE, is needed for the doFormulaTreeTraversal method
 */
 BOOL modelCheckPureRewardFormula( BOOL UNUSED(before), PTPureRewardF pPureRewardF ){
@@ -1073,8 +1129,8 @@ BOOL modelCheckPureRewardFormula( BOOL UNUSED(before), PTPureRewardF pPureReward
 	IF_SAFETY( pPureRewardF != NULL )
 		pFTypeRes->pProbRewardResult = getEECY( pPureRewardF->unary_op.unary_type,
 						( (PTFTypeRes) pPureRewardF->unary_op.pSubForm)->pYesBitsetResult,
-                                                (int)
-						pPureRewardF->time, &(pFTypeRes->prob_result_size) );
+						pPureRewardF->time, pPureRewardF->discount,
+						&(pFTypeRes->prob_result_size) );
 		/* TODO: There has to be a proper error bound assigned in */
 		/* the future, and may be not at this point but some time earlier. */
                 /* NOTE: This error bound is kind of right, because the pure
@@ -1219,24 +1275,28 @@ BOOL modelCheckNextFormula( BOOL UNUSED(before), PTNextF pNextF ){
 * @param ppProbRewardResult the array of probabilities
 * @param prob_result_size the size of pProbRewardResult
 * @param error_bound the error bound for the results in pProbRewardResult
+* @param ppResultPartition the partition if pProbRewardResult is kept per block
 */
 static void getUnboundedUntilProbability(const bitset * pPhiBitset,
                                                 const bitset * pPsiBitset,
                                                 double ** ppProbRewardResult,
-						int * prob_result_size, double * error_bound){
+						int * prob_result_size, double * error_bound,
+						partition ** ppResultPartition){
 	double * result = NULL;
 
+	*ppResultPartition = NULL;
 	if( isRunMode(CTMC_MODE) || isRunMode(DTMC_MODE) || isRunMode(DMRM_MODE) || isRunMode(CMRM_MODE) ){
-		result = until(TIME_UNBOUNDED_FORM, pPhiBitset, pPsiBitset, 0.0, 0.0, FALSE);
+		result = until(TIME_UNBOUNDED_FORM, pPhiBitset, pPsiBitset, 0.0, 0.0, FALSE,
+				ppResultPartition);
                 if ( NULL == result ) {
-                        exit(err_macro_7(err_CALLBY,
+                        exit(err_macro_8(err_CALLBY,
                                 "getUnboundedUntilProbability(%p[%d],%p[%d],%p,"
-                                "%p,%p)", (const void *) pPhiBitset,
+                                "%p,%p,%p)", (const void *) pPhiBitset,
                                 bitset_size(pPhiBitset),(const void*)pPsiBitset,
                                 bitset_size(pPsiBitset),
                                 (void *) ppProbRewardResult,
                                 (void *) prob_result_size, (void *) error_bound,
-                                EXIT_FAILURE));
+                                (void *) ppResultPartition, EXIT_FAILURE));
                 }
 	}else{
 		printf("ERROR: Unbounded until formula U is valid only for DTMC, CTMC, DMRM and CMRM.\n");
@@ -1246,7 +1306,7 @@ static void getUnboundedUntilProbability(const bitset * pPhiBitset,
 
 	/* Assign the results */
 	*ppProbRewardResult = result;
-	*prob_result_size = get_labeller()->ns;
+	*prob_result_size = getResultSize( *ppResultPartition );
 	/* TODO: There has to be a proper error bound assigned in */
 	/* the future, and may be not at this point but some time earlier. */
 	/* NOTE: This error bound is kind of right, because unbounded until is solved numerically */
@@ -1267,16 +1327,20 @@ static void getUnboundedUntilProbability(const bitset * pPhiBitset,
 * @param ppProbRewardResult the array of probabilities
 * @param prob_result_size the size of pProbRewardResult
 * @param error_bound the error bound for the results in pProbRewardResult
+* @param ppResultPartition the partition if pProbRewardResult is kept per block
 */
 static double * getTimeIntervalUntilProbability(const bitset * pPhiBitset,
                                                         const bitset*pPsiBitset,
 							double t_bound_1, double t_bound_2, double ** ppProbRewardResult,
-							int * prob_result_size, double * error_bound){
+							int * prob_result_size, double * error_bound,
+							partition ** ppResultPartition){
 	double * result = NULL;
 
+	*ppResultPartition = NULL;
 	if( isRunMode(CTMC_MODE) || isRunMode(DTMC_MODE) || isRunMode(DMRM_MODE) || isRunMode(CMRM_MODE) ||
 	    isRunMode(CTMDPI_MODE) ){
-		result = until(TIME_INTERVAL_FORM, pPhiBitset, pPsiBitset, t_bound_1, t_bound_2, FALSE);
+		result = until(TIME_INTERVAL_FORM, pPhiBitset, pPsiBitset, t_bound_1, t_bound_2, FALSE,
+				ppResultPartition);
                 if ( NULL == result ) {
                         err_msg_9(err_CALLBY, "getTimeIntervalUntilProbability("
                                 "%p[%d],%p[%d],%g,%g,%p,%p,%p)",
@@ -1294,7 +1358,7 @@ static double * getTimeIntervalUntilProbability(const bitset * pPhiBitset,
 	}
 	/* Assign the results */
 	*ppProbRewardResult = result;
-	*prob_result_size = get_labeller()->ns;
+	*prob_result_size = getResultSize( *ppResultPartition );
 	/* TODO: There has to be a proper error bound assigned in */
 	/* the future, and may be not at this point but some time earlier. */
 	*error_bound = get_error_bound();
@@ -1319,6 +1383,8 @@ static double * getTimeIntervalUntilProbability(const bitset * pPhiBitset,
 *                       store the errors
 *			for the resulting probabilities. (This is the return variable)
 *	NOTE: At present it is only used for the Uniformization of Qureshi-Sanders
+* @param ppResultPartition the partition if pProbRewardResult and *ppResultError
+*			are kept per block
 */
 static double *getTimeAndRewardBoundedUntilProbability(const bitset *pPhiBitset,
                                                                 const bitset *
@@ -1327,11 +1393,14 @@ static double *getTimeAndRewardBoundedUntilProbability(const bitset *pPhiBitset,
 								double r_bound_1, double r_bound_2,
 								double ** ppProbRewardResult,
 								int * prob_result_size, double * error_bound,
-								double ** ppResultError ){
+								double ** ppResultError,
+								partition ** ppResultPartition ){
 	double * result = NULL;
 
+	*ppResultPartition = NULL;
 	if( isRunMode(DMRM_MODE) || isRunMode(CMRM_MODE) ){
-		result = until_rewards(pPhiBitset, pPsiBitset, t_bound_1, t_bound_2, r_bound_1, r_bound_2, FALSE, ppResultError);
+		result = until_rewards(pPhiBitset, pPsiBitset, t_bound_1, t_bound_2, r_bound_1, r_bound_2, FALSE, ppResultError,
+				ppResultPartition);
 	}else{
 		printf("ERROR: Time- and reward-bounded until formula is valid only for DMRM and CMRM.\n");
                 result = (double *) calloc((size_t) mtx_rows(get_state_space()),
@@ -1340,7 +1409,7 @@ static double *getTimeAndRewardBoundedUntilProbability(const bitset *pPhiBitset,
 
 	/* Assign the results */
 	*ppProbRewardResult = result;
-	*prob_result_size = get_labeller()->ns;
+	*prob_result_size = getResultSize( *ppResultPartition );
 	/* TODO: There has to be a proper error bound assigned in */
 	/* the future, and may be not at this point but some time earlier. */
 	/* Note: for Uniformization Qureshi-Sanders error bounds are returned in ppResultError. */
@@ -1472,7 +1541,7 @@ BOOL modelCheckUntilFormula( BOOL UNUSED(before), BOOL UNUSED(between), PTUntilF
 				} else {
 					getUnboundedUntilProbability( pYesBitsetResultSubFormL, pYesBitsetResultSubFormR,
 									& pFTypeRes->pProbRewardResult, & pFTypeRes->prob_result_size,
-									& pFTypeRes->error_bound );
+									& pFTypeRes->error_bound, & pFTypeRes->pResultPartition );
 				}
 				break;
 			case UNTIL_PF_TIME:
@@ -1488,7 +1557,7 @@ BOOL modelCheckUntilFormula( BOOL UNUSED(before), BOOL UNUSED(between), PTUntilF
 						getTimeIntervalUntilProbability( pYesBitsetResultSubFormL, pYesBitsetResultSubFormR,
 										pUntilF->left_time_bound, pUntilF->right_time_bound,
 										& pFTypeRes->pProbRewardResult, & pFTypeRes->prob_result_size,
-										& pFTypeRes->error_bound );
+										& pFTypeRes->error_bound, & pFTypeRes->pResultPartition );
 					} else {
 						printf("ERROR: Only formulae of type P{ OP R }[ tt U[0, t] SFL ] are supported in CTMDPI mode.\n");
 						/* Assign dummy results, WARNING: Using the number of states in the CTMDPI */
@@ -1507,7 +1576,8 @@ BOOL modelCheckUntilFormula( BOOL UNUSED(before), BOOL UNUSED(between), PTUntilF
 									pUntilF->left_time_bound, pUntilF->right_time_bound,
 									pUntilF->left_reward_bound, pUntilF->right_reward_bound,
 									& pFTypeRes->pProbRewardResult, & pFTypeRes->prob_result_size,
-									& pFTypeRes->error_bound, & pFTypeRes->pErrorBound );
+									& pFTypeRes->error_bound, & pFTypeRes->pErrorBound,
+									& pFTypeRes->pResultPartition );
 				break;
 			default:
 				printf("ERROR: An unknown type '%d' of the Until operator.\n", pUntilF->binary_op.binary_type);
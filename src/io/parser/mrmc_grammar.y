@@ -92,20 +92,27 @@ void yyerror(const char * s);
 			SAMPLE_SIZE_DELTA MAX_SIM_DEPTH MIN_SIM_DEPTH SIM_DEPTH_DELTA
 			SIM_METHOD_DISC SIM_METHOD_EXP RNG_APP_CRYPT RNG_PRISM
 			RNG_CIARDO RNG_YMER RNG_GSL_RANLUX RNG_GSL_LFG RNG_GSL_TAUS
+			RNG_XOSHIRO RNG_PCG RNG_PHILOX
 			INITIAL_STATE SIM_STEP_TYPE SIM_STEP_TYPE_AUTO SIM_STEP_TYPE_MANUAL
 			BSCC_DIM_MULT METHOD_CTMDPI_TRANSIENT HD_UNI HD_NON_UNI HD_AUTO
+			METHOD_LUMPING SPLITTER_M SIGNATURE_M LUMPING_REUSE
+			LUMPING_WEAK SIM_THREADS SIM_SEED SIM_TEST SIM_TEST_ALPHA
+			SIM_TEST_BETA TEST_CONF_INT TEST_SPRT TEST_BAYES
+			METHOD_TRANSIENT UNIFORMIZATION_M KRYLOV_M
+			SIM_SPLIT_EFFORT SIM_SPLIT_RUNS SIM_IS SIM_IS_BIAS SIM_IS_FAILURE_RATE
+			IS_BFB IS_ZVA
 
-%nonassoc PROBABILITY_F NEXT_F UNTIL_F SPC NEWLINE TTRUE FFALSE IMPLIES EXPECTED_REWARD_RATE_F INSTANTANEOUS_REWARD_F EXPECTED_ACCUMULATED_REWARD_F LONG_RUN_F HELP PROB_THRESHOLD_QURESHI_SANDERS DISCRETIZATION_FACTOR
+%nonassoc PROBABILITY_F NEXT_F UNTIL_F SPC NEWLINE TTRUE FFALSE IMPLIES EXPECTED_REWARD_RATE_F INSTANTANEOUS_REWARD_F EXPECTED_ACCUMULATED_REWARD_F REACHABILITY_REWARD_F LONG_RUN_F HELP PROB_THRESHOLD_QURESHI_SANDERS DISCRETIZATION_FACTOR
 
 %left AND OR
 %right NOT
 
 %type <bval> on_off
 %type <ival> mformula comparator rng_method
-%type <formula_tree_node> stateformula termformula factorformula steadyformula longrunformula pathformula eformula cformula yformula untilformula nextformula
+%type <formula_tree_node> stateformula termformula factorformula steadyformula longrunformula pathformula eformula cformula yformula rformula untilformula nextformula
 /*The comparator is for {||, &&, >, <, =>, <=}*/
 
-%destructor { freeFormulaTree($$); } stateformula termformula factorformula steadyformula longrunformula pathformula eformula cformula yformula untilformula nextformula
+%destructor { freeFormulaTree($$); } stateformula termformula factorformula steadyformula longrunformula pathformula eformula cformula yformula rformula untilformula nextformula
 
 /**********************THE BEGINNING OF MAIN INTERFACE COMMANDS*********************/
 
@@ -172,6 +179,16 @@ mformula		: NEWLINE
 				set_method_path(GS);
 				return 1;
 			}
+			| SET METHOD_TRANSIENT UNIFORMIZATION_M NEWLINE
+			{
+				set_method_transient(UNIFORM);
+				return 1;
+			}
+			| SET METHOD_TRANSIENT KRYLOV_M NEWLINE
+			{
+				set_method_transient(KRYLOV);
+				return 1;
+			}
 			| SET METHOD_STEADY GAUSS_JACOBI_M NEWLINE
 			{
 				set_method_steady(GJ);
@@ -192,6 +209,26 @@ mformula		: NEWLINE
 				set_method_bscc(NON_REC);
 				return 1;
 			}
+			| SET METHOD_LUMPING SPLITTER_M NEWLINE
+			{
+				set_method_lumping(LUMP_SPLITTER);
+				return 1;
+			}
+			| SET METHOD_LUMPING SIGNATURE_M NEWLINE
+			{
+				set_method_lumping(LUMP_SIGNATURE);
+				return 1;
+			}
+			| SET LUMPING_REUSE on_off NEWLINE
+			{
+				set_lump_reuse($3);
+				return 1;
+			}
+			| SET LUMPING_WEAK on_off NEWLINE
+			{
+				set_lump_weak($3);
+				return 1;
+			}
 /********************************************************************************/
 /******************SET THE PRINTING RELATED PARAMETERS***************************/
 /********************************************************************************/
@@ -341,6 +378,76 @@ mformula		: NEWLINE
 				setSampleBSCCDimensionMultiplier( (int) $3 );
 				return 1;
 			}
+			| SET SIM_THREADS DOUBLE_VALUE NEWLINE
+			{
+				setSimThreads( (int) $3 );
+				return 1;
+			}
+			| SET SIM_SEED DOUBLE_VALUE NEWLINE
+			{
+				setSimSeed( (unsigned long) $3 );
+				return 1;
+			}
+			| SET SIM_TEST TEST_CONF_INT NEWLINE
+			{
+				setSimTestMethod( SIM_TEST_CONF_INT );
+				return 1;
+			}
+			| SET SIM_TEST TEST_SPRT NEWLINE
+			{
+				setSimTestMethod( SIM_TEST_SPRT );
+				return 1;
+			}
+			| SET SIM_TEST TEST_BAYES NEWLINE
+			{
+				setSimTestMethod( SIM_TEST_BAYES );
+				return 1;
+			}
+			| SET SIM_TEST_ALPHA DOUBLE_VALUE NEWLINE
+			{
+				setSimTestAlpha( $3 );
+				return 1;
+			}
+			| SET SIM_TEST_BETA DOUBLE_VALUE NEWLINE
+			{
+				setSimTestBeta( $3 );
+				return 1;
+			}
+			| SET SIM_SPLIT_EFFORT DOUBLE_VALUE NEWLINE
+			{
+				setSimSplitEffort( (int) $3 );
+				return 1;
+			}
+			| SET SIM_SPLIT_RUNS DOUBLE_VALUE NEWLINE
+			{
+				setSimSplitRuns( (int) $3 );
+				return 1;
+			}
+			| SET SIM_IS OFF NEWLINE
+			{
+				setSimISMethod( SIM_IS_NONE );
+				return 1;
+			}
+			| SET SIM_IS IS_BFB NEWLINE
+			{
+				setSimISMethod( SIM_IS_BFB );
+				return 1;
+			}
+			| SET SIM_IS IS_ZVA NEWLINE
+			{
+				setSimISMethod( SIM_IS_ZVA );
+				return 1;
+			}
+			| SET SIM_IS_BIAS DOUBLE_VALUE NEWLINE
+			{
+				setSimISBias( $3 );
+				return 1;
+			}
+			| SET SIM_IS_FAILURE_RATE DOUBLE_VALUE NEWLINE
+			{
+				setSimISFailureRate( $3 );
+				return 1;
+			}
 /********************************************************************************/
 /*****************SET THE ITERATION METHOD RELATED PARAMETERS********************/
 /********************************************************************************/
@@ -480,6 +587,10 @@ factorformula		: LEFT_PARENTHESIS stateformula RIGHT_PARENTHESIS
 			{
 				$$ = $1;
 			}
+			| rformula
+			{
+				$$ = $1;
+			}
 /**********************List of DOUBLE_VALUEs used in WRITE_RES_FILE***********************/
 double_val_list:
 	DOUBLE_VALUE double_val_list { write_res_file_add($1); }	
@@ -535,7 +646,7 @@ eformula		: EXPECTED_REWARD_RATE_F
 			  LEFT_SQUARE_BRACKET stateformula RIGHT_SQUARE_BRACKET
 			{
                                 void * pPureRewardF =
-                                        allocatePureRewardFormula(0.0, $8,
+                                        allocatePureRewardFormula(0.0, 1.0, $8,
                                                 PURE_REWARD_SF_EXPECTED_RR);
 				$$ = allocateComparatorFormula( $3, $5, pPureRewardF, COMPARATOR_SF_REWARD_INTERVAL );
 			}
@@ -544,7 +655,7 @@ eformula		: EXPECTED_REWARD_RATE_F
 			  LEFT_SQUARE_BRACKET DOUBLE_VALUE COMMA DOUBLE_VALUE RIGHT_SQUARE_BRACKET
 			  LEFT_SQUARE_BRACKET stateformula RIGHT_SQUARE_BRACKET
 			{
-				void * pPureRewardF = allocatePureRewardFormula( $3 , $11, PURE_REWARD_SF_EXPECTED_RR );
+				void * pPureRewardF = allocatePureRewardFormula( $3 , 1.0, $11, PURE_REWARD_SF_EXPECTED_RR );
 				$$ = allocateComparatorFormula( $6, $8, pPureRewardF, COMPARATOR_SF_REWARD_INTERVAL );
 			}
 			;
@@ -553,7 +664,7 @@ cformula		: INSTANTANEOUS_REWARD_F
 			  LEFT_SQUARE_BRACKET DOUBLE_VALUE COMMA DOUBLE_VALUE RIGHT_SQUARE_BRACKET
 			  LEFT_SQUARE_BRACKET stateformula RIGHT_SQUARE_BRACKET
 			{
-				void * pPureRewardF = allocatePureRewardFormula( $3 , $11, PURE_REWARD_SF_INSTANT_R );
+				void * pPureRewardF = allocatePureRewardFormula( $3 , 1.0, $11, PURE_REWARD_SF_INSTANT_R );
 				$$ = allocateComparatorFormula( $6, $8, pPureRewardF, COMPARATOR_SF_REWARD_INTERVAL );
 			}
 			;
@@ -562,9 +673,33 @@ yformula		: EXPECTED_ACCUMULATED_REWARD_F
 			  LEFT_SQUARE_BRACKET DOUBLE_VALUE COMMA DOUBLE_VALUE RIGHT_SQUARE_BRACKET
 			  LEFT_SQUARE_BRACKET stateformula RIGHT_SQUARE_BRACKET
 			{
-				void * pPureRewardF = allocatePureRewardFormula( $3 , $11, PURE_REWARD_SF_EXPECTED_AR );
+				void * pPureRewardF = allocatePureRewardFormula( $3 , 1.0, $11, PURE_REWARD_SF_EXPECTED_AR );
 				$$ = allocateComparatorFormula( $6, $8, pPureRewardF, COMPARATOR_SF_REWARD_INTERVAL );
 			}
+			/* Parameters:
+			*	DOUBLE_VALUE - the epoch
+			*	DOUBLE_VALUE - the discount of the reward of step k, discount^k
+			*	DOUBLE_VALUE - the lower reward bound
+			*	DOUBLE_VALUE - the upper reward bound
+			*	stateformula - the subformula
+			*/
+			| EXPECTED_ACCUMULATED_REWARD_F
+			  LEFT_SQUARE_BRACKET DOUBLE_VALUE COMMA DOUBLE_VALUE RIGHT_SQUARE_BRACKET
+			  LEFT_SQUARE_BRACKET DOUBLE_VALUE COMMA DOUBLE_VALUE RIGHT_SQUARE_BRACKET
+			  LEFT_SQUARE_BRACKET stateformula RIGHT_SQUARE_BRACKET
+			{
+				void * pPureRewardF = allocatePureRewardFormula( $3 , $5, $13, PURE_REWARD_SF_EXPECTED_AR );
+				$$ = allocateComparatorFormula( $8, $10, pPureRewardF, COMPARATOR_SF_REWARD_INTERVAL );
+			}
+			;
+			/* The expected reward accumulated until a stateformula state is reached */
+rformula		: REACHABILITY_REWARD_F
+			  LEFT_SQUARE_BRACKET DOUBLE_VALUE COMMA DOUBLE_VALUE RIGHT_SQUARE_BRACKET
+			  LEFT_SQUARE_BRACKET stateformula RIGHT_SQUARE_BRACKET
+			{
+				void * pPureRewardF = allocatePureRewardFormula( 0.0, 1.0, $8, PURE_REWARD_SF_REACHABILITY_R );
+				$$ = allocateComparatorFormula( $3, $5, pPureRewardF, COMPARATOR_SF_REWARD_INTERVAL );
+			}
 			;
 
 /*****************The Path formulas, such as Until and Next*****************/
@@ -700,6 +835,18 @@ rng_method	: RNG_APP_CRYPT
 		{
 			$$ = RNG_GSL_TAUS_METHOD;
 		}
+		| RNG_XOSHIRO
+		{
+			$$ = RNG_XOSHIRO_METHOD;
+		}
+		| RNG_PCG
+		{
+			$$ = RNG_PCG_METHOD;
+		}
+		| RNG_PHILOX
+		{
+			$$ = RNG_PHILOX_METHOD;
+		}
 		;
 /******************THE END OF GRAMMAR FOR FORMULAS******************/
 
@@ -123,13 +123,15 @@ inline void printHelpMessage(const int help_msg_type){
 			printf("%s%s", HELP_GENERAL_MSG1, HELP_GENERAL_MSG2);
 			break;
 		case HELP_COMMON_MSG_TYPE:
-			printf("%s%s", HELP_COMMON_MSG1, HELP_COMMON_MSG2);
+			printf("%s%s%s", HELP_COMMON_MSG1, HELP_COMMON_MSG2, HELP_COMMON_MSG3);
 			break;
 		case HELP_REWARDS_MSG_TYPE:
 			printf("%s", HELP_REWARDS_MSG);
 			break;
 		case HELP_SIMULATION_MSG_TYPE:
-			printf("%s%s%s%s", HELP_SIMULATION_MSG1, HELP_SIMULATION_MSG2, HELP_SIMULATION_MSG3, HELP_SIMULATION_MSG4);
+			printf("%s%s%s%s%s%s%s%s", HELP_SIMULATION_MSG1, HELP_SIMULATION_MSG2, HELP_SIMULATION_PAR_MSG,
+				HELP_SIMULATION_TEST_MSG, HELP_SIMULATION_SPLIT_MSG, HELP_SIMULATION_IS_MSG,
+				HELP_SIMULATION_MSG3, HELP_SIMULATION_MSG4);
 			break;
 		case HELP_LOGIC_MSG_TYPE:
 			switch( isRunMode(ANY_MODEL_MODE) ){
@@ -190,13 +192,14 @@ inline void printResultingStateProbability( const int index ){
 		if( pFTypeResSubForm->doSimHere ){
 			/* WARNING: Here we assume that the conf. int. borders are computed exactly */
 			print_state_prob( internal_state_index, pFTypeResSubForm->prob_result_size,
-						pFTypeResSubForm->pProbCILeftBorder, LEFT_CI_RESULT_STR, 0.0, NULL );
+						pFTypeResSubForm->pProbCILeftBorder, LEFT_CI_RESULT_STR, 0.0, NULL, NULL );
 			print_state_prob( internal_state_index, pFTypeResSubForm->prob_result_size,
-						pFTypeResSubForm->pProbCIRightBorder, RIGHT_CI_RESULT_STR, 0.0, NULL );
+						pFTypeResSubForm->pProbCIRightBorder, RIGHT_CI_RESULT_STR, 0.0, NULL, NULL );
 		} else {
 			print_state_prob( internal_state_index, pFTypeResSubForm->prob_result_size,
 					pFTypeResSubForm->pProbRewardResult, LEFT_RIGHT_RESULT_STR,
-					pFTypeResSubForm->error_bound, pFTypeResSubForm->pErrorBound );
+					pFTypeResSubForm->error_bound, pFTypeResSubForm->pErrorBound,
+					pFTypeResSubForm->pResultPartition );
 		}
 	}else{
 		printf("WARNING: There are NO results to print.\n");
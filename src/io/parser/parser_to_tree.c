@@ -72,6 +72,7 @@ static void initializeTFTypeRes( PTFTypeRes pFTypeRes, int formula_type ){
 	pFTypeRes->error_bound = 0.0;
 	pFTypeRes->pErrorBound = NULL;
 	pFTypeRes->pProbRewardResult = NULL;
+	pFTypeRes->pResultPartition = NULL;
 }
 
 static void initializeTUnaryOp( PTUnaryOp pUnaryOp, int formula_type, int unary_type, void * pSubForm ){
@@ -211,18 +212,21 @@ void * allocateLongSteadyFormula(void * pSubForm, const int unary_type){
 * For the reward bounds should be wrapped with the COMPARATOR_SF structure of unary_type:
 *	COMPARATOR_SF_REWARD_INTERVAL.
 * @param time the time instance
+* @param discount the discount of the Y formula, 1.0 for none
 * @param pSubForm the subformula for the reward formula
 * @param unary_type one of: PURE_REWARD_SF_EXPECTED_RR, PURE_REWARD_SF_INSTANT_R,
-*					PURE_REWARD_SF_EXPECTED_AR
+*					PURE_REWARD_SF_EXPECTED_AR, PURE_REWARD_SF_REACHABILITY_R
 * @return returns the pointer to the newly created TPureRewardF node casted to (void *)
 */
-void * allocatePureRewardFormula(double time, void * pSubForm, const int unary_type){
+void * allocatePureRewardFormula(double time, double discount, void * pSubForm,
+				const int unary_type){
         PTPureRewardF pPureRewardF = (PTPureRewardF) calloc((size_t) 1,
                         sizeof(TPureRewardF));
 
 	initializeTUnaryOp( &(pPureRewardF->unary_op), PURE_REWARD_SF, unary_type, pSubForm );
 
 	pPureRewardF->time = time;
+	pPureRewardF->discount = discount;
 
 	return (void *) pPureRewardF;
 }
@@ -494,6 +498,9 @@ static BOOL freePTFTypeRes( BOOL UNUSED(before), PTFTypeRes pFTypeRes ){
 	if( pFTypeRes->pErrorBound != NULL ){
 		free( pFTypeRes->pErrorBound );
 	}
+	if( pFTypeRes->pResultPartition != NULL ){
+		(void) free_partition( pFTypeRes->pResultPartition );
+	}
 	return FALSE;
 }
 
@@ -632,14 +639,15 @@ void printFormulaBitsetResultParams(PTFTypeRes pFTypeRes){
 
 				/* WARNING: Here we assume that the conf. int. borders are computed exactly */
 				print_state_probs( pFTypeResSubForm->prob_result_size, pFTypeResSubForm->pProbCILeftBorder,
-							LEFT_CI_RESULT_STR, 0.0, NULL );
+							LEFT_CI_RESULT_STR, 0.0, NULL, NULL );
 				print_state_probs( pFTypeResSubForm->prob_result_size, pFTypeResSubForm->pProbCIRightBorder,
-							RIGHT_CI_RESULT_STR, 0.0, NULL );
+							RIGHT_CI_RESULT_STR, 0.0, NULL, NULL );
 			} else {
 				/* The computation error can be provided in the array, if it is different for every state */
 				if( pFTypeResSubForm->pErrorBound != NULL ){
 					print_error_probs( pFTypeResSubForm->prob_result_size,
-							pFTypeResSubForm->pErrorBound, ERROR_BOUNDS_STR );
+							pFTypeResSubForm->pErrorBound, ERROR_BOUNDS_STR,
+							pFTypeResSubForm->pResultPartition );
 				} else {
 					/* Otherwise it is just one error for all states */
 					printf("%s: %e\n", ERROR_BOUND_STR, pFTypeResSubForm->error_bound );
@@ -657,7 +665,8 @@ void printFormulaBitsetResultParams(PTFTypeRes pFTypeRes){
 					pResultName = LEFT_RIGHT_RESULT_STR;
 				}
 				print_state_probs( pFTypeResSubForm->prob_result_size, pFTypeResSubForm->pProbRewardResult,
-							pResultName, pFTypeResSubForm->error_bound, pFTypeResSubForm->pErrorBound );
+							pResultName, pFTypeResSubForm->error_bound, pFTypeResSubForm->pErrorBound,
+							pFTypeResSubForm->pResultPartition );
 			}
 		}
 		if( pFTypeRes->doSimHere || pFTypeRes->doSimBelow ){
@@ -889,11 +898,23 @@ static BOOL dumpPTCompStateF( BOOL before, PTCompStateF pCompStateF ){
                                                         pCharFormulaString,
                                                         1, "Y");
 							break;
+						case PURE_REWARD_SF_REACHABILITY_R:
+                                                        appendToString(
+                                                        &pFTypeRes->
+                                                        pCharFormulaString,
+                                                        1, "R");
+							break;
 						default :
 							printf("\nERROR: An unexpected subtype '%d' of LONG_STEADY_F.\n", pPureRewardF->unary_op.unary_type );
                                                         exit(EXIT_FAILURE);
 					}
-					if( pPureRewardF->time > 0){
+					if( pPureRewardF->discount != 1.0 ){
+                                                appendToString(&pFTypeRes->
+                                                        pCharFormulaString,
+                                                        33, "[%e,%e]",
+                                                        pPureRewardF->time,
+                                                        pPureRewardF->discount);
+					}else if( pPureRewardF->time > 0){
                                                 appendToString(&pFTypeRes->
                                                         pCharFormulaString,
                                                         17, "[%e]",
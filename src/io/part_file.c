@@ -0,0 +1,191 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Maneesh Khattri, Ivan Zapreev
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description: Read and write partition (.part) files.
+*	Uses: DEF: partition.h, sparse.h
+*		LIB: partition.c, sparse.c
+*		Definition of read_part_file, write_part_file - part_file.h
+*/
+
+#include "part_file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+* Counts the transitions of Q in the same way as they appear in a .tra file,
+* i.e. the off-diagonal elements plus the non-zero diagonal elements.
+*/
+static int count_transitions(/*@observer@*/ const sparse * Q)
+{
+        int i, nnz = 0;
+
+        for ( i = 0 ; i < mtx_rows(Q) ; i++ ) {
+                nnz += mtx_next_num(Q, i);
+                /*@-realcompare@*/
+                if ( 0.0 != mtx_get_diag_val_nt(Q, i) ) /*@=realcompare@*/
+                        nnz++;
+        }
+        return nnz;
+}
+
+/*****************************************************************************
+name		: read_part_file
+role		: reads a .part file. puts the result in a partition (partition.h).
+@param		: sparse *Q: the transition matrix the partition belongs to.
+@param		: char *filename: input .part file's name.
+@return		: partition *: the partition or NULL if the file was not found
+		  or is invalid.
+******************************************************************************/
+partition * read_part_file(const sparse * Q, const char * filename)
+{
+	FILE *p;
+	char  s[1024], states[7], blocks[7], transitions[12];
+	int size = 0, num_blocks = 0, nnz = 0, state, blk, i;
+	state_index *number = NULL;
+	partition *P = NULL;
+
+	if ( NULL == Q || NULL == filename ) {
+		err_msg_2(err_PARAM, "read_part_file(%p,%p)", (const void *) Q,
+				(const void *) filename, NULL);
+	}
+	p = fopen(filename, "r");
+	if( p == NULL ) return NULL;
+
+	if( fgets( s, 1024, p ) == NULL
+			|| sscanf( s, "%6s%d", states, &size ) != 2
+			|| fgets( s, 1024, p ) == NULL
+			|| sscanf( s, "%6s%d", blocks, &num_blocks ) != 2
+			|| fgets( s, 1024, p ) == NULL
+			|| sscanf( s, "%11s%d", transitions, &nnz ) != 2
+			|| strcmp( states, "STATES" ) != 0
+			|| strcmp( blocks, "BLOCKS" ) != 0
+			|| strcmp( transitions, "TRANSITIONS" ) != 0 )
+	{
+		printf("ERROR: The '%s' file has an incorrect header.\n", filename);
+		(void)fclose(p);
+		return NULL;
+	}
+	if( size != mtx_rows(Q) || nnz != count_transitions(Q)
+			|| num_blocks <= 0 || num_blocks > size )
+	{
+		printf("ERROR: The '%s' file does not fit the transition matrix.\n", filename);
+		(void)fclose(p);
+		return NULL;
+	}
+
+	number = (state_index *) malloc((size_t) size * sizeof(state_index));
+	if( number == NULL ){
+		(void)fclose(p);
+		err_msg_2(err_MEMORY, "read_part_file(%p,%s)", (const void *) Q,
+				filename, NULL);
+	}
+	for( i = 0 ; i < size ; i++ ) number[i] = state_index_NONE;
+	while( fgets( s, 1024, p ) != NULL )
+	{
+		if( sscanf( s, "%d%d", &state, &blk ) != 2 ) continue;
+		if( state < 1 || state > size || blk < 1 || blk > num_blocks
+				|| number[state-1] != state_index_NONE )
+		{
+			printf("ERROR: The '%s' file contains an incorrect line '%d %d'.\n",
+				filename, state, blk);
+			free(number);
+			(void)fclose(p);
+			return NULL;
+		}
+		number[state-1] = blk - 1;
+	}
+	(void)fclose(p);
+
+	for( i = 0 ; i < size ; i++ ){
+		if( number[i] == state_index_NONE ){
+			printf("ERROR: The '%s' file does not contain state %d.\n", filename, i + 1);
+			free(number);
+			return NULL;
+		}
+	}
+	P = part_from_block_numbers(number, size, num_blocks);
+	free(number);
+	return P;
+}
+
+/*****************************************************************************
+name		: write_part_file
+role		: writes the (numbered) partition into a .part file.
+@param		: partition *P: the partition, e.g. computed by lump().
+@param		: sparse *Q: the transition matrix the partition belongs to.
+@param		: char *filename: output .part file's name.
+@return		: err_OK if the file was written, err_ERROR otherwise.
+******************************************************************************/
+err_state write_part_file(const partition * P, const sparse * Q,
+		const char * filename)
+{
+	FILE *p;
+	int i;
+
+	if ( part_is_invalid(P) || NULL == Q || NULL == filename
+			|| part_unlumped_state_space_size_nt(P) != mtx_rows(Q) )
+	{
+		err_msg_3(err_PARAM, "write_part_file(%p,%p,%p)",
+				(const void *) P, (const void *) Q,
+				(const void *) filename, err_ERROR);
+	}
+	p = fopen(filename, "w");
+	if( p == NULL ){
+		err_msg_3(err_FILE, "write_part_file(%p,%p,%s)",
+				(const void *) P, (const void *) Q, filename,
+				err_ERROR);
+	}
+	fprintf(p, "STATES %d\n", mtx_rows(Q));
+	fprintf(p, "BLOCKS %d\n", part_lumped_state_space_size_nt(P));
+	fprintf(p, "TRANSITIONS %d\n", count_transitions(Q));
+	for( i = 0 ; i < mtx_rows(Q) ; i++ ){
+		fprintf(p, "%d %d\n", i + 1, part_lump_state_id_nt(P, i) + 1);
+	}
+	if( fclose(p) != 0 ){
+		err_msg_3(err_FILE, "write_part_file(%p,%p,%s)",
+				(const void *) P, (const void *) Q, filename,
+				err_ERROR);
+	}
+	return err_OK;
+}
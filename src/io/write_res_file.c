@@ -84,35 +84,42 @@ void write_res_file_add(int stateToWrite)
 
 /**
 * Derived from print_state_prob in runtime.c
+* pResultPartition is the partition of the formula dependent lumping if probs
+* is kept per block, NULL otherwise.
 */
 static void print_state_prob_to_file( FILE *p, const int index, const int size, const double * probs,
                                 const double error_bound_local,
-                                const double * pErrorBounds)
+                                const double * pErrorBounds,
+                                const partition * pResultPartition)
 {
-    const partition * P_local = getPartition();
+    const partition * P_local = ( NULL != pResultPartition ? pResultPartition
+                    : ( isRunMode(F_IND_LUMP_MODE) ? getPartition() : NULL ) );
+
+	int internal_index = index, internal_size = size;
 
 	fprintf( p, "%d ", index + 1 );
-	if ( isRunMode(F_IND_LUMP_MODE) && NULL != P_local ) {
-			/* TODO
-			print_state_prob_partition(P_local, index, probs,
-							error_bound_local, pErrorBounds);
-			*/
-	}else{
-		if( probs != NULL ){
-			if( 0 <= index && index < size ){
-				/* Calculate the right pattern according to the precision */
-                                fprintf( p, "%1.*f\n", get_error_bound_precision(
-                                                index, error_bound_local,
-                                                size, pErrorBounds ),
-                                        probs[index]);
-			}else{
-				printf("??\n");
-				printf("WARNING: Invalid index %d, required to be in the [1, %d] interval.", index + 1, size);
-			}
+	/* After formula (in)dependent lumping the results are kept per block, */
+	/* so we look up the block of the state instead of unlumping them */
+	if ( NULL != P_local ) {
+		internal_size = get_unlumped_state_space_size(P_local);
+		if( 0 <= index && index < internal_size ){
+			internal_index = part_lump_state_id_nt(P_local, index);
+		}
+	}
+	if( probs != NULL ){
+		if( 0 <= index && index < internal_size ){
+			/* Calculate the right pattern according to the precision */
+                        fprintf( p, "%1.*f\n", get_error_bound_precision(
+                                        internal_index, error_bound_local,
+                                        size, pErrorBounds ),
+                                probs[internal_index]);
 		}else{
 			printf("??\n");
-			printf("WARNING: Trying to print an element of a non-existing array.");
+			printf("WARNING: Invalid index %d, required to be in the [1, %d] interval.", index + 1, internal_size);
 		}
+	}else{
+		printf("??\n");
+		printf("WARNING: Trying to print an element of a non-existing array.");
 	}
 }
 
@@ -121,32 +128,34 @@ static void print_state_prob_to_file( FILE *p, const int index, const int size,
 */
 static void print_state_sat_to_file( FILE *p, const bitset * pBitset, const int index ){
 	const partition * P_local = getPartition();
+	int internal_index = index, internal_size;
 
 	fprintf(p, "%d ", index + 1);
        
-	if ( isRunMode(F_IND_LUMP_MODE) && NULL != P_local ) {
-		/*
-		TODO
-			print_original_state(P_local, pBitset, index);
-		*/
-	}else{
-		if( pBitset != NULL ){
-			if ( 0 <= index && index < bitset_size(pBitset) ) {
-				if( get_bit_val( pBitset, index ) ){
-					fprintf(p,"TRUE\n");
-				}else{
-					fprintf(p,"FALSE\n");
-				}
+	if( pBitset != NULL ){
+		internal_size = bitset_size(pBitset);
+		/* After formula independent lumping the bitset is over the blocks */
+		if ( isRunMode(F_IND_LUMP_MODE) && NULL != P_local ) {
+			internal_size = get_unlumped_state_space_size(P_local);
+			if ( 0 <= index && index < internal_size ) {
+				internal_index = part_lump_state_id_nt(P_local, index);
+			}
+		}
+		if ( 0 <= index && index < internal_size ) {
+			if( get_bit_val( pBitset, internal_index ) ){
+				fprintf(p,"TRUE\n");
 			}else{
-				fprintf(p,"??\n");
-                                printf("WARNING: Invalid index %d, required to "
-                                       "be in the [1, %d] interval.",
-                                       index + 1, bitset_size(pBitset));
+				fprintf(p,"FALSE\n");
 			}
 		}else{
 			fprintf(p,"??\n");
-			printf("WARNING: Trying to print an element of a non-existing bitset.");
+                        printf("WARNING: Invalid index %d, required to "
+                               "be in the [1, %d] interval.",
+                               index + 1, internal_size);
 		}
+	}else{
+		fprintf(p,"??\n");
+		printf("WARNING: Trying to print an element of a non-existing bitset.");
 	}
 }
 
@@ -174,7 +183,8 @@ static void write_result_of_state_to_res_file(PTFTypeRes pFTypeRes, FILE *p, con
 		} else {
 			print_state_prob_to_file(p, internal_state_index, pFTypeResSubForm->prob_result_size,
 					pFTypeResSubForm->pProbRewardResult,
-					pFTypeResSubForm->error_bound, pFTypeResSubForm->pErrorBound );
+					pFTypeResSubForm->error_bound, pFTypeResSubForm->pErrorBound,
+					pFTypeResSubForm->pResultPartition );
 		}
 	}else{
 		printf("WARNING: There are NO results to print.\n");
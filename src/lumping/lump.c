@@ -52,6 +52,7 @@
 
 #include "runtime.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -68,6 +69,46 @@ static /*@only@*/ /*@null@*/ sparse *calculate_lumped_probabilities(partition*P,
 static void quicksort(int * cols, double * vals, int left, int right)
                 /*@modifies *cols, *vals@*/;
 
+
+/**
+* The function returns the impulse rewards that lumping has to respect, i.e.
+* the impulse rewards of a CMRM, or NULL if there are none.
+*/
+static /*@observer@*/ /*@null@*/ const sparse * lump_impulse_rewards(void)
+                /*@modifies nothing@*/
+{
+        return 0 != isRunMode(CMRM_MODE) ? getImpulseRewards() : NULL;
+}
+
+
+/**
+* The function returns TRUE if lumping computes weak bisimulation, i.e. if it
+* ignores internal transitions (transitions that stay within their block and do
+* not earn an impulse reward). This is only sound for continuous-time models.
+*/
+static BOOL lump_is_weak(void) /*@modifies nothing@*/
+{
+        return is_lump_weak_on() && 0 != isRunMode(CTMC_MODE | CMRM_MODE);
+}
+
+
+/**
+* The function returns the impulse reward of the transition from s to t, or 0.0
+* if rewi is NULL.
+*/
+static double impulse_of(/*@observer@*/ /*@null@*/ const sparse * rewi,
+                state_index s, state_index t) /*@modifies nothing@*/
+{
+        double imp = 0.0;
+
+        if ( NULL != rewi && err_state_iserror(get_mtx_val(rewi, (int) s,
+                                                        (int) t, &imp)) )
+        {
+                imp = 0.0;
+        }
+        return imp;
+}
+
 /**
 * This internal subroutine finds all predecessors of splitter and treats them
 * as follows:
@@ -88,13 +129,13 @@ static err_state find_predecessors(partition *P, /*@observer@*/ const sparse *Q,
                 /*@observer@*/ const block * splitter)
                 /*@requires notnull P->blocks, P->sum, P->pos@*/
                 /*@requires isnull P->first_PredCl@*/
-                /*@modifies P->first_PredCl, *P->sum, *P->pos, P->ib[],
+                /*@modifies P->first_PredCl, *P->sum, *P->pos, P->id[],
                         P->num_blocks, splitter->next@*/
 {
         pos_index s_pos, begin = part_block_begin_nt(splitter);
 
         for ( s_pos = part_block_end_nt(splitter) ; s_pos-- > begin ; ) {
-                state_index s = P->ib[s_pos].id;
+                state_index s = P->id[s_pos];
 
                 mtx_walk_column(Q, t, (const int) s, val) {
                         /*@dependent@*/ block * C;
@@ -151,20 +192,20 @@ static err_state find_predecessors(partition *P, /*@observer@*/ const sparse *Q,
                                            Note that after these swaps, s is no
                                            longer at s_pos. */
                                         if ( t_pos != s_pos ) {
-                                                ss= P->ib[t_pos].id
-                                                        = P->ib[s_pos].id;
+                                                ss= P->id[t_pos]
+                                                        = P->id[s_pos];
                                                 P->pos[ss] = t_pos;
                                         }
-                                        ss = P->ib[s_pos].id
-                                        = P->ib[part_block_end_nt(C_pred)].id;
+                                        ss = P->id[s_pos]
+                                        = P->id[part_block_end_nt(C_pred)];
                                         P->pos[ss] = s_pos++;
                                         if ( begin!=part_block_end_nt(C_pred) ){
-                                                ss = P->ib[part_block_end_nt(
-                                                C_pred)].id = P->ib[begin].id;
+                                                ss = P->id[part_block_end_nt(
+                                                C_pred)] = P->id[begin];
                                                 P->pos[ss]
                                                 = part_block_end_nt(C_pred);
                                         }
-                                        P->ib[begin].id = t;
+                                        P->id[begin] = t;
                                         P->pos[t] = begin++;
                                 /* }else if ( part_block_end_nt(C_pred) >= s_pos
                                                         && s_pos > t_pos ) {
@@ -173,10 +214,10 @@ static err_state find_predecessors(partition *P, /*@observer@*/ const sparse *Q,
                                 } else {
                                         /* swap state t with state at
                                            part_block_end_nt(C_pred) */
-                                        state_index tt = P->ib[t_pos].id
-                                        = P->ib[part_block_end_nt(C_pred)].id;
+                                        state_index tt = P->id[t_pos]
+                                        = P->id[part_block_end_nt(C_pred)];
                                         P->pos[tt] = t_pos;
-                                        P->ib[part_block_end_nt(C_pred)].id = t;
+                                        P->id[part_block_end_nt(C_pred)] = t;
                                         P->pos[t] = part_block_end_nt(C_pred);
                                 }
                                 /* part_block_end_nt */ C_pred->end++;
@@ -199,7 +240,7 @@ static err_state refine(partition * P)
                 /*@requires notnull P->blocks, P->sum, P->pos@*/
                 /*@ensures isnull P->first_PredCl@*/
                 /*@modifies P->first_Sp, P->first_PredCl, *P->blocks,
-                        P->num_blocks, P->ib, *P->pos@*/
+                        P->num_blocks, P->b, *P->pos@*/
 {
         /*@dependent@*/ /*@null@*/ block * C_pred, * next_PredCl;
 
@@ -226,7 +267,8 @@ static err_state refine(partition * P)
                            directly because there may be pointers to C.) */
                         /*@only@*/ /*@null@*/ block * temp = C_pred->next;
                         if ( NULL != C->next ) {
-                                if ( err_state_iserror(free_block(C->next)) ) {
+                                if ( err_state_iserror(part_free_block(P,
+                                                        C->next)) ) {
                                         /*@-mustfreeonly@*/
                                         err_msg_1(err_CALLBY, "refine("
                                                 "%p)", (void *) P,
@@ -295,6 +337,545 @@ static err_state refine(partition * P)
 }
 
 
+/**
+* The signatures used by the signature-based refinement. For each state s,
+* the signature is the list of pairs (blk[i], val[i]) for
+* begin[s] <= i < begin[s] + len[s], sorted by block number; val[i] is the
+* total rate (or probability) from s to the block with number blk[i].
+* If impulse rewards have to be respected, imp is not NULL and the signature
+* consists of triples (blk[i], imp[i], val[i]) sorted by block number and
+* impulse reward; val[i] is the total rate of the transitions to block blk[i]
+* that earn the impulse reward imp[i].
+* hash[s] is a hash value of the block numbers in the signature of s.
+* The arrays blk, imp and val have space for every non-zero entry of the matrix,
+* so a signature never needs more than begin[s+1] - begin[s] pairs.
+*/
+typedef struct {
+        /*@only@*/ int * begin;
+        /*@only@*/ int * blk;
+        /*@only@*/ /*@null@*/ double * imp;
+        /*@only@*/ double * val;
+        /*@only@*/ state_count * len;
+        /*@only@*/ unsigned * hash;
+} signatures;
+
+/**
+* The signatures that are compared by comp_signature() and the keys that are
+* compared by comp_key(). qsort() does not allow to pass additional data to
+* the compare function; the signatures are only read while sorting, and every
+* block only writes the keys of its own states, so the blocks can still be
+* sorted in parallel.
+*/
+static /*@null@*/ /*@dependent@*/ const signatures * cmp_sig = NULL;
+static /*@null@*/ /*@dependent@*/ const double * cmp_key = NULL;
+
+/**
+* The function is a compare function for qsort(). It interprets its two
+* arguments as pointers to state indices and compares the blocks and impulse
+* rewards of the signatures of the states in cmp_sig, but not their values.
+* The values are compared afterwards, one position at a time, see
+* group_values().
+*/
+static int comp_signature(const void * s1, const void * s2) {
+        const state_index a = *(const state_index *) s1;
+        const state_index b = *(const state_index *) s2;
+        const int * blk_a, * blk_b;
+        state_count i;
+
+        if ( cmp_sig->hash[a] != cmp_sig->hash[b] ) {
+                return cmp_sig->hash[a] < cmp_sig->hash[b] ? -1 : 1;
+        }
+        if ( cmp_sig->len[a] != cmp_sig->len[b] ) {
+                return cmp_sig->len[a] - cmp_sig->len[b];
+        }
+        blk_a = &cmp_sig->blk[cmp_sig->begin[a]];
+        blk_b = &cmp_sig->blk[cmp_sig->begin[b]];
+        for ( i = 0 ; i < cmp_sig->len[a] ; i++ ) {
+                if ( blk_a[i] != blk_b[i] ) {
+                        return blk_a[i] - blk_b[i];
+                }
+        }
+        if ( NULL != cmp_sig->imp ) {
+                const double * imp_a = &cmp_sig->imp[cmp_sig->begin[a]];
+                const double * imp_b = &cmp_sig->imp[cmp_sig->begin[b]];
+
+                for ( i = 0 ; i < cmp_sig->len[a] ; i++ ) {
+                        /*@-realcompare@*/
+                        if ( imp_a[i] != imp_b[i] ) {
+                                return imp_a[i] < imp_b[i] ? -1 : 1;
+                        }
+                        /*@=realcompare@*/
+                }
+        }
+        return 0;
+}
+
+
+/**
+* The function is a compare function for qsort(). It interprets its two
+* arguments as pointers to state indices and compares their keys in cmp_key;
+* states with equal keys are ordered by their index.
+*/
+static int comp_key(const void * s1, const void * s2) {
+        const state_index a = *(const state_index *) s1;
+        const state_index b = *(const state_index *) s2;
+
+        /*@-realcompare@*/
+        if ( cmp_key[a] != cmp_key[b] ) {
+                return cmp_key[a] < cmp_key[b] ? -1 : 1;
+        }
+        /*@=realcompare@*/
+        return a - b;
+}
+
+
+/**
+* This internal subroutine groups the states ids[lo], ..., ids[hi-1], whose
+* signatures have the same blocks and impulse rewards, by the values at the
+* positions pos, pos+1, ... of their signatures. For every position, the
+* states are sorted by their value and a new group starts where two
+* neighbours differ by more than EPSILON, like in sort_and_split_block(); the
+* groups are then grouped by the next position. States whose values all
+* differ by at most EPSILON are never separated, and the groups do not
+* depend on the order of the states. new_group[i] is set to TRUE for every
+* lo < i < hi where a group starts.
+*/
+static void group_values(/*@observer@*/ const signatures * sig,
+                state_index * ids, double * key, BOOL * new_group,
+                pos_index lo, pos_index hi, state_count pos)
+                /*@modifies ids[], key[], new_group[]@*/
+{
+        pos_index i, start;
+
+        if ( hi - lo <= 1 || pos >= sig->len[ids[lo]] ) {
+                return;
+        }
+        for ( i = lo ; i < hi ; i++ ) {
+                key[ids[i]] = sig->val[sig->begin[ids[i]] + pos];
+        }
+        qsort(&ids[lo], (size_t) (hi - lo), sizeof(state_index), comp_key);
+        for ( i = lo + 1 ; i < hi ; i++ ) {
+                new_group[i] = key[ids[i]] - key[ids[i - 1]] > EPSILON;
+        }
+        /* the keys of the states are overwritten by the next position */
+        for ( start = lo, i = lo + 1 ; i <= hi ; i++ ) {
+                if ( i == hi || new_group[i] ) {
+                        group_values(sig, ids, key, new_group, start, i,
+                                        pos + 1);
+                        start = i;
+                }
+        }
+}
+
+
+/**
+* This internal subroutine sorts the states ids[begin], ..., ids[end-1] by
+* their signatures and sets new_group[i] to TRUE for every begin < i < end
+* where a group of states with the same signature starts: the blocks and
+* impulse rewards have to be equal, the values may differ by at most EPSILON
+* (see group_values()).
+*/
+static void group_signatures(/*@observer@*/ const signatures * sig,
+                state_index * ids, double * key, BOOL * new_group,
+                pos_index begin, pos_index end)
+                /*@modifies ids[], key[], new_group[]@*/
+{
+        pos_index i, start;
+
+        qsort(&ids[begin], (size_t) (end - begin), sizeof(state_index),
+                        comp_signature);
+        for ( start = begin, i = begin + 1 ; i <= end ; i++ ) {
+                if ( i == end || 0 != comp_signature(&ids[i - 1], &ids[i]) ) {
+                        if ( i < end ) {
+                                new_group[i] = TRUE;
+                        }
+                        group_values(sig, ids, key, new_group, start, i, 0);
+                        start = i;
+                }
+        }
+}
+
+
+/**
+* The function returns TRUE if the signatures of the states a and b in sig
+* have the same blocks and impulse rewards and values that differ by at most
+* EPSILON, just like in sort_and_split_block().
+*/
+static BOOL same_signature(/*@observer@*/ const signatures * sig,
+                state_index a, state_index b) /*@modifies nothing@*/
+{
+        const double * val_a = &sig->val[sig->begin[a]];
+        const double * val_b = &sig->val[sig->begin[b]];
+        state_count i;
+
+        if ( sig->hash[a] != sig->hash[b] || sig->len[a] != sig->len[b] ) {
+                return FALSE;
+        }
+        for ( i = 0 ; i < sig->len[a] ; i++ ) {
+                /*@-realcompare@*/
+                if ( sig->blk[sig->begin[a] + i] != sig->blk[sig->begin[b] + i]
+                                || (NULL != sig->imp
+                                && sig->imp[sig->begin[a] + i]
+                                        != sig->imp[sig->begin[b] + i])
+                                || fabs(val_a[i] - val_b[i]) > EPSILON )
+                /*@=realcompare@*/
+                {
+                        return FALSE;
+                }
+        }
+        return TRUE;
+}
+
+
+/**
+* This internal subroutine sorts the triples (blk[i], imp[i], val[i]) for
+* 0 <= i < len by block number and impulse reward (Shell sort; the rows are
+* usually short).
+*/
+static void sort_by_impulse(int * blk, double * imp, double * val,
+                state_count len) /*@modifies *blk, *imp, *val@*/
+{
+        state_count h, i, j;
+
+        for ( h = 1 ; h < len / 3 ; h = 3 * h + 1 ) {
+                ;
+        }
+        for ( ; 0 < h ; h /= 3 ) {
+                for ( i = h ; i < len ; i++ ) {
+                        const int b = blk[i];
+                        const double r = imp[i], v = val[i];
+
+                        for ( j = i ; h <= j && (blk[j - h] > b
+                                        || (blk[j - h] == b && imp[j - h] > r))
+                                        ; j -= h )
+                        {
+                                blk[j] = blk[j - h];
+                                imp[j] = imp[j - h];
+                                val[j] = val[j - h];
+                        }
+                        blk[j] = b;
+                        imp[j] = r;
+                        val[j] = v;
+                }
+        }
+}
+
+
+/**
+* This internal subroutine computes the signature of every state that belongs to
+* a block that may still be split. It assumes that P->b[...]->u.row contains
+* the current block numbers. If rewi is not NULL, transitions with different
+* impulse rewards are kept apart; if weak is TRUE, internal transitions (see
+* lump_is_weak()) are left out. The states are independent of each other, so
+* the loop runs in parallel if OpenMP is enabled.
+*/
+static void compute_signatures(/*@observer@*/ const partition * P,
+                /*@observer@*/ const sparse * Q,
+                /*@observer@*/ /*@null@*/ const sparse * rewi, BOOL weak,
+                signatures * sig)
+                /*@requires notnull P->blocks@*/
+                /*@modifies sig->blk, sig->imp, sig->val, sig->len,
+                        sig->hash@*/
+{
+        state_index s;
+        const state_count n = mtx_rows(Q);
+
+#       ifdef _OPENMP
+#       pragma omp parallel for schedule(dynamic, 1024)
+#       endif
+        for ( s = 0 ; s < n ; s++ ) {
+                const block * B = block_of(P, s);
+                int * blk = &sig->blk[sig->begin[s]];
+                double * imp = NULL != sig->imp ? &sig->imp[sig->begin[s]]
+                                                : NULL;
+                double * val = &sig->val[sig->begin[s]];
+                state_count len = 0, i;
+                unsigned hash = 2166136261U;
+
+                if ( 0 != (B->flags & ABSORBING) || part_block_size_nt(B) <= 1 )
+                {
+                        sig->len[s] = 0;
+                        sig->hash[s] = 0;
+                        continue;
+                }
+                mtx_walk_row(Q, (const int) s, col, v) {
+                        const double r = impulse_of(rewi, s, col);
+
+                        /*@-realcompare@*/
+                        if ( weak && block_of(P, col) == B && 0.0 == r ) {
+                                continue;
+                        }
+                        /*@=realcompare@*/
+                        if ( NULL != imp ) {
+                                imp[len] = r;
+                        }
+                        blk[len] = block_of(P, col)->u.row;
+                        val[len++] = v;
+                } end_mtx_walk_row;
+                if ( NULL != imp ) {
+                        sort_by_impulse(blk, imp, val, len);
+                } else if ( 1 < len ) {
+                        quicksort(blk, val, 0, len - 1);
+                }
+                /* merge the entries that lead to the same block (and earn
+                   the same impulse reward) */
+                if ( 0 < len ) {
+                        state_count last = 0;
+
+                        for ( i = 1 ; i < len ; i++ ) {
+                                /*@-realcompare@*/
+                                if ( blk[i] == blk[last] && (NULL == imp
+                                                || imp[i] == imp[last]) )
+                                /*@=realcompare@*/
+                                {
+                                        val[last] += val[i];
+                                } else {
+                                        blk[++last] = blk[i];
+                                        if ( NULL != imp ) {
+                                                imp[last] = imp[i];
+                                        }
+                                        val[last] = val[i];
+                                }
+                        }
+                        len = last + 1;
+                }
+                for ( i = 0 ; i < len ; i++ ) {
+                        hash = (hash ^ (unsigned) blk[i]) * 16777619U;
+                }
+                sig->len[s] = len;
+                sig->hash[s] = hash;
+        }
+}
+
+
+/**
+* This internal subroutine allocates the signatures for the matrix Q; the
+* impulse rewards of the signatures are only allocated if impulses is TRUE.
+*/
+static err_state alloc_signatures(/*@out@*/ signatures * sig,
+                /*@observer@*/ const sparse * Q, BOOL impulses)
+                /*@modifies *sig@*/
+{
+        const state_count n = mtx_rows(Q);
+        state_index s;
+
+        sig->blk = NULL;
+        sig->imp = NULL;
+        sig->val = NULL;
+        sig->begin = (int *) calloc((size_t) n + 1, sizeof(int));
+        sig->len = (state_count *) calloc((size_t) n, sizeof(state_count));
+        sig->hash = (unsigned *) calloc((size_t) n, sizeof(unsigned));
+        if ( NULL != sig->begin ) {
+                for ( s = 0 ; s < n ; s++ ) {
+                        sig->begin[s + 1] = sig->begin[s] + mtx_next_num(Q, s)
+                                                + 1;
+                }
+                sig->blk = (int *) calloc((size_t) sig->begin[n], sizeof(int));
+                sig->val = (double *) calloc((size_t) sig->begin[n],
+                                sizeof(double));
+                if ( impulses ) {
+                        sig->imp = (double *) calloc((size_t) sig->begin[n],
+                                        sizeof(double));
+                }
+        }
+        if ( NULL == sig->begin || NULL == sig->len || NULL == sig->hash
+                        || NULL == sig->blk || NULL == sig->val
+                        || (impulses && NULL == sig->imp) )
+        {
+                err_msg_4(err_MEMORY, "alloc_signatures(%p,%p[%dx%d])",
+                                (void *) sig, (const void *) Q, mtx_rows(Q),
+                                mtx_cols(Q), (free(sig->imp), free(sig->val),
+                                free(sig->blk), free(sig->hash), free(sig->len),
+                                free(sig->begin), err_ERROR));
+        }
+        return err_OK;
+}
+
+
+/**
+* This internal subroutine frees the signatures.
+*/
+static void free_signatures(/*@only@*/ signatures * sig)
+                /*@modifies *sig@*/
+{
+        free(sig->imp);
+        free(sig->val);
+        free(sig->blk);
+        free(sig->hash);
+        free(sig->len);
+        free(sig->begin);
+}
+
+
+/**
+* This internal subroutine refines the partition by signatures instead of
+* splitters: in every round, it computes for every state the total rate to
+* every block, sorts every block by these signatures, and splits it into the
+* groups of states with equal signatures. It stops as soon as a round does not
+* split any block. The states are grouped by the blocks of their signatures
+* first and then by the values, one position at a time, where neighbours in
+* the sorted order that differ by more than EPSILON are split (see
+* group_signatures()), so the result does not depend on the order of the
+* states. Up to rates that differ by about EPSILON, it is the
+* same partition as the one computed by find_predecessors() and refine(), but
+* the signatures of one round can be computed independently of each other.
+* The signatures also respect the impulse rewards (see lump_impulse_rewards())
+* and, for weak bisimulation, ignore internal transitions (see lump_is_weak());
+* the splitter-based refinement supports neither.
+* Absorbing blocks and blocks with only one state are never split.
+* The function leaves all blocks without the flags SPLITTER and PARTITIONED.
+*/
+static err_state refine_signatures(partition * P,
+                /*@observer@*/ const sparse * Q)
+                /*@requires notnull P->blocks@*/
+                /*@ensures isnull P->first_Sp, P->first_PredCl@*/
+                /*@modifies P->first_Sp, P->first_PredCl, *P->blocks,
+                        P->num_blocks, P->id, P->b@*/
+{
+        const state_count n = mtx_rows(Q);
+        const sparse * rewi = lump_impulse_rewards();
+        const BOOL weak = lump_is_weak();
+        signatures sig;
+        /*@only@*/ /*@null@*/ state_index * ids;
+        /*@only@*/ /*@null@*/ double * key;
+        /*@only@*/ /*@null@*/ BOOL * new_group;
+        /*@only@*/ /*@null@*/ block ** todo = NULL;
+        state_count num_todo, t, num_split;
+        BOOL error = FALSE;
+
+        P->first_Sp = NULL;
+        P->first_PredCl = NULL;
+        part_walk_blocks(P, b) {
+                b->flags &= ABSORBING;
+        } end_part_walk_blocks;
+
+        ids = (state_index *) calloc((size_t) n, sizeof(state_index));
+        key = (double *) calloc((size_t) n, sizeof(double));
+        new_group = (BOOL *) calloc((size_t) n, sizeof(BOOL));
+        if ( NULL == ids || NULL == key || NULL == new_group
+                        || err_state_iserror(alloc_signatures(&sig, Q,
+                                                        NULL != rewi)) )
+        {
+                err_msg_4(err_MEMORY, "refine_signatures(%p,%p[%dx%d])",
+                                (void *) P, (const void *) Q, mtx_rows(Q),
+                                mtx_cols(Q), (free(new_group), free(key),
+                                free(ids), err_ERROR));
+        }
+
+        do {
+                /* number the blocks and collect those that may be split */
+                free(todo);
+                todo = (block **) calloc((size_t) P->num_blocks,
+                                sizeof(block *));
+                if ( NULL == todo ) {
+                        error = TRUE;
+                        break;
+                }
+                num_todo = 0;
+                t = 0;
+                part_walk_blocks(P, b) {
+                        b->u.row = t++;
+                        if ( 0 == (b->flags & ABSORBING)
+                                        && part_block_size_nt(b) > 1 )
+                        {
+                                todo[num_todo++] = b;
+                        }
+                } end_part_walk_blocks;
+
+                compute_signatures(P, Q, rewi, weak, &sig);
+
+                /* sort the states in every block by their signatures */
+                cmp_sig = &sig;
+                cmp_key = key;
+#               ifdef _OPENMP
+#               pragma omp parallel for schedule(dynamic, 1)
+#               endif
+                for ( t = 0 ; t < num_todo ; t++ ) {
+                        const pos_index begin = part_block_begin_nt(todo[t]);
+                        const pos_index end = part_block_end_nt(todo[t]);
+                        pos_index i;
+
+                        for ( i = begin ; i < end ; i++ ) {
+                                ids[i] = P->id[i];
+                                new_group[i] = FALSE;
+                        }
+                        group_signatures(&sig, ids, key, new_group, begin,
+                                        end);
+                        for ( i = begin ; i < end ; i++ ) {
+                                P->id[i] = ids[i];
+                        }
+                }
+
+                /* split the blocks where the signature changes */
+                num_split = 0;
+                for ( t = 0 ; t < num_todo && ! error ; t++ ) {
+                        block * B = todo[t];
+                        pos_index i, begin = part_block_begin_nt(B);
+
+                        for ( i = begin + 1 ; i < part_block_end_nt(B) ; i++ ){
+                                block * B_new;
+
+                                if ( ! new_group[i] ) {
+                                        continue;
+                                }
+                                if ( (B_new = part_split_block(P, B, i))
+                                                                == NULL )
+                                {
+                                        error = TRUE;
+                                        break;
+                                }
+                                for ( ; begin < i ; begin++ ) {
+                                        P->b[P->id[begin]] = B_new->idx;
+                                }
+                                num_split++;
+                        }
+                }
+                cmp_sig = NULL;
+                cmp_key = NULL;
+        } while ( 0 < num_split && ! error );
+
+        free(todo);
+        free_signatures(&sig);
+        free(new_group);
+        free(key);
+        free(ids);
+        if ( error ) {
+                err_msg_4(err_CALLBY, "refine_signatures(%p,%p[%dx%d])",
+                                (void *) P, (const void *) Q, mtx_rows(Q),
+                                mtx_cols(Q), err_ERROR);
+        }
+        return err_OK;
+}
+
+
+/**
+* This internal subroutine is the variant of lump() that refines the partition
+* by signatures (see refine_signatures()).
+*/
+static /*@only@*/ /*@null@*/ sparse * lump_signature(partition * P,
+                /*@observer@*/ const sparse * Q)
+                /*@requires notnull P->blocks, P->pos@*/
+                /*@requires isnull P->sum@*/
+                /*@ensures isnull P->first_Sp, P->first_PredCl, P->sum,
+                        P->pos@*/
+                /*@modifies *P@*/
+{
+        sparse * res = NULL;
+
+        free(P->pos);
+        P->pos = NULL;
+        if ( err_state_iserror(refine_signatures(P, Q))
+                        || err_state_iserror(part_number_blocks(P))
+                        || (res = calculate_lumped_probabilities(P,Q)) == NULL )
+        {
+                err_msg_4(err_CALLBY, "lump_signature(%p,%p[%dx%d])",
+                                (void *) P, (const void*) Q, mtx_rows(Q),
+                                mtx_cols(Q), NULL);
+        }
+        return res;
+}
+
+
 /*****************************************************************************
 name		: lump
 role		: This method computes the optimal lumped matrix of the input matrix.
@@ -325,6 +906,12 @@ role		: This method computes the optimal lumped matrix of the input matrix.
                 /*@=nullstate@*/
         }
 
+        if ( LUMP_SIGNATURE == get_method_lumping() || lump_is_weak()
+                                        || NULL != lump_impulse_rewards() )
+        {
+                return lump_signature(P, Q);
+        }
+
         P->first_PredCl = NULL;
         if ( (P->sum = calloc((size_t) part_unlumped_state_space_size_nt(P),
                                 sizeof(double))) == NULL )
@@ -402,11 +989,396 @@ role		: This method computes the optimal lumped matrix of the input matrix.
 }
 
 
+/**
+* This method computes the lumped matrix for a partition that is already stable,
+* e.g. a partition that has been read from a file. No refinement is done.
+* @param	: partition *P: The partition.
+* @param	: sparse *Q: The matrix to lump.
+* @return	: The lumped matrix.
+*/
+/*@only@*/ /*@null@*/ sparse * lump_quotient(/*@i1@*/ /*@null@*/ partition * P,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const sparse * Q)
+{
+        sparse * res = NULL;
+
+        if ( part_is_invalid(P) || NULL != P->pos || NULL != P->sum
+                        || NULL != P->first_Sp || NULL != P->first_PredCl
+                        || NULL == Q
+                        || part_unlumped_state_space_size_nt(P) != mtx_rows(Q))
+        {
+                err_msg_4(err_PARAM, "lump_quotient(%p,%p[%dx%d])", (void *) P,
+                                (const void *) Q, NULL != Q ? mtx_rows(Q) : 0,
+                                NULL != Q ? mtx_cols(Q) : 0, NULL);
+        }
+        if ( err_state_iserror(part_number_blocks(P))
+                        || (res = calculate_lumped_probabilities(P,Q)) == NULL )
+        {
+                err_msg_4(err_CALLBY, "lump_quotient(%p,%p[%dx%d])", (void *) P,
+                                (const void*)Q, mtx_rows(Q), mtx_cols(Q), NULL);
+        }
+        return res;
+}
+
+
+/**
+* The function checks whether the bitset is a union of blocks of P, i.e.
+* whether all states of each block agree on their bit.
+*/
+static BOOL part_respects_bitset(/*@observer@*/ const partition * P,
+                /*@observer@*/ const bitset * bs) /*@modifies nothing@*/
+{
+        state_index i;
+
+        if ( part_unlumped_state_space_size_nt(P) != bitset_size(bs) ) {
+                return FALSE;
+        }
+        for ( i = 0 ; i < part_unlumped_state_space_size_nt(P) ; i++ ) {
+                if ( get_bit_val(bs, i) != get_bit_val(bs,
+                                part_unlump_state_block_nt(P, block_of(P, i))) )
+                {
+                        return FALSE;
+                }
+        }
+        return TRUE;
+}
+
+
+/**
+* This method checks whether the partition is consistent with the labelling and
+* the state rewards, i.e. whether it can be used as initial partition for
+* formula-independent lumping. It does not check whether the partition is stable.
+* @param	: partition *P: the partition.
+* @param	: labelling *labellin: the labelling.
+* @param	: double *rewards: the state rewards or NULL.
+* @return	: TRUE if all labels and rewards are constant on each block.
+*/
+BOOL part_respects_labelling(/*@observer@*/ /*@i1@*/ /*@null@*/ const partition*P,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const labelling * labellin,
+                /*@observer@*/ /*@null@*/ const double * rewards)
+{
+        int label;
+        state_index i;
+
+        if ( part_is_invalid(P) || NULL == labellin
+                        || part_unlumped_state_space_size_nt(P)
+                                        != labellin->ns )
+        {
+                return FALSE;
+        }
+        for ( label = 0 ; label < labellin->n ; label++ ) {
+                if ( ! part_respects_bitset(P, labellin->b[label]) ) {
+                        return FALSE;
+                }
+        }
+        if ( NULL != rewards ) {
+                for ( i = 0 ; i < labellin->ns ; i++ ) {
+                        /*@-realcompare@*/
+                        if ( rewards[i] != rewards[part_unlump_state_block_nt(
+                                                P, block_of(P, i))] )
+                        /*@=realcompare@*/
+                        {
+                                return FALSE;
+                        }
+                }
+        }
+        return TRUE;
+}
+
+
+/**
+* This method checks whether the partition is stable for the matrix, i.e.
+* whether all states of a block have the same total rate (up to EPSILON) to
+* every block, with the same impulse rewards if these have to be respected
+* (see lump_impulse_rewards()). Only then can lump_quotient() be used.
+* It needs one pass over the matrix.
+* @param	: partition *P: the partition, its blocks have to be numbered.
+* @param	: sparse *Q: the matrix.
+* @return	: TRUE if P is a lumping of Q.
+*/
+BOOL part_is_stable(/*@observer@*/ /*@i1@*/ /*@null@*/ const partition * P,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const sparse * Q)
+{
+        signatures sig;
+        state_index s;
+        BOOL stable = TRUE;
+
+        if ( part_is_invalid(P) || NULL == Q
+                        || part_unlumped_state_space_size_nt(P) != mtx_rows(Q)
+                        || err_state_iserror(alloc_signatures(&sig, Q,
+                                        NULL != lump_impulse_rewards())) )
+        {
+                return FALSE;
+        }
+        compute_signatures(P, Q, lump_impulse_rewards(), lump_is_weak(), &sig);
+        for ( s = 0 ; s < mtx_rows(Q) && stable ; s++ ) {
+                stable = same_signature(&sig, s,
+                                part_unlump_state_block_nt(P, block_of(P, s)));
+        }
+        free_signatures(&sig);
+        return stable;
+}
+
+
+/**
+* The cached quotient for formula-dependent lumping: base_P is the coarsest
+* stable partition of base_space that respects the labelling base_labels, the
+* state rewards base_rewards and the impulse rewards base_impulse; base_Q is
+* the corresponding lumped matrix and base_Q_impulse the lumped impulse
+* rewards. The cache is valid as long as these four pointers and base_weak do
+* not change and base_space still has the fingerprint base_fingerprint (see
+* get_fingerprint()), since a freed matrix may be reallocated at the same
+* address.
+*/
+static /*@null@*/ /*@dependent@*/ const sparse * base_space = NULL;
+static unsigned long base_fingerprint = 0;
+static /*@null@*/ /*@dependent@*/ const labelling * base_labels = NULL;
+static /*@null@*/ /*@dependent@*/ const double * base_rewards = NULL;
+static /*@null@*/ /*@dependent@*/ const sparse * base_impulse = NULL;
+static BOOL base_weak = FALSE;
+static /*@null@*/ /*@only@*/ partition * base_P = NULL;
+static /*@null@*/ /*@only@*/ sparse * base_Q = NULL;
+static /*@null@*/ /*@only@*/ sparse * base_Q_impulse = NULL;
+
+
+/**
+* This method frees the cached quotient used by lump_formula().
+*/
+void free_lump_cache(void)
+{
+        if ( NULL != base_Q_impulse ) {
+                (void) free_sparse_ncolse(base_Q_impulse);
+                base_Q_impulse = NULL;
+        }
+        if ( NULL != base_Q ) {
+                (void) free_sparse_ncolse(base_Q);
+                base_Q = NULL;
+        }
+        if ( NULL != base_P ) {
+                (void) free_partition(base_P);
+                base_P = NULL;
+        }
+        base_space = NULL;
+        base_fingerprint = 0;
+        base_labels = NULL;
+        base_rewards = NULL;
+        base_impulse = NULL;
+        base_weak = FALSE;
+}
+
+
+/**
+* The function computes a hash value of the size and all the entries of Q, to
+* tell apart two matrices that were allocated at the same address.
+*/
+static unsigned long get_fingerprint(/*@observer@*/ const sparse * Q)
+{
+        unsigned long hash = 2166136261UL;
+        unsigned char bytes[sizeof(double)];
+        size_t i;
+
+        hash = (hash ^ (unsigned long) mtx_rows(Q)) * 16777619UL;
+        hash = (hash ^ (unsigned long) mtx_cols(Q)) * 16777619UL;
+        mtx_walk_all(Q, row, col, val) {
+                hash = (hash ^ (unsigned long) row) * 16777619UL;
+                hash = (hash ^ (unsigned long) col) * 16777619UL;
+                memcpy(bytes, &val, sizeof(double));
+                for ( i = 0 ; i < sizeof(double) ; i++ ) {
+                        hash = (hash ^ bytes[i]) * 16777619UL;
+                }
+        } end_mtx_walk_all;
+        return hash;
+}
+
+
+/**
+* The function makes sure that the cached quotient belongs to Q and the current
+* labelling, state rewards and impulse rewards; it lumps Q if necessary.
+* Result: TRUE if the cached quotient can be used.
+*/
+static BOOL get_base_quotient(/*@observer@*/ const sparse * Q)
+{
+        const labelling * labellin = get_labeller();
+        const double * rewards = getStateRewards();
+        const sparse * rewi = lump_impulse_rewards();
+
+        if ( NULL != base_Q && Q == base_space && labellin == base_labels
+                        && rewards == base_rewards && rewi == base_impulse
+                        && lump_is_weak() == base_weak
+                        && get_fingerprint(Q) == base_fingerprint )
+        {
+                return TRUE;
+        }
+        free_lump_cache();
+        if ( NULL == labellin || labellin->ns != mtx_rows(Q) ) {
+                return FALSE;
+        }
+        printf("Lumping: Computing the quotient w.r.t. the labelling.\n");
+        if ( (base_P = init_partition(labellin)) == NULL
+                        || (base_Q = lump(base_P, Q)) == NULL
+                        || (NULL != rewi && (base_Q_impulse =
+                                change_impulse_rewards(rewi, base_P, Q))
+                                                                == NULL) )
+        {
+                free_lump_cache();
+                return FALSE;
+        }
+        base_space = Q;
+        base_fingerprint = get_fingerprint(Q);
+        base_labels = labellin;
+        base_rewards = rewards;
+        base_impulse = rewi;
+        base_weak = lump_is_weak();
+        return TRUE;
+}
+
+
+/**
+* This internal subroutine of lump_formula() refines the cached quotient for the
+* formula and composes the two partitions. If phi and psi are unions of blocks
+* of the cached partition, this partition is stable and respects the formula,
+* so it refines the coarsest lumpable partition for the formula. Lumping the
+* quotient further therefore yields the same partition as lump() on Q, up to
+* the numbering of the blocks.
+* Result: the lumped matrix and (in *pP) the partition of Q; NULL if phi or psi
+* are not unions of blocks of the cached quotient or some error happened.
+*/
+static /*@only@*/ /*@null@*/ sparse * lump_formula_from_base(
+                /*@out@*/ partition ** pP, /*@observer@*/ const sparse * Q,
+                /*@observer@*/ const bitset * phi,
+                /*@observer@*/ const bitset * psi, BOOL interval)
+{
+        /*@only@*/ /*@null@*/ bitset * lumped_phi = NULL, * lumped_psi = NULL;
+        /*@only@*/ /*@null@*/ double * lumped_rewards = NULL;
+        /*@only@*/ /*@null@*/ partition * P1 = NULL;
+        /*@only@*/ /*@null@*/ sparse * Q1 = NULL;
+        /*@only@*/ /*@null@*/ state_index * number = NULL;
+        /*@dependent@*/ /*@null@*/ double * p_old_rew = getStateRewards();
+        /*@dependent@*/ /*@null@*/ sparse * p_old_rewi;
+        state_index i;
+
+        *pP = NULL;
+        if ( ! get_base_quotient(Q) || ! part_respects_bitset(base_P, phi)
+                        || ! part_respects_bitset(base_P, psi) )
+        {
+                return NULL;
+        }
+
+        /* The initial partition of the quotient is refined by the lumped */
+        /* state and impulse rewards, so we temporarily switch to them. */
+        if ( (lumped_phi = lump_bitset(base_P, phi)) == NULL
+                        || (lumped_psi = lump_bitset(base_P, psi)) == NULL
+                        || (NULL != p_old_rew && (lumped_rewards =
+                                change_state_rewards(p_old_rew, base_P))
+                                                                == NULL) )
+        {
+                err_msg_5(err_CALLBY, "lump_formula_from_base(%p,%p,%p,%p,%d)",
+                                (void *) pP, (const void *) Q,
+                                (const void *) phi, (const void *) psi,
+                                (int) interval,
+                                (free(lumped_rewards), (void) (NULL ==
+                                lumped_psi || free_bitset(lumped_psi)),
+                                (void) (NULL == lumped_phi
+                                || free_bitset(lumped_phi)), NULL));
+        }
+        setStateRewards(lumped_rewards);
+        p_old_rewi = exchangeImpulseRewards(base_Q_impulse);
+        P1 = init_partition_formula(lumped_phi, lumped_psi, interval);
+        if ( NULL != P1 ) {
+                Q1 = lump(P1, base_Q);
+        }
+        (void) exchangeImpulseRewards(p_old_rewi);
+        setStateRewards(p_old_rew);
+        free(lumped_rewards);
+        (void) free_bitset(lumped_psi);
+        (void) free_bitset(lumped_phi);
+
+        /* compose the two partitions; the blocks keep the numbers of P1 */
+        if ( NULL == Q1 || (number = (state_index *) calloc((size_t)
+                                        mtx_rows(Q), sizeof(state_index)))
+                                                == NULL )
+        {
+                err_msg_5(err_CALLBY, "lump_formula_from_base(%p,%p,%p,%p,%d)",
+                                (void *) pP, (const void *) Q,
+                                (const void *) phi, (const void *) psi,
+                                (int) interval, ((void) (NULL == Q1
+                                || free_sparse_ncolse(Q1)), (void) (NULL == P1
+                                || free_partition(P1)), NULL));
+        }
+        for ( i = 0 ; i < mtx_rows(Q) ; i++ ) {
+                number[i] = part_lump_state_id_nt(P1,
+                                part_lump_state_id_nt(base_P, i));
+        }
+        if ( (*pP = part_from_block_numbers(number, mtx_rows(Q), mtx_rows(Q1)))
+                                                                == NULL )
+        {
+                err_msg_5(err_CALLBY, "lump_formula_from_base(%p,%p,%p,%p,%d)",
+                                (void *) pP, (const void *) Q,
+                                (const void *) phi, (const void *) psi,
+                                (int) interval, (free(number),
+                                (void) free_sparse_ncolse(Q1),
+                                (void) free_partition(P1), NULL));
+        }
+        free(number);
+        part_walk_blocks(*pP, B) {
+                B->flags = block_of(P1, part_lump_state_id_nt(base_P,
+                                part_unlump_state_block_nt(*pP, B)))->flags
+                                                                & ABSORBING;
+        } end_part_walk_blocks;
+        (void) free_partition(P1);
+        return Q1;
+}
+
+
+/**
+* This method computes the lumped matrix for formula-dependent lumping, i.e. it
+* replaces the sequence init_partition_formula(phi, psi, interval); lump(P, Q).
+* If is_lump_reuse_on(), the quotient of Q w.r.t. the labelling is computed once
+* and cached; each formula then only refines this (smaller) quotient. Otherwise,
+* or if phi or psi do not respect the cached quotient, Q is lumped directly.
+* @param	: partition **pP: returns the partition; NULL on error.
+* @param	: sparse *Q: The matrix to lump.
+* @param	: bitset *phi, *psi, BOOL interval: see init_partition_formula().
+* @return	: The lumped matrix.
+*/
+/*@only@*/ /*@null@*/ sparse * lump_formula(/*@out@*/ partition ** pP,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const sparse * Q,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const bitset * phi,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const bitset * psi,
+                BOOL interval)
+{
+        sparse * res = NULL;
+
+        if ( NULL == pP || NULL == Q || NULL == phi || NULL == psi ) {
+                err_msg_5(err_PARAM, "lump_formula(%p,%p,%p,%p,%d)",
+                                (void *) pP, (const void *) Q,
+                                (const void *) phi, (const void *) psi,
+                                (int) interval, NULL);
+        }
+        if ( is_lump_reuse_on() && (res = lump_formula_from_base(pP, Q, phi,
+                                                psi, interval)) != NULL )
+        {
+                return res;
+        }
+        if ( (*pP = init_partition_formula(phi, psi, interval)) == NULL
+                        || (res = lump(*pP, Q)) == NULL )
+        {
+                err_msg_5(err_CALLBY, "lump_formula(%p,%p,%p,%p,%d)",
+                                (void *) pP, (const void *) Q,
+                                (const void *) phi, (const void *) psi,
+                                (int) interval, ((void) (NULL == *pP
+                                || free_partition(*pP)), *pP = NULL, NULL));
+        }
+        return res;
+}
+
+
 /**
 * The function allocates a new sparse matrix that contains the lumped transition
 * matrix, based on the partition and the original transition matrix.
 * The function assumes that the blocks in the partition have been duly numbered
 * (by calling part_number_blocks()).
+* For weak bisimulation, the internal transitions are left out, as their rates
+* may differ between the states of a block.
 */
 static /*@only@*/ /*@null@*/ sparse *calculate_lumped_probabilities(partition*P,
                 /*@observer@*/ const sparse * Q)
@@ -415,6 +1387,8 @@ static /*@only@*/ /*@null@*/ sparse *calculate_lumped_probabilities(partition*P,
         state_index xi, row;
         /*@only@*/ /*@null@*/ int * ncolse, * L1;
         /*@only@*/ /*@null@*/ sparse * Q1 = NULL;
+        const sparse * rewi = lump_impulse_rewards();
+        const BOOL weak = lump_is_weak();
 
         n = part_lumped_state_space_size_nt(P);
         /* The following code is taken mostly from the old lump() routine. */
@@ -486,6 +1460,13 @@ static /*@only@*/ /*@null@*/ sparse *calculate_lumped_probabilities(partition*P,
                 xi = part_unlump_state_block_nt(P, B);
 		/* line 10-12 */
                 mtx_walk_row(Q, (const int) xi, col, val) {
+                        /*@-realcompare@*/
+                        if ( weak && part_lump_state_id_nt(P, col) == row
+                                        && 0.0 == impulse_of(rewi, xi, col) )
+                        /*@=realcompare@*/
+                        {
+                                continue;
+                        }
                         if ( err_state_iserror(add_mtx_val_ncolse(Q1, row,
                                         part_lump_state_id_nt(P, col), val)) )
                         {
@@ -658,6 +1639,144 @@ err_state change_labelling(/*@i1@*/ /*@null@*/ labelling * labellin,
 }
 
 
+/**
+* This method computes the impulse rewards of the lumped model. The impulse
+* reward of the lumped transition from block B to block C is the impulse reward
+* of the transitions from an arbitrary state of B to the states in C; the
+* partition has to be computed by lump() while the impulse rewards were set
+* (see getImpulseRewards()).
+* A lumped transition only carries one impulse reward. If the transitions from
+* a state of B to C earn different impulse rewards, the impulse rewards cannot
+* be lumped and the method returns NULL without an error message.
+* NOTE:		We do not free the old impulse rewards structure because
+*		it should be done on the outer level.
+* @param	: sparse *rewi: the impulse rewards of the original model.
+* @param	: partition *P: the partition.
+* @param	: sparse *Q: the original transition matrix.
+* @return	: The impulse rewards after lumping or NULL.
+*/
+/*@only@*/ /*@null@*/ sparse * change_impulse_rewards(
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const sparse * rewi,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const partition * P,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const sparse * Q)
+{
+        state_count n;
+        state_index xi, row;
+        /*@only@*/ /*@null@*/ int * ncolse, * L1;
+        /*@only@*/ /*@null@*/ double * imp;
+        /*@only@*/ /*@null@*/ sparse * rewi1 = NULL;
+        const BOOL weak = lump_is_weak();
+        BOOL conflict = FALSE;
+
+        if ( NULL == rewi || part_is_invalid(P) || NULL == Q
+                        || part_unlumped_state_space_size_nt(P) != mtx_rows(Q)
+                        || mtx_rows(rewi) != mtx_rows(Q) )
+        {
+                err_msg_3(err_PARAM, "change_impulse_rewards(%p,%p,%p)",
+                                (const void *) rewi, (const void *) P,
+                                (const void *) Q, NULL);
+        }
+        n = part_lumped_state_space_size_nt(P);
+
+        /* L1[c] is the last row that has a transition to block c, and imp[c]
+           the impulse reward of this transition */
+        L1 = (int *) calloc((size_t) n, sizeof(int));
+        ncolse = (int *) calloc((size_t) n, sizeof(int));
+        imp = (double *) calloc((size_t) n, sizeof(double));
+        if ( NULL == L1 || NULL == ncolse || NULL == imp ) {
+                err_msg_3(err_MEMORY, "change_impulse_rewards(%p,%p,%p)",
+                                (const void *) rewi, (const void *) P,
+                                (const void *) Q,
+                                (free(imp), free(ncolse), free(L1), NULL));
+        }
+        memset(L1, -1, n * sizeof(int));
+        part_walk_blocks(P, B) {
+                if ( 0 != test_flag((unsigned) B->flags, ABSORBING) ) {
+                        continue;
+                }
+                xi = part_unlump_state_block_nt(P, B);
+                row = part_lump_state_block_nt(P, B);
+                mtx_walk_row(Q, (const int) xi, col, val) {
+                        const state_index c = part_lump_state_id_nt(P, col);
+                        const double r = impulse_of(rewi, xi, col);
+
+                        /*@-noeffect@*/ (void) val; /*@=noeffect@*/
+                        /*@-realcompare@*/
+                        if ( weak && c == row && 0.0 == r ) {
+                                continue;
+                        }
+                        if ( L1[c] != row ) {
+                                L1[c] = row;
+                                imp[c] = r;
+                                if ( 0.0 != r && c != row ) {
+                                        ++ncolse[row];
+                                }
+                        } else if ( imp[c] != r ) {
+                                conflict = TRUE;
+                        }
+                        /*@=realcompare@*/
+                } end_mtx_walk_row;
+        } end_part_walk_blocks;
+        if ( conflict ) {
+                printf("Lumping: The impulse rewards cannot be lumped, "
+                        "transitions between two blocks earn different "
+                        "impulse rewards.\n");
+                free(imp);
+                free(ncolse);
+                free(L1);
+                return NULL;
+        }
+
+        rewi1 = allocate_sparse_matrix_ncolse(n, n, ncolse);
+        free(ncolse);
+        if ( NULL == rewi1 ) {
+                err_msg_3(err_MEMORY, "change_impulse_rewards(%p,%p,%p)",
+                                (const void *) rewi, (const void *) P,
+                                (const void *) Q, (free(imp), free(L1), NULL));
+        }
+        memset(L1, -1, n * sizeof(int));
+        part_walk_blocks(P, B) {
+                if ( 0 != test_flag((unsigned) B->flags, ABSORBING) ) {
+                        continue;
+                }
+                xi = part_unlump_state_block_nt(P, B);
+                row = part_lump_state_block_nt(P, B);
+                mtx_walk_row(Q, (const int) xi, col, val) {
+                        const state_index c = part_lump_state_id_nt(P, col);
+
+                        /*@-noeffect@*/ (void) val; /*@=noeffect@*/
+                        if ( L1[c] == row ) {
+                                continue;
+                        }
+                        L1[c] = row;
+                        if ( err_state_iserror(set_mtx_val_ncolse(rewi1, row,
+                                        c, impulse_of(rewi, xi, col))) )
+                        {
+                                err_msg_3(err_CALLBY, "change_impulse_rewards("
+                                                "%p,%p,%p)", (const void *)rewi,
+                                                (const void *) P,
+                                                (const void *) Q, (free(imp),
+                                                free(L1), (void)
+                                                free_sparse_ncolse(rewi1),
+                                                NULL));
+                        }
+                } end_mtx_walk_row;
+                /* order row by column index */
+                if ( 1 < mtx_next_num(rewi1, row) ) {
+                        /*@-type@*/
+                        /* sparse matrix internals used */
+                        quicksort(rewi1->valstruc[row].col,
+                                        rewi1->valstruc[row].val, 0,
+                                        mtx_next_num(rewi1, row) - 1);
+                        /*@=type@*/
+                }
+        } end_part_walk_blocks;
+        free(imp);
+        free(L1);
+        return rewi1;
+}
+
+
 /*****************************************************************************
 name		: unlump_vector
 role		: unlump a probability vector with respect to the partition.
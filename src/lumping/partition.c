@@ -53,12 +53,89 @@
 #include <errno.h>
 #include <string.h>
 
+static void part_release(/*@only@*/ /*@null@*/ partition * P)
+                /*@modifies P@*/;
+
+/**
+* The function takes a block from the block pool of the partition. Released
+* blocks are reused first; otherwise the next unused block of the last chunk is
+* taken, and a new chunk is allocated when the last chunk is full.
+* Parameter: P = partition
+* Result: a pointer to the block (with B->idx set); NULL if some error has
+* happened.
+*/
+static /*@dependent@*/ /*@null@*/ block * part_alloc_block(partition * P)
+                /*@modifies P->pool, P->pool_chunks, P->pool_used,
+                        P->pool_free@*/
+{
+        /*@dependent@*/ block * B;
+        state_count chunk;
+
+        if ( NULL != P->pool_free ) {
+                B = P->pool_free;
+                P->pool_free = B->next;
+                return B;
+        }
+        chunk = P->pool_used >> PART_POOL_CHUNK_BITS;
+        /* the chunk may already exist if part_number_blocks() has shrunk
+           the pool */
+        if ( 0 == (P->pool_used & (PART_POOL_CHUNK - 1))
+                        && (chunk >= P->pool_chunks || NULL == P->pool[chunk]) )
+        {
+                if ( chunk >= P->pool_chunks ) {
+                        /* enlarge the array of chunks */
+                        /*@null@*/ block ** pool = (block **) realloc(P->pool,
+                                        2 * (size_t) P->pool_chunks
+                                                        * sizeof(block *));
+                        if ( NULL == pool ) {
+                                err_msg_1(err_MEMORY, "part_alloc_block(%p)",
+                                                (void *) P, NULL);
+                        }
+                        memset(&pool[P->pool_chunks], 0, (size_t)
+                                        P->pool_chunks * sizeof(block *));
+                        P->pool = pool;
+                        P->pool_chunks *= 2;
+                }
+                P->pool[chunk] = (block *) malloc(PART_POOL_CHUNK
+                                                        * sizeof(block));
+                if ( NULL == P->pool[chunk] ) {
+                        err_msg_1(err_MEMORY, "part_alloc_block(%p)",
+                                        (void *) P, NULL);
+                }
+        }
+        B = &P->pool[chunk][P->pool_used & (PART_POOL_CHUNK - 1)];
+        B->idx = P->pool_used++;
+        return B;
+}
+
+
+/**
+* This method returns the block to the block pool of the partition.
+* @param	: partition *P: The partition.
+* @param	: block *B: The block.
+*/
+err_state part_free_block(/*@i1@*/ /*@null@*/ partition * P,
+                /*@dependent@*/ /*@i1@*/ /*@null@*/ block * B)
+{
+        if ( part_is_invalid(P) || NULL == B || B->idx < 0
+                        || B->idx >= P->pool_used
+                        || part_block_nt(P, B->idx) != B )
+        {
+                err_msg_2(err_PARAM, "part_free_block(%p,%p)", (void *) P,
+                                (void *) B, err_ERROR);
+        }
+        B->next = P->pool_free;
+        P->pool_free = B;
+        return err_OK;
+}
+
+
 /*****************************************************************************
 * The function splits a block into two parts. It creates a new block and moves
-* the states in ib[begin(B) ... pos-1].id to the new block. The new block may
+* the states in id[begin(B) ... pos-1] to the new block. The new block may
 * be empty, but it is an error if the old block becomes empty. It also is an
 * error if the block was absorbing.
-* The function does not change the block pointers P->ib[...].b.
+* The function does not change the block pointers P->b[...].
 * Parameters:   P = partition
 *               B_old = block
 *               pos = position where the block has to be split.
@@ -81,7 +158,7 @@
                                 (void *) B_old, pos, NULL);
         }
 
-        b = malloc(sizeof(block));
+        b = part_alloc_block(P);
 	if(b == NULL){
                 err_msg_3(err_MEMORY, "part_split_block(%p,%p,%d)", (void *) P,
                                 (void *) B_old, pos, NULL);
@@ -337,6 +414,42 @@ err_state print_state_prob_partition(/*@observer@*/ const partition * P,
 }
 
 
+/**
+* The function allocates a new partition without blocks: the arrays P->id and
+* P->b are allocated (but not initialised), and the block pool is empty.
+* Parameter: size = number of states to be members of the partition
+* Result: Pointer to a new partition; NULL if some error has happened.
+*/
+static /*@null@*/ /*@only@*/ partition * part_alloc(state_count size)
+                /*@modifies internalState@*/
+{
+        /*@null@*/ /*@only@*/ partition * P = malloc(sizeof(partition));
+        /* the pool does not need more chunks than there are states */
+        state_count chunks = (size >> PART_POOL_CHUNK_BITS) + 1;
+
+        if ( NULL == P ) {
+                err_msg_1(err_MEMORY, "part_alloc(%d)", size, NULL);
+        }
+        P->id = (state_index *) malloc(2 * (size_t) size * sizeof(state_index));
+        P->pool = (block **) calloc((size_t) chunks, sizeof(block *));
+        if ( NULL == P->id || NULL == P->pool ) {
+                err_msg_1(err_MEMORY, "part_alloc(%d)", size,
+                                (free(P->pool), free(P->id), free(P), NULL));
+        }
+        P->b = P->id + size;
+        P->pool_chunks = chunks;
+        P->pool_used = 0;
+        P->pool_free = NULL;
+        P->blocks = NULL;
+        P->first_Sp = NULL;
+        P->first_PredCl = NULL;
+        P->num_blocks /* lumped size */ = 0;
+        P->sum = NULL;
+        P->pos = NULL;
+        return P;
+}
+
+
 /**
 * The function creates a new partition with a single block. The block is NOT
 * inserted into the list of potential splitters.
@@ -347,38 +460,26 @@ static /*@null@*/ /*@only@*/ partition * part_new(state_count size)
                 /*@ensures notnull result->blocks@*/
                 /*@ensures isnull result->first_Sp, result->first_PredCl,
                         result->sum, result->pos@*/
-                /*@ensures maxRead(result->blocks) == 1 /\
-                        maxRead(result->ib) == size@*/
-                /*@defines result->blocks, result->first_Sp,
-                        result->first_PredCl, result->num_blocks, result->sum,
-                        result->pos, result->ib[0]@*/
                 /*@modifies internalState@*/
 {
         pos_index i;
-        /*@null@*/ /*@only@*/ partition * P = malloc(sizeof(partition)
-                        - sizeof(struct id_block)
-                        + sizeof(struct id_block) * size);
-        /*@null@*/ /*@only@*/ block * B = malloc(sizeof(block));
-        if ( NULL == P || NULL == B ) {
+        /*@null@*/ /*@only@*/ partition * P = part_alloc(size);
+        /*@null@*/ /*@dependent@*/ block * B = NULL;
+
+        if ( NULL == P || (B = part_alloc_block(P)) == NULL ) {
                 err_msg_1(err_MEMORY, "part_new(%d)", size,
-                                (free(B), free(P), NULL));
+                                (part_release(P), NULL));
         }
         B->next = NULL;
         B->u.next_Sp = NULL;
         B->end = size;
         B->flags = 0;
 
-        P->first_Sp = NULL;
-        P->first_PredCl = NULL;
         P->num_blocks /* lumped size */ = 1;
-        P->sum = NULL;
-        P->pos = NULL;
         P->blocks = B;
-        P->ib[0].id = 0;
-        P->ib[0].b = B;
-        for ( i = 1 ; i < size ; i++ ) {
-                P->ib[i].id = i;
-                P->ib[i].b = B;
+        for ( i = 0 ; i < size ; i++ ) {
+                P->id[i] = i;
+                P->b[i] = B->idx;
         }
         return P;
 }
@@ -390,14 +491,14 @@ static /*@null@*/ /*@only@*/ partition * part_new(state_count size)
 * Parameters: P = partition to be split
 *       B = block to be split
 *       bs = bitset that indicates how to split
-* Result: the array P->ib[].id is sorted: P->ib[begin(B) ... return value-1].id
-* is not in the bitset; P->ib[return value ... end(B)-1].id is in the
+* Result: the array P->id[] is sorted: P->id[begin(B) ... return value-1]
+* is not in the bitset; P->id[return value ... end(B)-1] is in the
 * bitset. If some error happens, the function returns state_index_ERROR.
 */
 static pos_index block_sort_bitset(partition * P, block * B,
                 /*@observer@*/ const bitset * bs)
                 /*@requires notnull P->blocks@*/
-                /*@requires isnull P->pos@*/ /*@modifies P->ib[].id@*/
+                /*@requires isnull P->pos@*/ /*@modifies P->id[]@*/
 {
         pos_index left, right;
         state_index temp;
@@ -410,35 +511,35 @@ static pos_index block_sort_bitset(partition * P, block * B,
            only split into two parts. */
         do {
                 /* left <= right;
-                   ib[block_begin(B) ... left-1].id are NOT in bs;
-                   ib[right+1 ... block_end(B)-1].id are in bs. */
-                while ( ! get_bit_val(bs, P->ib[left ].id) ) {
-                        /* ib[block_begin(B) ... left].id are NOT in bs; */
+                   id[block_begin(B) ... left-1] are NOT in bs;
+                   id[right+1 ... block_end(B)-1] are in bs. */
+                while ( ! get_bit_val(bs, P->id[left ]) ) {
+                        /* id[block_begin(B) ... left] are NOT in bs; */
                         ++left;
                         if ( left > right )
                                 return left;
                 }
                 /* left <= right;
-                   ib[begin(B) ... left-1].id are NOT in bs;
-                   ib[left].id is in bs;
-                   ib[right+1 ... end(B)-1].id are in bs. */
+                   id[begin(B) ... left-1] are NOT in bs;
+                   id[left] is in bs;
+                   id[right+1 ... end(B)-1] are in bs. */
                 do {
                         if ( left >= right )
                                 return left;
-                        if ( ! get_bit_val(bs, P->ib[right].id) )
+                        if ( ! get_bit_val(bs, P->id[right]) )
                                 break;
-                        /* ib[right ... block_end(B)-1].id are in bs. */
+                        /* id[right ... block_end(B)-1] are in bs. */
                         --right;
                 } while ( TRUE );
                 /* left < right;
-                   ib[block_begin(B) ... left-1].id are NOT in bs;
-                   ib[left].id is in bs;
-                   ib[right].id is NOT in bs;
-                   ib[right+1 ... block_end(B)-1].id are in bs. */
-                /* Now swap the states at ib[left].id and ib[right].id. */
-                temp = P->ib[left].id;
-                P->ib[left ].id = P->ib[right].id;
-                P->ib[right].id = temp;
+                   id[block_begin(B) ... left-1] are NOT in bs;
+                   id[left] is in bs;
+                   id[right] is NOT in bs;
+                   id[right+1 ... block_end(B)-1] are in bs. */
+                /* Now swap the states at id[left] and id[right]. */
+                temp = P->id[left];
+                P->id[left ] = P->id[right];
+                P->id[right] = temp;
                 ++left, --right;
         } while ( left <= right );
         return left;
@@ -453,7 +554,7 @@ static /*@dependent@*/ /*@null@*/ block * part_split_and_adapt_block(
                 partition * P, block * B, pos_index pos)
                 /*@requires notnull P->blocks@*/
                 /*@requires isnull P->pos@*/
-                /*@modifies B->next, P->num_blocks, P->ib[].b@*/
+                /*@modifies B->next, P->num_blocks, P->b[]@*/
 {
         pos_index i;
         /*@dependent@*/ block * B_new;
@@ -465,7 +566,7 @@ static /*@dependent@*/ /*@null@*/ block * part_split_and_adapt_block(
         }
 
         for ( ; i < pos ; i++ ) {
-                P->ib[P->ib[i].id].b = B_new;
+                P->b[P->id[i]] = B_new->idx;
         }
         return B_new;
 }
@@ -480,7 +581,7 @@ static /*@dependent@*/ /*@null@*/ block * part_split_and_adapt_block(
 static err_state part_sort_bitset(partition *P, /*@observer@*/ const bitset *bs)
                 /*@requires notnull P->blocks@*/
                 /*@requires isnull P->pos@*/
-                /*@modifies P->ib, P->num_blocks, *P->blocks@*/
+                /*@modifies P->id, P->b, P->num_blocks, *P->blocks@*/
 {
         part_walk_blocks(P, b) {
                 if ( 0 == (b->flags & ABSORBING) ) {
@@ -589,7 +690,7 @@ err_state part_refine_rewards(/*@i1@*/ /*@null@*/ partition * P,
                                 (free_partition(P), NULL));
         }
         for ( i = 1 ; i < size ; i++ ) {
-                P->pos[P->ib[i].id] = i;
+                P->pos[P->id[i]] = i;
                 /* calloc() already does the 0-th iteration through this loop */
         }
 
@@ -721,7 +822,7 @@ err_state part_refine_rewards(/*@i1@*/ /*@null@*/ partition * P,
                                 (int) interval, (free_partition(P), NULL));
         }
         for ( i = 1 ; i < size ; i++ ) {
-                P->pos[P->ib[i].id] = i;
+                P->pos[P->id[i]] = i;
                 /* calloc() already does the 0-th iteration through this loop */
         }
 
@@ -740,43 +841,181 @@ err_state part_refine_rewards(/*@i1@*/ /*@null@*/ partition * P,
 }
 
 
+/**
+* The function creates a partition from an array that assigns a block number to
+* every state, e.g. a partition that has been read from a file or a partition
+* that is composed of two lumping steps. Block i gets the number i (in u.row),
+* so that the partition can be used directly to compute the lumped matrix. No
+* block is absorbing and P->pos is NULL.
+* Parameters: number = array with number[s] = block of state s, where every
+*               number in 0 ... num_blocks - 1 has to be used at least once
+*       size = number of states
+*       num_blocks = number of blocks
+* Result: Pointer to a new partition; NULL if some error has happened.
+*/
+/*@only@*/ /*@null@*/ partition * part_from_block_numbers(
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const state_index * number,
+                state_count size, state_count num_blocks)
+{
+        /*@only@*/ /*@null@*/ partition * P = NULL;
+        /*@only@*/ /*@null@*/ pos_index * end = NULL;
+        /*@dependent@*/ /*@null@*/ block * B = NULL;
+        state_index i;
+
+        if ( NULL == number || size <= 0 || num_blocks <= 0
+                                                || num_blocks > size )
+        {
+                err_msg_3(err_PARAM, "part_from_block_numbers(%p,%d,%d)",
+                                (const void *) number, size, num_blocks, NULL);
+        }
+        P = part_alloc(size);
+        end = (pos_index *) calloc((size_t) num_blocks, sizeof(pos_index));
+        if ( NULL == P || NULL == end ) {
+                err_msg_3(err_MEMORY, "part_from_block_numbers(%p,%d,%d)",
+                                (const void *) number, size, num_blocks,
+                                (free(end), part_release(P), NULL));
+        }
+
+        /* count the states per block; end[i] becomes the end of block i */
+        for ( i = 0 ; i < size ; i++ ) {
+                if ( number[i] < 0 || number[i] >= num_blocks ) {
+                        err_msg_3(err_PARAM, "part_from_block_numbers(%p,%d,"
+                                        "%d)", (const void *) number, size,
+                                        num_blocks,
+                                        (free(end), part_release(P), NULL));
+                }
+                end[number[i]]++;
+        }
+        /* The pool of the new partition hands out the blocks in order, so
+           block i gets the pool index i. The list of blocks is ordered by
+           decreasing end. */
+        for ( i = 0 ; i < num_blocks ; i++ ) {
+                const char * error_str = 0 == end[i] ? err_PARAM : err_MEMORY;
+                /*@dependent@*/ /*@null@*/ block * prev = B;
+
+                if ( 0 == end[i] || (B = part_alloc_block(P)) == NULL ) {
+                        err_msg_3(error_str,
+                                        "part_from_block_numbers(%p,%d,%d)",
+                                        (const void *) number, size, num_blocks,
+                                        (free(end), part_release(P), NULL));
+                }
+                if ( 0 < i ) {
+                        end[i] += end[i - 1];
+                }
+                B->next = prev;
+                B->u.row = i;
+                B->flags = 0;
+                B->end = end[i];
+        }
+
+        /* fill the blocks from their ends downwards */
+        for ( i = size ; i-- > 0 ; ) {
+                pos_index pos = --end[number[i]];
+                P->id[pos] = i;
+                P->b[i] = number[i];
+        }
+
+        P->blocks = B;
+        P->num_blocks /* lumped size */ = num_blocks;
+        free(end);
+        return P;
+}
+
+
+/**
+* The function frees the partition and all its blocks without checking it.
+*/
+static void part_release(/*@only@*/ /*@null@*/ partition * P)
+                /*@modifies P@*/
+{
+        state_count i;
+
+        if ( NULL == P ) {
+                return;
+        }
+        if ( NULL != P->pool ) {
+                for ( i = 0 ; i < P->pool_chunks ; i++ ) {
+                        free(P->pool[i]);
+                }
+                free(P->pool);
+        }
+        free(P->id);
+        free(P->pos);
+        free(P->sum);
+        free(P);
+}
+
+
 /*****************************************************************************
 name		: free_partition
 role		: This method frees the partition.
 @param		: partition *P: The partition.
 ******************************************************************************/
 err_state free_partition(/*@only@*/ /*@i1@*/ /*@null@*/ partition * P) {
-        /*@only@*/ block * B = NULL;
-
         if ( part_is_invalid(P) ) {
                 err_msg_1(err_PARAM, "free_partition(%p)", (void *) P,
                                 err_ERROR);
         }
+        part_release(P);
+        return err_OK;
+}
 
-	B = P->blocks;
-        do {
-                /*@only@*/ /*@null@*/ block *
-		next = B->next;
-                if ( err_state_iserror(free_block(B)) ) {
-                        /*@-mustfreeonly@*/
-                        err_msg_1(err_CALLBY, "free_partition(%p)", (void *) P,
-                                (free(P->pos),free(P->sum),free(P), err_ERROR));
-                        /*@=mustfreeonly@*/
-                }
-		B = next;
-	}
-        while ( NULL != B );
 
-        free(P->pos);
-        free(P->sum);
-	free(P);
+/**
+* The function moves every block of a numbered partition to the pool slot with
+* its number, so that afterwards P->b[s] is the number of the block of s and
+* part_lump_state_id_nt() needs no pointer access. The unused slots are dropped
+* from the pool (but their chunks are kept). Pointers to blocks become invalid.
+*/
+static err_state part_sort_pool(partition * P)
+                /*@requires notnull P->blocks@*/
+                /*@modifies *P@*/
+{
+        const state_count n = part_lumped_state_space_size_nt(P);
+        /*@only@*/ /*@null@*/ block * copy;
+        /*@only@*/ /*@null@*/ block_index * number;
+        state_index i, first;
+
+        copy = (block *) calloc((size_t) n, sizeof(block));
+        number = (block_index *) calloc((size_t) P->pool_used,
+                                                sizeof(block_index));
+        if ( NULL == copy || NULL == number ) {
+                err_msg_1(err_MEMORY, "part_sort_pool(%p)", (void *) P,
+                                (free(number), free(copy), err_ERROR));
+        }
+        /* copy[j].idx temporarily holds the number of the next block */
+        part_walk_blocks(P, B) {
+                copy[B->u.row] = *B;
+                copy[B->u.row].idx = NULL != B->next ? B->next->u.row
+                                                : state_index_NONE;
+                number[B->idx] = B->u.row;
+        } end_part_walk_blocks;
+        first = P->blocks->u.row;
+        for ( i = 0 ; i < n ; i++ ) {
+                block * B = part_block_nt(P, i);
+
+                *B = copy[i];
+                B->next = state_index_NONE != copy[i].idx
+                                ? part_block_nt(P, copy[i].idx) : NULL;
+                B->idx = i;
+        }
+        P->blocks = part_block_nt(P, first);
+        for ( i = 0 ; i < part_unlumped_state_space_size_nt(P) ; i++ ) {
+                P->b[i] = number[P->b[i]];
+        }
+        P->pool_used = n;
+        P->pool_free = NULL;
+        free(number);
+        free(copy);
         return err_OK;
 }
 
 
 /**
 * The function numbers the blocks in partition P. As many states as possible get
-* a number n such that state n is also a member of the block.
+* a number n such that state n is also a member of the block. Afterwards, every
+* block is stored in the pool slot with its number, so the block number of a
+* state can be read directly from P->b; pointers to blocks become invalid.
 * Parameter: P = partition
 * Result: err_OK if everything went fine; err_ERROR otherwise.
 */
@@ -800,7 +1039,7 @@ err_state part_number_blocks(/*@i1@*/ /*@null@*/ partition * P) {
                    of their member state with the smallest index. */
                 state_index num = 0;
                 for ( i = 0 ; i < part_unlumped_state_space_size_nt(P) ; i++ ) {
-                        if ( state_index_NONE == part_lump_state_id_nt(P, i) ) {
+                        if ( state_index_NONE == block_of(P, i)->u.row ) {
                                 block_of(P, i)->u.row = num;
                                 if ( ++num>=part_lumped_state_space_size_nt(P) )
                                 {
@@ -823,7 +1062,7 @@ err_state part_number_blocks(/*@i1@*/ /*@null@*/ partition * P) {
                 }
                 free_number = 0;
                 for ( i = 0 ; i < part_lumped_state_space_size_nt(P) ; i++ ) {
-                        if ( state_index_NONE == part_lump_state_id_nt(P, i) ) {
+                        if ( state_index_NONE == block_of(P, i)->u.row ) {
                                 block_of(P, i)->u.row = i;
                         } else {
                                 free_id[free_number++] = i;
@@ -835,7 +1074,7 @@ err_state part_number_blocks(/*@i1@*/ /*@null@*/ partition * P) {
                         for ( ; i < part_unlumped_state_space_size_nt(P) ; i++ )
                         {
                                 if ( state_index_NONE ==
-                                                part_lump_state_id_nt(P, i) )
+                                                block_of(P, i)->u.row )
                                 {
                                         block_of(P, i)->u.row = *used_id++;
                                         if ( --free_number <= 0 )
@@ -847,6 +1086,10 @@ err_state part_number_blocks(/*@i1@*/ /*@null@*/ partition * P) {
         }
 #       endif
 
+        if ( err_state_iserror(part_sort_pool(P)) ) {
+                err_msg_1(err_CALLBY, "part_number_blocks(%p)", (void *) P,
+                                err_ERROR);
+        }
         return err_OK;
 }
 
@@ -871,7 +1114,7 @@ static err_state print_block_states(/*@observer@*/ /*@temp@*/ const partition*P,
 {
         /*@only@*/ /*@null@*/ state_index * ssort;
         /*@dependent@*/ state_index * ssort_temp;
-        const struct id_block * id_temp;
+        const state_index * id_temp;
         pos_index j;
 
         /* create a sorted list of the states in block B */
@@ -882,11 +1125,11 @@ static err_state print_block_states(/*@observer@*/ /*@temp@*/ const partition*P,
                                 (const void *) P, (const void *) B, err_ERROR);
         }
         ssort_temp = ssort;
-        id_temp = &P->ib[part_block_begin_nt(B)];
+        id_temp = &P->id[part_block_begin_nt(B)];
         j = part_block_size_nt(B);
         printf("%d state%c: { ", j, 1 == j ? ' ' : 's');
         for ( ; j > 0 ; j-- ) {
-                *ssort_temp++ = id_temp++->id;
+                *ssort_temp++ = *id_temp++;
         }
         qsort(ssort, (size_t) part_block_size_nt(B), sizeof(state_index),
                         comp_state_index);
@@ -899,7 +1142,7 @@ static err_state print_block_states(/*@observer@*/ /*@temp@*/ const partition*P,
                         /* block_of is inconsistent */
                         (void) putchar('B');
                 }
-                if ( NULL != P->pos && P->ib[P->pos[ssort[j]]].id != ssort[j] ){
+                if ( NULL != P->pos && P->id[P->pos[ssort[j]]] != ssort[j] ){
                         /* pos is inconsistent */
                         (void) putchar('P');
                 }
@@ -1050,14 +1293,14 @@ err_state part_print_extended(const partition * P) {
                                         len1 = 0;
                                 }
                         }
-                        format_len = sprintf(&line1[len1],"%d",P->ib[i].id+1);
+                        format_len = sprintf(&line1[len1],"%d",P->id[i]+1);
                         if ( format_len > (int) sizeof(line1) - 1 - len1 ) {
                                 format_len = (int) sizeof(line1) - 1 - len1;
                         }
                         strncat(&line2[len1], space20,
                                         format_len - strlen(&line2[len1]));
                         len1 += format_len;
-                        if ( NULL != P->pos && P->pos[P->ib[i].id] != i ) {
+                        if ( NULL != P->pos && P->pos[P->id[i]] != i ) {
                                 line2[len1 - 1] = '*';
                         }
                 }
@@ -1092,9 +1335,9 @@ Another format to print the partition in detail:
         printf("States in the partition:\n");
         for ( i = 0 ; i < part_unlumped_state_space_size_nt(P) ; i++ ) {
                 pos_index pos_i = NULL == P->pos ? -1 : P->pos[i];
-                printf("State %d: pos=%d, block=%p, sum=%g, ib[pos[%d]].id==%d\n",
+                printf("State %d: pos=%d, block=%p, sum=%g, id[pos[%d]]==%d\n",
                                 i, pos_i, (const void *) block_of(P, i),
-                                P->sum[i], i, P->ib[pos_i].id);
+                                P->sum[i], i, P->id[pos_i]);
         }
         printf("Blocks in the partition:\n");
         i = part_lumped_state_space_size_nt(P);
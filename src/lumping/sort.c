@@ -51,12 +51,6 @@
 
 #include "runtime.h"
 
-/**
-* What is the maximum difference between two elements to put them into the same
-* equivalence class?
-*/
-#define EPSILON 3E-12
-
 /**
 * The function finds the median of 3 entries.
 * Parameters: P = partition
@@ -71,23 +65,23 @@ static pos_index median3_noerror(/*@observer@*/ /*@temp@*/ const partition * P,
                         /\ maxRead(key) >= c@*/
                 /*@modifies nothing@*/
 {
-        if( /*@-realcompare@*/ key[P->ib[a].id]==key[P->ib[b].id]
+        if( /*@-realcompare@*/ key[P->id[a]]==key[P->id[b]]
                                                         /*@=realcompare@*/ )
         {
                 return a;
         }
-        if ( key[P->ib[a].id] > key[P->ib[b].id] ) {
+        if ( key[P->id[a]] > key[P->id[b]] ) {
                 pos_index temp = a;
                 a = b;
                 b = temp;
         }
         /* a < b */
-        if ( key[P->ib[b].id] <= key[P->ib[c].id] ) {
+        if ( key[P->id[b]] <= key[P->id[c]] ) {
                 /* a < b <= c */
                 return b;
         }
         /* a < b and b > c */
-        if ( key[P->ib[a].id] <= key[P->ib[c].id] ) {
+        if ( key[P->id[a]] <= key[P->id[c]] ) {
                 /* a <= c < b */
                 return c;
         }
@@ -107,7 +101,7 @@ static pos_index median3_noerror(/*@observer@*/ /*@temp@*/ const partition * P,
 */
 static void find_pivot_noerror(partition * P, block * B,
                 /*@observer@*/ const double * key)
-                /*@requires notnull P->blocks@*/ /*@modifies P->ib[].id@*/;
+                /*@requires notnull P->blocks@*/ /*@modifies P->id[]@*/;
 
 static void find_pivot_noerror(partition * P, block * B,
                 /*@observer@*/ const double * key)
@@ -134,9 +128,9 @@ static void find_pivot_noerror(partition * P, block * B,
         }
         /* Now, pivot_middle contains the position of the pivot, and pivot_end
            its desired position. */
-        temp = P->ib[pivot_middle].id;
-        P->ib[pivot_middle].id = P->ib[pivot_end].id;
-        P->ib[pivot_end].id = temp;
+        temp = P->id[pivot_middle];
+        P->id[pivot_middle] = P->id[pivot_end];
+        P->id[pivot_end] = temp;
 }
 
 
@@ -152,7 +146,7 @@ static void find_pivot_noerror(partition * P, block * B,
 static state_index pass_file_noerror(partition * P, block * B,
                 /*@observer@*/ const double *key, /*@out@*/ state_index *middle)
                 /*@requires notnull P->blocks@*/
-                /*@modifies *middle, P->ib[].id@*/
+                /*@modifies *middle, P->id[]@*/
 {
         pos_index end, small, large;
         state_index id_small, id_large;
@@ -160,8 +154,8 @@ static state_index pass_file_noerror(partition * P, block * B,
 
         small = part_block_begin_nt(B);
         large = part_block_end_nt(B) - 1;
-        pivot_key_minus_epsilon = key[P->ib[large].id] - EPSILON;
-        pivot_key_plus_epsilon = key[P->ib[large].id] + EPSILON;
+        pivot_key_minus_epsilon = key[P->id[large]] - EPSILON;
+        pivot_key_plus_epsilon = key[P->id[large]] + EPSILON;
         /* begin(B) == small <= large == end(B) - 1
            key[id[large]] == pivot
            key[id[large+1]] ... key[id[end(B)-1]] is empty */
@@ -177,7 +171,7 @@ static state_index pass_file_noerror(partition * P, block * B,
                 /* begin(B) == small < large < end(B)
                    key[id[large]] ... key[id[end(B)-1]] == pivot */
                 --large;
-                id_large = P->ib[large].id;
+                id_large = P->id[large];
                 /* begin(B) == small <= large < end(B)
                    id_large == id[large]
                    key[id[large+1]] ... key[id[end(B)-1]] == pivot */
@@ -212,7 +206,7 @@ static state_index pass_file_noerror(partition * P, block * B,
                                    key[id[large]] ... key[id[end-1]] > pivot
                                    key[id[end]]...key[id[end(B)-1]] == pivot */
                                 --large;
-                                id_large = P->ib[large].id;
+                                id_large = P->id[large];
                                 /* begin(B) == small <= large < end <= end(B)
                                    id_large == id[large]
                                    key[id[large+1]] ... key[id[end-1]] > pivot
@@ -239,8 +233,8 @@ static state_index pass_file_noerror(partition * P, block * B,
                            key[id[large+1]] ... key[id[end]] > pivot
                            key[id[end+1]] ... key[id[end(B)-1]] == pivot */
                         /* Swap id[large] with id[end] */
-                        P->ib[large].id = P->ib[end].id;
-                        P->ib[end].id = id_large;
+                        P->id[large] = P->id[end];
+                        P->id[end] = id_large;
                         /* begin(B) == small <= large <= end < end(B)
                            key[id[large]] ... key[id[end-1]] > pivot
                            key[id[end]] ... key[id[end(B)-1]] == pivot */
@@ -270,7 +264,7 @@ static state_index pass_file_noerror(partition * P, block * B,
                                 *middle = small + 1;
                                 return end;
                         }
-                        id_small = P->ib[small].id;
+                        id_small = P->id[small];
                         /* begin(B) <= small < large < end <= end(B)
                            key[id[begin(B)]] ... key[id[small-1]] < pivot
                            id_small == id[small]
@@ -304,7 +298,7 @@ static state_index pass_file_noerror(partition * P, block * B,
                    key[id_large] < pivot
                    key[id[large+1]] ... key[id[end-1]] > pivot
                    key[id[end]] ... key[id[end(B)-1]] == pivot */
-                P->ib[small].id = id_large;
+                P->id[small] = id_large;
                 /* begin(B) <= small < large < end <= end(B)
                    key[id[begin(B)]] ... key[id[small]] < pivot
                    cur_key == key[id_small] >= pivot
@@ -325,14 +319,14 @@ static state_index pass_file_noerror(partition * P, block * B,
                            id[large] has to be overwritten
                            key[id[large+1]] ... key[id[end]] > pivot
                            key[id[end+1]] ... key[id[end(B)-1]] == pivot */
-                        P->ib[large].id = P->ib[end].id;
+                        P->id[large] = P->id[end];
                         /* begin(B) <= small < large <= end < end(B)
                            key[id[begin(B)]] ... key[id[small]] < pivot
                            key[id_small] == pivot
                            key[id[large]] ... key[id[end-1]] > pivot
                            id[end] has to be overwritten
                            key[id[end+1]] ... key[id[end(B)-1]] == pivot */
-                        P->ib[end].id = id_small;
+                        P->id[end] = id_small;
                         /* begin(B) <= small < large <= end < end(B)
                            key[id[begin(B)]] ... key[id[small]] < pivot
                            key[id[large]] ... key[id[end-1]] > pivot
@@ -344,7 +338,7 @@ static state_index pass_file_noerror(partition * P, block * B,
                            id[large] has to be overwritten
                            key[id[large+1]] ... key[id[end-1]] > pivot
                            key[id[end]] ... key[id[end(B)-1]] == pivot */
-                        P->ib[large].id = id_small;
+                        P->id[large] = id_small;
                         /* begin(B) <= small < large < end <= end(B)
                            key[id[begin(B)]] ... key[id[small]] < pivot
                            key[id[large]] ... key[id[end-1]] > pivot
@@ -378,7 +372,7 @@ static state_index pass_file_noerror(partition * P, block * B,
                                    key[id[large]] ... key[id[end-1]] > pivot
                                    key[id[end]]...key[id[end(B)-1]] == pivot */
                                 --large;
-                                id_large = P->ib[large].id;
+                                id_large = P->id[large];
                                 /* begin(B) < small <= large < end <= end(B)
                                    key[id[begin(B)]]...key[id[small-1]] < pivot
                                    id_large == id[large]
@@ -408,8 +402,8 @@ static state_index pass_file_noerror(partition * P, block * B,
                            key[id_large] == pivot
                            key[id[large+1]] ... key[id[end]] > pivot
                            key[id[end+1]] ... key[id[end(B)-1]] == pivot */
-                        P->ib[large].id = P->ib[end].id;
-                        P->ib[end].id = id_large;
+                        P->id[large] = P->id[end];
+                        P->id[end] = id_large;
                         /* begin(B) < small <= large <= end < end(B)
                            key[id[begin(B)]] ... key[id[small-1]] < pivot
                            key[id[large]] ... key[id[end-1]] > pivot
@@ -432,7 +426,7 @@ static state_index pass_file_noerror(partition * P, block * B,
 * (almost) the same key value.
 * The "_internal" function assumes that block B is a splitter and inserts all
 * newly generated blocks into the list of splitters after B.
-* The arrays P->ib[...].b and P->pos[...] are not changed by this
+* The arrays P->b[...] and P->pos[...] are not changed by this
 * function. Because it does swap elements and split B, they will have to be
 * corrected afterwards.
 * Parameters: P = partition
@@ -443,7 +437,7 @@ static state_index pass_file_noerror(partition * P, block * B,
 static err_state sort_and_split_block_internal(partition * P, block * B,
                 /*@observer@*/ const double * key)
                 /*@requires notnull P->blocks@*/
-                /*@modifies P->num_blocks, P->ib[], B->u.next_Sp, B->next@*/
+                /*@modifies P->num_blocks, P->id[], B->u.next_Sp, B->next@*/
 {
         /*@dependent@*/ /*@null@*/ block * B_left = NULL, * B_right = NULL;
         pos_index middle, equal;
@@ -555,13 +549,13 @@ err_state sort_and_split_block(/*@i1@*/ /*@null@*/ partition * P,
                                 (const void*) key, (int) set_b, err_ERROR);
         }
 
-        /* correct P->ib[...].b and P->pos[...] */
+        /* correct P->b[...] and P->pos[...] */
         i = part_block_end_nt(B);
         if ( ! set_b ) {
                 pos_index new_begin = part_block_begin_nt(B);
                 do {
                         --i;
-                        P->pos[P->ib[i].id] = i;
+                        P->pos[P->id[i]] = i;
                 } while ( i > new_begin );
                 if ( i <= begin ) {
                         return err_OK;
@@ -577,8 +571,8 @@ err_state sort_and_split_block(/*@i1@*/ /*@null@*/ partition * P,
                 pos_index new_begin = part_block_begin_nt(B);
                 do {
                         --i;
-                        P->ib[P->ib[i].id].b = B;
-                        P->pos[P->ib[i].id] = i;
+                        P->b[P->id[i]] = B->idx;
+                        P->pos[P->id[i]] = i;
                 } while ( i > new_begin );
                 if ( i <= begin ) {
                         break;
@@ -54,8 +54,11 @@
 # include "execute_cmd_script.h"
 # include "write_res_file.h"
 # include "lump.h"
+# include "part_file.h"
 # include "parser_to_core.h"
 # include "steady.h"
+# include "prctl.h"
+# include "foxglynn.h"
 #include "rand_num_generator.h"
 
 #include <string.h>
@@ -77,6 +80,7 @@ int yyparse (void);
 /* This is the list of possible options */
 #define F_IND_LUMP_MODE_STR "-ilump"
 #define F_DEP_LUMP_MODE_STR "-flump"
+#define SIG_LUMP_METHOD_STR "-slump"
 
 /* This "logic" is used for testing vector */
 /* matrix and matrix vector multiplications */
@@ -90,10 +94,11 @@ int yyparse (void);
 #define RES_FILE_EXT ".res"
 #define REWI_FILE_EXT ".rewi"
 #define CTMDPI_FILE_EXT ".ctmdpi"
+#define PART_FILE_EXT ".part"
 
 /**
 * An extension can be one of:
-*	.rew, .rewi, .tra, .lab, .ctmdpi
+*	.rew, .rewi, .tra, .lab, .ctmdpi, .part
 * plus at least one symbol of the name
 */
 #define MIN_FILE_NAME_LENGTH 5
@@ -122,6 +127,7 @@ static BOOL is_cmd_present  = FALSE;
 static BOOL is_res_present  = FALSE;
 static BOOL is_rewi_present = FALSE;
 static BOOL is_ctmdpi_present = FALSE;
+static BOOL is_part_present = FALSE;
 
 /**
 * Here we will store pointers to the input files
@@ -133,15 +139,17 @@ static const char * cmd_file  = NULL;
 extern const char * res_file;
 static const char * rewi_file = NULL;
 static const char * ctmdpi_file = NULL;
+static const char * part_file = NULL;
 
 /**
 * This part simply prints the program usage info.
 */
 static void usage(void)
 {
-	printf("Usage: mrmc <model> <options> <.tra file> <.ctmdpi file> <.lab file> <.rew file> <.rewi file> <.cmd file> <.res file>\n");
+	printf("Usage: mrmc <model> <options> <.tra file> <.ctmdpi file> <.lab file> <.rew file> <.rewi file> <.cmd file> <.res file> <.part file>\n");
 	printf("\t<model>\t\t- could be one of {%s, %s, %s, %s, %s}.\n",CTMC_MODE_STR, DTMC_MODE_STR, DMRM_MODE_STR, CMRM_MODE_STR, CTMDPI_MODE_STR);
 	printf("\t<options>\t- could be one of {%s, %s}, optional.\n", F_IND_LUMP_MODE_STR, F_DEP_LUMP_MODE_STR);
+	printf("\t\t\t  With %s, lumping uses signature-based partition refinement (optional).\n", SIG_LUMP_METHOD_STR);
 	printf("\t<.tra file>\t- is the file with the matrix of transitions (for DMRM/CMRM, DTMC/CTMC).\n");
 	printf("\t<.ctmdpi file>\t- is the file with the transition matrix and transition labels (for CTMDPI).\n");
 	printf("\t<.lab file>\t- contains labeling.\n");
@@ -149,6 +157,7 @@ static void usage(void)
 	printf("\t<.rewi file>\t- contains impulse rewards (for CMRM, optional).\n");
 	printf("\t<.cmd file>\t- contains script to execute (optional).\n");
 	printf("\t<.res file>\t- filename where write_res_file writes the results to (optional).\n");
+	printf("\t<.part file>\t- stores the partition of formula independent lumping; if it exists, it is reused (optional).\n");
 	printf("\nNote: In the '.tra' and '.ctmdpi' file transitions should be ordered by rows and columns!\n\n");
 }
 
@@ -299,6 +308,9 @@ static BOOL setRunningMode(const char * mode)
 		}else{
 			printf("WARNING: The lumping mode has already been set, the parameter '%s' is skipped.\n", mode);
 		}
+	}else if( strcmp(mode,SIG_LUMP_METHOD_STR) == 0 ){
+		result = TRUE;
+		set_method_lumping(LUMP_SIGNATURE);
 	}
 	return result;
 }
@@ -459,18 +471,6 @@ static void checkConsistency(void) {
 	}
 
 	/* Check for the option combinations. */
-	/* Formula independent lumping for CSRL is not supported, the option will be ignored. */
-	if( isRunMode(CMRM_MODE) && isRunMode(F_IND_LUMP_MODE) && is_rewi_present){
-		printf("WARNING: Formula independent lumping for CMRM with impulse rewards is not supported, the '%s' option will be ignored.\n",F_IND_LUMP_MODE_STR);
-		clearRunMode(F_IND_LUMP_MODE);
-		printf("The formula independent lumping is OFF.\n");
-	}
-	/* Formula dependent lumping in CSRL is not supported for the case with impulse rewards */
-	if( isRunMode(CMRM_MODE) && isRunMode(F_DEP_LUMP_MODE) && is_rewi_present ){
-		printf("WARNING: Formula dependent lumping for CMRM with impulse rewards is not supported, the '%s' option will be ignored.\n",F_DEP_LUMP_MODE_STR);
-		clearRunMode(F_DEP_LUMP_MODE);
-		printf("The formula dependent lumping is OFF.\n");
-	}
 	/* Formula independent lumping in PRCTL is not supported for the case with impulse rewards */
 	if( isRunMode(DMRM_MODE) && isRunMode(F_IND_LUMP_MODE) && is_rewi_present ){
 		printf("WARNING: Formula independent lumping for DMRM with impulse rewards is not supported, the '%s' option will be ignored.\n",F_IND_LUMP_MODE_STR);
@@ -496,6 +496,12 @@ static void checkConsistency(void) {
 		printf("The formula independent lumping is OFF.\n");
 	}
 
+	/* The partition file is only used by formula independent lumping */
+	if( is_part_present && !isRunMode(F_IND_LUMP_MODE) ){
+		printf("WARNING: The '%s' file is only used for formula independent lumping, skipping the '%s' file.\n", PART_FILE_EXT, part_file);
+		is_part_present = FALSE;
+	}
+
 	/* Check for the presence of all required files. */
 	missing_file = NULL;
 	if( !isRunMode(CTMDPI_MODE) && !is_tra_present ){
@@ -581,6 +587,13 @@ static void parseInParamsAndInitialize(int argc, char *argv[])
 					}else{
 						printf("WARNING: The '%s' file has been noticed before, skipping the '%s' file.\n", res_file, argv[i]);
 					}
+				}else if ( strcmp(expension, PART_FILE_EXT) == 0 ){
+					if( !is_part_present ){
+							is_part_present = TRUE;
+							part_file = argv[i];
+					}else{
+						printf("WARNING: The '%s' file has been noticed before, skipping the '%s' file.\n", part_file, argv[i]);
+					}
 				}else {
 				    printf("WARNING: An unknown file type '%s' for input file '%s', skipping.\n", expension, argv[i]);
 				}
@@ -628,11 +641,55 @@ static void doFormulaIndependentLumping(void) {
 		/* Starting the timer, if it has not been started yet */
 		startTimer();
 
-		/* Create initial partitioning */
-		P = init_partition(labels);
+		/* Reuse the partition of a previous run, if it fits the model */
+		P = NULL;
+		Q1 = NULL;
+		if( is_part_present && (P = read_part_file(space, part_file)) != NULL ){
+			if( !part_respects_labelling(P, labels, getStateRewards()) ){
+				printf("WARNING: The partition in '%s' does not fit the labelling, lumping again.\n", part_file);
+			}else if( !part_is_stable(P, space) ){
+				printf("WARNING: The partition in '%s' is not a lumping of the model, lumping again.\n", part_file);
+			}else{
+				printf("Reading the partition from '%s'.\n", part_file);
+				Q1 = lump_quotient(P, space);
+			}
+			if( Q1 == NULL ){
+				free_partition(P);
+				P = NULL;
+			}
+		}
 
-		/* Lump the state space */
-		Q1 = lump(P, space);
+		if( P == NULL ){
+			/* Create initial partitioning */
+			P = init_partition(labels);
+
+			/* Lump the state space */
+			Q1 = lump(P, space);
+
+			/* Store the partition for the next run */
+			if( is_part_present && Q1 != NULL
+					&& !err_state_iserror(write_part_file(P, space, part_file)) ){
+				printf("Writing the partition to '%s'.\n", part_file);
+			}
+		}
+
+		/* Change impulse rewards; the lumping is undone if some */
+		/* lumped transition would earn different impulse rewards */
+		if( isRunMode(CMRM_MODE) && getImpulseRewards() != NULL ){
+			sparse * p_new_rewi = change_impulse_rewards(getImpulseRewards(), P, space);
+			if( p_new_rewi == NULL ){
+				free_partition(P);
+				if ( Q1 != NULL ) {
+					(void) free_sparse_ncolse(Q1);
+				}
+				clearRunMode(F_IND_LUMP_MODE);
+				printf("The formula independent lumping is OFF.\n");
+				(void) stopTimer();
+				return;
+			}
+			freeImpulseRewards();
+			(void) exchangeImpulseRewards(p_new_rewi);
+		}
 
 		/* Change labelling */
 		change_labelling(labels, P);
@@ -725,9 +782,14 @@ int main(int argc, char *argv[])
 	freeStateRewards();
 	/* If something was allocated for lumping */
 	freePartition();
+	free_lump_cache();
 
 	/* If something was allocated for model checkig the steady-state operator */
 	freeSteady();
+	/* If something was allocated for the C and Y formulas */
+	free_reward_sweep();
+	/* If something was allocated for the Poisson probabilities */
+	free_fox_glynn_cache();
 
 	/*This is done to deallocate the memory used by RNG methods.*/
 	/* Free the random-number generator data, especially needed by GSL functions */
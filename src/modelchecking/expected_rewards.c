@@ -0,0 +1,569 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Maneesh Khattri, Ivan Zapreev, Tim Kemna
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*
+*	Source description: Expected rewards of CTMRM and DTMRM: the
+*				 instantaneous reward, the cumulative reward and
+*				 the reachability reward.
+*	Uses: DEF: bitset.h, sparse.h, foxglynn.h, transient_common.h, runtime.h
+*		LIB: bitset.c, sparse.c, foxglynn.c, transient_common.c, runtime.c
+*/
+
+#include "expected_rewards.h"
+
+#include "transient_common.h"
+#include "foxglynn.h"
+
+#include "runtime.h"
+
+#include <string.h>
+#include <math.h>
+
+/* The maximum number of accumulators of one sweep */
+#define MAX_REWARD_ACC 2
+
+/**
+* Computes the reward rates of the states: the state reward and the
+* impulse rewards of the outgoing transitions weighted by their rates
+* (CTMRM) or probabilities (DTMRM).
+* NOTE: The state space has to be in its original state, i.e. this has to
+*	be called before the model is uniformized.
+* @param phi only the phi states get rewards, if NULL then all states do
+* @param states TRUE if the state rewards are included
+* @param impulses TRUE if the impulse rewards are included
+* @return the reward rates
+*/
+static double * get_reward_rates(const bitset * phi, BOOL states, BOOL impulses)
+{
+	const sparse * state_space = get_state_space();
+	const int size = get_state_space_size();
+	const double * pStateRewards = getStateRewards();
+	const sparse * pImpulseRewards = getImpulseRewards();
+	double * pRates = (double *) calloc((size_t) size, sizeof(double));
+	int i;
+
+	if( NULL == pRates ){
+		exit(err_macro_0(err_MEMORY, "get_reward_rates()", EXIT_FAILURE));
+	}
+	for( i = 0; i < size; i++ ){
+		if( NULL != phi && ! get_bit_val(phi, i) ){
+			continue;
+		}
+		if( states && NULL != pStateRewards ){
+			pRates[i] = pStateRewards[i];
+		}
+		if( impulses && NULL != pImpulseRewards ){
+			mtx_walk_row(state_space, i, col, val)
+			{
+				double impulse = 0.0;
+				if( err_state_iserror(get_mtx_val(pImpulseRewards, i, col, &impulse)) ){
+					exit(err_macro_4(err_CALLBY, "get_reward_rates(%p[%d],%d,%d)",
+						(const void *) phi, NULL != phi ? bitset_size(phi) : 0,
+						states, impulses, EXIT_FAILURE));
+				}
+				pRates[i] += val * impulse;
+			}
+			end_mtx_walk_row;
+		}
+	}
+	return pRates;
+}
+
+/**
+* Adds sum_{k=0}^{num_steps} ppWeights[a][k] * P^k * pRewards to every
+* accumulator ppAcc[a]. Every step is one fused matrix-vector product and
+* accumulation, see multiply_mtx_MV_acc(...).
+* With the steady-state detection the iterates stop as soon as replacing
+* the remaining ones by the current iterate costs at most
+* ssd_error * max|pRewards| * sum_k ppWeights[a][k] in every accumulator,
+* see is_ssd_reached(...). P has to be (sub)stochastic for this.
+* @param pP the matrix P
+* @param pRewards the reward vector
+* @param num_steps the number of steps
+* @param num_acc the number of accumulators, at most MAX_REWARD_ACC
+* @param ppWeights the weights of the accumulators, num_steps+1 each
+* @param ppAcc the accumulators
+* @param ssd_error the relative error of the steady-state detection, 0.0 if
+*		it is off
+*/
+static void accumulate_rewards(const sparse * pP, const double * pRewards,
+		int num_steps, int num_acc, double ** ppWeights, double ** ppAcc,
+		double ssd_error)
+{
+	const int size = mtx_rows(pP);
+	double * pIterate = (double *) malloc((size_t) size * sizeof(double));
+	double * pNext = (double *) malloc((size_t) size * sizeof(double));
+	double * pTmp;
+	double weights[MAX_REWARD_ACC];
+	TSSDTail tails[MAX_REWARD_ACC];
+	double budgets[MAX_REWARD_ACC];
+	double max_reward = 0.0;
+	int a, i, k;
+
+	if( NULL == pIterate || NULL == pNext ){
+		exit(err_macro_0(err_MEMORY, "accumulate_rewards()", EXIT_FAILURE));
+	}
+
+	/* The steps after the last non-zero weight do not contribute */
+	for( ; num_steps > 0; num_steps-- ){
+		for( a = 0; a < num_acc && 0.0 == ppWeights[a][num_steps]; a++ );
+		if( a < num_acc ){
+			break;
+		}
+	}
+
+	memcpy(pIterate, pRewards, size * sizeof(double));
+	for( i = 0; i < size; i++ ){
+		if( fabs(pRewards[i]) > max_reward ){
+			max_reward = fabs(pRewards[i]);
+		}
+	}
+	for( a = 0; a < num_acc; a++ ){
+		for( i = 0; i < size; i++ ){
+			ppAcc[a][i] += ppWeights[a][0] * pIterate[i];
+		}
+		init_ssd_tail(&tails[a], ppWeights[a], 0, num_steps, 0);
+		budgets[a] = ssd_error * max_reward * ( ppWeights[a][0] + tails[a].mass );
+	}
+	for( k = 1; k <= num_steps; k++ ){
+		for( a = 0; a < num_acc; a++ ){
+			weights[a] = ppWeights[a][k];
+		}
+		if( err_state_iserror(multiply_mtx_MV_acc(pP, pIterate, pNext,
+						num_acc, weights, ppAcc)) ){
+			exit(err_macro_5(err_CALLBY, "accumulate_rewards(%p[%dx%d],%p,%d)",
+				(const void *) pP, mtx_rows(pP), mtx_cols(pP),
+				(const void *) pRewards, num_steps, EXIT_FAILURE));
+		}
+		pTmp = pIterate; pIterate = pNext; pNext = pTmp;
+
+		for( a = 0; a < num_acc; a++ ){
+			step_ssd_tail(&tails[a], weights[a]);
+		}
+		if( ssd_error > 0.0 && 0 == k % SSD_CHECK_PERIOD ){
+			for( a = 0; a < num_acc && is_ssd_reached(&tails[a], pNext,
+						pIterate, NULL, size, budgets[a]); a++ );
+			if( a == num_acc ){
+				/* The remaining iterates are taken as the current one */
+				for( a = 0; a < num_acc; a++ ){
+					for( i = 0; i < size; i++ ){
+						ppAcc[a][i] += tails[a].mass * pIterate[i];
+					}
+				}
+				printf("SSD: i = %d\n", k);
+				break;
+			}
+		}
+	}
+	free(pIterate);
+	free(pNext);
+}
+
+/**
+* The common part of the CTMRM and DTMRM expected rewards. If both rewards
+* are requested, the state rewards are iterated once for both of them, the
+* impulse rewards only for the cumulative reward.
+* @param pP the (uniformized) transition probability matrix
+* @param num_steps the number of steps
+* @param pInstantW the weights of the iterates for the instantaneous reward
+* @param pCumulativeW the weights of the iterates for the cumulative reward
+* @param pStateRates the state reward rates
+* @param pImpulseRates the impulse reward rates, or NULL if there are none
+* @param pInstant the instantaneous rewards, or NULL if not requested
+* @param pCumulative the cumulative rewards, or NULL if not requested
+* @param ssd_error the relative error of the steady-state detection, 0.0 if
+*		it is off
+*/
+static void expected_rewards_universal(const sparse * pP, int num_steps,
+		double * pInstantW, double * pCumulativeW,
+		double * pStateRates, const double * pImpulseRates,
+		double * pInstant, double * pCumulative, double ssd_error)
+{
+	double * ppWeights[MAX_REWARD_ACC];
+	double * ppAcc[MAX_REWARD_ACC];
+	int i, num_acc = 0;
+
+	if( NULL != pInstant ){
+		ppWeights[num_acc] = pInstantW;
+		ppAcc[num_acc++] = pInstant;
+	}
+	if( NULL != pCumulative ){
+		ppWeights[num_acc] = pCumulativeW;
+		ppAcc[num_acc++] = pCumulative;
+		if( NULL != pImpulseRates ){
+			if( NULL == pInstant ){
+				/* One sweep over the sum of the rewards is enough */
+				for( i = 0; i < mtx_rows(pP); i++ ){
+					pStateRates[i] += pImpulseRates[i];
+				}
+			}else{
+				accumulate_rewards(pP, pImpulseRates, num_steps, 1,
+						&pCumulativeW, &pCumulative, ssd_error);
+			}
+		}
+	}
+	if( num_acc > 0 ){
+		accumulate_rewards(pP, pStateRates, num_steps, num_acc, ppWeights,
+				ppAcc, ssd_error);
+	}
+}
+
+/**
+* Allocates the requested result vectors.
+*/
+static void allocate_expected_rewards(int size, double ** ppInstant,
+		double ** ppCumulative, double ** pInstant, double ** pCumulative)
+{
+	*pInstant = NULL;
+	*pCumulative = NULL;
+	if( ( NULL != ppInstant
+	      && NULL == ( *pInstant = (double *) calloc((size_t) size, sizeof(double)) ) )
+	    || ( NULL != ppCumulative
+	      && NULL == ( *pCumulative = (double *) calloc((size_t) size, sizeof(double)) ) ) ){
+		exit(err_macro_0(err_MEMORY, "allocate_expected_rewards()", EXIT_FAILURE));
+	}
+}
+
+/**
+* Computes the expected instantaneous reward at time supi and the expected
+* cumulative reward up to time supi of a CTMRM, for all the initial states,
+* by uniformization. With the Poisson probabilities psi_k of lambda*supi:
+*	instantaneous = sum_k psi_k P^k rho
+*	cumulative = sum_k (1 - sum_{j<=k} psi_j)/lambda P^k (rho + R.iota)
+* Both are computed from the same iterates, by the fused matrix-vector
+* product and accumulation, see multiply_mtx_MV_acc(...).
+* @param supi the time bound
+* @param phi only the rewards of the phi states (and of the transitions
+*	leaving them) are taken into account, if NULL then all of them are
+* @param ppInstant if not NULL then the instantaneous rewards are
+*	allocated here and returned by this pointer
+* @param ppCumulative if not NULL then the cumulative rewards are
+*	allocated here and returned by this pointer
+* @return err_OK if everything went fine; err_ERROR otherwise.
+*/
+err_state ctmrm_expected_rewards(double supi, const bitset * phi,
+		double ** ppInstant, double ** ppCumulative)
+{
+	const sparse * state_space = get_state_space();
+	const int size = get_state_space_size();
+	/* With the steady-state detection, half of the error goes to it */
+	const double ssd_error = ( is_ssd_on() ? get_error_bound() / 2 : 0.0 );
+	double lambda = 0.0, tail;
+	int non_absorbing = 0, i, k;
+	double * pStateRates, * pImpulseRates = NULL;
+	double * pInstant, * pCumulative;
+	double * diag, * pInstantW, * pCumulativeW;
+	bitset * all_states;
+	sparse * abs_local;
+	FoxGlynn * pFG = NULL;
+
+	if( 0.0 > supi ){
+		err_msg_5(err_PARAM, "ctmrm_expected_rewards(%g,%p[%d],%p,%p)", supi,
+			(const void *) phi, NULL != phi ? bitset_size(phi) : 0,
+			(void *) ppInstant, (void *) ppCumulative, err_ERROR);
+	}
+	allocate_expected_rewards(size, ppInstant, ppCumulative, &pInstant, &pCumulative);
+
+	/* The rates have to be computed before the matrix is uniformized */
+	pStateRates = get_reward_rates(phi, TRUE, FALSE);
+	if( NULL != pCumulative && NULL != getImpulseRewards() ){
+		pImpulseRates = get_reward_rates(phi, FALSE, TRUE);
+	}
+
+	/* No state is made absorbing, ab_state_space is only used for the */
+	/* rates and for the copy of the matrix with its own diagonal */
+	all_states = get_new_bitset(size);
+	fill_bitset_one(all_states);
+	diag = (double *) calloc((size_t) size, sizeof(double));
+	abs_local = ab_state_space(state_space, all_states, &lambda, diag, &non_absorbing);
+
+	if( 0.0 == lambda || 0.0 == supi ){
+		/* The model does not move, the rewards are earned in the initial state */
+		for( i = 0; i < size; i++ ){
+			if( NULL != pInstant ){
+				pInstant[i] = pStateRates[i];
+			}
+			if( NULL != pCumulative ){
+				pCumulative[i] = supi * pStateRates[i];
+			}
+		}
+	}else if( fox_glynn(lambda * supi, get_underflow(), get_overflow(),
+				get_error_bound() - ssd_error, &pFG) ){
+		/* Uniformize: P = I + (R - E(s))/lambda */
+		if( err_state_iserror(sub_mtx_diagonal(abs_local, diag))
+		    || err_state_iserror(mult_mtx_const(abs_local, 1 / lambda))
+		    || err_state_iserror(add_mtx_cons_diagonal(abs_local, 1.0)) ){
+			exit(err_macro_5(err_CALLBY, "ctmrm_expected_rewards(%g,%p[%d],%p,%p)",
+				supi, (const void *) phi, NULL != phi ? bitset_size(phi) : 0,
+				(void *) ppInstant, (void *) ppCumulative, EXIT_FAILURE));
+		}
+
+		/* The Poisson probabilities and the remaining Poisson mass divided by lambda */
+		pInstantW = (double *) calloc((size_t) pFG->right + 1, sizeof(double));
+		pCumulativeW = (double *) calloc((size_t) pFG->right + 1, sizeof(double));
+		if( NULL == pInstantW || NULL == pCumulativeW ){
+			exit(err_macro_0(err_MEMORY, "ctmrm_expected_rewards()", EXIT_FAILURE));
+		}
+		tail = 1.0;
+		for( k = 0; k <= pFG->right; k++ ){
+			if( k >= pFG->left ){
+				pInstantW[k] = pFG->weights[k - pFG->left] / pFG->total_weight;
+				tail -= pInstantW[k];
+			}
+			pCumulativeW[k] = ( tail > 0.0 ? tail : 0.0 ) / lambda;
+		}
+
+		expected_rewards_universal(abs_local, pFG->right, pInstantW, pCumulativeW,
+				pStateRates, pImpulseRates, pInstant, pCumulative, ssd_error);
+		free(pInstantW);
+		free(pCumulativeW);
+
+		/* Reset the matrix to its original state */
+		/* NOTE: operations on diagonals are not required */
+		if( err_state_iserror(mult_mtx_const(abs_local, lambda)) ){
+			exit(err_macro_5(err_CALLBY, "ctmrm_expected_rewards(%g,%p[%d],%p,%p)",
+				supi, (const void *) phi, NULL != phi ? bitset_size(phi) : 0,
+				(void *) ppInstant, (void *) ppCumulative, EXIT_FAILURE));
+		}
+	}else{
+		/* NOTE: fox_glynn(...) allocates the structure even if it fails */
+		err_msg_5(err_CALLBY, "ctmrm_expected_rewards(%g,%p[%d],%p,%p)", supi,
+			(const void *) phi, NULL != phi ? bitset_size(phi) : 0,
+			(void *) ppInstant, (void *) ppCumulative,
+			(free(pInstant), free(pCumulative), free(pStateRates),
+			 free(pImpulseRates), free(diag), free_abs(abs_local),
+			 free_bitset(all_states), freeFG(pFG), err_ERROR));
+	}
+
+	freeFG(pFG);
+	free(pStateRates);
+	free(pImpulseRates);
+	free(diag);
+	free_abs(abs_local);
+	free_bitset(all_states);
+
+	if( NULL != ppInstant ){
+		*ppInstant = pInstant;
+	}
+	if( NULL != ppCumulative ){
+		*ppCumulative = pCumulative;
+	}
+	return err_OK;
+}
+
+/**
+* Computes the expected instantaneous reward at step steps and the expected
+* cumulative reward of the first steps steps of a DTMRM, for all the initial
+* states, in one sweep:
+*	instantaneous = P^steps rho
+*	cumulative = sum_{k=0}^{steps-1} P^k (rho + P.iota)
+* @param steps the number of steps
+* @param phi only the rewards of the phi states (and of the transitions
+*	leaving them) are taken into account, if NULL then all of them are
+* @param ppInstant if not NULL then the instantaneous rewards are
+*	allocated here and returned by this pointer
+* @param ppCumulative if not NULL then the cumulative rewards are
+*	allocated here and returned by this pointer
+* @return err_OK if everything went fine; err_ERROR otherwise.
+*/
+err_state dtmrm_expected_rewards(int steps, const bitset * phi,
+		double ** ppInstant, double ** ppCumulative)
+{
+	const int size = get_state_space_size();
+	double * pStateRates, * pImpulseRates = NULL;
+	double * pInstant, * pCumulative;
+	double * pInstantW, * pCumulativeW;
+	int k;
+
+	if( 0 > steps ){
+		err_msg_5(err_PARAM, "dtmrm_expected_rewards(%d,%p[%d],%p,%p)", steps,
+			(const void *) phi, NULL != phi ? bitset_size(phi) : 0,
+			(void *) ppInstant, (void *) ppCumulative, err_ERROR);
+	}
+	allocate_expected_rewards(size, ppInstant, ppCumulative, &pInstant, &pCumulative);
+
+	pStateRates = get_reward_rates(phi, TRUE, FALSE);
+	if( NULL != pCumulative && NULL != getImpulseRewards() ){
+		pImpulseRates = get_reward_rates(phi, FALSE, TRUE);
+	}
+	pInstantW = (double *) calloc((size_t) steps + 1, sizeof(double));
+	pCumulativeW = (double *) calloc((size_t) steps + 1, sizeof(double));
+	if( NULL == pInstantW || NULL == pCumulativeW ){
+		exit(err_macro_0(err_MEMORY, "dtmrm_expected_rewards()", EXIT_FAILURE));
+	}
+	pInstantW[steps] = 1.0;
+	for( k = 0; k < steps; k++ ){
+		pCumulativeW[k] = 1.0;
+	}
+
+	expected_rewards_universal(get_state_space(), steps, pInstantW, pCumulativeW,
+			pStateRates, pImpulseRates, pInstant, pCumulative,
+			( is_ssd_on() ? get_error_bound() : 0.0 ));
+
+	free(pInstantW);
+	free(pCumulativeW);
+	free(pStateRates);
+	free(pImpulseRates);
+
+	if( NULL != ppInstant ){
+		*ppInstant = pInstant;
+	}
+	if( NULL != ppCumulative ){
+		*ppCumulative = pCumulative;
+	}
+	return err_OK;
+}
+
+/**
+* The common part of the CTMRM and DTMRM reachability rewards.
+* Solves x = b + P x for the states that reach psi almost surely but are
+* not psi states, where P and b are the transition probabilities and the
+* expected rewards of one step of the (embedded) DTMC.
+* @param psi SAT(psi).
+* @param embedded TRUE for a CTMRM, then the embedded DTMC is used
+* @return the expected rewards, HUGE_VAL for the states that reach psi
+*	with a probability less than one.
+*/
+static double * reachability_reward_universal(const bitset * psi, BOOL embedded)
+{
+	sparse * state_space = get_state_space();
+	const int size = get_state_space_size();
+	const double * row_sums = embedded ? get_row_sums() : NULL;
+	bitset * all_states = get_new_bitset(size);
+	bitset * EU = NULL, * AU = NULL, * valid = NULL;
+	int * pValidStates = NULL;
+	double * pRates = NULL, * initial = NULL, * rhs = NULL, * result = NULL;
+	sparse * pQ = NULL;
+	int i, j;
+
+	const char * error_str = err_CALLBY;
+	if( NULL == all_states
+	    || err_state_iserror(fill_bitset_one(all_states))
+	    || NULL == (EU = get_exist_until(state_space, all_states, psi))
+	    || NULL == (AU = get_always_until(state_space, all_states, psi, EU))
+	    || NULL == (valid = not(psi))
+	    || err_state_iserror(and_result(AU, valid))
+	    || NULL == (pValidStates = count_set(valid))
+	    || (error_str = err_MEMORY,
+	        initial = (double *) calloc((size_t) size, sizeof(double))) == NULL
+	    || (rhs = (double *) calloc((size_t) size, sizeof(double))) == NULL
+	    || (error_str = err_CALLBY,
+	        pQ = allocate_sparse_matrix(size, size)) == NULL )
+	{
+		err_msg_3(error_str, "reachability_reward_universal(%p[%d],%d)",
+			(const void *) psi, bitset_size(psi), embedded,
+			(free_bitset(all_states), NULL == EU || (free_bitset(EU), FALSE),
+			 NULL == AU || (free_bitset(AU), FALSE),
+			 NULL == valid || (free_bitset(valid), FALSE),
+			 free(pValidStates), free(initial), free(rhs), NULL));
+	}
+
+	/* The expected reward of one step, before the matrix is modified */
+	pRates = get_reward_rates(NULL, TRUE, TRUE);
+	for( j = 1; j <= pValidStates[0]; j++ ){
+		i = pValidStates[j];
+		rhs[i] = embedded ? pRates[i] / row_sums[i] : pRates[i];
+	}
+	free(pRates);
+
+	if( err_state_iserror(initMatrix(state_space, pQ, pValidStates))
+	    || ( embedded && err_state_iserror(mult_mtx_cer_const_array(pQ,
+					row_sums, pValidStates, TRUE)) ) )
+	{
+		exit(err_macro_3(err_CALLBY, "reachability_reward_universal(%p[%d],%d)",
+			(const void *) psi, bitset_size(psi), embedded, EXIT_FAILURE));
+	}
+
+	/* Solve (I-P)x = b */
+	result = unbounded_until_universal(pQ, pValidStates, initial, rhs, TRUE);
+
+	if( NULL == result
+	    || ( embedded && err_state_iserror(mult_mtx_cer_const_array(pQ,
+					row_sums, pValidStates, FALSE)) )
+	    || err_state_iserror(cleanMatrix(pQ, pValidStates))
+	    || err_state_iserror(free_mtx_sparse(pQ)) )
+	{
+		exit(err_macro_3(err_CALLBY, "reachability_reward_universal(%p[%d],%d)",
+			(const void *) psi, bitset_size(psi), embedded, EXIT_FAILURE));
+	}
+
+	/* The reward is infinite if psi is not reached almost surely */
+	for( i = 0; i < size; i++ ){
+		if( ! get_bit_val(AU, i) ){
+			result[i] = HUGE_VAL;
+		}else if( get_bit_val(psi, i) ){
+			result[i] = 0.0;
+		}
+	}
+
+	free(rhs);
+	free(pValidStates);
+	free_bitset(valid);
+	free_bitset(AU);
+	free_bitset(EU);
+	free_bitset(all_states);
+	return result;
+}
+
+/**
+* Computes the expected reward accumulated until a psi state is reached in
+* a CTMRM, for all the initial states.
+* @param psi SAT(psi).
+* @return the expected rewards, HUGE_VAL for the states that reach psi
+*	with a probability less than one.
+*/
+double * ctmrm_reachability_reward(const bitset * psi)
+{
+	return reachability_reward_universal(psi, TRUE);
+}
+
+/**
+* Computes the expected reward accumulated until a psi state is reached in
+* a DTMRM, for all the initial states.
+* @param psi SAT(psi).
+* @return the expected rewards, HUGE_VAL for the states that reach psi
+*	with a probability less than one.
+*/
+double * dtmrm_reachability_reward(const bitset * psi)
+{
+	return reachability_reward_universal(psi, FALSE);
+}
@@ -51,6 +51,7 @@
 #include "runtime.h"
 
 #include <string.h>
+#include <math.h>
 
 
 /*****************************************************************************
@@ -76,7 +77,7 @@ static double * ef_bounded(int steps, const bitset * phi) {
         while ( (i = get_idx_next_non_zero(phi, i)) != state_index_NONE ) {
 			set_bit_val(psi, i, BIT_ON);
                         temp_result = until(TIME_INTERVAL_FORM, tt, psi, 0.0,
-                                        (double) steps, FALSE);
+                                        (double) steps, FALSE, NULL);
                         if ( NULL == temp_result ) {
                                 err_msg_3(err_CALLBY, "ef_bounded(%d,%p[%d])",
                                         steps, (const void *) phi,
@@ -115,7 +116,7 @@ static double * ef_unbounded(const bitset * phi) {
         i = state_index_NONE;
         while ( (i = get_idx_next_non_zero(phi, i)) != state_index_NONE ) {
 			set_bit_val(psi, i, BIT_ON);
-			temp_result=until( TIME_UNBOUNDED_FORM, tt, psi, 0.0, 0.0, FALSE);
+			temp_result=until( TIME_UNBOUNDED_FORM, tt, psi, 0.0, 0.0, FALSE, NULL);
                         if ( NULL == temp_result ) {
                                 err_msg_2(err_CALLBY, "ef_unbounded(%p[%d])",
                                         (const void *) phi, bitset_size(phi),
@@ -165,6 +166,241 @@ double * ef(int steps, const bitset * phi) {
 	return result;
 }
 
+/* The state of the last reward sweep, see advance_reward_sweep(...). */
+/* The C and Y formulas continue the sweep of the previous query if it */
+/* is for the same model, phi and discount, and for a later epoch. */
+/* The model the sweep is computed for */
+static const sparse * pSweepSpace = NULL;
+static const double * pSweepRewards = NULL;
+static double sweep_err = 0.0;
+/* The phi states of the sweep and max|rho_phi| */
+static bitset * pSweepPhi = NULL;
+static double sweep_max_reward = 0.0;
+/* The discount of the sweep */
+static double sweep_discount = 1.0;
+/* The current step k and discount^k */
+static int sweep_step = 0;
+static double sweep_factor = 1.0;
+/* The iterate P^k*rho_phi */
+static double * pSweepIterate = NULL;
+/* The discounted sum of the iterates 0..k */
+static double * pSweepSum = NULL;
+/* A temporary vector */
+static double * pSweepNext = NULL;
+/* max|P^k*rho_phi - P^(k-1)*rho_phi|, HUGE_VAL before the first step */
+static double sweep_diff = HUGE_VAL;
+
+/*****************************************************************************
+name		: free_reward_sweep
+role		: free the state of the reward sweep of the C and Y formulas.
+remark		: Has to be called before model checking a new model.
+******************************************************************************/
+void free_reward_sweep(void)
+{
+	if( NULL != pSweepPhi ){
+		free_bitset(pSweepPhi);
+		pSweepPhi = NULL;
+	}
+	free(pSweepIterate);
+	pSweepIterate = NULL;
+	free(pSweepSum);
+	pSweepSum = NULL;
+	free(pSweepNext);
+	pSweepNext = NULL;
+	pSweepSpace = NULL;
+	pSweepRewards = NULL;
+	sweep_diff = HUGE_VAL;
+}
+
+/**
+* Checks whether the reward sweep can be continued for the given query.
+* @return TRUE if the sweep is for the current model, phi and discount and
+*	has not passed the given number of steps yet.
+*/
+static BOOL isSweepReusable(int steps, const bitset * phi, double discount)
+{
+	BOOL reusable = FALSE;
+	bitset * pDiff;
+
+	if( NULL != pSweepPhi && pSweepSpace == get_state_space()
+	    && pSweepRewards == getStateRewards() && sweep_err == get_error_bound()
+	    && sweep_discount == discount && bitset_size(pSweepPhi) == bitset_size(phi)
+	    && sweep_step <= steps )
+	{
+		pDiff = xor(pSweepPhi, phi);
+		if( NULL == pDiff ){
+			exit(err_macro_4(err_CALLBY, "isSweepReusable(%d,%p[%d],%g)", steps,
+				(const void *) phi, bitset_size(phi), discount, EXIT_FAILURE));
+		}
+		reusable = is_bitset_zero(pDiff);
+		free_bitset(pDiff);
+	}
+	return reusable;
+}
+
+/**
+* Gets the sum of discount^j for j = from..to-1, in closed form.
+* @param discount the discount, 0 < discount <= 1
+* @param from the first power
+* @param to the power after the last one
+* @return the sum, 0.0 if to <= from
+*/
+static double get_discount_sum(double discount, int from, int to)
+{
+	if( to <= from ){
+		return 0.0;
+	}else if( 1.0 == discount ){
+		return (double) ( to - from );
+	}
+	return pow(discount, (double) from)
+		* ( 1.0 - pow(discount, (double) ( to - from )) ) / ( 1.0 - discount );
+}
+
+/**
+* Checks whether the iterates after the current one can be replaced by it.
+* P is stochastic, so the differences of the iterates do not grow and
+* |P^j*rho_phi - P^k*rho_phi| <= min((j-k)*sweep_diff, 2*max|rho_phi|) for
+* all j > k. With r = steps-k remaining steps and d the discount the error
+* of the C formula is at most r*sweep_diff, the one of the Y formula at most
+* d^(k+1) * sum_{m=1}^{r-1} d^(m-1)*min(m*sweep_diff, 2*max|rho_phi|), where
+* sum_{m=1}^{r-1} m*d^(m-1) <= min(r*(r-1)/2, 1/(1-d)^2) and
+* sum_{m=1}^{r-1} d^(m-1) <= min(r-1, 1/(1-d)). So with a discount the sweep
+* also stops without a fixpoint, once the discounted tail is small.
+* The errors have to be within get_error_bound() relative to max|rho_phi|
+* and max|rho_phi|*sum_{j<steps} d^j, the bounds of the C and Y values.
+* @param steps the epoch of the query
+* @param instant TRUE if the C formula is computed
+* @param cumulative TRUE if the Y formula is computed
+* @return TRUE if the sweep may stop at the current step
+*/
+static BOOL isSweepConverged(int steps, BOOL instant, BOOL cumulative)
+{
+	const double remaining = (double) ( steps - sweep_step );
+	const double budget = sweep_err * sweep_max_reward;
+	double pairs, count, error;
+
+	if( instant && remaining * sweep_diff > budget ){
+		return FALSE;
+	}
+	if( ! cumulative || remaining <= 1.0 ){
+		return TRUE;
+	}
+	pairs = remaining * ( remaining - 1.0 ) / 2;
+	count = remaining - 1.0;
+	if( 1.0 > sweep_discount ){
+		if( pairs > 1.0 / ( ( 1.0 - sweep_discount ) * ( 1.0 - sweep_discount ) ) ){
+			pairs = 1.0 / ( ( 1.0 - sweep_discount ) * ( 1.0 - sweep_discount ) );
+		}
+		if( count > 1.0 / ( 1.0 - sweep_discount ) ){
+			count = 1.0 / ( 1.0 - sweep_discount );
+		}
+	}
+	error = pairs * sweep_diff;
+	if( error > 2 * sweep_max_reward * count ){
+		error = 2 * sweep_max_reward * count;
+	}
+	return sweep_factor * sweep_discount * error
+		<= budget * get_discount_sum(sweep_discount, 0, steps);
+}
+
+/*****************************************************************************
+name		: advance_reward_sweep
+role		: compute P^steps*rho_phi and sum_{k<steps} discount^k*P^k*rho_phi
+		  for all states.
+@param		: int steps: n.
+@param		: bitset *phi: satisfaction relation for phi formula.
+@param		: double discount: the discount of the Y formula, 1.0 for none.
+@param		: double *pInstant: if not NULL, P^steps*rho_phi.
+@param		: double *pCumulative: if not NULL, the discounted sum.
+remark		: The iterates are shared by the queries of increasing epochs,
+		  each step is one fused matrix-vector product and accumulation.
+		  The sweep stops once the remaining iterates can be taken as
+		  the current one within get_error_bound(), see
+		  isSweepConverged(...), and they are added in closed form:
+		  sum_{j=k+1}^{steps-1} discount^j = discount^k * discount
+		  * (1 - discount^(steps-1-k)) / (1 - discount).
+******************************************************************************/
+static void advance_reward_sweep(int steps, const bitset * phi, double discount,
+		double * pInstant, double * pCumulative)
+{
+	const sparse * state_space = get_state_space();
+	const int size = get_state_space_size();
+	const double * rewards = getStateRewards();
+	double * pTmp, diff, tail;
+	int i;
+
+	if( ! isSweepReusable(steps, phi, discount) ){
+		free_reward_sweep();
+		pSweepPhi = get_new_bitset(size);
+		pSweepIterate = (double *) calloc((size_t) size, sizeof(double));
+		pSweepSum = (double *) calloc((size_t) size, sizeof(double));
+		pSweepNext = (double *) calloc((size_t) size, sizeof(double));
+		if( NULL == pSweepPhi || NULL == pSweepIterate || NULL == pSweepSum
+		    || NULL == pSweepNext || err_state_iserror(copy_bitset(phi, pSweepPhi)) ){
+			exit(err_macro_4(err_MEMORY, "advance_reward_sweep(%d,%p[%d],%g)",
+				steps, (const void *) phi, bitset_size(phi), discount,
+				EXIT_FAILURE));
+		}
+		pSweepSpace = state_space;
+		pSweepRewards = rewards;
+		sweep_err = get_error_bound();
+		sweep_max_reward = 0.0;
+		sweep_discount = discount;
+		sweep_step = 0;
+		sweep_factor = 1.0;
+		sweep_diff = HUGE_VAL;
+
+		i = state_index_NONE;
+		while ( (i = get_idx_next_non_zero(phi, i)) != state_index_NONE ) {
+			pSweepIterate[i] = rewards[i];
+			pSweepSum[i] = rewards[i];
+			if( fabs(rewards[i]) > sweep_max_reward ){
+				sweep_max_reward = fabs(rewards[i]);
+			}
+		}
+	}
+
+	while( sweep_step < steps && ! isSweepConverged(steps, NULL != pInstant,
+							NULL != pCumulative) ){
+		/* The discounted sum of the iterates 0..k+1 */
+		sweep_factor *= discount;
+		if( err_state_iserror(multiply_mtx_MV_acc(state_space, pSweepIterate,
+					pSweepNext, 1, &sweep_factor, &pSweepSum)) ){
+			exit(err_macro_4(err_CALLBY, "advance_reward_sweep(%d,%p[%d],%g)",
+				steps, (const void *) phi, bitset_size(phi), discount,
+				EXIT_FAILURE));
+		}
+		sweep_diff = 0.0;
+		for( i = 0; i < size; i++ ){
+			diff = fabs(pSweepNext[i] - pSweepIterate[i]);
+			if( diff > sweep_diff ){
+				sweep_diff = diff;
+			}
+		}
+		pTmp = pSweepIterate;
+		pSweepIterate = pSweepNext;
+		pSweepNext = pTmp;
+		sweep_step++;
+	}
+
+	/* The iterates sweep_step+1..steps-1 are taken as the current one, */
+	/* or the sum of the iterates 0..steps-1 if the sweep reached steps */
+	if( sweep_step < steps ){
+		tail = get_discount_sum(discount, sweep_step + 1, steps);
+	}else{
+		tail = - sweep_factor;
+	}
+
+	for( i = 0; i < size; i++ ){
+		if( NULL != pInstant ){
+			pInstant[i] = pSweepIterate[i];
+		}
+		if( NULL != pCumulative ){
+			pCumulative[i] = ( 0 == steps ? 0.0 : pSweepSum[i] + tail * pSweepIterate[i] );
+		}
+	}
+}
+
 /*****************************************************************************
 name		: cf
 role		: solve C formula in DMRM
@@ -174,47 +410,20 @@ role		: solve C formula in DMRM
 remark		:
 ******************************************************************************/
 double * cf(int steps, const bitset * phi) {
-	int i, j;
-        const
-	sparse * state_space = get_state_space();
 	const int size = get_state_space_size();
         double * result = (double *) calloc((size_t) size, sizeof(double));
-        const double * rewards = getStateRewards();
-        double * result_1 = (double *) calloc((size_t) size, sizeof(double));
-        double * result_2 = (double *) calloc((size_t) size, sizeof(double)),
-                        * pTmp = NULL;
 
 	if( isRunMode(DMRM_MODE) ) {
-                i = state_index_NONE;
-                while ( (i = get_idx_next_non_zero(phi,i)) != state_index_NONE )
-                {
-                                memset(result_1, '\0', size * sizeof(double));
-				result_1[i] = 1.0;
-				/*Compute P^supi*i_phi*/
-				for(j = 0; j < steps ; j++) {
-                                        if ( err_state_iserror(multiply_mtx_MV(
-                                                        state_space, result_1,
-                                                        result_2)) )
-                                        {
-                                                err_msg_3(err_CALLBY, "cf(%d,"
-                                                        "%p[%d])", steps,
-                                                        (const void *) phi,
-                                                        bitset_size(phi), NULL);
-                                        }
-					pTmp = result_1;
-					result_1 = result_2;
-					result_2 = pTmp;
-				}
-				for(j=0;j<size;j++) {
-					result[j]+=result_1[j]*rewards[i];
-				}
+		if ( NULL == result ) {
+			err_msg_3(err_MEMORY, "cf(%d,%p[%d])", steps,
+				(const void *) phi, bitset_size(phi), NULL);
 		}
+		/*Compute P^supi*rho_phi*/
+		advance_reward_sweep(steps, phi, 1.0, result, NULL);
 	} else {
 		printf("ERROR: Unsupported mode for C formula\n");
                 exit(EXIT_FAILURE);
 	}
-	free(result_1);
-	free(result_2);
 	return result;
 }
 
@@ -227,38 +436,34 @@ role		: solve Y formula in DMRM
 remark		:
 ******************************************************************************/
 double * yf(int steps, const bitset * phi) {
-	int i, j;
-        const
-	sparse * state_space = get_state_space();
+	return yf_discounted(steps, phi, 1.0);
+}
+
+/*****************************************************************************
+name		: yf_discounted
+role		: solve the discounted Y formula in DMRM
+@param		: int steps: n.
+@param		: bitset *phi: satisfaction relation for phi formula.
+@param		: double discount: the reward of step k is discounted by
+		  discount^k, 0 < discount <= 1.
+@return		: double *: result of N-R bounded discounted Y formula in DMRM.
+remark		:
+******************************************************************************/
+double * yf_discounted(int steps, const bitset * phi, double discount) {
 	const int size = get_state_space_size();
-        const
-	double *rewards = getStateRewards();
-        double * result1 = (double *) calloc((size_t) size, sizeof(double));
-        double * result2 = (double *) calloc((size_t) size, sizeof(double));
-        double * rewards2 = (double *) calloc((size_t) size, sizeof(double));
+        double * result = (double *) calloc((size_t) size, sizeof(double));
 
-        i = state_index_NONE;
-        while ( (i = get_idx_next_non_zero(phi, i)) != state_index_NONE ) {
-			rewards2[i] = rewards[i];
-	}
 	if( isRunMode(DMRM_MODE) ) {
-		for(i=0;i<steps;i++) {
-                        if ( err_state_iserror(multiply_mtx_MV(state_space,
-                                                        result1, result2)) )
-                        {
-                                err_msg_3(err_CALLBY, "yf(%d,%p[%d])", steps,
-                                        (const void*)phi,bitset_size(phi),NULL);
-                        }
-			for(j=0;j<size;j++) {
-				result1[j] = rewards2[j]+result2[j];
-			}
+		if ( NULL == result || 0.0 >= discount || 1.0 < discount ) {
+			err_msg_4(NULL == result ? err_MEMORY : err_PARAM,
+				"yf_discounted(%d,%p[%d],%g)", steps, (const void *) phi,
+				bitset_size(phi), discount, (free(result), NULL));
 		}
+		/*Compute sum_{k<steps} discount^k*P^k*rho_phi*/
+		advance_reward_sweep(steps, phi, discount, NULL, result);
 	} else {
 		printf("ERROR: Unsupported mode for Y formula\n");
                 exit(EXIT_FAILURE);
 	}
-
-	free(result2);
-	free(rewards2);
-	return result1;
+	return result;
 }
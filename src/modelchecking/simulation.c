@@ -48,6 +48,7 @@
 #include "simulation.h"
 
 #include "rand_num_generator.h"
+#include "simulation_common.h"
 
 #include "runtime.h"
 
@@ -420,6 +421,261 @@ int getSampleBSCCDimensionMultiplier(void) {
 }
 
 
+/****************************************************************************/
+/*****************MANAGE THE PARALLEL SIMULATION PARAMETERS******************/
+/****************************************************************************/
+
+/* The number of simulation threads */
+static int sim_threads = DEF_SIM_THREADS;
+
+/* The seed of the parallel simulation streams, 0 for the system clock */
+static unsigned long sim_seed = DEF_SIM_SEED;
+
+/**
+* Sets the number of simulation threads.
+* @param _threads the number of threads, 0 for the sequential simulation
+*		with the generators set by sim_method_disc and sim_method_exp
+*/
+void setSimThreads(int _threads){
+	if( (_threads >= MIN_SIM_THREADS) && (_threads <= MAX_SIM_THREADS) ){
+		sim_threads = _threads;
+		/* The streams have to be created anew for the new number */
+		freeSimulationStreams();
+	} else {
+		printf("WARNING: The number of simulation threads should be >= %d and <= %d.\n", MIN_SIM_THREADS, MAX_SIM_THREADS );
+		printf("WARNING: The 'set' command is ignored.\n");
+	}
+}
+
+/**
+* Gets the number of simulation threads.
+* @return the number of simulation threads
+*/
+int getSimThreads(void) {
+	return sim_threads;
+}
+
+/**
+* Sets the seed of the parallel simulation streams.
+* @param _seed the seed, 0 for seeding by the system clock
+*/
+void setSimSeed(unsigned long _seed){
+	sim_seed = _seed;
+	/* Restart the streams from the new seed */
+	freeSimulationStreams();
+}
+
+/**
+* Gets the seed of the parallel simulation streams.
+* @return the seed, 0 stands for seeding by the system clock
+*/
+unsigned long getSimSeed(void) {
+	return sim_seed;
+}
+
+/****************************************************************************/
+/**************MANAGE THE HYPOTHESIS TEST FOR THE PROBABILITY BOUND**********/
+/****************************************************************************/
+
+/* The test deciding on the probability bound */
+static int sim_test = DEF_SIM_TEST;
+
+/* The error probabilities of the sequential tests, 0 for 1 - confidence */
+static double sim_test_alpha = DEF_SIM_TEST_ERROR;
+static double sim_test_beta = DEF_SIM_TEST_ERROR;
+
+/**
+* Sets the test deciding on the probability bound.
+* @param _test one from {SIM_TEST_CONF_INT, SIM_TEST_SPRT, SIM_TEST_BAYES}
+*/
+void setSimTestMethod(int _test){
+	sim_test = _test;
+}
+
+/**
+* Gets the test deciding on the probability bound.
+* @return one from {SIM_TEST_CONF_INT, SIM_TEST_SPRT, SIM_TEST_BAYES}
+*/
+int getSimTestMethod(void) {
+	return sim_test;
+}
+
+/**
+* Sets the probability of the sequential tests to decide that the
+* probability lies below the indifference region while it lies above.
+* @param _alpha the error probability, 0 for 1 - confidence
+*/
+void setSimTestAlpha(double _alpha){
+	if( ( _alpha >= MIN_SIM_TEST_ERROR ) && ( _alpha < MAX_SIM_TEST_ERROR ) ){
+		sim_test_alpha = _alpha;
+	}else{
+		printf("WARNING: The error probability should be >= %e and < %e.\n",
+				MIN_SIM_TEST_ERROR, MAX_SIM_TEST_ERROR);
+		printf("WARNING: The set command is ignored.\n");
+	}
+}
+
+/**
+* Gets the probability of the sequential tests to decide that the
+* probability lies below the indifference region while it lies above.
+* @return the error probability, 0 stands for 1 - confidence
+*/
+double getSimTestAlpha(void) {
+	return sim_test_alpha;
+}
+
+/**
+* Sets the probability of the sequential tests to decide that the
+* probability lies above the indifference region while it lies below.
+* @param _beta the error probability, 0 for 1 - confidence
+*/
+void setSimTestBeta(double _beta){
+	if( ( _beta >= MIN_SIM_TEST_ERROR ) && ( _beta < MAX_SIM_TEST_ERROR ) ){
+		sim_test_beta = _beta;
+	}else{
+		printf("WARNING: The error probability should be >= %e and < %e.\n",
+				MIN_SIM_TEST_ERROR, MAX_SIM_TEST_ERROR);
+		printf("WARNING: The set command is ignored.\n");
+	}
+}
+
+/**
+* Gets the probability of the sequential tests to decide that the
+* probability lies above the indifference region while it lies below.
+* @return the error probability, 0 stands for 1 - confidence
+*/
+double getSimTestBeta(void) {
+	return sim_test_beta;
+}
+
+/****************************************************************************/
+/******************MANAGE THE IMPORTANCE SPLITTING PARAMETERS****************/
+/****************************************************************************/
+
+/* The number of trajectories per level, 0 for no splitting */
+static int sim_split_effort = DEF_SIM_SPLIT_EFFORT;
+
+/* The number of independent splitting runs */
+static int sim_split_runs = DEF_SIM_SPLIT_RUNS;
+
+/**
+* Sets the number of trajectories per level of the importance splitting.
+* @param _effort the number of trajectories per level, 0 for no splitting
+*/
+void setSimSplitEffort(int _effort){
+	if( (_effort >= MIN_SIM_SPLIT_EFFORT) && (_effort <= MAX_SIM_SPLIT_EFFORT) ){
+		sim_split_effort = _effort;
+	} else {
+		printf("WARNING: The number of trajectories per level should be >= %d and <= %d.\n",
+				MIN_SIM_SPLIT_EFFORT, MAX_SIM_SPLIT_EFFORT );
+		printf("WARNING: The 'set' command is ignored.\n");
+	}
+}
+
+/**
+* Gets the number of trajectories per level of the importance splitting.
+* @return the number of trajectories per level, 0 stands for no splitting
+*/
+int getSimSplitEffort(void) {
+	return sim_split_effort;
+}
+
+/**
+* Sets the number of independent runs of the importance splitting.
+* @param _runs the number of runs
+*/
+void setSimSplitRuns(int _runs){
+	if( (_runs >= MIN_SIM_SPLIT_RUNS) && (_runs <= MAX_SIM_SPLIT_RUNS) ){
+		sim_split_runs = _runs;
+	} else {
+		printf("WARNING: The number of splitting runs should be >= %d and <= %d.\n",
+				MIN_SIM_SPLIT_RUNS, MAX_SIM_SPLIT_RUNS );
+		printf("WARNING: The 'set' command is ignored.\n");
+	}
+}
+
+/**
+* Gets the number of independent runs of the importance splitting.
+* @return the number of runs
+*/
+int getSimSplitRuns(void) {
+	return sim_split_runs;
+}
+
+/****************************************************************************/
+/*****************MANAGE THE IMPORTANCE SAMPLING PARAMETERS******************/
+/****************************************************************************/
+
+/* The importance sampling method */
+static int sim_is_method = DEF_SIM_IS;
+
+/* The bias of the importance sampling */
+static double sim_is_bias = DEF_SIM_IS_BIAS;
+
+/* The rate threshold of the failure transitions */
+static double sim_is_failure_rate = DEF_SIM_IS_FAILURE_RATE;
+
+/**
+* Sets the importance sampling method of time-interval until.
+* @param _method one from {SIM_IS_NONE, SIM_IS_BFB, SIM_IS_ZVA}
+*/
+void setSimISMethod(int _method){
+	sim_is_method = _method;
+}
+
+/**
+* Gets the importance sampling method of time-interval until.
+* @return one from {SIM_IS_NONE, SIM_IS_BFB, SIM_IS_ZVA}
+*/
+int getSimISMethod(void) {
+	return sim_is_method;
+}
+
+/**
+* Sets the bias of the importance sampling.
+* @param _bias the bias in (0,1)
+*/
+void setSimISBias(double _bias){
+	if( ( _bias > MIN_SIM_IS_BIAS ) && ( _bias < MAX_SIM_IS_BIAS ) ){
+		sim_is_bias = _bias;
+	}else{
+		printf("WARNING: The importance sampling bias should be > %e and < %e.\n",
+				MIN_SIM_IS_BIAS, MAX_SIM_IS_BIAS);
+		printf("WARNING: The set command is ignored.\n");
+	}
+}
+
+/**
+* Gets the bias of the importance sampling.
+* @return the bias in (0,1)
+*/
+double getSimISBias(void) {
+	return sim_is_bias;
+}
+
+/**
+* Sets the rate threshold of the failure transitions.
+* @param _rate the rate threshold, 0 for the transitions that go down the
+*		distance to the Psi states
+*/
+void setSimISFailureRate(double _rate){
+	if( _rate >= 0.0 ){
+		sim_is_failure_rate = _rate;
+	}else{
+		printf("WARNING: The failure rate threshold should be >= %e.\n", 0.0);
+		printf("WARNING: The set command is ignored.\n");
+	}
+}
+
+/**
+* Gets the rate threshold of the failure transitions.
+* @return the rate threshold, 0 stands for the transitions that go down the
+*		distance to the Psi states
+*/
+double getSimISFailureRate(void) {
+	return sim_is_failure_rate;
+}
+
 /****************************************************************************/
 /*******************PRINT THE SIMULATION RUNTIME PARAMETERS******************/
 /****************************************************************************/
@@ -446,6 +702,58 @@ inline void printRuntimeSimInfo(BOOL isExpNeeded){
 		printf(" Min sample size\t = %d\n", getSimMinSampleSize() );
 		printf(" Sample-size step type\t = %s\n", (isSimSampleSizeStepAuto() ? "AUTO":"MANUAL" ) );
 		printf(" Sample-size step\t = %d\n", getSimSampleSizeStep() );
+		switch( getSimTestMethod() ){
+			case SIM_TEST_SPRT:
+				printf(" Probability-bound test\t = SPRT\n" );
+				break;
+			case SIM_TEST_BAYES:
+				printf(" Probability-bound test\t = BAYES\n" );
+				break;
+			default:
+				printf(" Probability-bound test\t = CONF. INT.\n" );
+		}
+		if( getSimTestMethod() != SIM_TEST_CONF_INT ){
+			printf(" Test error alpha\t = %e\n", getSimTestAlpha() );
+			printf(" Test error beta\t = %e\n", getSimTestBeta() );
+		}
+
+		if( getSimThreads() == 0 ){
+			printf(" Simulation threads\t = OFF\n" );
+		} else {
+			printf(" Simulation threads\t = %d\n", getSimThreads() );
+			if( getSimSeed() == 0 ){
+				printf(" Simulation seed\t = CLOCK\n" );
+			} else {
+				printf(" Simulation seed\t = %lu\n", getSimSeed() );
+			}
+		}
+
+		if( getSimSplitEffort() == 0 ){
+			printf(" Importance splitting\t = OFF\n" );
+		} else {
+			printf(" Split. level effort\t = %d\n", getSimSplitEffort() );
+			printf(" Split. runs\t\t = %d\n", getSimSplitRuns() );
+		}
+		switch( getSimISMethod() ){
+			case SIM_IS_BFB:
+				printf(" Importance sampling\t = BFB\n" );
+				break;
+			case SIM_IS_ZVA:
+				printf(" Importance sampling\t = ZVA\n" );
+				break;
+			default:
+				printf(" Importance sampling\t = OFF\n" );
+		}
+		if( getSimISMethod() != SIM_IS_NONE ){
+			printf(" Imp. sampling bias\t = %e\n", getSimISBias() );
+			if( getSimISMethod() == SIM_IS_BFB ){
+				if( getSimISFailureRate() > 0.0 ){
+					printf(" Failure rate threshold\t = %e\n", getSimISFailureRate() );
+				} else {
+					printf(" Failure rate threshold\t = DISTANCE\n" );
+				}
+			}
+		}
 
 		/* Print the runtime parameters of the random number generator */
 		printRuntimeRNGInfoDiscrete();
@@ -48,10 +48,12 @@
 #include "simulation_common.h"
 
 #include "simulation.h"
+#include "simulation_splitting.h"
 #include "simulation_utils.h"
 
 #include <gsl/gsl_cdf.h>
 #include <math.h>
+#include <time.h>
 
 /****************************************************************************/
 /********THE COMMON FUNCTION FOR INVOCATION THE SIMULATION PROCEDURE ********/
@@ -216,9 +218,12 @@ void modelCheckStatesCommon( const sparse * pStateSpace, const double confidence
 * @param pNoBitSet contains curr_state if it does not satisfy the formula
 * @param pNumUsedObserv the pointer to the return-value variable that will store the
 *		number of observations used for simulating this one state.
-* @param pTransAndGoodStatesArguments contain the two bitsets in the following order:
+* @param pTransAndGoodStatesArguments contain the two bitsets and the level
+*		function in the following order:
 *		1. pTransientStates the bitsets containing all the transient states
 *		2. pGoodStates the bitsets containing all the good absorbing states
+*		3. pLevels the level function of the importance splitting, if it
+*			is NULL the state is model checked by crude simulation
 */
 void modelCheckOneStateUUCommon( const sparse* pStateSpace, const int initial_state, const double indiff_width,
 					const double confidence, const int comparator, const double prob_bound,
@@ -228,6 +233,8 @@ void modelCheckOneStateUUCommon( const sparse* pStateSpace, const int initial_st
 	/* Contain the Transient states and also the Good absorbing states respectively */
 	bitset * pTransientStates = va_arg( pTransAndGoodStatesArguments, bitset * );
 	bitset * pGoodStates = va_arg( pTransAndGoodStatesArguments, bitset * );
+	/* Contains the level function of the importance splitting or NULL */
+	const int * pLevels = va_arg( pTransAndGoodStatesArguments, int * );
 
 	TV_LOGIC mc_result = TVL_NN;
 	double leftBorderOne = 0.0, rightBorderOne = 1.0, leftBorderTwo = 0.0, rightBorderTwo = 1.0;
@@ -253,9 +260,37 @@ void modelCheckOneStateUUCommon( const sparse* pStateSpace, const int initial_st
 	/* The odd/even iteration and invalid conf.int. indicators */
 	BOOL isOdd = TRUE, isInvalidCI = FALSE;
 
+	PTSampleVecUntil pSampleVecUntilOne = NULL, pSampleVecUntilTwo = NULL;
+
+	if( pLevels != NULL ){
+		/* Estimate the probability by importance splitting, the paths */
+		/* are cut at the maximum simulation depth and the conf. int. */
+		/* comes from the independent runs */
+		TSplittingModel model;
+
+		model.pStateSpace = pStateSpace;
+		model.pPhiBitSet = pTransientStates;
+		model.pPsiBitSet = pGoodStates;
+		model.pLevels = pLevels;
+		model.pExitRates = NULL;
+		model.left_time_bound = 0.0;
+		model.right_time_bound = max_simulation_depth;
+
+		*pNumUsedObserv = 0;
+		estimateBySplitting( &model, initial_state, getSimSplitEffort(), getSimSplitRuns(),
+					gsl_cdf_ugaussian_Pinv( 0.5 * ( 1 + confidence ) ),
+					&leftBorderOne, &rightBorderTwo, pNumUsedObserv );
+		mc_result = checkBoundVSConfInt( comparator, prob_bound, leftBorderOne, rightBorderTwo, indiff_width );
+
+		pCiLeftBorders[arr_index] = leftBorderOne;
+		pCiRightBorders[arr_index] = rightBorderTwo;
+		markYesNoSetEntree(mc_result, initial_state, pYesBitSet, pNoBitSet);
+		return;
+	}
+
 	/* Allocate and simulate the initial sample vectors */
-	PTSampleVecUntil pSampleVecUntilOne = allocateSampleVectorUntil( sample_size, initial_state );
-	PTSampleVecUntil pSampleVecUntilTwo = allocateSampleVectorUntil( sample_size, initial_state );
+	pSampleVecUntilOne = allocateSampleVectorUntil( sample_size, initial_state );
+	pSampleVecUntilTwo = allocateSampleVectorUntil( sample_size, initial_state );
 
 	/* Simulate observations in depth */
 	simulateSampleVectorUnbUntilDTMC( pStateSpace, pSampleVecUntilOne, sample_size, simulation_depth,
@@ -586,3 +621,314 @@ PTSampleVecSteady * prepareSSSimulationSample(const sparse * pStateSpace, const
     /* Return the initialised vector of SS samples */
     return pSampleVecSteady;
 }
+
+/****************************************************************************/
+/*****************THE SAMPLING INDEX OF THE SIMULATED MODEL******************/
+/****************************************************************************/
+
+/**
+* The model for which the sampling index was built, NULL if there is none.
+*/
+static /*@dependent@*/ /*@null@*/ const sparse * pSamplingModel = NULL;
+
+/**
+* For every row of pSamplingModel the start of its alias table in
+* pAliasProb and pAliasIdx, or -1 if the row has no alias table.
+*/
+static /*@only@*/ /*@null@*/ int * pAliasRowStart = NULL;
+
+/**
+* The acceptance probabilities of the alias tables of all rows.
+*/
+static /*@only@*/ /*@null@*/ double * pAliasProb = NULL;
+
+/**
+* The alias entries (row positions) of the alias tables of all rows.
+*/
+static /*@only@*/ /*@null@*/ int * pAliasIdx = NULL;
+
+/**
+* This function frees the sampling index built by buildSamplingIndex.
+*/
+void freeSamplingIndex(void) {
+        free(pAliasRowStart);
+        pAliasRowStart = NULL;
+        free(pAliasProb);
+        pAliasProb = NULL;
+        free(pAliasIdx);
+        pAliasIdx = NULL;
+        pSamplingModel = NULL;
+}
+
+/**
+* This function builds the sampling index of the given (embedded) DTMC: an
+* alias table for every row with at least SAMPLING_ALIAS_MIN_ROW_SIZE
+* off-diagonal entries.
+* WARNING: The index has to be freed before the values of pM change.
+* @param pM the sparse matrix of the embedded DTMC to be simulated
+*/
+void buildSamplingIndex(const sparse * pM) {
+        const int rows = mtx_rows(pM);
+        int row, width, max_width = 0, total_width = 0;
+        int * pWork = NULL;
+
+        freeSamplingIndex();
+
+        /* Find the rows that get an alias table */
+        for ( row = 0 ; row < rows ; row++ ) {
+                width = (int) mtx_next_num(pM, row);
+                if ( width >= SAMPLING_ALIAS_MIN_ROW_SIZE ) {
+                        total_width += width;
+                        if ( width > max_width ) {
+                                max_width = width;
+                        }
+                }
+        }
+        if ( 0 == total_width ) {
+                /* All rows are narrow, the cumulative scan is good enough */
+                return;
+        }
+
+        pAliasRowStart = (int *) malloc(rows * sizeof(int));
+        pAliasProb = (double *) malloc(total_width * sizeof(double));
+        pAliasIdx = (int *) malloc(total_width * sizeof(int));
+        pWork = (int *) malloc(max_width * sizeof(int));
+        if ( NULL == pAliasRowStart || NULL == pAliasProb || NULL == pAliasIdx
+                        || NULL == pWork )
+        {
+                free(pWork);
+                freeSamplingIndex();
+                (void) err_macro_1(err_MEMORY, "buildSamplingIndex(%p)",
+                                (const void *) pM, 0);
+                return;
+        }
+
+        total_width = 0;
+        for ( row = 0 ; row < rows ; row++ ) {
+                width = (int) mtx_next_num(pM, row);
+                if ( width >= SAMPLING_ALIAS_MIN_ROW_SIZE ) {
+                        pAliasRowStart[row] = total_width;
+                        buildAliasTable(pM->valstruc[row].val, width,
+                                        &pAliasProb[total_width],
+                                        &pAliasIdx[total_width], pWork);
+                        total_width += width;
+                } else {
+                        pAliasRowStart[row] = -1;
+                }
+        }
+        free(pWork);
+        pSamplingModel = pM;
+}
+
+/**
+* This function computes to which state we will go from a state that has
+* outgoing off-diagonal transitions.
+* @param pM the sparse matrix describing the state space
+* @param current_obs_state the current state index
+* @return the next state
+*/
+state_index sampleNextState(const sparse * pM, state_index current_obs_state) {
+        const int * cols = pM->valstruc[current_obs_state].col;
+        const int width = (int) mtx_next_num(pM, current_obs_state);
+        int start;
+
+        if ( pM == pSamplingModel && NULL != pAliasRowStart
+                        && (start = pAliasRowStart[current_obs_state]) >= 0 )
+        {
+                return generateRandNumberAlias(cols, &pAliasProb[start],
+                                &pAliasIdx[start], width);
+        }
+        return generateRandNumberDiscrete(cols,
+                        pM->valstruc[current_obs_state].val, width);
+}
+
+/**
+* This function computes to which state we will go with the given uniformly
+* distributed random number.
+* @param pM the sparse matrix describing the state space
+* @param current_obs_state the current state index
+* @param unif_rand a uniformly distributed random number in [0,1)
+* @return the next state, current_obs_state if it is absorbing
+*/
+state_index chooseNextState(const sparse * pM, state_index current_obs_state,
+                const double unif_rand) {
+        const int * cols = pM->valstruc[current_obs_state].col;
+        const int width = (int) mtx_next_num(pM, current_obs_state);
+        int start;
+
+        if ( 0 == width ) {
+                return current_obs_state;
+        }
+        if ( pM == pSamplingModel && NULL != pAliasRowStart
+                        && (start = pAliasRowStart[current_obs_state]) >= 0 )
+        {
+                return chooseRandNumberAlias(cols, &pAliasProb[start],
+                                &pAliasIdx[start], width, unif_rand);
+        }
+        return chooseRandNumberDiscrete(cols,
+                        pM->valstruc[current_obs_state].val, width, unif_rand);
+}
+
+/****************************************************************************/
+/*********************THE SIMULATION MODEL OF THE CTMC***********************/
+/****************************************************************************/
+
+/**
+* The simulation model built by getSimulationModel, its pEmbeddedDTMC is
+* NULL if there is none.
+*/
+static TSimulationModel simulation_model = { NULL, NULL, NULL, NULL, NULL };
+
+/**
+* This function frees the simulation model built by getSimulationModel
+* together with its sampling index.
+*/
+void freeSimulationModel(void) {
+        if ( NULL != simulation_model.pEmbeddedDTMC ) {
+                if ( pSamplingModel == simulation_model.pEmbeddedDTMC ) {
+                        freeSamplingIndex();
+                }
+                (void) free_sparse_ncolse(simulation_model.pEmbeddedDTMC);
+        }
+        free(simulation_model.pExitRates);
+        free(simulation_model.pHoldingTimes);
+        simulation_model.pRateMatrix = NULL;
+        simulation_model.pRowSums = NULL;
+        simulation_model.pEmbeddedDTMC = NULL;
+        simulation_model.pExitRates = NULL;
+        simulation_model.pHoldingTimes = NULL;
+}
+
+/**
+* This function returns the simulation model of the given CTMC: the embedded
+* DTMC without the self loops with its sampling index, the exit rates and the
+* mean holding times of all states. The model is built on the first call and
+* kept for the following ones with the same rate matrix.
+* @param pRateMatrix the rate matrix of the CTMC
+* @param pRowSums the row sums of pRateMatrix
+* @return the simulation model
+*/
+const TSimulationModel * getSimulationModel(const sparse * pRateMatrix,
+                const double * pRowSums) {
+        const int rows = mtx_rows(pRateMatrix);
+        int row, i, width;
+        int * pNumCols = NULL;
+        double exit_rate;
+        sparse * pM = NULL;
+
+        if ( NULL != simulation_model.pEmbeddedDTMC
+                        && simulation_model.pRateMatrix == pRateMatrix
+                        && simulation_model.pRowSums == pRowSums )
+        {
+                return &simulation_model;
+        }
+        freeSimulationModel();
+
+        /* The embedded DTMC has the off-diagonal structure of the rate matrix */
+        pNumCols = (int *) malloc(rows * sizeof(int));
+        simulation_model.pExitRates = (double *) calloc((size_t) rows,
+                        sizeof(double));
+        simulation_model.pHoldingTimes = (double *) calloc((size_t) rows,
+                        sizeof(double));
+        if ( NULL == pNumCols || NULL == simulation_model.pExitRates
+                        || NULL == simulation_model.pHoldingTimes )
+        {
+                exit(err_macro_4(err_MEMORY, "getSimulationModel(%p[%dx%d],%p)",
+                                (const void *) pRateMatrix, rows,
+                                mtx_cols(pRateMatrix), (const void *) pRowSums,
+                                EXIT_FAILURE));
+        }
+        for ( row = 0 ; row < rows ; row++ ) {
+                pNumCols[row] = (int) mtx_next_num(pRateMatrix, row);
+        }
+        pM = allocate_sparse_matrix_ncolse(rows, mtx_cols(pRateMatrix),
+                        pNumCols);
+        free(pNumCols);
+        if ( NULL == pM ) {
+                exit(err_macro_4(err_CALLBY, "getSimulationModel(%p[%dx%d],%p)",
+                                (const void *) pRateMatrix, rows,
+                                mtx_cols(pRateMatrix), (const void *) pRowSums,
+                                EXIT_FAILURE));
+        }
+
+        /* Normalize the off-diagonal rates by the exit rates once, */
+        /* the simulation steps then only look them up */
+        for ( row = 0 ; row < rows ; row++ ) {
+                width = (int) mtx_next_num(pRateMatrix, row);
+                if ( width > 0 ) {
+                        exit_rate = pRowSums[row]
+                                        - mtx_get_diag_val_nt(pRateMatrix, row);
+                        if ( exit_rate <= 0.0 ) {
+                                exit(err_macro_4(err_INCONSISTENT,
+                                        "getSimulationModel(%p[%dx%d],%p)",
+                                        (const void *) pRateMatrix, rows,
+                                        mtx_cols(pRateMatrix),
+                                        (const void *) pRowSums,
+                                        (free_sparse_ncolse(pM),
+                                         freeSimulationModel(), EXIT_FAILURE)));
+                        }
+                        simulation_model.pExitRates[row] = exit_rate;
+                        simulation_model.pHoldingTimes[row] = 1.0 / exit_rate;
+                        for ( i = 0 ; i < width ; i++ ) {
+                                pM->valstruc[row].col[i] =
+                                        pRateMatrix->valstruc[row].col[i];
+                                pM->valstruc[row].val[i] =
+                                        pRateMatrix->valstruc[row].val[i]
+                                                / exit_rate;
+                        }
+                        pM->valstruc[row].ncols = width;
+                }
+        }
+
+        simulation_model.pRateMatrix = pRateMatrix;
+        simulation_model.pRowSums = pRowSums;
+        simulation_model.pEmbeddedDTMC = pM;
+        buildSamplingIndex(pM);
+        return &simulation_model;
+}
+
+/****************************************************************************/
+/****************THE RANDOM-NUMBER STREAMS OF PARALLEL SIMULATION************/
+/****************************************************************************/
+
+/**
+* The streams of the parallel simulation, one per simulation thread.
+*/
+static /*@only@*/ /*@null@*/ TRNGStream * pSimStreams = NULL;
+
+/**
+* This function frees the streams of the parallel simulation.
+*/
+void freeSimulationStreams(void) {
+        free(pSimStreams);
+        pSimStreams = NULL;
+}
+
+/**
+* This function returns the streams of the parallel simulation, one for
+* each of the getSimThreads() threads but at least one, and creates them
+* if needed.
+* @return the array of streams
+*/
+TRNGStream * getSimulationStreams(void) {
+        TRNGStream stream;
+        /* The sequential importance splitting uses one stream as well */
+        const int threads = ( getSimThreads() > 0 ? getSimThreads() : 1 );
+        int t;
+
+        if ( NULL == pSimStreams ) {
+                pSimStreams = (TRNGStream *) malloc(threads
+                                * sizeof(TRNGStream));
+                if ( NULL == pSimStreams ) {
+                        exit(err_macro_0(err_MEMORY,
+                                "getSimulationStreams()", EXIT_FAILURE));
+                }
+                seedRNGStream(&stream, 0 != getSimSeed() ? getSimSeed()
+                                : (unsigned long) time(NULL));
+                for ( t = 0 ; t < threads ; t++ ) {
+                        pSimStreams[t] = stream;
+                        jumpRNGStream(&stream);
+                }
+        }
+        return pSimStreams;
+}
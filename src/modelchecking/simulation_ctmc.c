@@ -50,6 +50,8 @@
 
 #include "simulation_common.h"
 #include "simulation.h"
+#include "simulation_importance.h"
+#include "simulation_splitting.h"
 #include "transient_common.h"
 
 #include <gsl/gsl_cdf.h>
@@ -156,10 +158,11 @@ void modelCheckUnboundedUntilCTMC(sparse * pStateSpace,
                                                 const BOOL
                                                 isSimOneInitState_local,
 						unsigned int * pMaxNumUsedObserv ){
-	int *pTransientStateIdx=NULL;
-	/* This vector will store the exit rates for the elements of pTransientBitSet*/
-	double * pExitRatesOfTransStates = NULL;
+	/* The embedded DTMC (WITHOUT THE SELF LOOPS!!!) and the exit rates */
+	const TSimulationModel * pSimModel = NULL;
         bitset * pAUBitSet = NULL, *pBadBitSet = NULL, *pTransientBitSet = NULL;
+	/* The level function of the importance splitting, if it is on */
+	int * pLevels = NULL;
 
         /* 0: Sort out the 1.0 and 0.0 prob reachable states */
 	bitset * pEUBitSet = get_exist_until( pStateSpace, pPhiBitSet, pPsiBitSet );
@@ -181,19 +184,7 @@ void modelCheckUnboundedUntilCTMC(sparse * pStateSpace,
                                         == NULL
 	/* 1.3: At this point pTransientBitSet contains only allowed transient states */
 	/* from which there is a way to go to Psi states via Phi states with prob < 1.0 */
-                        || err_state_iserror(not_result(pTransientBitSet))
-
-	/* print_mtx_sparse(pStateSpace); */
-
-	/* 3: Make states absorbing */
-                        || (pTransientStateIdx = count_set(pTransientBitSet))
-                                        == NULL
-
-	/* 4: Obtain the embedded DTMC (WITHOUT THE SELF LOOPS!!!) */
-                        || (pExitRatesOfTransStates =
-                                        make_embedded_dtmc_out_of_rate_mtx_vs(
-                                        pStateSpace, pCTMCRowSums,
-                                        pTransientStateIdx)) == NULL )
+                        || err_state_iserror(not_result(pTransientBitSet)) )
         {
                 exit(err_macro_19(err_CALLBY, "modelCheckUnboundedUntilCTMC(%p"
                         "[%dx%d],%p,%g,%p[%d],%p[%d],%p,%p,%p,%p,%p,%d,%g,%d,"
@@ -211,56 +202,39 @@ void modelCheckUnboundedUntilCTMC(sparse * pStateSpace,
                                 NULL == pBadBitSet || (free_bitset(pBadBitSet),
                                     NULL == pTransientBitSet
                                             || (free_bitset(pTransientBitSet),
-                                        free(pTransientStateIdx), FALSE))))),
+                                        FALSE))))),
                         EXIT_FAILURE)));
         }
 
-	/* print_mtx_sparse(pStateSpace); */
+	/* 2: Obtain the embedded DTMC (WITHOUT THE SELF LOOPS!!!), the states */
+	/* that are not transient are absorbing because we stop in them */
+	pSimModel = getSimulationModel( pStateSpace, pCTMCRowSums );
 
-	/* 5: Construct the pGoodStates and pTransientStates sets */
+	/* 3: Construct the pGoodStates and pTransientStates sets */
 	/* NOTE: They are already constructed, namely: pAUBitSet and pTransientBitSet */
 
-	/* 6: Do simulations */
-	modelCheckStatesCommon( pStateSpace, confidence, ppYesBitsetResult, ppNoBitsetResult, ppProbCILeftBorder,
+	/* 4: Do simulations, the importance splitting goes */
+	/* down the distance to the good absorbing states */
+	if( getSimSplitEffort() > 0 ){
+		pLevels = computeSplittingLevels( pStateSpace, pTransientBitSet, pAUBitSet );
+	}
+	modelCheckStatesCommon( pSimModel->pEmbeddedDTMC, confidence, ppYesBitsetResult, ppNoBitsetResult, ppProbCILeftBorder,
 				ppProbCIRightBorder, pResultSize, comparator, prob_bound, initial_state,
                                 isSimOneInitState_local, pTransientBitSet,
                                 pMaxNumUsedObserv, modelCheckOneStateUUCommon,
-				pTransientBitSet, pAUBitSet );
+				pTransientBitSet, pAUBitSet, pLevels );
+	free( pLevels );
 
-	/* 7.1: Update ppYesBitsetResult and ppNoBitsetResult with pAUBitSet and pBadBitSet states. */
+	/* 5.1: Update ppYesBitsetResult and ppNoBitsetResult with pAUBitSet and pBadBitSet states. */
         considerAlwaysAndNeverStates(isSimOneInitState_local,
                                         * ppYesBitsetResult, * ppNoBitsetResult,
 					pAUBitSet, pBadBitSet, initial_state, comparator, prob_bound );
-	/* 7.2: Update ppProbCILeftBorder and ppProbCIRightBorder with probability 1.0 for pAUBitSet states. */
+	/* 5.2: Update ppProbCILeftBorder and ppProbCIRightBorder with probability 1.0 for pAUBitSet states. */
         updateConfIntAlwaysStates(isSimOneInitState_local, ppProbCILeftBorder,
                                          ppProbCIRightBorder, pResultSize,
 					 pAUBitSet, initial_state );
 
-	/* 8: Restore the state space */
-	/* NOTE: not required for diagonal elements */
-        if ( err_state_iserror(restore_rate_mtx_out_of_embedded_dtmc_vs(
-                                pStateSpace, pTransientStateIdx,
-                                pExitRatesOfTransStates)) )
-        {
-                exit(err_macro_19(err_CALLBY, "modelCheckUnboundedUntilCTMC(%p"
-                        "[%dx%d],%p,%g,%p[%d],%p[%d],%p,%p,%p,%p,%p,%d,%g,%d,"
-                        "%d,%p)", (void *) pStateSpace, mtx_rows(pStateSpace),
-                        mtx_cols(pStateSpace), (const void *) pCTMCRowSums,
-                        confidence, (const void *) pPhiBitSet,
-                        bitset_size(pPhiBitSet), (const void *) pPsiBitSet,
-                        bitset_size(pPsiBitSet), (void *) ppYesBitsetResult,
-                        (void *) ppNoBitsetResult, (void *) ppProbCILeftBorder,
-                        (void *) ppProbCIRightBorder, (void *) pResultSize,
-                        comparator, prob_bound, initial_state,
-                        isSimOneInitState_local, (void *) pMaxNumUsedObserv,
-                        EXIT_FAILURE));
-        }
-
-	/* print_mtx_sparse(pStateSpace); */
-
-	/* 9: Free the resources */
-	free( pExitRatesOfTransStates );
-	free( pTransientStateIdx );
+	/* 6: Free the resources */
 	free_bitset( pEUBitSet );
 	free_bitset( pAUBitSet );
 	free_bitset( pBadBitSet );
@@ -275,15 +249,16 @@ void modelCheckUnboundedUntilCTMC(sparse * pStateSpace,
  * This function computes when we will leave the state.
  * In addition to that for an absorbing current state the time of leaving the state is
  * set to be right_time_bound + 1.0 in order to avoid further simulations
- * @param current_exit_rate the exit rate of the current state
+ * @param current_holding_time the mean holding time of the current state,
+ *	0.0 for an absorbing state
  * @param right_time_bound the right time bound of the until
  * @return the next exit time
  */
-static inline double computeExitTime( const double current_exit_rate, const double right_time_bound ){
+static inline double computeExitTime( const double current_holding_time, const double right_time_bound ){
 	/* If we are not in an absorbing state */
-	if( current_exit_rate != 0.0 ){
+	if( current_holding_time != 0.0 ){
 		/* Compute when we leave the current state */
-		return generateRandNumberExp( current_exit_rate );
+		return generateRandNumberExp( 1.0 ) * current_holding_time;
 	} else {
 		/* If we are absorbed in a Phi state which might be also a Psi state */
 		/* then we just go beyond the time interval to stop further iterations */
@@ -291,9 +266,222 @@ static inline double computeExitTime( const double current_exit_rate, const doub
 	}
 }
 
+/**
+ * This function computes when we will leave the state, like computeExitTime,
+ * but from the given exponentially distributed random number with rate 1.
+ * @param current_holding_time the mean holding time of the current state,
+ *	0.0 for an absorbing state
+ * @param right_time_bound the right time bound of the until
+ * @param exp_rand an exponentially distributed random number with rate 1
+ * @return the next exit time
+ */
+static inline double computeExitTimeExp( const double current_holding_time, const double right_time_bound,
+					const double exp_rand ){
+	if( current_holding_time != 0.0 ){
+		return exp_rand * current_holding_time;
+	} else {
+		return right_time_bound + 1.0;
+	}
+}
+
+/**
+* This function simulates one observation for interval until CTMC:
+* "Phi U[tl, tr] Psi".
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pStateSpace the sparse matrix of the embedded DTMC
+* @param initial_state the state the observation starts in
+* @param pNotPhiAndNotPsiBitSet the bitsets containing all
+*	not Phi and not Psi states
+* @param pPhiBitSet the bitsets containing all the Phi
+* @param pPsiBitSet the bitsets containing all the Psi
+* @param left_time_bound the left time bound "tl"
+* @param right_time_bound the right time bound "tr"
+* @param pHoldingTimes the array of mean holding times, 0.0 for the absorbing states,
+*	note that its size corresponds to the dimensions of pStateSpace
+* @param pVisitedStates the counter of simulated states, it is increased
+* @return TRUE if the observation ended up in a Psi state in the right time
+*/
+static BOOL simulateIntUntilObservationCTMC( const sparse * pStateSpace, const int initial_state,
+					const bitset * pNotPhiAndNotPsiBitSet, const bitset * pPhiBitSet,
+					const bitset * pPsiBitSet, const double left_time_bound,
+					const double right_time_bound, const double * pHoldingTimes,
+					unsigned int * pVisitedStates ){
+	/* Take the initial state index */
+	int current_obs_state = initial_state;
+	/* We start in the initial state at time 0.0 */
+	double current_obs_enter_time = 0.0;
+	/* Compute when we leave the initial state */
+	double current_obs_exit_time = computeExitTime( pHoldingTimes[current_obs_state],
+								right_time_bound );
+
+	/* printf("\n----------------------------------------------------\n"); */
+	/* printf("I: (%s) state %d exit at %e \n", (isInitialPartFailed? "-": "+"),
+			current_obs_state+1, current_obs_exit_time ); */
+
+	/* Iterate while we go through Phi states until left_time_bound */
+	while( ( current_obs_exit_time <= left_time_bound ) && get_bit_val( pPhiBitSet, current_obs_state ) ){
+		/* Go through the states until */
+		current_obs_state = computeNextState(pStateSpace,
+						current_obs_state);
+		current_obs_enter_time = current_obs_exit_time;
+		current_obs_exit_time += computeExitTime( pHoldingTimes[current_obs_state],
+								right_time_bound );
+		/* The next state was simulated */
+		(*pVisitedStates)++;
+	}
+
+	/* printf("M: (%s) state %d exit at %e \n", (isInitialPartFailed? "-": "+"),
+			current_obs_state+1, current_obs_exit_time ); */
+
+	if( ( current_obs_enter_time == left_time_bound ) || get_bit_val( pPhiBitSet, current_obs_state ) ){
+		/* Iterate while we go through Phi states */
+		while( ! get_bit_val( pNotPhiAndNotPsiBitSet, current_obs_state ) &&
+			! get_bit_val( pPsiBitSet, current_obs_state) &&
+			( current_obs_exit_time <= right_time_bound ) ){
+			/* While we are not in a bad state not in the target state and before right_time_bound */
+			current_obs_state = computeNextState(pStateSpace,
+						current_obs_state);
+			current_obs_exit_time += computeExitTime( pHoldingTimes[current_obs_state],
+								right_time_bound );
+			/* The next state was simulated */
+			(*pVisitedStates)++;
+		}
+
+		/* printf("F: (%s) state %d exit at %e \n",
+			( get_bit_val( pPsiBitSet, current_obs_state) ? "+": "-"),
+			current_obs_state+1, current_obs_exit_time ); */
+
+		/* We ended up in a Psi state in the right time */
+		return get_bit_val( pPsiBitSet, current_obs_state ) ? TRUE : FALSE;
+	}
+	return FALSE;
+}
+
+/* The lane of the time-interval until simulation goes through Phi states */
+/* until the left time bound, this corresponds to the first loop of */
+/* simulateIntUntilObservationCTMC */
+#define LANE_BEFORE_LEFT_BOUND 0
+/* The lane goes through Phi states until the right time bound, this */
+/* corresponds to the second loop of simulateIntUntilObservationCTMC */
+#define LANE_BEFORE_RIGHT_BOUND 1
+
+/**
+* This function simulates num_obs observations for interval until CTMC by
+* lanes: up to SIM_LANES observations make a step together, the random
+* numbers for the successor states and the exit times of a step are drawn
+* at once and a finished lane is refilled with the next observation.
+* Every lane follows the same rules as simulateIntUntilObservationCTMC.
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pStateSpace the sparse matrix of the embedded DTMC
+* @param initial_state the state the observations start in
+* @param num_obs the number of observations to simulate
+* @param pNotPhiAndNotPsiBitSet the bitsets containing all
+*	not Phi and not Psi states
+* @param pPhiBitSet the bitsets containing all the Phi
+* @param pPsiBitSet the bitsets containing all the Psi
+* @param left_time_bound the left time bound "tl"
+* @param right_time_bound the right time bound "tr"
+* @param pHoldingTimes the array of mean holding times, 0.0 for the absorbing states,
+*	note that its size corresponds to the dimensions of pStateSpace
+* @param pStream the stream to draw from
+* @param pVisitedStates the counter of simulated states, it is increased
+* @return the number of observations that ended up in a Psi state in the right time
+*/
+static int simulateIntUntilLanesCTMC( const sparse * pStateSpace, const int initial_state,
+					const int num_obs, const bitset * pNotPhiAndNotPsiBitSet,
+					const bitset * pPhiBitSet, const bitset * pPsiBitSet,
+					const double left_time_bound, const double right_time_bound,
+					const double * pHoldingTimes, TRNGStream * pStream,
+					unsigned int * pVisitedStates ){
+	/* The current states, phases, enter and exit times of the lanes */
+	int lane_state[SIM_LANES], lane_phase[SIM_LANES];
+	double lane_enter_time[SIM_LANES], lane_exit_time[SIM_LANES];
+	/* The random numbers of one step, the exponentially distributed */
+	/* ones come from the ziggurat method and have rate 1 */
+	double lane_unif[SIM_LANES], lane_exp[SIM_LANES];
+	/* The buffered words of the stream */
+	TRandWordSource source;
+	int active = 0, started = 0, sum_good = 0, k, first_new;
+	BOOL isFinished;
+
+	initRandWordSource( &source, fillRandWordsStream, pStream );
+	for( ; ; ){
+		/* Fill the free lanes with new observations */
+		first_new = active;
+		while( active < SIM_LANES && started < num_obs ){
+			lane_state[active] = initial_state;
+			lane_phase[active] = LANE_BEFORE_LEFT_BOUND;
+			lane_enter_time[active] = 0.0;
+			started++;
+			active++;
+		}
+		fillRandExpWords( &source, lane_exp, active - first_new );
+		for( k = first_new; k < active; k++ ){
+			lane_exit_time[k] = computeExitTimeExp( pHoldingTimes[initial_state],
+							right_time_bound, lane_exp[k - first_new] );
+		}
+
+		/* Retire the finished lanes, the last lane takes the free place */
+		for( k = 0; k < active; ){
+			isFinished = FALSE;
+			if( lane_phase[k] == LANE_BEFORE_LEFT_BOUND &&
+				! ( lane_exit_time[k] <= left_time_bound && get_bit_val( pPhiBitSet, lane_state[k] ) ) ){
+				if( lane_enter_time[k] == left_time_bound || get_bit_val( pPhiBitSet, lane_state[k] ) ){
+					lane_phase[k] = LANE_BEFORE_RIGHT_BOUND;
+				} else {
+					isFinished = TRUE;
+				}
+			}
+			if( lane_phase[k] == LANE_BEFORE_RIGHT_BOUND &&
+				( get_bit_val( pNotPhiAndNotPsiBitSet, lane_state[k] ) ||
+				  get_bit_val( pPsiBitSet, lane_state[k] ) ||
+				  lane_exit_time[k] > right_time_bound ) ){
+				if( get_bit_val( pPsiBitSet, lane_state[k] ) ){
+					sum_good++;
+				}
+				isFinished = TRUE;
+			}
+			if( isFinished ){
+				active--;
+				lane_state[k] = lane_state[active];
+				lane_phase[k] = lane_phase[active];
+				lane_enter_time[k] = lane_enter_time[active];
+				lane_exit_time[k] = lane_exit_time[active];
+			} else {
+				k++;
+			}
+		}
+		if( active == 0 ){
+			if( started == num_obs ){
+				break;
+			}
+			continue;
+		}
+
+		/* Make one step in every lane */
+		fillRandUnifWords( &source, lane_unif, active );
+		fillRandExpWords( &source, lane_exp, active );
+		for( k = 0; k < active; k++ ){
+			lane_state[k] = chooseNextState( pStateSpace, lane_state[k], lane_unif[k] );
+			if( lane_phase[k] == LANE_BEFORE_LEFT_BOUND ){
+				lane_enter_time[k] = lane_exit_time[k];
+			}
+			lane_exit_time[k] += computeExitTimeExp( pHoldingTimes[lane_state[k]],
+							right_time_bound, lane_exp[k] );
+		}
+		(*pVisitedStates) += active;
+	}
+	return sum_good;
+}
+
 /**
 * This function is designed to simulate the new sample observations for interval
 * until CTMC: "Phi U[tl, tr] Psi".
+* If there are simulation threads, the new observations are divided in
+* contiguous chunks, one per thread, and every thread simulates its chunk
+* by lanes with its own stream. The counts of the threads are added up
+* before the conf. int. is checked, so the result does not depend on the
+* thread scheduling.
 * WARNING: We simulate the states ASSUMING there are no self loops!
 * @param pStateSpace the sparse matrix of the embedded DTMC
 * @param pSampleVecIntUntil the sample vector obtained on the previous iteration
@@ -304,72 +492,51 @@ static inline double computeExitTime( const double current_exit_rate, const doub
 * @param pPsiBitSet the bitsets containing all the Psi
 * @param left_time_bound the left time bound "tl"
 * @param right_time_bound the right time bound "tr"
-* @param pExitRatesOfAllowedStates the array of exit rates for the "not pNotPhiAndNotPsiBitSet"
-*	states, not that its size corresponds to the dimensions of pStateSpace
+* @param pHoldingTimes the array of mean holding times, 0.0 for the absorbing states,
+*	note that its size corresponds to the dimensions of pStateSpace
 */
 static void simulateIntUntilSampleCTMC( const sparse * pStateSpace, PTSampleVecIntUntil pSampleVecIntUntil,
 										const int old_sample_size, const bitset * pNotPhiAndNotPsiBitSet,
 										const bitset * pPhiBitSet, const bitset * pPsiBitSet,
 										const double left_time_bound, const double right_time_bound,
-										const double * pExitRatesOfAllowedStates ){
-	int i, current_obs_state;
-	double current_obs_enter_time, current_obs_exit_time;
+										const double * pHoldingTimes ){
+	int i;
 	/* Will store the number of newly simulated observations */
 	unsigned int newlyVisitedStates = 0;
 
 	/* Cast to the parent structure which contains initial_state and curr_sample_size */
 	PTSampleVec pSampleVecIntUntilBase = (PTSampleVec) pSampleVecIntUntil;
-
-	/* For all the newly added observation in the sample */
-	for( i = 0; i < ( pSampleVecIntUntilBase->curr_sample_size - old_sample_size ) ; i++ ){
-		/* Take the initial state index */
-		current_obs_state = pSampleVecIntUntilBase->initial_state;
-		/* We start in the initial state at time 0.0 */
-		current_obs_enter_time = 0.0;
-		/* Compute when we leave the initial state */
-		current_obs_exit_time = computeExitTime( pExitRatesOfAllowedStates[current_obs_state], right_time_bound );
-
-		/* printf("\n----------------------------------------------------\n"); */
-		/* printf("I: (%s) state %d exit at %e \n", (isInitialPartFailed? "-": "+"),
-				current_obs_state+1, current_obs_exit_time ); */
-
-		/* Iterate while we go through Phi states until left_time_bound */
-		while( ( current_obs_exit_time <= left_time_bound ) && get_bit_val( pPhiBitSet, current_obs_state ) ){
-			/* Go through the states until */
-                        current_obs_state = computeNextState(pStateSpace,
-                                                current_obs_state);
-			current_obs_enter_time = current_obs_exit_time;
-			current_obs_exit_time += computeExitTime( pExitRatesOfAllowedStates[current_obs_state],
-									right_time_bound );
-			/* The next state was simulated */
-			newlyVisitedStates++;
+	const int new_observations = pSampleVecIntUntilBase->curr_sample_size - old_sample_size;
+	const int threads = getSimThreads();
+
+	if( threads > 0 ){
+		TRNGStream * pStreams = getSimulationStreams();
+		int sum_good = 0;
+
+		/* Every thread simulates its chunk of the new observations */
+#		ifdef _OPENMP
+#		pragma omp parallel for num_threads(threads) schedule(static, 1) reduction(+:sum_good,newlyVisitedStates)
+#		endif
+		for( i = 0; i < threads; i++ ){
+			sum_good += simulateIntUntilLanesCTMC( pStateSpace, pSampleVecIntUntilBase->initial_state,
+						SIM_CHUNK_START( new_observations, threads, i + 1 )
+						- SIM_CHUNK_START( new_observations, threads, i ),
+						pNotPhiAndNotPsiBitSet, pPhiBitSet, pPsiBitSet,
+						left_time_bound, right_time_bound,
+						pHoldingTimes, &pStreams[i],
+						&newlyVisitedStates );
 		}
-
-		/* printf("M: (%s) state %d exit at %e \n", (isInitialPartFailed? "-": "+"),
-				current_obs_state+1, current_obs_exit_time ); */
-
-		if( ( current_obs_enter_time == left_time_bound ) || get_bit_val( pPhiBitSet, current_obs_state ) ){
-			/* Iterate while we go through Phi states */
-			while( ! get_bit_val( pNotPhiAndNotPsiBitSet, current_obs_state ) &&
-				! get_bit_val( pPsiBitSet, current_obs_state) &&
-				( current_obs_exit_time <= right_time_bound ) ){
-				/* While we are not in a bad state not in the target state and before right_time_bound */
-                                current_obs_state=computeNextState(pStateSpace,
-									current_obs_state );
-				current_obs_exit_time += computeExitTime( pExitRatesOfAllowedStates[current_obs_state],
-									right_time_bound );
-				/* The next state was simulated */
-				newlyVisitedStates++;
-			}
-
+		pSampleVecIntUntil->sum_good += sum_good;
+	} else {
+		/* For all the newly added observation in the sample */
+		for( i = 0; i < new_observations ; i++ ){
 			/* Update the sum_good field if we ended up in a Psi state in the right time */
-			if( get_bit_val( pPsiBitSet, current_obs_state) ){
+			if( simulateIntUntilObservationCTMC( pStateSpace, pSampleVecIntUntilBase->initial_state,
+							pNotPhiAndNotPsiBitSet, pPhiBitSet, pPsiBitSet,
+							left_time_bound, right_time_bound,
+							pHoldingTimes, &newlyVisitedStates ) ){
 				pSampleVecIntUntil->sum_good += 1;
 			}
-
-			/* printf("F: (%s) state %d exit at %e \n",
-				( get_bit_val( pPsiBitSet, current_obs_state) ? "+": "-"),
-				current_obs_state+1, current_obs_exit_time ); */
 		}
 	}
 
@@ -394,20 +561,20 @@ static void simulateIntUntilSampleCTMC( const sparse * pStateSpace, PTSampleVecI
 * @param pPsiBitSet the bitsets containing all the Psi
 * @param left_time_bound the left time bound "tl"
 * @param right_time_bound the right time bound "tr"
-* @param pExitRatesOfAllowedStates the array of exit rates for the "not pNotPhiAndNotPsiBitSet"
-*	states, not that its size corresponds to the dimensions of pStateSpace
+* @param pHoldingTimes the array of mean holding times, 0.0 for the absorbing states,
+*	note that its size corresponds to the dimensions of pStateSpace
 */
 static void simulateSampleVectorIntUntilCTMC( const sparse * pStateSpace, PTSampleVecIntUntil pSampleVecIntUntil,
 					const int new_sample_size, const bitset * pNotPhiAndNotPsiBitSet,
 					const bitset * pPhiBitSet, const bitset * pPsiBitSet, const double left_time_bound,
-					const double right_time_bound, const double * pExitRatesOfAllowedStates ){
+					const double right_time_bound, const double * pHoldingTimes ){
 	IF_SAFETY( pSampleVecIntUntil != NULL )
 		/* Cast to the parent structure which contains initial_state and curr_sample_size */
 		PTSampleVec pSampleVecIntUntilBase = (PTSampleVec) pSampleVecIntUntil;
 
 		IF_SAFETY( ( pNotPhiAndNotPsiBitSet != NULL ) && ( pPhiBitSet != NULL ) && ( pPsiBitSet != NULL ) )
 			IF_SAFETY( pStateSpace != NULL )
-				IF_SAFETY( pExitRatesOfAllowedStates != NULL )
+				IF_SAFETY( pHoldingTimes != NULL )
 					IF_SAFETY( pSampleVecIntUntilBase->curr_sample_size < new_sample_size )
 						const int old_sample_size = pSampleVecIntUntilBase->curr_sample_size;
 
@@ -417,7 +584,7 @@ static void simulateSampleVectorIntUntilCTMC( const sparse * pStateSpace, PTSamp
 						/*Do simulations for the newly added observations */
 						simulateIntUntilSampleCTMC( pStateSpace, pSampleVecIntUntil, old_sample_size,
 									pNotPhiAndNotPsiBitSet, pPhiBitSet, pPsiBitSet,
-									left_time_bound, right_time_bound, pExitRatesOfAllowedStates );
+									left_time_bound, right_time_bound, pHoldingTimes );
 					ELSE_SAFETY
 						printf("ERROR: The sample size is not going to increase, there is nothing to simulate.\n");
                                                 exit(EXIT_FAILURE);
@@ -440,6 +607,36 @@ static void simulateSampleVectorIntUntilCTMC( const sparse * pStateSpace, PTSamp
 	ENDIF_SAFETY
 }
 
+/**
+* Checks the sample of the interval-until operator against the probability
+* constraint, either by its conf. int. or by a sequential test.
+* @param test one from {SIM_TEST_CONF_INT, SIM_TEST_SPRT, SIM_TEST_BAYES}
+* @param comparator the comparator, one of:
+*	COMPARATOR_SF_GREATER, COMPARATOR_SF_GREATER_OR_EQUAL,
+*	COMPARATOR_SF_LESS, COMPARATOR_SF_LESS_OR_EQUAL
+* @param prob_bound the probability bound
+* @param leftBorder the left border of the conf. int. of the sample
+* @param rightBorder the right border of the conf. int. of the sample
+* @param indiff_width the width of the indifference region
+* @param pSampleVecIntUntil the sample
+* @param alpha the error probability of the sequential tests to decide
+*	for a probability below the indifference region
+* @param beta the error probability of the sequential tests to decide
+*	for a probability above the indifference region
+* @return returns one of: TVL_TT, TVL_FF, TVL_NN
+*/
+static TV_LOGIC checkBoundIUCTMC( const int test, const int comparator, const double prob_bound,
+				const double leftBorder, const double rightBorder, const double indiff_width,
+				const PTSampleVecIntUntil pSampleVecIntUntil, const double alpha, const double beta ){
+	if( test == SIM_TEST_CONF_INT ){
+		return checkBoundVSConfInt( comparator, prob_bound, leftBorder, rightBorder, indiff_width );
+	} else {
+		return checkBoundSequentialTest( test, comparator, prob_bound,
+						( (PTSampleVec) pSampleVecIntUntil )->curr_sample_size,
+						pSampleVecIntUntil->sum_good, indiff_width, alpha, beta );
+	}
+}
+
 /**
 * Model checks the interval-until operator "Phi U[tl, tr] Psi" for one initial state only.
 * Note that this is a univesral procedure that assumes that we work with the embedded DTMC.
@@ -471,9 +668,11 @@ static void simulateSampleVectorIntUntilCTMC( const sparse * pStateSpace, PTSamp
 *		3. pPsiBitSet the bitsets containing all the Psi
 *		4. left_time_bound the left time bound "tl"
 *		5. right_time_bound the right time bound "tr"
-*		6. pExitRatesOfAllowedStates the array of exit rates for the
-*			"not pNotPhiAndNotPsiBitSet" states, not that its size corresponds
-*			to the dimensions of pStateSpace
+*		6. pSimModel the simulation model of the CTMC, its embedded
+*			DTMC is pStateSpace
+*		7. pLevels the level function of the importance splitting or
+*			sampling, if it is NULL the state is model checked by crude
+*			simulation
 */
 static void modelCheckOneStateIUCTMC( const sparse* pStateSpace, const int initial_state, const double indiff_width,
 					const double confidence, const int comparator, const double prob_bound,
@@ -487,8 +686,10 @@ static void modelCheckOneStateIUCTMC( const sparse* pStateSpace, const int initi
 	/* Contain the left and the right time bounds respectively */
 	const double left_time_bound = va_arg( pArguments, double );
 	const double right_time_bound = va_arg( pArguments, double );
-	/* Contains the exit rates for the "not pNotPhiAndNotPsiBitSet" states */
-	const double * pExitRatesOfAllowedStates = va_arg( pArguments, double * );
+	/* Contains the exit rates and the mean holding times of the states */
+	const TSimulationModel * pSimModel = va_arg( pArguments, TSimulationModel * );
+	/* Contains the level function of the importance splitting or sampling or NULL */
+	const int * pLevels = va_arg( pArguments, int * );
 
 	/* The model checking result*/
 	TV_LOGIC mc_result = TVL_NN;
@@ -504,27 +705,100 @@ static void modelCheckOneStateIUCTMC( const sparse* pStateSpace, const int initi
 	/* for model checking, but then again we have a different confidence for the */
 	/* produced conf. int. this is bad because then the user does not know that. */
 
-	/* Initialize the sample size parameters */
-	int sample_size = getSimMinSampleSize();
+	/* The test deciding on the probability bound and its error */
+	/* probabilities, by default they are given by the confidence */
+	const int test = getSimTestMethod();
+	const double alpha = ( getSimTestAlpha() > 0.0 ? getSimTestAlpha() : 1.0 - confidence );
+	const double beta = ( getSimTestBeta() > 0.0 ? getSimTestBeta() : 1.0 - confidence );
+
+	/* Initialize the sample size parameters, the sequential tests */
+	/* start with one sample-size step and decide after every step */
 	const int sample_size_step = getSimSampleSizeStep();
 	const int max_sample_size = getSimMaxSampleSize();
+	int sample_size = ( test == SIM_TEST_CONF_INT ? getSimMinSampleSize() :
+				( sample_size_step < max_sample_size ? sample_size_step : max_sample_size ) );
+
+	PTSampleVecIntUntil pSampleVecIntUntil = NULL;
+	PTSampleVec pSampleVecIntUntilBase = NULL;
+
+	if( pLevels != NULL ){
+		TSplittingModel model;
+
+		model.pStateSpace = pStateSpace;
+		model.pPhiBitSet = pPhiBitSet;
+		model.pPsiBitSet = pPsiBitSet;
+		model.pLevels = pLevels;
+		model.pExitRates = pSimModel->pExitRates;
+		model.left_time_bound = left_time_bound;
+		model.right_time_bound = right_time_bound;
+
+		*pNumUsedObserv = 0;
+		if( pLevels[initial_state] < 0 ){
+			/* Psi can not be reached, the probability is exactly 0 */
+			leftBorder = 0.0;
+			rightBorder = 0.0;
+			mc_result = checkBoundVSConfInt( comparator, prob_bound, leftBorder, rightBorder,
+							indiff_width );
+		} else if( getSimSplitEffort() > 0 ){
+			/* Estimate the probability by importance splitting, */
+			/* its conf. int. comes from the independent runs */
+			estimateBySplitting( &model, initial_state, getSimSplitEffort(), getSimSplitRuns(),
+						gen_conf_zeta, &leftBorder, &rightBorder, pNumUsedObserv );
+			mc_result = checkBoundVSConfInt( comparator, prob_bound, leftBorder, rightBorder,
+							indiff_width );
+		} else {
+			/* Estimate the probability by importance sampling, the conf. */
+			/* int. of the weights is checked after every sample-size step */
+			TImportanceBias bias;
+			double sum_weights = 0.0, sum_sq_weights = 0.0;
+			int old_sample_size = 0;
+
+			bias.method = getSimISMethod();
+			bias.bias = getSimISBias();
+			bias.failure_rate = getSimISFailureRate();
+
+			sample_size = getSimMinSampleSize();
+			simulateImportanceSample( &model, &bias, initial_state, sample_size,
+						&sum_weights, &sum_sq_weights, pNumUsedObserv );
+			computeBordersWeighted( gen_conf_zeta, &leftBorder, &rightBorder, sample_size,
+						sum_weights, sum_sq_weights );
+			mc_result = checkBoundVSConfInt( comparator, prob_bound, leftBorder, rightBorder,
+							indiff_width );
+			while( ( mc_result == TVL_NN ) && ( sample_size < max_sample_size ) ){
+				old_sample_size = sample_size;
+				increment( &sample_size, sample_size_step, max_sample_size );
+				simulateImportanceSample( &model, &bias, initial_state, sample_size - old_sample_size,
+							&sum_weights, &sum_sq_weights, pNumUsedObserv );
+				computeBordersWeighted( gen_conf_zeta, &leftBorder, &rightBorder, sample_size,
+							sum_weights, sum_sq_weights );
+				mc_result = checkBoundVSConfInt( comparator, prob_bound, leftBorder, rightBorder,
+								indiff_width );
+			}
+		}
+
+		pCiLeftBorders[arr_index] = leftBorder;
+		pCiRightBorders[arr_index] = rightBorder;
+		markYesNoSetEntree(mc_result, initial_state, pYesBitSet, pNoBitSet);
+		return;
+	}
 
 	/* Allocate an empty sample vector */
-	PTSampleVecIntUntil pSampleVecIntUntil = allocateSampleVectorIntUntil( 0, initial_state );
+	pSampleVecIntUntil = allocateSampleVectorIntUntil( 0, initial_state );
 	/* Cast to the parent structure which contains initial_state and curr_sample_size */
-	PTSampleVec pSampleVecIntUntilBase = (PTSampleVec) pSampleVecIntUntil;
+	pSampleVecIntUntilBase = (PTSampleVec) pSampleVecIntUntil;
 
 	/* Extend the initial vector with sample_size observations*/
 	simulateSampleVectorIntUntilCTMC( pStateSpace, pSampleVecIntUntil, sample_size, pNotPhiAndNotPsiBitSet,
-					pPhiBitSet, pPsiBitSet, left_time_bound, right_time_bound, pExitRatesOfAllowedStates );
+					pPhiBitSet, pPsiBitSet, left_time_bound, right_time_bound, pSimModel->pHoldingTimes );
 
 	/* printSampleVectorIntUntil( pSampleVecIntUntil ); */
 	/* Perform the check of the initial conf. int. */
 	computeBordersConfInt( gen_conf_zeta, &leftBorder, &rightBorder, pSampleVecIntUntilBase->curr_sample_size,
 				pSampleVecIntUntil->sum_good, pSampleVecIntUntil->sum_good, AGRESTI_COULL_CONF_INT);
 
-	/* Check the conf. int. against the probability constraint */
-	mc_result = checkBoundVSConfInt( comparator, prob_bound, leftBorder, rightBorder, indiff_width );
+	/* Check the conf. int. or the sequential test against the probability constraint */
+	mc_result = checkBoundIUCTMC( test, comparator, prob_bound, leftBorder, rightBorder, indiff_width,
+					pSampleVecIntUntil, alpha, beta );
 
 	/* The main simulation cycle */
 	while( ( mc_result == TVL_NN ) && ( sample_size < max_sample_size ) ){
@@ -533,15 +807,16 @@ static void modelCheckOneStateIUCTMC( const sparse* pStateSpace, const int initi
 
 		/* Extend the initial vector with sample_size observations*/
 		simulateSampleVectorIntUntilCTMC( pStateSpace, pSampleVecIntUntil, sample_size, pNotPhiAndNotPsiBitSet,
-						pPhiBitSet, pPsiBitSet, left_time_bound, right_time_bound, pExitRatesOfAllowedStates );
+						pPhiBitSet, pPsiBitSet, left_time_bound, right_time_bound, pSimModel->pHoldingTimes );
 
 		/* printSampleVectorIntUntil( pSampleVecIntUntil ); */
 		/* Perform the check of the initial conf. int. */
 		computeBordersConfInt( gen_conf_zeta, &leftBorder, &rightBorder, pSampleVecIntUntilBase->curr_sample_size,
 					pSampleVecIntUntil->sum_good, pSampleVecIntUntil->sum_good, AGRESTI_COULL_CONF_INT);
 
-		/* Check the conf. int. against the probability constraint */
-		mc_result = checkBoundVSConfInt( comparator, prob_bound, leftBorder, rightBorder, indiff_width );
+		/* Check the conf. int. or the sequential test against the probability constraint */
+		mc_result = checkBoundIUCTMC( test, comparator, prob_bound, leftBorder, rightBorder, indiff_width,
+						pSampleVecIntUntil, alpha, beta );
 	}
 	/* Update the pCiLeftBorders and pCiRightBorders */
 	pCiLeftBorders[arr_index] = leftBorder;
@@ -599,10 +874,10 @@ void modelCheckTimeIntervalUntilCTMC(sparse * pStateSpace,
                                      const int initial_state, const BOOL
                                      isSimOneInitState_local, unsigned int * pMaxNumUsedObserv ){
         bitset *pNotPhiAndNotPsiBitSet = NULL, * pTmpBitSet = NULL;
-        /* This vector will store the exit rates for the elements of pNotPhiAndNotPsiBitSet*/
-        double * pExitRatesOfAllowedStates = NULL;
-        /* This array will hold indices of the possible initial states */
-        int *pNAIStatesIdx = NULL;
+        /* The embedded DTMC and the exit rates and mean holding times */
+        const TSimulationModel * pSimModel = NULL;
+        /* The level function of the importance splitting or sampling, if it is on */
+        int * pLevels = NULL;
 
         /* To compute pNotPhiAndNotPsiBitset directly, one needed three
            negations, and a fourth to compute its complement. Changing the order
@@ -612,79 +887,85 @@ void modelCheckTimeIntervalUntilCTMC(sparse * pStateSpace,
         pTmpBitSet = or(pPsiBitSet, pPhiBitSet);
         /* 1: Compute the set of "Always illegal" states, i.e. not Psi and not Phi states */
         pNotPhiAndNotPsiBitSet = not(pTmpBitSet);
-        pNAIStatesIdx = count_set( pTmpBitSet );
-
-        /* 2: Obtain the embedded DTMC and the vector of exit rates */
-        /* (the diagonal elements stay intact) */
-        pExitRatesOfAllowedStates = make_embedded_dtmc_out_of_rate_mtx_vs( pStateSpace, pCTMCRowSums, pNAIStatesIdx );
-        if ( NULL == pExitRatesOfAllowedStates ) {
-                exit(err_macro_21(err_CALLBY, "modelCheckTimeIntervalUntilCTMC("
-                        "%p[%dx%d],%p,%g,%p[%d],%p[%d],%g,%g,%p,%p,%p,%p,%p,%d,"
-                        "%g,%d,%d,%p)", (void *) pStateSpace,
-                        mtx_rows(pStateSpace), mtx_cols(pStateSpace),
-                        (const void *) pCTMCRowSums, confidence,
-                        (const void *) pPhiBitSet, bitset_size(pPhiBitSet),
-                        (const void *) pPsiBitSet, bitset_size(pPsiBitSet),
-                        left_time_bound, right_time_bound,
-                        (void *) ppYesBitsetResult, (void *) ppNoBitsetResult,
-                        (void*) ppProbCILeftBorder, (void*) ppProbCIRightBorder,
-                        (void *) pResultSize, comparator, prob_bound,
-                        initial_state, isSimOneInitState_local,
-                        (void *) pMaxNumUsedObserv, EXIT_FAILURE));
-        }
 
-        /* print_mtx_sparse(pStateSpace); */
-        /* printf("The valid-state exit rates are listed here: "); */
-        /* print_vec_double(mtx_rows(pStateSpace), pExitRatesOfAllowedStates);*/
-        /* printf("\n"); */
+        /* 2: Obtain the embedded DTMC and the vector of exit rates, */
+        /* the simulation stops in the "Always illegal" states */
+        pSimModel = getSimulationModel( pStateSpace, pCTMCRowSums );
 
-        /* 3: Do model checking via simulations */
-        modelCheckStatesCommon( pStateSpace, confidence, ppYesBitsetResult, ppNoBitsetResult,
+        /* 3: Do model checking via simulations, the importance splitting */
+        /* and sampling are guided by the distance to the Psi states */
+        if( getSimSplitEffort() > 0 || getSimISMethod() != SIM_IS_NONE ){
+                pLevels = computeSplittingLevels( pStateSpace, pPhiBitSet, pPsiBitSet );
+        }
+        modelCheckStatesCommon( pSimModel->pEmbeddedDTMC, confidence, ppYesBitsetResult, ppNoBitsetResult,
                                 ppProbCILeftBorder, ppProbCIRightBorder, pResultSize, comparator,
                                 prob_bound, initial_state, isSimOneInitState_local, pTmpBitSet,
                                 pMaxNumUsedObserv, modelCheckOneStateIUCTMC, pNotPhiAndNotPsiBitSet,
                                 pPhiBitSet, pPsiBitSet, left_time_bound, right_time_bound,
-                                pExitRatesOfAllowedStates );
-
-        /* 4: Restore the state space */
-        /* NOTE: not required for diagonal elements */
-        if ( err_state_iserror(restore_rate_mtx_out_of_embedded_dtmc_vs(
-                                pStateSpace, pNAIStatesIdx,
-                                pExitRatesOfAllowedStates)) )
-        {
-                exit(err_macro_21(err_CALLBY, "modelCheckTimeIntervalUntilCTMC("
-                        "%p[%dx%d],%p,%g,%p[%d],%p[%d],%g,%g,%p,%p,%p,%p,%p,%d,"
-                        "%g,%d,%d,%p)", (void *) pStateSpace,
-                        mtx_rows(pStateSpace), mtx_cols(pStateSpace),
-                        (const void *) pCTMCRowSums, confidence,
-                        (const void *) pPhiBitSet, bitset_size(pPhiBitSet),
-                        (const void *) pPsiBitSet, bitset_size(pPsiBitSet),
-                        left_time_bound, right_time_bound,
-                        (void *) ppYesBitsetResult, (void *) ppNoBitsetResult,
-                        (void*) ppProbCILeftBorder, (void*) ppProbCIRightBorder,
-                        (void *) pResultSize, comparator, prob_bound,
-                        initial_state, isSimOneInitState_local,
-                        (void *) pMaxNumUsedObserv, EXIT_FAILURE));
-        }
+                                pSimModel, pLevels );
+        free( pLevels );
 
-        /* 5: Update the ppYesBitsetResult and ppNoBitsetResult with respect to pNotPhiAndNotPsiBitSet */
+        /* 4: Update the ppYesBitsetResult and ppNoBitsetResult with respect to pNotPhiAndNotPsiBitSet */
         considerAlwaysAndNeverStates( isSimOneInitState_local, * ppYesBitsetResult, * ppNoBitsetResult,
                                       NULL, pNotPhiAndNotPsiBitSet, initial_state, comparator, prob_bound );
 
-        /* 6: Free the allocated memory */
+        /* 5: Free the allocated memory */
         free_bitset( pTmpBitSet );
         free_bitset( pNotPhiAndNotPsiBitSet );
-        free( pExitRatesOfAllowedStates );
-        free( pNAIStatesIdx );
 }
 
 /*******************************************************************************/
 /********THE FUNCTIONS FOR SIMULATING STEADY-STATE OPERATOR ON A CTMC***********/
 /*******************************************************************************/
 
+/**
+* This function simulates a batch of regeneration cycles for steady state
+* CTMC: "S<>p(Psi)" with the given stream and adds them to the statistics.
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pStateSpace the sparse matrix of the embedded DTMC
+* @param initial_state the regeneration state, every cycle starts and ends in it
+* @param num_cycles the number of regeneration cycles to simulate
+* @param pPsiBitSet the bitsets containing all Psi states
+* @param pHoldingTimes the array of mean holding times of the states,
+*	note that its size corresponds to the dimensions of pStateSpace
+* @param pStream the stream to draw from
+* @param pCycleStats the statistics the cycles are added to
+* @param pVisitedStates the counter of simulated states, it is increased
+*/
+static void simulateSSCyclesCTMC( const sparse * pStateSpace, const int initial_state,
+					const int num_cycles, const bitset * pPsiBitSet,
+					const double * pHoldingTimes, TRNGStream * pStream,
+					TCycleStats * pCycleStats, unsigned int * pVisitedStates ){
+	int i, current_obs_state = initial_state;
+	double accumulated_time, accumulated_good, rand;
+	/* The buffered words of the stream */
+	TRandWordSource source;
+
+	initRandWordSource( &source, fillRandWordsStream, pStream );
+	for( i = 0; i < num_cycles; i++ ){
+		accumulated_time = 0.0;
+		accumulated_good = 0.0;
+		do{
+			accumulated_time += pHoldingTimes[current_obs_state];
+			if( get_bit_val( pPsiBitSet, current_obs_state ) ){
+				accumulated_good += pHoldingTimes[current_obs_state];
+			}
+			fillRandUnifWords( &source, &rand, 1 );
+			current_obs_state = chooseNextState( pStateSpace, current_obs_state, rand );
+			( * pVisitedStates )++;
+		} while( current_obs_state != initial_state );
+		addCycleStats( pCycleStats, accumulated_time, accumulated_good );
+	}
+}
+
 /**
 * This function is designed to simulate the new regeneration cycles for steady
-* state CTMC: "S<>p(Psi)".
+* state CTMC: "S<>p(Psi)". Only the sums of the cycle times and good times are
+* kept, see TCycleStats, the cycles themselves are not stored.
+* If there are simulation threads, the new cycles are divided in contiguous
+* chunks, one per thread, and every thread collects its chunk into its own
+* statistics with its own stream. These are merged in the thread order, so
+* the result does not depend on the thread scheduling.
 *
 * WARNING: We simulate the states ASSUMING there are no self loops!
 *	The absorbing states have to be found based on the absence of transitions to other states
@@ -693,12 +974,12 @@ void modelCheckTimeIntervalUntilCTMC(sparse * pStateSpace,
 * @param pSampleVecSteady the sample vector obtained on the previous iteration
 * @param old_sample_size the old number of regeneration cycles (sample size)
 * @param pPsiBitSet the bitsets containing all Psi states
-* @param pExitRatesOfAllowedStates the array of exit rates for the Psi states,
+* @param pHoldingTimes the array of mean holding times of the states,
 *	note that its size corresponds to the dimensions of pStateSpace
 */
 static void simulateSSSampleCTMC( const sparse * pStateSpace, PTSampleVecSteady pSampleVecSteady,
 					const int old_samle_size, const bitset * pPsiBitSet,
-					const double * pExitRatesOfAllowedStates ){
+					const double * pHoldingTimes ){
 	int i, current_obs_state;
 	/* Calculate the expected time spent in the i'th regeneration cycle in here */
 	double accumulated_time;
@@ -710,38 +991,64 @@ static void simulateSSSampleCTMC( const sparse * pStateSpace, PTSampleVecSteady
 
 	/* Cast to the parent structure which contains initial_state and curr_sample_size */
 	PTSampleVec pSampleVecSteadyBase = (PTSampleVec) pSampleVecSteady;
+	const int new_cycles = pSampleVecSteadyBase->curr_sample_size - old_samle_size;
+	const int threads = getSimThreads();
+
+	if( threads > 0 ){
+		TRNGStream * pStreams = getSimulationStreams();
+		/* The per-thread statistics of the new regeneration cycles */
+		TCycleStats * pThreadStats = (TCycleStats *) calloc( (size_t) threads, sizeof( TCycleStats ) );
+		if( pThreadStats == NULL ){
+			printf("ERROR: Unable to allocate the per-thread regeneration cycle statistics.\n");
+			exit(EXIT_FAILURE);
+		}
 
-	/* For every regeneration cycle we start in the same initial state */
-	current_obs_state = pSampleVecSteadyBase->initial_state;
-
-	/* Simulate the newly added regeneration cycles */
-	for( i = old_samle_size; i < pSampleVecSteadyBase->curr_sample_size; i++ ){
-		/* Set the initial counter values to zero */
-		accumulated_time = 0.0;
-		accumulated_good = 0.0;
+		/* Every thread simulates its chunk of the new regeneration cycles */
+#		ifdef _OPENMP
+#		pragma omp parallel for num_threads(threads) schedule(static, 1) reduction(+:newlyVisitedStates)
+#		endif
+		for( i = 0; i < threads; i++ ){
+			simulateSSCyclesCTMC( pStateSpace, pSampleVecSteadyBase->initial_state,
+						SIM_CHUNK_START( new_cycles, threads, i + 1 )
+						- SIM_CHUNK_START( new_cycles, threads, i ),
+						pPsiBitSet, pHoldingTimes, &pStreams[i],
+						&pThreadStats[i], &newlyVisitedStates );
+		}
+		for( i = 0; i < threads; i++ ){
+			mergeCycleStats( &pSampleVecSteady->cycleStats, &pThreadStats[i] );
+		}
+		free( pThreadStats );
+	} else {
+		/* For every regeneration cycle we start in the same initial state */
+		current_obs_state = pSampleVecSteadyBase->initial_state;
 
-		/* Simulate one regeneration cycle, i.e. until the initial state is reached again */
-		do{
-			accumulated_time += 1.0 / pExitRatesOfAllowedStates[current_obs_state];
-			/* Increment only if the current state is a Psi state */
-			if( get_bit_val( pPsiBitSet, current_obs_state ) ){
-				accumulated_good += 1.0 / pExitRatesOfAllowedStates[current_obs_state];
-			}
+		/* Simulate the newly added regeneration cycles */
+		for( i = 0; i < new_cycles; i++ ){
+			/* Set the initial counter values to zero */
+			accumulated_time = 0.0;
+			accumulated_good = 0.0;
 
-			/* Go to the next state */
-                        current_obs_state = computeNextState(pStateSpace,
-                                        current_obs_state);
+			/* Simulate one regeneration cycle, i.e. until the initial state is reached again */
+			do{
+				accumulated_time += pHoldingTimes[current_obs_state];
+				/* Increment only if the current state is a Psi state */
+				if( get_bit_val( pPsiBitSet, current_obs_state ) ){
+					accumulated_good += pHoldingTimes[current_obs_state];
+				}
 
-			/* The next state was simulated */
-			newlyVisitedStates++;
-		} while( current_obs_state != pSampleVecSteadyBase->initial_state );
+				/* Go to the next state */
+				current_obs_state = computeNextState(pStateSpace,
+						current_obs_state);
 
-		/* printf("REGENERATION SYCLE IS DONE\n"); */
+				/* The next state was simulated */
+				newlyVisitedStates++;
+			} while( current_obs_state != pSampleVecSteadyBase->initial_state );
 
-		/* Store the results for this regeneration cycle in the sample structure */
-		pSampleVecSteady->pTimeObservationsVec[i] = accumulated_time;
-		pSampleVecSteady->pGoodObservationsVec[i] = accumulated_good;
+			/* printf("REGENERATION SYCLE IS DONE\n"); */
 
+			/* Add the results for this regeneration cycle to the sample statistics */
+			addCycleStats( &pSampleVecSteady->cycleStats, accumulated_time, accumulated_good );
+		}
 	}
 
 	/* printSampleVectorSteady( pSampleVecSteady ); */
@@ -760,12 +1067,12 @@ static void simulateSSSampleCTMC( const sparse * pStateSpace, PTSampleVecSteady
 * @param pSampleVecSteady the sample vector obtained on the previous iteration
 * @param new_sample_size the new sample size
 * @param pPsiBitSet the bitsets containing all Psi states
-* @param pExitRatesOfAllowedStates the array of exit rates for the Psi states,
+* @param pHoldingTimes the array of mean holding times of the states,
 *	note that its size corresponds to the dimensions of pStateSpace
 */
 static void simulateSampleVectorSSCTMC( const sparse * pStateSpace, PTSampleVecSteady pSampleVecSteady,
 					const int new_sample_size, const bitset * pPsiBitSet,
-					const double * pExitRatesOfAllowedStates ){
+					const double * pHoldingTimes ){
 	IF_SAFETY( pSampleVecSteady != NULL )
 		/* Cast to the parent structure which contains initial_state and curr_sample_size */
 		PTSampleVec pSampleVecSteadyBase = (PTSampleVec) pSampleVecSteady;
@@ -780,7 +1087,7 @@ static void simulateSampleVectorSSCTMC( const sparse * pStateSpace, PTSampleVecS
 
 					/*Do simulations for the newly added observations */
 					simulateSSSampleCTMC( pStateSpace, pSampleVecSteady, old_sample_size,
-								pPsiBitSet, pExitRatesOfAllowedStates );
+								pPsiBitSet, pHoldingTimes );
 				}
 			ELSE_SAFETY
 				printf("ERROR: The sparse matrix is NULL.\n");
@@ -939,7 +1246,7 @@ static void initializeSHybridSimulationConfIntRelated( const int numberOfReachab
  * @param pStateSpace the state space
  * @param pAvgCycleLength the average number of the regeneration cycle, is updated here
  * @param pPsiBitSet the set of all \Psi states in the model
- * @param pExitRatesOfAllowedStates the array of the exit rates for the allowed states
+ * @param pHoldingTimes the array of the mean holding times of the states
  * @param pReachableNonTrivBSCCBitSet the bitset that stores the indices of
  *                                    non-trivial \Psi BSCCs
  *                                    that are also reachable from the actual initial state
@@ -958,7 +1265,7 @@ static void initializeSHybridSimulationConfIntRelated( const int numberOfReachab
  * @param pRightBorder the array of right conf. int. borders for all reachable BSCCs
  */
 static void simulateAllReachablePsiBSCCs( const sparse* const pStateSpace, int * pAvgCycleLength,
-									const bitset * const pPsiBitSet, const double * const pExitRatesOfAllowedStates,
+									const bitset * const pPsiBitSet, const double * const pHoldingTimes,
 									const bitset * const pReachableNonTrivBSCCBitSet,
 									const int numberOfReachableTrivialBSCCs, const int numberOfNonTrivBSCCStates,
 									PTSampleVecSteady * pSampleVecSteady, BOOL isDynamicSampleStep,
@@ -983,7 +1290,7 @@ static void simulateAllReachablePsiBSCCs( const sparse* const pStateSpace, int *
     i = numberOfReachableTrivialBSCCs;
     while((curr_index = get_idx_next_non_zero( pReachableNonTrivBSCCBitSet, curr_index) ) != -1){
         /* Do more simulations for this BSCC */
-        simulateSampleVectorSSCTMC( pStateSpace, pSampleVecSteady[curr_index], sample_size, pPsiBitSet, pExitRatesOfAllowedStates );
+        simulateSampleVectorSSCTMC( pStateSpace, pSampleVecSteady[curr_index], sample_size, pPsiBitSet, pHoldingTimes );
         /* Re-compute the confidence interval borders */
         computeBordersConfIntSS( sample_size, zeta_ss, &pLeftBorder[i], &pRightBorder[i], pSampleVecSteady[curr_index] );
         /* Is the sample size step set manually or automatically? */
@@ -1042,9 +1349,8 @@ static void simulateAllReachablePsiBSCCs( const sparse* const pStateSpace, int *
 			initial states to BSCCs with Psi states.
 *		3. error_bound the error bound for the numerically computed reachability
 *			probabilities
-*		4. pExitRatesOfAllowedStates the array of exit rates for the
-*			"pPsiBitSet" states, note that its size corresponds
-*			to the dimensions of pStateSpace
+*		4. pHoldingTimes the array of mean holding times of the states,
+*			note that its size corresponds to the dimensions of pStateSpace
 *		5. pSampleVecSteady the array of sample structures for the non-trivial BSCCs
 *		6. numberOfNonTrivBSCCs the number of non-trivial BSCCs containing Psi states
 *		7. numberOfTrivialBSCCs the number of trivial BSCCs consisting of good states
@@ -1061,8 +1367,8 @@ static void modelCheckOneStateSSHybridCTMC( const sparse* pStateSpace, const int
 	double ** ppReachProbability = va_arg( pArguments, double ** );
 	/* Contains the error bound for numerical computation */
 	const double error_bound = va_arg( pArguments, double );
-	/* Contains the exit rates for the "pPsiBitSet" states */
-	const double * pExitRatesOfAllowedStates = va_arg( pArguments, double * );
+	/* Contains the mean holding times of the states */
+	const double * pHoldingTimes = va_arg( pArguments, double * );
 	/* Contains a sample structure for every non-trivial BSCC */
 	PTSampleVecSteady * pSampleVecSteady = va_arg( pArguments, PTSampleVecSteady * );
 	/* The number of non-trivial BSCCs containing Psi states */
@@ -1130,7 +1436,7 @@ static void modelCheckOneStateSSHybridCTMC( const sparse* pStateSpace, const int
 				int avg_cycle_length = 0;
 
 				/* Perform simulations for all of the reachable \Psi BSCCs */
-				simulateAllReachablePsiBSCCs( pStateSpace, &avg_cycle_length, pPsiBitSet, pExitRatesOfAllowedStates,
+				simulateAllReachablePsiBSCCs( pStateSpace, &avg_cycle_length, pPsiBitSet, pHoldingTimes,
 												pReachableNonTrivBSCCBitSet, numberOfReachableTrivialBSCCs,
 												numberOfNonTrivBSCCStates, pSampleVecSteady, isDynamicSampleStep,
 												&sample_size, &sample_size_step, max_sample_size, zeta_ss,
@@ -1233,13 +1539,10 @@ void modelCheckSteadyStateHybridCTMC( sparse * pStateSpace, const double * pCTMC
 	bitset ** ppNonTrivBSCCBitSets = NULL;
 	/* The bitset indicating the Psi states belonging to trivial BSCCs */
 	bitset * pTrivialBSCCBitSet = NULL;
-        /* The array that holds the indices of states belonging to non-trivial
-           BSCCs */
-	int * pNonTrivBSCCStates = NULL;
 	/* The structure, that stores the probability to reach BSCC i from state j */
 	double ** ppReachProbability;
-	/* This vector will store the exit rates for the elements of pPsiBitSet*/
-	double * pExitRatesOfAllowedStates = NULL;
+	/* The embedded DTMC and the mean holding times of the states */
+	const TSimulationModel * pSimModel = NULL;
 	/* The state space dimension */
         const int n_states = mtx_rows(pStateSpace);
 
@@ -1252,34 +1555,19 @@ void modelCheckSteadyStateHybridCTMC( sparse * pStateSpace, const double * pCTMC
 	fill_bitset_one( pValidInitialStatesBitSet );
 
 	/* Get the trivial and non=trivial BSCCs that contain \Psi states */
-	ppNonTrivBSCCBitSets = getTrivialAndNonTrivialPsiBSCC( pStateSpace, pPsiBitSet, &pNonTrivBSCCStates,
+	ppNonTrivBSCCBitSets = getTrivialAndNonTrivialPsiBSCC( pStateSpace, pPsiBitSet, NULL,
 															&pTrivialBSCCBitSet, &numberOfNonTrivBSCCs,
 															&numberOfTrivialBSCCs, &numberOfBSCCs,
 															pFAllowedBSCCSearchCTMC );
 
-	/* Obtain the embedded DTMC and the vector of exit rates */
-	/* WARNING: The self loops on states are not modified. Thus the proper way */
-	/* to identify an absorbing state is to make sure that there are */
-	/* no non-diagonal elements in the corresponding row. */
-	pExitRatesOfAllowedStates = make_embedded_dtmc_out_of_rate_mtx_vs( pStateSpace, pCTMCRowSums, pNonTrivBSCCStates );
-        if ( NULL == pExitRatesOfAllowedStates ) {
-                exit(err_macro_18(err_CALLBY, "modelCheckSteadyStateHybridCTMC("
-                        "%p[%dx%d],%p,%g,%p[%d],%p,%p,%p,%p,%p,%d,%g,%d,%d,_,_,"
-                        "%g,%p)", (void*) pStateSpace, mtx_rows(pStateSpace),
-                        mtx_cols(pStateSpace), (const void *) pCTMCRowSums,
-                        confidence, (const void *) pPsiBitSet,
-                        bitset_size(pPsiBitSet), (void *) ppYesBitsetResult,
-                        (void *) ppNoBitsetResult, (void *) ppProbCILeftBorder,
-                        (void *) ppProbCIRightBorder, (void *) pResultSize,
-                        comparator, prob_bound, initial_state,
-                        isSimOneInitState_local, error_bound,
-                        (void *) pMaxNumUsedObserv, EXIT_FAILURE));
-        }
+	/* Obtain the embedded DTMC, it has no self loops. Thus an absorbing */
+	/* state has no non-diagonal elements in the corresponding row. */
+	pSimModel = getSimulationModel( pStateSpace, pCTMCRowSums );
 
 	/* Prepare the steady state simulation samples vector for */
 	/* each BSCC and choose regeneration states for each BSCC */
 	/* Also count the number of the non-trivial BSCCs */
-	pSampleVecSteady = prepareSSSimulationSample( pStateSpace, numberOfNonTrivBSCCs, ppNonTrivBSCCBitSets, &numberOfNonTrivBSCCStates );
+	pSampleVecSteady = prepareSSSimulationSample( pSimModel->pEmbeddedDTMC, numberOfNonTrivBSCCs, ppNonTrivBSCCBitSets, &numberOfNonTrivBSCCStates );
 
     /* Calculate the average number of states in a BSCC */
 	if( numberOfNonTrivBSCCs > 0 ){
@@ -1292,37 +1580,15 @@ void modelCheckSteadyStateHybridCTMC( sparse * pStateSpace, const double * pCTMC
 															pFNumUnbUntilCTMC );
 
 	/* Call the common model-checking procedure for all (one) state(s) */
-    modelCheckStatesCommon( pStateSpace, confidence, ppYesBitsetResult, ppNoBitsetResult, ppProbCILeftBorder,
+    modelCheckStatesCommon( pSimModel->pEmbeddedDTMC, confidence, ppYesBitsetResult, ppNoBitsetResult, ppProbCILeftBorder,
 							ppProbCIRightBorder, pResultSize, comparator, prob_bound, initial_state,
                         isSimOneInitState_local, pValidInitialStatesBitSet,
                         pMaxNumUsedObserv,
 							modelCheckOneStateSSHybridCTMC, pPsiBitSet, ppReachProbability, error_bound,
-							pExitRatesOfAllowedStates, pSampleVecSteady, numberOfNonTrivBSCCs,
+							pSimModel->pHoldingTimes, pSampleVecSteady, numberOfNonTrivBSCCs,
 							numberOfTrivialBSCCs, numberOfNonTrivBSCCStates );
 
-	/* Restore the state space */
-        /* NOTE: The diagonal elements do not have to be restored since they
-           have not been changed */
-        if ( err_state_iserror(restore_rate_mtx_out_of_embedded_dtmc_vs(
-                                pStateSpace, pNonTrivBSCCStates,
-                                pExitRatesOfAllowedStates)) )
-        {
-                exit(err_macro_18(err_CALLBY, "modelCheckSteadyStateHybridCTMC("
-                        "%p[%dx%d],%p,%g,%p[%d],%p,%p,%p,%p,%p,%d,%g,%d,%d,_,_,"
-                        "%g,%p)", (void*) pStateSpace, mtx_rows(pStateSpace),
-                        mtx_cols(pStateSpace), (const void *) pCTMCRowSums,
-                        confidence, (const void *) pPsiBitSet,
-                        bitset_size(pPsiBitSet), (void *) ppYesBitsetResult,
-                        (void *) ppNoBitsetResult, (void *) ppProbCILeftBorder,
-                        (void *) ppProbCIRightBorder, (void *) pResultSize,
-                        comparator, prob_bound, initial_state,
-                        isSimOneInitState_local, error_bound,
-                        (void *) pMaxNumUsedObserv, EXIT_FAILURE));
-        }
-
 	/* Deallocate the used memory */
-	free( pExitRatesOfAllowedStates ); pExitRatesOfAllowedStates = NULL;
-	free( pNonTrivBSCCStates ); pNonTrivBSCCStates = NULL;
 	free_bitset( pTrivialBSCCBitSet ); pTrivialBSCCBitSet = NULL;
 	free_bitset( pValidInitialStatesBitSet ); pValidInitialStatesBitSet = NULL;
 
@@ -1541,9 +1807,8 @@ static TV_LOGIC checkConfIntSSPure( const int comparator, const double prob_boun
 			from which the BSCC_{i} is at least sometimes reachable.
 *		3. ppBSCCAlwaysReachableStates the array that stores bitsets (at index i) with states
 			from which the BSCC_{i} is always reachable.
-*		4. pExitRatesOfAllStates the array of exit rates for the
-*			"pPsiBitSet" states, note that its size corresponds
-*			to the dimensions of pStateSpace
+*		4. pHoldingTimes the array of mean holding times of the states,
+*			note that its size corresponds to the dimensions of pStateSpace
 *		5. pSampleVecSteady the array of sample structures for the non-trivial BSCCs
 *		6. numberOfNonTrivBSCCs the number of non-trivial BSCCs containing Psi states
 *		7. numberOfTrivialBSCCs the number of trivial BSCCs consisting of good states
@@ -1564,8 +1829,8 @@ static void modelCheckOneStateSSPureCTMC( const sparse* pStateSpace, const int i
 	/* in ppBSCCExistsReachableStates[i] and ppBSCCAlwaysReachableStates[i] respectively */
 	const bitset ** const ppBSCCExistsReachableStates = va_arg( pArguments, const bitset ** const );
 	const bitset ** const ppBSCCAlwaysReachableStates = va_arg( pArguments, const bitset ** const );
-	/* Contains the exit rates for the "pPsiBitSet" states */
-	const double * const pExitRatesOfAllStates = va_arg( pArguments, double * );
+	/* Contains the mean holding times of the states */
+	const double * const pHoldingTimes = va_arg( pArguments, double * );
 	/* Contains a sample structure for every non-trivial BSCC */
 	PTSampleVecSteady * pSampleVecSteady = va_arg( pArguments, PTSampleVecSteady * );
 	/* The number of non-trivial BSCCs containing Psi states */
@@ -1684,7 +1949,7 @@ static void modelCheckOneStateSSPureCTMC( const sparse* pStateSpace, const int i
 				if( mc_result == TVL_NN ) {
 					/* If not, then do steady state simulations an update their conf. int. */
 					/* Perform simulations for all of the reachable \Psi BSCCs */
-					simulateAllReachablePsiBSCCs( pStateSpace, &avg_cycle_length, pPsiBitSet, pExitRatesOfAllStates,
+					simulateAllReachablePsiBSCCs( pStateSpace, &avg_cycle_length, pPsiBitSet, pHoldingTimes,
 													pReachableNonTrivBSCCBitSet, numberOfReachableTrivialBSCCs,
 													numberOfNonTrivBSCCStates, pSampleVecSteady, isDynamicSampleStepSS,
 													&sample_size_ss, &sample_size_step_ss, max_sample_size_ss, zeta_ss,
@@ -1869,9 +2134,9 @@ void modelCheckSteadyStatePureCTMC(sparse * pStateSpace,
 	bitset ** ppNonTrivBSCCBitSets = NULL;
 	/* The bitset indicating the Psi states belonging to trivial BSCCs */
 	bitset * pTrivialBSCCBitSet = NULL;
-	/* This vector will store the exit rates for all the states since */
+	/* The embedded DTMC and the mean holding times of all the states since */
 	/* we do pure simulations but not only simulate \Psi BSCCs */
-	double * pExitRatesOfAllStates = NULL;
+	const TSimulationModel * pSimModel = NULL;
 	/* The state space dimension */
         const int n_states = mtx_rows(pStateSpace);
 
@@ -1921,31 +2186,15 @@ void modelCheckSteadyStatePureCTMC(sparse * pStateSpace,
 		printf("ALL PATHs TO BSCC [%d] from: ", i); print_bitset_states( ppBSCCAlwaysReachableStates[i] ); printf("\n");
 	 } */
 
-	/* Obtain the embedded DTMC and the vector of exit rates */
-	/* WARNING: The self loops on states are not modified. Thus the proper way */
-	/* to identify an absorbing state is to make sure that there are */
-	/* no non-diagonal elements in the corresponding row. */
-	/* printf("MAKING EMBEDDED DTMC\n"); */
-	pExitRatesOfAllStates = make_embedded_dtmc_out_of_rate_mtx_all( pStateSpace, pCTMCRowSums );
-        if ( NULL == pExitRatesOfAllStates ) {
-                exit(err_macro_17(err_CALLBY, "modelCheckSteadyStatePureCTMC("
-                        "%p[%dx%d],%p,%g,%p[%d],%p,%p,%p,%p,%p,%d,%g,%d,%d,_,_,"
-                        "_,%p)", (void*) pStateSpace, mtx_rows(pStateSpace),
-                        mtx_cols(pStateSpace), (const void *) pCTMCRowSums,
-                        confidence, (const void *) pPsiBitSet,
-                        bitset_size(pPsiBitSet), (void *) ppYesBitsetResult,
-                        (void *) ppNoBitsetResult, (void *) ppProbCILeftBorder,
-                        (void *) ppProbCIRightBorder, (void *) pResultSize,
-                        comparator, prob_bound, initial_state,
-                        isSimOneInitState_local,
-                        (void *) pMaxNumUsedObserv, EXIT_FAILURE));
-        }
+	/* Obtain the embedded DTMC, it has no self loops. Thus an absorbing */
+	/* state has no non-diagonal elements in the corresponding row. */
+	pSimModel = getSimulationModel( pStateSpace, pCTMCRowSums );
 
 	/* Prepare the steady state simulation samples vector for */
 	/* each BSCC and choose regeneration states for each BSCC */
 	/* Also count the number of the non-trivial BSCCs */
 	/* printf("PREPARING SS SIMULATION SAMPLES\n"); */
-	pSampleVecSteady = prepareSSSimulationSample( pStateSpace, numberOfNonTrivBSCCs, ppNonTrivBSCCBitSets, &numberOfNonTrivBSCCStates );
+	pSampleVecSteady = prepareSSSimulationSample( pSimModel->pEmbeddedDTMC, numberOfNonTrivBSCCs, ppNonTrivBSCCBitSets, &numberOfNonTrivBSCCStates );
 
     /* Calculate the average number of states in a BSCC */
 	if( numberOfNonTrivBSCCs > 0 ){
@@ -1954,37 +2203,17 @@ void modelCheckSteadyStatePureCTMC(sparse * pStateSpace,
 
 	/* Call the common model checking procedure algorithm */
 	/* printf("CALLING THE MAIN SIMULATION PROCEDURE\n"); */
-    modelCheckStatesCommon( pStateSpace, confidence, ppYesBitsetResult, ppNoBitsetResult, ppProbCILeftBorder,
+    modelCheckStatesCommon( pSimModel->pEmbeddedDTMC, confidence, ppYesBitsetResult, ppNoBitsetResult, ppProbCILeftBorder,
 							ppProbCIRightBorder, pResultSize, comparator, prob_bound, initial_state,
                         isSimOneInitState_local, pValidInitialStatesBitSet,
                         pMaxNumUsedObserv,
 							modelCheckOneStateSSPureCTMC, pPsiBitSet, ppBSCCExistsReachableStates,
-							ppBSCCAlwaysReachableStates, pExitRatesOfAllStates, pSampleVecSteady,
+							ppBSCCAlwaysReachableStates, pSimModel->pHoldingTimes, pSampleVecSteady,
 							numberOfNonTrivBSCCs, numberOfTrivialBSCCs, numberOfNonTrivBSCCStates,
 							pTransientBitSet, ppNonTrivBSCCBitSets, pTrivialBSCCBitSet );
 
-	/* Restore the state space */
-	/* NOTE: The diagonal elements do not have to be restored since they were not changed */
-	/* printf("REVERTING THE EMBEDDED DTMC BACK INTO A CTMC\n"); */
-        if ( err_state_iserror(restore_rate_mtx_out_of_embedded_dtmc_all(
-                                pStateSpace, pExitRatesOfAllStates)) )
-        {
-                exit(err_macro_17(err_CALLBY, "modelCheckSteadyStatePureCTMC("
-                        "%p[%dx%d],%p,%g,%p[%d],%p,%p,%p,%p,%p,%d,%g,%d,%d,_,_,"
-                        "_,%p)", (void*) pStateSpace, mtx_rows(pStateSpace),
-                        mtx_cols(pStateSpace), (const void *) pCTMCRowSums,
-                        confidence, (const void *) pPsiBitSet,
-                        bitset_size(pPsiBitSet), (void *) ppYesBitsetResult,
-                        (void *) ppNoBitsetResult, (void *) ppProbCILeftBorder,
-                        (void *) ppProbCIRightBorder, (void *) pResultSize,
-                        comparator, prob_bound, initial_state,
-                        isSimOneInitState_local,
-                        (void *) pMaxNumUsedObserv, EXIT_FAILURE));
-        }
-
 	/* Clean the memory: BSCC's bitsets, samples and etc */
 	/* printf("CLEANING MEMORY\n"); */
-	free( pExitRatesOfAllStates ); pExitRatesOfAllStates = NULL;
 	free_bitset( pTrivialBSCCBitSet ); pTrivialBSCCBitSet = NULL;
 	free_bitset( pValidInitialStatesBitSet ); pValidInitialStatesBitSet = NULL;
 
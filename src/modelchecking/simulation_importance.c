@@ -0,0 +1,276 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description: This is a source file for the simulation engine
+*	here we intend to define the importance sampling of time-interval
+*	until.
+*/
+
+#include "simulation_importance.h"
+
+#include "simulation.h"
+#include "simulation_common.h"
+
+#include <math.h>
+
+/**
+* This function tells whether the transition from state to next_state with
+* the given probability is a failure transition for the balanced failure
+* biasing.
+* @param pModel the model of the until formula
+* @param pBias the change of measure
+* @param state the source state
+* @param next_state the target state
+* @param prob the probability of the transition in the embedded DTMC
+* @return TRUE if the transition is a failure transition
+*/
+static BOOL isFailureTransition( const TSplittingModel * pModel, const TImportanceBias * pBias,
+				const int state, const int next_state, const double prob ){
+	if( pBias->failure_rate > 0.0 ){
+		return ( NULL == pModel->pExitRates ? prob : prob * pModel->pExitRates[state] )
+			<= pBias->failure_rate;
+	} else {
+		return pModel->pLevels[next_state] >= 0 &&
+			pModel->pLevels[next_state] < pModel->pLevels[state];
+	}
+}
+
+/**
+* This function computes the zero-variance approximation of the probability
+* to fulfill the formula from next_state, bias^level(next_state), relative to
+* the one from state, i.e. bias^(level(next_state) - level(state)); it is 0 if
+* Psi can not be reached from next_state. Only the ratios matter for the
+* biased probabilities, and unlike bias^level they do not underflow on deep
+* levels.
+* @param pModel the model of the until formula
+* @param pBias the change of measure
+* @param state the current state
+* @param next_state the successor
+* @return the approximated probability ratio
+*/
+static double approximateRatioZVA( const TSplittingModel * pModel, const TImportanceBias * pBias,
+				const int state, const int next_state ){
+	const int level = ( pModel->pLevels[state] >= 0 ? pModel->pLevels[state] : 0 );
+
+	return ( pModel->pLevels[next_state] >= 0 ?
+			pow( pBias->bias, pModel->pLevels[next_state] - level ) : 0.0 );
+}
+
+/**
+* This function chooses the successor of the given state with the biased
+* probabilities and multiplies the likelihood ratio of the path by the one
+* of the step. The state has to have outgoing transitions.
+* NOTE: The biased probabilities depend on the state and the bias, so there
+* is no alias table for them and the row is scanned, see buildSamplingIndex.
+* @param pModel the model of the until formula
+* @param pBias the change of measure
+* @param state the current state
+* @param unif_rand a uniformly distributed random number in [0,1)
+* @param pLikelihood the likelihood ratio of the path, it is updated
+* @return the next state, -1 if no successor can reach a Psi state
+*/
+static int chooseBiasedNextState( const TSplittingModel * pModel, const TImportanceBias * pBias,
+				const int state, const double unif_rand, double * pLikelihood ){
+	const sparse * pStateSpace = pModel->pStateSpace;
+	/* The number and the probability of the failure and other transitions */
+	int num_failures = 0, num_others = 0, next_state = -1;
+	double prob_failures = 0.0, prob_others = 0.0;
+	/* The total weight of the zero-variance approximation */
+	double weight = 0.0;
+	/* The biased probability of a transition and the cumulative one */
+	double biased_prob = 0.0, biased_next_prob = 0.0, cumulative = 0.0, next_prob = 0.0;
+
+	/* Sum up the weights of the transitions */
+	mtx_walk_row_nodiag( pStateSpace, state, col, val )
+	{
+		if( pBias->method == SIM_IS_ZVA ){
+			weight += val * approximateRatioZVA( pModel, pBias, state, col );
+		} else if( isFailureTransition( pModel, pBias, state, col, val ) ){
+			num_failures++;
+			prob_failures += val;
+		} else {
+			num_others++;
+			prob_others += val;
+		}
+	}
+	end_mtx_walk_row_nodiag;
+	if( pBias->method == SIM_IS_ZVA && weight == 0.0 ){
+		return -1;
+	}
+
+	/* Choose the transition by the biased probabilities */
+	mtx_walk_row_nodiag( pStateSpace, state, col, val )
+	{
+		if( pBias->method == SIM_IS_ZVA ){
+			biased_prob = val * approximateRatioZVA( pModel, pBias, state, col ) / weight;
+		} else if( num_failures == 0 ){
+			biased_prob = val / prob_others;
+		} else if( isFailureTransition( pModel, pBias, state, col, val ) ){
+			/* The failures are balanced, they all get the same probability */
+			biased_prob = ( num_others == 0 ? 1.0 : pBias->bias ) / num_failures;
+		} else {
+			biased_prob = ( 1.0 - pBias->bias ) * val / prob_others;
+		}
+		if( biased_prob > 0.0 ){
+			/* Remember the last possible transition in case */
+			/* the cumulative probability is rounded below 1 */
+			next_state = col;
+			next_prob = val;
+			biased_next_prob = biased_prob;
+			cumulative += biased_prob;
+			if( unif_rand < cumulative ){
+				break;
+			}
+		}
+	}
+	end_mtx_walk_row_nodiag;
+
+	*pLikelihood *= next_prob / biased_next_prob;
+	return next_state;
+}
+
+/**
+* This function simulates one path of "Phi U[tl, tr] Psi" with the biased
+* successor probabilities. The path follows the rules of
+* simulateIntUntilObservationCTMC.
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pModel the model of the until formula
+* @param pBias the change of measure
+* @param initial_state the state the path starts in
+* @param pSource the source of the random numbers
+* @param pVisitedStates the counter of simulated states, it is increased
+* @return the likelihood ratio of the path if it fulfills the formula, otherwise 0
+*/
+static double simulateImportancePath( const TSplittingModel * pModel, const TImportanceBias * pBias,
+				const int initial_state, TRandWordSource * pSource,
+				unsigned int * pVisitedStates ){
+	const double left_time_bound = pModel->left_time_bound;
+	const double right_time_bound = pModel->right_time_bound;
+	int state = initial_state;
+	double time = 0.0, exit_time, rand, likelihood = 1.0;
+
+	for( ; ; ){
+		if( time > right_time_bound ){
+			return 0.0;
+		}
+		/* A Psi state entered after the left time bound fulfills the formula */
+		if( get_bit_val( pModel->pPsiBitSet, state ) && time >= left_time_bound ){
+			return likelihood;
+		}
+		if( ! get_bit_val( pModel->pPhiBitSet, state ) ){
+			return 0.0;
+		}
+
+		/* Compute when we leave the state, an absorbing state */
+		/* is left after the right time bound */
+		if( NULL == pModel->pExitRates ){
+			exit_time = time + 1.0;
+		} else if( pModel->pExitRates[state] != 0.0 ){
+			fillRandExpWords( pSource, &rand, 1 );
+			exit_time = time + rand / pModel->pExitRates[state];
+		} else {
+			exit_time = right_time_bound + 1.0;
+		}
+
+		/* A Psi state we are in at the left time bound fulfills the formula */
+		if( get_bit_val( pModel->pPsiBitSet, state ) && exit_time > left_time_bound &&
+			left_time_bound <= right_time_bound ){
+			return likelihood;
+		}
+		if( exit_time > right_time_bound || mtx_next_num( pModel->pStateSpace, state ) == 0 ){
+			return 0.0;
+		}
+
+		/* Go to the next state */
+		fillRandUnifWords( pSource, &rand, 1 );
+		state = chooseBiasedNextState( pModel, pBias, state, rand, &likelihood );
+		if( state < 0 ){
+			return 0.0;
+		}
+		time = exit_time;
+		(*pVisitedStates)++;
+	}
+}
+
+/**
+* This function simulates num_obs paths of "Phi U[tl, tr] Psi" from
+* initial_state with the successor probabilities changed by the bias.
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pModel the model of the until formula
+* @param pBias the change of measure
+* @param initial_state the state the paths start in
+* @param num_obs the number of paths to simulate
+* @param pSumWeights the sum of the weights, it is increased
+* @param pSumSqWeights the sum of the squared weights, it is increased
+* @param pVisitedStates the counter of simulated states, it is increased
+*/
+void simulateImportanceSample( const TSplittingModel * pModel, const TImportanceBias * pBias,
+				const int initial_state, const int num_obs, double * pSumWeights,
+				double * pSumSqWeights, unsigned int * pVisitedStates ){
+	/* The paths are divided among the threads, without */
+	/* threads they are simulated with the first stream */
+	const int chunks = ( getSimThreads() > 0 ? getSimThreads() : 1 );
+	TRNGStream * pStreams = getSimulationStreams();
+	double sum = 0.0, sum_sq = 0.0;
+	unsigned int newlyVisitedStates = 0;
+	int t;
+
+#	ifdef _OPENMP
+#	pragma omp parallel for num_threads(chunks) schedule(static, 1) reduction(+:sum,sum_sq,newlyVisitedStates)
+#	endif
+	for( t = 0; t < chunks; t++ ){
+		TRandWordSource source;
+		double weight;
+		int i;
+
+		initRandWordSource( &source, fillRandWordsStream, &pStreams[t] );
+		for( i = SIM_CHUNK_START( num_obs, chunks, t ); i < SIM_CHUNK_START( num_obs, chunks, t + 1 ); i++ ){
+			weight = simulateImportancePath( pModel, pBias, initial_state, &source, &newlyVisitedStates );
+			sum += weight;
+			sum_sq += weight * weight;
+		}
+	}
+
+	*pSumWeights += sum;
+	*pSumSqWeights += sum_sq;
+	*pVisitedStates += newlyVisitedStates;
+}
@@ -0,0 +1,296 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*       $LastChangedRevision: 415 $
+*       $LastChangedDate: 2010-12-18 17:21:05 +0100 (Sa, 18. Dez 2010) $
+*       $LastChangedBy: davidjansen $
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) The University of Twente, 2004-2008.
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*	Authors: Ivan Zapreev, Christina Jansen
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*       Old contact:
+*		Formal Methods and Tools Group, University of Twente,
+*		P.O. Box 217, 7500 AE Enschede, The Netherlands,
+*		Phone: +31 53 4893767, Fax: +31 53 4893247,
+*		E-mail: mrmc@cs.utwente.nl
+*
+*	Source description: This is a source file for the simulation engine
+*	here we intend to define the importance splitting of the until
+*	operators.
+*/
+
+#include "simulation_splitting.h"
+
+#include "simulation.h"
+#include "simulation_common.h"
+#include "simulation_utils.h"
+
+/* The outcomes of a path of the importance splitting */
+#define SPLIT_PATH_STOPPED 0
+#define SPLIT_PATH_ENTERED 1
+
+/**
+* This function computes the level function of the importance splitting:
+* the length of the shortest path from a state via Phi states to a Psi
+* state. Like get_exist_until it searches backward from the Psi states,
+* but it takes the states in the order they are found, such that every
+* state gets the number of the round it is found in.
+* @param pStateSpace the state space
+* @param pPhiBitSet the states the paths may go through
+* @param pPsiBitSet the states the paths have to reach
+* @return the level of every state, -1 if Psi is not reachable via Phi
+*/
+int * computeSplittingLevels( const sparse * pStateSpace, const bitset * pPhiBitSet,
+				const bitset * pPsiBitSet ){
+	const int size = mtx_rows( pStateSpace );
+	int * pLevels = (int *) malloc( size * sizeof(int) );
+	/* The found states in the order they are found */
+	int * pStates = (int *) malloc( size * sizeof(int) );
+	int found = 0, i, state = -1;
+
+	if( NULL == pLevels || NULL == pStates ){
+		free( pLevels );
+		free( pStates );
+		exit(err_macro_0(err_MEMORY, "computeSplittingLevels()", EXIT_FAILURE));
+	}
+
+	for( i = 0; i < size; i++ ){
+		pLevels[i] = -1;
+	}
+	/* The Psi states are on level 0 */
+	while( ( state = get_idx_next_non_zero( pPsiBitSet, state ) ) != -1 ){
+		pLevels[state] = 0;
+		pStates[found++] = state;
+	}
+	/* The Phi predecessors of a state on level l are on level l + 1 */
+	/* if they are not on a lower level already */
+	for( i = 0; i < found; i++ ){
+		mtx_walk_column_nodiag_noval( pStateSpace, back_set_j, (const int) pStates[i] )
+		{
+			if( get_bit_val( pPhiBitSet, back_set_j ) && pLevels[back_set_j] == -1 ){
+				pLevels[back_set_j] = pLevels[pStates[i]] + 1;
+				pStates[found++] = back_set_j;
+			}
+		}
+		end_mtx_walk_column_nodiag_noval;
+	}
+	free( pStates );
+	return pLevels;
+}
+
+/**
+* This function simulates one path of the importance splitting from the
+* given state, entered at the given time, until it enters the level
+* threshold or a lower one, or it fulfills the until formula if threshold
+* is 0. The path is simulated by the same rules as
+* simulateIntUntilObservationCTMC, it stops if it leaves the Phi states,
+* exceeds the right time bound or enters a state with a negative level.
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pModel the model of the until formula
+* @param threshold the level the path has to enter, 0 for Psi
+* @param pState the state the path starts in, it becomes the state the
+*		path entered the level in
+* @param pTime the time the path entered *pState, it becomes the time the
+*		path entered the level
+* @param pSource the source of the random numbers
+* @param pVisitedStates the counter of simulated states, it is increased
+* @return SPLIT_PATH_ENTERED if the path entered the level, otherwise
+*		SPLIT_PATH_STOPPED
+*/
+static int simulateSplittingPath( const TSplittingModel * pModel, const int threshold,
+				int * pState, double * pTime, TRandWordSource * pSource,
+				unsigned int * pVisitedStates ){
+	const double left_time_bound = pModel->left_time_bound;
+	const double right_time_bound = pModel->right_time_bound;
+	int state = *pState;
+	double time = *pTime, exit_time, rand;
+
+	for( ; ; ){
+		if( time > right_time_bound ){
+			return SPLIT_PATH_STOPPED;
+		}
+		/* A Psi state entered after the left time bound fulfills the formula */
+		if( get_bit_val( pModel->pPsiBitSet, state ) && time >= left_time_bound ){
+			break;
+		}
+		if( ! get_bit_val( pModel->pPhiBitSet, state ) || pModel->pLevels[state] < 0 ){
+			return SPLIT_PATH_STOPPED;
+		}
+		if( threshold > 0 && pModel->pLevels[state] <= threshold ){
+			break;
+		}
+
+		/* Compute when we leave the state, an absorbing state */
+		/* is left after the right time bound */
+		if( NULL == pModel->pExitRates ){
+			exit_time = time + 1.0;
+		} else if( pModel->pExitRates[state] != 0.0 ){
+			fillRandExpWords( pSource, &rand, 1 );
+			exit_time = time + rand / pModel->pExitRates[state];
+		} else {
+			exit_time = right_time_bound + 1.0;
+		}
+
+		/* A Psi state we are in at the left time bound fulfills the formula */
+		if( get_bit_val( pModel->pPsiBitSet, state ) && exit_time > left_time_bound &&
+			left_time_bound <= right_time_bound ){
+			break;
+		}
+		if( exit_time > right_time_bound ){
+			return SPLIT_PATH_STOPPED;
+		}
+
+		/* Go to the next state */
+		fillRandUnifWords( pSource, &rand, 1 );
+		state = chooseNextState( pModel->pStateSpace, state, rand );
+		time = exit_time;
+		(*pVisitedStates)++;
+	}
+	*pState = state;
+	*pTime = time;
+	return SPLIT_PATH_ENTERED;
+}
+
+/**
+* This function does one run of the fixed-effort importance splitting.
+* On every level effort paths are started, the i-th one from the (i mod n)-th
+* of the n states where the paths of the level above entered the level.
+* @param pModel the model of the until formula
+* @param initial_state the state the paths start in
+* @param effort the number of paths per level
+* @param pStates the array of effort states the paths start in
+* @param pTimes the array of effort times the paths start at
+* @param pNextStates the array of effort states the paths enter the next level in
+* @param pNextTimes the array of effort times the paths enter the next level at
+* @param pSource the source of the random numbers
+* @param pVisitedStates the counter of simulated states, it is increased
+* @return the estimated probability
+*/
+static double simulateSplittingRun( const TSplittingModel * pModel, const int initial_state,
+				const int effort, int * pStates, double * pTimes, int * pNextStates,
+				double * pNextTimes, TRandWordSource * pSource, unsigned int * pVisitedStates ){
+	const int levels = pModel->pLevels[initial_state];
+	double estimate = 1.0;
+	int num_entered = 1, num_started, threshold, i;
+	int * pTmpStates;
+	double * pTmpTimes;
+
+	if( levels < 0 ){
+		return 0.0;
+	}
+
+	pStates[0] = initial_state;
+	pTimes[0] = 0.0;
+	/* Go down the levels one by one, the last stage */
+	/* (threshold 0) checks the formula itself */
+	for( threshold = ( levels > 0 ? levels - 1 : 0 ); threshold >= 0; threshold-- ){
+		num_started = num_entered;
+		num_entered = 0;
+		for( i = 0; i < effort; i++ ){
+			pNextStates[num_entered] = pStates[i % num_started];
+			pNextTimes[num_entered] = pTimes[i % num_started];
+			if( simulateSplittingPath( pModel, threshold, &pNextStates[num_entered],
+						&pNextTimes[num_entered], pSource, pVisitedStates )
+				== SPLIT_PATH_ENTERED ){
+				num_entered++;
+			}
+		}
+		estimate *= (double) num_entered / (double) effort;
+		if( num_entered == 0 ){
+			break;
+		}
+
+		/* The entered states are the start states of the next level */
+		pTmpStates = pStates; pStates = pNextStates; pNextStates = pTmpStates;
+		pTmpTimes = pTimes; pTimes = pNextTimes; pNextTimes = pTmpTimes;
+	}
+	return estimate;
+}
+
+/**
+* This function estimates the probability of "Phi U[tl, tr] Psi" in
+* initial_state by fixed-effort importance splitting.
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pModel the model of the until formula
+* @param initial_state the state the paths start in
+* @param effort the number of paths per level
+* @param runs the number of independent runs
+* @param conf_zeta the zeta value of the conf. int.
+* @param pCiLeftBorder the return value for the left conf. int. border
+* @param pCiRightBorder the return value for the right conf. int. border
+* @param pVisitedStates the counter of simulated states, it is increased
+* NOTE: If Psi can not be reached from initial_state, i.e. its level is
+*	negative, the probability is exactly 0 and nothing is simulated.
+*/
+void estimateBySplitting( const TSplittingModel * pModel, const int initial_state,
+				const int effort, const int runs, const double conf_zeta,
+				double * pCiLeftBorder, double * pCiRightBorder,
+				unsigned int * pVisitedStates ){
+	/* The runs are divided among the threads, without */
+	/* threads they are simulated with the first stream */
+	const int chunks = ( getSimThreads() > 0 ? getSimThreads() : 1 );
+	TRNGStream * pStreams = getSimulationStreams();
+	double sum = 0.0, sum_sq = 0.0;
+	unsigned int newlyVisitedStates = 0;
+	int t;
+
+	if( pModel->pLevels[initial_state] < 0 ){
+		*pCiLeftBorder = 0.0;
+		*pCiRightBorder = 0.0;
+		return;
+	}
+
+#	ifdef _OPENMP
+#	pragma omp parallel for num_threads(chunks) schedule(static, 1) reduction(+:sum,sum_sq,newlyVisitedStates)
+#	endif
+	for( t = 0; t < chunks; t++ ){
+		TRandWordSource source;
+		int * pStates = (int *) malloc( 2 * effort * sizeof(int) );
+		double * pTimes = (double *) malloc( 2 * effort * sizeof(double) );
+		double estimate;
+		int r;
+
+		if( NULL == pStates || NULL == pTimes ){
+			exit(err_macro_0(err_MEMORY, "estimateBySplitting()", EXIT_FAILURE));
+		}
+		initRandWordSource( &source, fillRandWordsStream, &pStreams[t] );
+		for( r = SIM_CHUNK_START( runs, chunks, t ); r < SIM_CHUNK_START( runs, chunks, t + 1 ); r++ ){
+			estimate = simulateSplittingRun( pModel, initial_state, effort, pStates, pTimes,
+						pStates + effort, pTimes + effort, &source, &newlyVisitedStates );
+			sum += estimate;
+			sum_sq += estimate * estimate;
+		}
+		free( pStates );
+		free( pTimes );
+	}
+
+	/* The conf. int. from the mean and the sample variance of the runs */
+	computeBordersWeighted( conf_zeta, pCiLeftBorder, pCiRightBorder, runs, sum, sum_sq );
+	*pVisitedStates += newlyVisitedStates;
+}
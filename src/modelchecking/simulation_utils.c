@@ -48,10 +48,16 @@
 #include "simulation_utils.h"
 
 #include "parser_to_tree.h"
+#include "simulation.h"
 #include "simulation_common.h"
 
+#include <gsl/gsl_cdf.h>
 #include <math.h>
 
+/* The sequential tests keep the borders of the indifference region */
+/* this far away from 0 and 1, such that the likelihoods stay positive */
+#define SEQUENTIAL_TEST_MIN_PROB 1e-9
+
 /****************************************************************************/
 /**************CHECK THE CONF. INT. AGAINST THE PROB. CONSTRAINT*************/
 /****************************************************************************/
@@ -231,6 +237,88 @@ TV_LOGIC checkBoundVSConfInt( const int comparator, const double prob_bound, con
 	return tvl_result;
 }
 
+/**
+* This function decides on the probability bound by a sequential test:
+* either Wald's sequential probability ratio test or the Bayesian test
+* with the posterior odds under the uniform prior. Both weigh the hypothesis
+* "p >= prob_bound + indiff_width/2" against "p <= prob_bound - indiff_width/2"
+* and decide as soon as the evidence for one of them exceeds Wald's bound.
+* @param test one from {SIM_TEST_SPRT, SIM_TEST_BAYES}
+* @param comparator the comparator, one of:
+*	COMPARATOR_SF_GREATER, COMPARATOR_SF_GREATER_OR_EQUAL,
+*	COMPARATOR_SF_LESS, COMPARATOR_SF_LESS_OR_EQUAL
+* @param prob_bound the probability bound
+* @param sample_size the number of observations
+* @param sum_good the number of successful observations
+* @param indiff_width the indifference-region width
+* @param alpha the probability to decide for "p below" while p lies above
+* @param beta the probability to decide for "p above" while p lies below
+* @return returns one of: TVL_TT, TVL_FF, TVL_NN
+*/
+TV_LOGIC checkBoundSequentialTest( const int test, const int comparator, const double prob_bound,
+				const int sample_size, const int sum_good, const double indiff_width,
+				const double alpha, const double beta ){
+	TV_LOGIC tvl_result = TVL_NN;
+	/* The borders of the indifference region */
+	double upper = prob_bound + 0.5 * indiff_width, lower = prob_bound - 0.5 * indiff_width;
+	/* The posterior probabilities of the two hypotheses */
+	double post_above, post_below;
+	/* The logarithm of the evidence for "p above" against "p below" */
+	double log_ratio = 0.0;
+	BOOL isAbove, isBelow;
+
+	if( upper > 1.0 - SEQUENTIAL_TEST_MIN_PROB ){
+		upper = 1.0 - SEQUENTIAL_TEST_MIN_PROB;
+	}
+	if( lower < SEQUENTIAL_TEST_MIN_PROB ){
+		lower = SEQUENTIAL_TEST_MIN_PROB;
+	}
+
+	switch( test ){
+		case SIM_TEST_SPRT:
+			/* The log-likelihood ratio of the Bernoulli observations */
+			log_ratio = sum_good * log( upper / lower ) +
+					( sample_size - sum_good ) * log( ( 1.0 - upper ) / ( 1.0 - lower ) );
+			break;
+		case SIM_TEST_BAYES:
+			/* The posterior of the uniform prior is Beta(1 + good, 1 + bad) */
+			post_above = gsl_cdf_beta_Q( upper, 1.0 + sum_good, 1.0 + sample_size - sum_good );
+			post_below = gsl_cdf_beta_P( lower, 1.0 + sum_good, 1.0 + sample_size - sum_good );
+			if( post_below == 0.0 ){
+				log_ratio = ( post_above == 0.0 ? 0.0 : HUGE_VAL );
+			} else if( post_above == 0.0 ){
+				log_ratio = -HUGE_VAL;
+			} else {
+				log_ratio = log( post_above / post_below );
+			}
+			break;
+		default:
+			printf("ERROR: An unexpected sequential test: %d.\n", test);
+			exit(EXIT_FAILURE);
+	}
+
+	/* Wald's bounds for the error probabilities alpha and beta */
+	isAbove = ( log_ratio >= log( ( 1.0 - alpha ) / beta ) );
+	isBelow = ( -log_ratio >= log( ( 1.0 - beta ) / alpha ) );
+
+	/* Distinguish the cases based on the comparator type */
+	switch( comparator ){
+		case COMPARATOR_SF_LESS_OR_EQUAL:
+		case COMPARATOR_SF_LESS:
+			tvl_result = checkBoundVSConfIntHelper( isBelow, isAbove );
+			break;
+		case COMPARATOR_SF_GREATER_OR_EQUAL:
+		case COMPARATOR_SF_GREATER:
+			tvl_result = checkBoundVSConfIntHelper( isAbove, isBelow );
+			break;
+		default:
+			printf("ERROR: An unexpected comparator type: %d.\n", comparator);
+			exit(EXIT_FAILURE);
+	}
+
+	return tvl_result;
+}
+
 /**
 * This function checks the precondition of the conf. int. like it is done in checkBoundVSConfInt(...)
 * Namely we check if the width of the confidence interval ( ciRightBorder - ciLeftBorder ) for the state
@@ -373,6 +461,44 @@ inline void computeBordersUU( const double conf_zeta, double * pCiLeftBorder, do
 	ENDIF_SAFETY
 }
 
+/**
+* This method computes the standard conf. int. borders of the mean of a sample
+* of real-valued observations, such as the likelihood ratios of importance
+* sampling or the estimates of independent splitting runs.
+* NOTE: The borders that do not fit into the interval R[0,1] are truncated.
+* NOTE: If all observations are zero, i.e. the event has not been seen yet,
+*	the sample variance says nothing. Then the right border is the
+*	zero-success bound 1 - alpha^(1/sample_size), where alpha is the error
+*	of one side of the conf. int.: a probability above it would have
+*	produced a non-zero observation with probability more than 1 - alpha.
+*	This needs every observation to be non-zero with a probability of at
+*	least the mean, which holds for the splitting runs (their estimates
+*	lie in [0,1]) and for importance sampling whose bias does not make the
+*	Psi states less likely to be reached.
+* @param conf_zeta the zeta value derived from the confidence
+* @param pCiLeftBorder the pointer to the left conf. int. border
+* @param pCiRightBorder the pointer to the right conf. int. border
+* @param sample_size the number of observations, at least 2
+* @param sum the sum of the observations
+* @param sum_sq the sum of the squared observations
+*/
+void computeBordersWeighted( const double conf_zeta, double * pCiLeftBorder, double * pCiRightBorder,
+				const int sample_size, const double sum, const double sum_sq ){
+	const double mean = sum / sample_size;
+	const double variance = ( sum_sq - sample_size * mean * mean ) / ( sample_size - 1.0 );
+	const double half_width = ( variance > 0.0 ? conf_zeta * sqrt( variance / sample_size ) : 0.0 );
+
+	if( sum_sq <= 0.0 ){
+		/* The error of one side of the two-sided conf. int. */
+		const double alpha = 1.0 - gsl_cdf_ugaussian_P( conf_zeta );
+		( * pCiLeftBorder ) = 0.0;
+		( * pCiRightBorder ) = 1.0 - pow( alpha, 1.0 / sample_size );
+		return;
+	}
+	( * pCiLeftBorder ) = ( mean - half_width > 0.0 ? mean - half_width : 0.0 );
+	( * pCiRightBorder ) = ( mean + half_width < 1.0 ? mean + half_width : 1.0 );
+}
+
 /**
 * This method computes the conf. int. borders of steady-state simulation for
 * the given sample, i.e. we compute and set: (*pCiLeftBorder), (*pCiRightBorder).
@@ -386,38 +512,24 @@ inline void computeBordersUU( const double conf_zeta, double * pCiLeftBorder, do
 */
 inline void computeBordersConfIntSS( const int reg_cycles, const double conf_zeta, double * pCiLeftBorder,
 					double * pCiRightBorder, const PTSampleVecSteady pSampleVecSteady ){
-	int i;
 	double point_estimate, half_width_ci;
-	double good_mean = 0; double time_mean = 0;
+	double good_mean, time_mean;
 	double point_estimate_variance;
-	double good_variance = 0; double time_variance = 0; double time_good_covariance = 0;
-	double good_helper, time_helper;
+	double good_variance, time_variance, time_good_covariance;
 
 	IF_SAFETY( pSampleVecSteady != NULL )
 		IF_SAFETY( ( pCiLeftBorder != NULL ) && ( pCiRightBorder != NULL ) )
+			/* The statistics of the regeneration cycles */
+			const TCycleStats * pStats = &pSampleVecSteady->cycleStats;
 
-			/* Compute the mean value for "good" states and time */
-			for( i = 0; i < reg_cycles; i++){
-				good_mean += pSampleVecSteady->pGoodObservationsVec[i];
-				time_mean += pSampleVecSteady->pTimeObservationsVec[i];
-			}
-			good_mean = good_mean / reg_cycles;
-			time_mean = time_mean / reg_cycles;
-
-			/* Compute the variances */
-			for( i = 0; i < reg_cycles; i++){
-				good_helper = pSampleVecSteady->pGoodObservationsVec[i] - good_mean;
-				time_helper = pSampleVecSteady->pTimeObservationsVec[i] - time_mean;
-
-                                /* Multiplying a double with itself is faster
-                                   than calling pow(...,2.0). David N. Jansen.*/
-                                good_variance += good_helper * good_helper;
-                                time_variance += time_helper * time_helper;
-				time_good_covariance += good_helper * time_helper;
-			}
-			good_variance = good_variance / (reg_cycles - 1);
-			time_variance = time_variance / (reg_cycles - 1);
-			time_good_covariance = time_good_covariance / (reg_cycles - 1);
+			/* Take the mean value for "good" states and time */
+			good_mean = pStats->mean_good;
+			time_mean = pStats->mean_time;
+
+			/* Compute the variances and the covariance from the central moments */
+			good_variance = pStats->m2_good / (reg_cycles - 1);
+			time_variance = pStats->m2_time / (reg_cycles - 1);
+			time_good_covariance = pStats->co_time_good / (reg_cycles - 1);
 
 			/* Compute the point estimate */
 			point_estimate = good_mean / time_mean;
@@ -456,18 +568,143 @@ inline void computeBordersConfIntSS( const int reg_cycles, const double conf_zet
 /**********THE FUNCTION THAT SIMULATES THE SAMPLE FOR UNBOUNDED UNTIL********/
 /****************************************************************************/
 
-/* These are the same two values and they indicate that the simulation of */
-/* new observations should start from the first one and also that all the */
-/* observation in the sample were processed */
-#define END_OF_OBSERVATIONS -1
-#define FOR_ALL_OBSERVATIONS END_OF_OBSERVATIONS
+/* This value indicates that the simulation of the transient */
+/* observations should start from the first one */
+#define FOR_ALL_OBSERVATIONS -1
+
+/**
+* This function performs at most "depth_steps_needed" successive simulations
+* of one observation, it stops early in a non-transient state.
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pStateSpace the sparse matrix of the embedded DTMC with good ad bad
+*			states made absorbing
+* @param current_obs_state the current state of the observation
+* @param depth_steps_needed the maximum number of simulation steps
+* @param pTransientStates the bitsets containing all the transient states
+* @param pVisitedStates the counter of simulated states, it is increased
+* @return the new state of the observation
+*/
+static int simulateUnbUntilObservationDTMC( const sparse * pStateSpace, int current_obs_state,
+					const int depth_steps_needed, const bitset *pTransientStates,
+					unsigned int * pVisitedStates ){
+	int extra_simulation_depth = 0;
+
+	/* Iterate until we are in the absorbing state or we are on the right depth */
+	while( ( extra_simulation_depth < depth_steps_needed ) && get_bit_val( pTransientStates, current_obs_state) ){
+		/* WARNING: We simulate the state ASSUMING there are no self loops! */
+		/* WARNING: We simulate a pTransientStates state, i.e. there are outgoing */
+		/* transitions in this state that are not self-loop transitions */
+		current_obs_state = computeNextState(pStateSpace,
+					current_obs_state);
+
+		/* The next state was simulated */
+		(*pVisitedStates)++;
+
+		/* Update the loop-condition variable */
+		extra_simulation_depth += 1;
+	}
+	return current_obs_state;
+}
+
+/**
+* This function simulates the given observations by lanes: up to SIM_LANES
+* observations make a step together, the random numbers of a step are drawn
+* at once and a finished lane is refilled with the next observation. Every
+* observation makes at most "depth_steps_needed" steps, it stops early in a
+* non-transient state.
+* WARNING: We simulate the states ASSUMING there are no self loops!
+* @param pStateSpace the sparse matrix of the embedded DTMC with good ad bad
+*			states made absorbing
+* @param pObservationsVec the states of the observations, they are updated
+* @param num_obs the size of pObservationsVec
+* @param depth_steps_needed the maximum number of simulation steps
+* @param pTransientStates the bitsets containing all the transient states
+* @param pStream the stream to draw from
+* @param pVisitedStates the counter of simulated states, it is increased
+*/
+static void simulateUnbUntilLanesDTMC( const sparse * pStateSpace, int * pObservationsVec,
+					const int num_obs, const int depth_steps_needed,
+					const bitset *pTransientStates, TRNGStream * pStream,
+					unsigned int * pVisitedStates ){
+	/* The current states, observation indices and depths of the lanes */
+	int lane_state[SIM_LANES], lane_obs[SIM_LANES], lane_depth[SIM_LANES];
+	/* The random numbers of one step */
+	double lane_unif[SIM_LANES];
+	/* The buffered words of the stream */
+	TRandWordSource source;
+	int active = 0, next_obs = 0, k;
+
+	initRandWordSource( &source, fillRandWordsStream, pStream );
+	for( ; ; ){
+		/* Fill the free lanes with the observations that still need steps */
+		while( active < SIM_LANES && next_obs < num_obs ){
+			lane_obs[active] = next_obs++;
+			lane_state[active] = pObservationsVec[lane_obs[active]];
+			lane_depth[active] = 0;
+			if( depth_steps_needed > 0 && get_bit_val( pTransientStates, lane_state[active] ) ){
+				active++;
+			}
+		}
+		if( active == 0 ){
+			break;
+		}
+
+		/* Make one step in every lane */
+		fillRandUnifWords( &source, lane_unif, active );
+		for( k = 0; k < active; k++ ){
+			lane_state[k] = chooseNextState( pStateSpace, lane_state[k], lane_unif[k] );
+		}
+		(*pVisitedStates) += active;
+
+		/* Retire the finished lanes, the last lane takes the free place */
+		for( k = 0; k < active; ){
+			if( ++lane_depth[k] >= depth_steps_needed
+					|| ! get_bit_val( pTransientStates, lane_state[k] ) ){
+				pObservationsVec[lane_obs[k]] = lane_state[k];
+				active--;
+				lane_state[k] = lane_state[active];
+				lane_obs[k] = lane_obs[active];
+				lane_depth[k] = lane_depth[active];
+			} else {
+				k++;
+			}
+		}
+	}
+}
+
+/**
+* This function drops the observations that are not in transient states any
+* more from the sample, those in good states are added to sum_good. The order
+* of the remaining transient observations is kept.
+* @param pSampleVecUntil the sample vector
+* @param pGoodStates the bitsets containing all the good absorbing states
+* @param pTransientStates the bitsets containing all the transient states
+*/
+static void removeFinishedObservationsDTMC( PTSampleVecUntil pSampleVecUntil, const bitset * pGoodStates,
+					const bitset *pTransientStates ){
+	int * pObservationsVec = pSampleVecUntil->pObservationsVec;
+	int i, num_trans = 0;
+
+	for( i = 0; i < pSampleVecUntil->sum_trans; i++ ){
+		if( get_bit_val( pTransientStates, pObservationsVec[i] ) ){
+			pObservationsVec[num_trans++] = pObservationsVec[i];
+		} else if( get_bit_val( pGoodStates, pObservationsVec[i] ) ){
+			pSampleVecUntil->sum_good += 1;
+		}
+	}
+	pSampleVecUntil->sum_trans = num_trans;
+}
 
 /**
 * This function is supposed to perform "depth_steps_needed" successive simulations
-* for every observation after and including the "initial_obs_index"
+* for every transient observation after and including the "initial_obs_index"
 * (if initial_obs_index != -1). The fields of "pSampleVecUntil", such as
-*	sum_good, sum_trans, curr_simulation_depth, pTransStateInd, pObservationsVec.
-* are updated correspondingly.
+*	sum_good, sum_trans, curr_simulation_depth, pObservationsVec.
+* are updated correspondingly, the finished observations are dropped.
+* If there are simulation threads, the observations are divided in
+* contiguous chunks, one per thread, and every thread simulates its
+* chunk by lanes with its own stream. The sample fields are updated
+* afterwards, so the result does not depend on the thread scheduling.
 * WARNING: We simulate the states ASSUMING there are no self loops!
 * @param pStateSpace the sparse matrix of the embedded DTMC with good ad bad
 *			states made absorbing
@@ -483,14 +720,13 @@ inline void computeBordersConfIntSS( const int reg_cycles, const double conf_zet
 static void simulateUnbUntilSampleDTMC( const sparse * pStateSpace, PTSampleVecUntil pSampleVecUntil,
 					const int initial_obs_index, const int depth_steps_needed,
 					const bitset * pGoodStates, const bitset *pTransientStates ){
-        /* Note that the second parameter to get_idx_next_non_zero() is the
-           index of the previously found bitset element. */
-	/* Therefore if we are not searching from the beginning of the bitset we have to use  */
-	/* "initial_obs_index - 1" as the initial index */
-	int curr_obs_idx = ( initial_obs_index == -1 ? initial_obs_index : initial_obs_index - 1 );
-	bitset * pTransStateInd = pSampleVecUntil->pTransStateInd;
+	const int first_obs_idx = ( initial_obs_index == FOR_ALL_OBSERVATIONS ? 0 : initial_obs_index );
+	const int num_obs = pSampleVecUntil->sum_trans - first_obs_idx;
+	int * pObservationsVec = &pSampleVecUntil->pObservationsVec[first_obs_idx];
 	/* Will store the number of newly visited states */
 	unsigned int newlyVisitedStates = 0;
+	const int threads = getSimThreads();
+	int i;
 
 	/* In case we are not adding new observations but just simulating all further */
 	if( initial_obs_index == FOR_ALL_OBSERVATIONS ){
@@ -498,40 +734,32 @@ static void simulateUnbUntilSampleDTMC( const sparse * pStateSpace, PTSampleVecU
 		pSampleVecUntil->curr_simulation_depth += depth_steps_needed;
 	}
 
-	/* For all the transient-state observation in the sample */
-	while( ( curr_obs_idx = get_idx_next_non_zero( pTransStateInd, curr_obs_idx  )) != END_OF_OBSERVATIONS ){
-		/* Take the current value of the curr_obs_idx's observation */
-		int current_obs_state = pSampleVecUntil->pObservationsVec[curr_obs_idx];
-		int extra_simulation_depth = 0;
-
-		/* Iterate until we are in the absorbing state or we are on the right depth */
-		while( ( extra_simulation_depth < depth_steps_needed ) && get_bit_val( pTransientStates, current_obs_state) ){
-			/* WARNING: We simulate the state ASSUMING there are no self loops! */
-			/* WARNING: We simulate a pTransientStates state, i.e. there are outgoing */
-			/* transitions in this state that are not self-loop transitions */
-                        current_obs_state = computeNextState(pStateSpace,
-                                        current_obs_state);
-
-			/* The next state was simulated */
-			newlyVisitedStates++;
-
-			/* Update the loop-condition variable */
-			extra_simulation_depth += 1;
+	if( threads > 0 ){
+		TRNGStream * pStreams = getSimulationStreams();
+
+		/* Every thread simulates its chunk of the observations */
+#		ifdef _OPENMP
+#		pragma omp parallel for num_threads(threads) schedule(static, 1) reduction(+:newlyVisitedStates)
+#		endif
+		for( i = 0; i < threads; i++ ){
+			const int first = SIM_CHUNK_START( num_obs, threads, i );
+			simulateUnbUntilLanesDTMC( pStateSpace, &pObservationsVec[first],
+						SIM_CHUNK_START( num_obs, threads, i + 1 ) - first,
+						depth_steps_needed, pTransientStates, &pStreams[i],
+						&newlyVisitedStates );
 		}
-
-		/* Update the observation pObservationsVec[curr_obs_idx] */
-		pSampleVecUntil->pObservationsVec[curr_obs_idx] = current_obs_state;
-
-		/* Update the sum_good, sum_trans and pTransStateInd fields */
-		if( ! get_bit_val( pTransientStates, current_obs_state) ){
-			pSampleVecUntil->sum_trans -= 1;
-                        set_bit_val(pTransStateInd, curr_obs_idx, BIT_OFF);
-			if( get_bit_val( pGoodStates, current_obs_state) ){
-				pSampleVecUntil->sum_good += 1;
-			}
+	} else {
+		/* For all the transient-state observation in the sample */
+		for( i = 0; i < num_obs; i++ ){
+			pObservationsVec[i] = simulateUnbUntilObservationDTMC( pStateSpace,
+							pObservationsVec[i], depth_steps_needed,
+							pTransientStates, &newlyVisitedStates );
 		}
 	}
 
+	/* Update the sum_good and sum_trans fields */
+	removeFinishedObservationsDTMC( pSampleVecUntil, pGoodStates, pTransientStates );
+
 	/* printSampleVectorUntil(pSampleVecUntil); */
 
 	/* Update the number of states visited while preparing this sample */
@@ -565,13 +793,14 @@ void simulateSampleVectorUnbUntilDTMC( const sparse * pStateSpace, PTSampleVecUn
 
 				/* If we need to extend the sample size */
 				if( pSampleVecUntilBase->curr_sample_size < new_sample_size ){
-					const int old_sample_size = pSampleVecUntilBase->curr_sample_size;
+					/* The new observations are added after the transient ones */
+					const int old_sum_trans = pSampleVecUntil->sum_trans;
 
 					/* Extend the sample size */
 					extendSampleVectorUntil( pSampleVecUntil, new_sample_size );
 
 					/* Do simulations for the newly added observations */
-					simulateUnbUntilSampleDTMC( pStateSpace, pSampleVecUntil, old_sample_size,
+					simulateUnbUntilSampleDTMC( pStateSpace, pSampleVecUntil, old_sum_trans,
 									pSampleVecUntil->curr_simulation_depth,
 									pGoodStates, pTransientStates );
 				}
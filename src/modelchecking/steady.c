@@ -266,7 +266,7 @@ static double * getReachProbability(const int bscc_id)
 
 	/* Compute the probabilities P(true U BSCC) */
 	if( isRunMode(CTMC_MODE) || isRunMode(DTMC_MODE) || isRunMode(DMRM_MODE) ){
-		pUntilResults = until( TIME_UNBOUNDED_FORM, pbTRUEBitSet, pBSCC, 0.0, 0.0, TRUE );
+		pUntilResults = until( TIME_UNBOUNDED_FORM, pbTRUEBitSet, pBSCC, 0.0, 0.0, TRUE, NULL );
                 if ( NULL == pUntilResults ) {
                         err_msg_1(err_CALLBY, "getReachProbability(%d)",bscc_id,
                                 (free_bitset(pBSCC),free(pUntilResults), NULL));
@@ -64,36 +64,43 @@
 * @param subi the left time bound.
 * @param supi tyhe right time bound.
 * @param isIgnoreFLumping if we want the formula dependent lumping to be ignored
+* @param ppP if not NULL, receives the partition the result is kept over (one
+*	value per block) when formula dependent lumping is done, NULL otherwise
 * @return result of the until formula for all states.
 */
-double * until(const int type, const bitset *phi, const bitset *psi, double subi, double supi, BOOL isIgnoreFLumping)
+double * until(const int type, const bitset *phi, const bitset *psi, double subi, double supi, BOOL isIgnoreFLumping,
+                partition ** ppP)
 {
 	const BOOL isLumping = isRunMode(F_DEP_LUMP_MODE) && ( ! isIgnoreFLumping );
 
+	if( ppP != NULL ){
+		*ppP = NULL;
+	}
+
 	if( isRunMode(CTMC_MODE) || isRunMode(CMRM_MODE))
 	{
 		/*The CTMC case*/
 		if( type == TIME_UNBOUNDED_FORM ){
                         double * result;
                         if ( isLumping )
-                                result = unbounded_until_lumping(phi, psi);
+                                result = unbounded_until_lumping(phi, psi, ppP);
                         else
                                 result = unbounded_until(phi, psi);
                         if ( NULL == result ) {
-                                err_msg_8(err_CALLBY, "until(%d,%p[%d],%p[%d],"
-                                        "%g,%g,%d)", type, (const void *) phi,
+                                err_msg_9(err_CALLBY, "until(%d,%p[%d],%p[%d],"
+                                        "%g,%g,%d,%p)", type, (const void *) phi,
                                         bitset_size(phi), (const void *) psi,
                                         bitset_size(psi), subi, supi,
-                                        isIgnoreFLumping, NULL);
+                                        isIgnoreFLumping, (void *) ppP, NULL);
                         }
                         return result;
 		}else{
 			if( type == TIME_INTERVAL_FORM ){
 				if( subi == 0.0 ){
-					return ( isLumping ? bounded_until_lumping(phi, psi, supi) : bounded_until(phi, psi, supi) );
+					return ( isLumping ? bounded_until_lumping(phi, psi, supi, ppP) : bounded_until(phi, psi, supi) );
 				}else{
 					if( subi > 0.0 && supi >= subi ){
-						return ( isLumping ? interval_until_lumping(phi, psi, subi, supi) : interval_until(phi, psi, subi, supi) );
+						return ( isLumping ? interval_until_lumping(phi, psi, subi, supi, ppP) : interval_until(phi, psi, subi, supi) );
 					}else{
 						printf("ERROR: The formula time bounds [%f,%f] are inappropriate.\n", subi, supi);
                                                 return (double*) calloc((size_t)
@@ -109,11 +116,11 @@ double * until(const int type, const bitset *phi, const bitset *psi, double subi
 	}else if( isRunMode(DTMC_MODE) || isRunMode(DMRM_MODE)){
 		/*The DTMC case*/
 		if( type == TIME_UNBOUNDED_FORM ){
-			return ( isLumping ? dtmc_unbounded_until_lumping(phi, psi) : dtmc_unbounded_until(phi, psi) );
+			return ( isLumping ? dtmc_unbounded_until_lumping(phi, psi, ppP) : dtmc_unbounded_until(phi, psi) );
 		}else{
 			if( type == TIME_INTERVAL_FORM ){
 				if( subi == 0.0 ){
-					return ( isLumping ? dtmc_bounded_until_lumping(phi, psi, supi) : dtmc_bounded_until(phi, psi, supi) );
+					return ( isLumping ? dtmc_bounded_until_lumping(phi, psi, supi, ppP) : dtmc_bounded_until(phi, psi, supi) );
 				}else{
 					printf("ERROR: This formula with general time bounds is not supported for PCTL.\n");
                                         return (double*) calloc(
@@ -223,17 +230,23 @@ double * next(const int type, const bitset * phi, double subi, double supi) {
 * @param ppResultError  the pointer to the array of doubles. This array will
 *                       store the errors
 *			for the resulting probabilities. (This is the return variable)
+* @param ppP if not NULL, receives the partition the result is kept over (one
+*	value per block) when formula dependent lumping is done, NULL otherwise
 * @return result of the until formula for all states.
 */
 double * until_rewards(const bitset * phi, const bitset * psi, double subi,
                 double supi, double subj, double supj, BOOL isIgnoreFLumping,
-                double ** ppResultError)
+                double ** ppResultError, partition ** ppP)
 {
 	const BOOL isLumping = isRunMode(F_DEP_LUMP_MODE) && ( ! isIgnoreFLumping );
 
+	if( ppP != NULL ){
+		*ppP = NULL;
+	}
+
 	if( isRunMode(CMRM_MODE) ){
 		if( subi == 0.0 && subj == 0.0 && supi != 0.0 && supj != 0.0 ){
-			return ( isLumping ? ctmrm_bounded_until_lumping(phi, psi, supi, supj, ppResultError) : ctmrm_bounded_until(phi, psi, supi, supj, ppResultError) );
+			return ( isLumping ? ctmrm_bounded_until_lumping(phi, psi, supi, supj, ppResultError, ppP) : ctmrm_bounded_until(phi, psi, supi, supj, ppResultError) );
 		}else{
 			printf("ERROR: Given parameters combination is not supported by CSRL.\n");
                         return (double *) calloc((size_t) bitset_size(phi),
@@ -242,7 +255,7 @@ double * until_rewards(const bitset * phi, const bitset * psi, double subi,
 	}else{
 		if( isRunMode(DMRM_MODE) ){
 			if( supi != 0.0 && supj != 0.0 ){
-				return ( isLumping ? dtmrm_bounded_until_lumping(phi, psi, subi, supi, subj, supj) : dtmrm_bounded_until(phi, psi, subi, supi, subj, supj) );
+				return ( isLumping ? dtmrm_bounded_until_lumping(phi, psi, subi, supi, subj, supj, ppP) : dtmrm_bounded_until(phi, psi, subi, supi, subj, supj) );
 			}else{
 				printf("ERROR: Given parameters combination is not supported by PRCTL.\n");
                                 return (double *) calloc((size_t)
@@ -51,6 +51,8 @@
 
 #include "runtime.h"
 
+#include <math.h>
+
 /**
 * Solve E(phi U psi) until formula.
 * @param: sparse *state_space: the state space
@@ -377,3 +379,83 @@ sparse * ab_state_space(const sparse * state_space, const bitset *n_absorbing, d
     *pNonAbsorbing = non_absorbing;
         return ab_state_space_result;
 }
+
+/**
+* Initializes the tail of the weights for the iterate k.
+* @param pTail the tail to initialize
+* @param pWeights the weights w_first, ..., w_last
+* @param first the index of the first weight
+* @param last the index of the last weight
+* @param k the current iterate
+*/
+void init_ssd_tail(TSSDTail * pTail, const double * pWeights, int first, int last, int k)
+{
+	int j;
+
+	pTail->mass = 0.0;
+	pTail->moment = 0.0;
+	for( j = ( k < first ? first : k + 1 ); j <= last; j++ ){
+		pTail->mass += pWeights[j - first];
+		pTail->moment += ( j - k ) * pWeights[j - first];
+	}
+}
+
+/**
+* Moves the tail of the weights from the iterate k to the iterate k+1.
+* @param pTail the tail to update
+* @param w_next the weight of the iterate k+1
+*/
+void step_ssd_tail(TSSDTail * pTail, double w_next)
+{
+	/* Every remaining iterate is one step closer, the k+1st one leaves */
+	pTail->moment -= pTail->mass;
+	pTail->mass -= w_next;
+	if( pTail->mass < 0.0 ){
+		pTail->mass = 0.0;
+	}
+	if( pTail->moment < 0.0 ){
+		pTail->moment = 0.0;
+	}
+}
+
+/**
+* Computes the maximum norm of the change between two iterates.
+* @param pOld the previous iterate
+* @param pNew the current iterate
+* @param pRows the rows that change, pRows[0] is their number, or NULL for
+*		all of the size rows
+* @param size the size of the iterates
+* @return max_i |pNew[i] - pOld[i]|
+*/
+double get_max_change(const double * pOld, const double * pNew,
+		const int * pRows, int size)
+{
+	double delta = 0.0, diff;
+	int i, num = ( NULL == pRows ? size : pRows[0] );
+
+	for( i = 0; i < num; i++ ){
+		const int row = ( NULL == pRows ? i : pRows[i + 1] );
+		diff = fabs(pNew[row] - pOld[row]);
+		if( diff > delta ){
+			delta = diff;
+		}
+	}
+	return delta;
+}
+
+/**
+* Checks whether the remaining iterates can be replaced by the current one.
+* @param pTail the tail of the weights for the current iterate
+* @param pOld the previous iterate
+* @param pNew the current iterate
+* @param pRows the rows that change, pRows[0] is their number, or NULL for
+*		all of the size rows
+* @param size the size of the iterates
+* @param budget the error that may be spent on the remaining iterates
+* @return TRUE if the remaining iterates cost at most budget
+*/
+BOOL is_ssd_reached(const TSSDTail * pTail, const double * pOld,
+		const double * pNew, const int * pRows, int size, double budget)
+{
+	return get_max_change(pOld, pNew, pRows, size) * pTail->moment <= budget;
+}
@@ -49,6 +49,7 @@
 #include "bscc.h"
 #include "transient_common.h"
 #include "foxglynn.h"
+#include "krylov.h"
 #include "lump.h"
 
 #include "runtime.h"
@@ -234,9 +235,12 @@ double * unbounded_until(const bitset *phi, const bitset *psi)
 * Solve the unbounded until operator for all states with lumping.
 * @param	: bitset *phi: SAT(phi).
 * @param	: bitset *psi: SAT(psi).
+* @param	: partition **ppP: if not NULL, receives the partition and the
+*		  result is kept per block
 * @return	: double *: result of the unbounded until operator for all states.
 */
-double * unbounded_until_lumping(const bitset *phi, const bitset *psi)
+double * unbounded_until_lumping(const bitset *phi, const bitset *psi,
+                partition ** ppP)
 {
 	sparse *state_space = get_state_space();
 	bitset * EU = get_exist_until(state_space, phi, psi);
@@ -254,8 +258,8 @@ double * unbounded_until_lumping(const bitset *phi, const bitset *psi)
                                         == NULL
 
 	/* create initial partition for unbounded until formula and lump */
-                        || (P = init_partition_formula(EU, AU, FALSE)) == NULL
-                        || (Q = lump(P, state_space)) == NULL
+                        || (Q = lump_formula(&P, state_space, EU, AU, FALSE))
+                                        == NULL
 
         /* dummy = not(not(EU) or AU) = EU and not(AU) */
                         || (dummy = not(AU)) == NULL
@@ -278,9 +282,9 @@ double * unbounded_until_lumping(const bitset *phi, const bitset *psi)
                         || (rhs = (double *) calloc((size_t) mtx_rows(Q),
                                         sizeof(double))) == NULL )
         {
-                err_msg_4(error_str, "unbounded_until_lumping(%p[%d],%p[%d])",
-                        (const void *) phi, bitset_size(phi), (const void*) psi,
-                        bitset_size(psi),
+                err_msg_5(error_str, "unbounded_until_lumping(%p[%d],%p[%d],"
+                        "%p)", (const void *) phi, bitset_size(phi),
+                        (const void *) psi, bitset_size(psi), (void *) ppP,
                         ((void) (NULL == EU || (free_bitset(EU),
                            NULL == AU || (free_bitset(AU),
                               NULL == P || (free_partition(P),
@@ -304,9 +308,10 @@ double * unbounded_until_lumping(const bitset *phi, const bitset *psi)
                                         (lumped_id = part_lump_state_block(P,B))
                                                 == state_index_ERROR) )
                 {
-                        err_msg_4(err_CALLBY, "unbounded_until_lumping(%p[%d],"
-                                "%p[%d])", (const void *) phi, bitset_size(phi),
-                                (const void *) psi, bitset_size(psi),
+                        err_msg_5(err_CALLBY, "unbounded_until_lumping(%p[%d],"
+                                "%p[%d],%p)", (const void *) phi,
+                                bitset_size(phi), (const void *) psi,
+                                bitset_size(psi), (void *) ppP,
                                 (free(rhs), free(initial), free(q_row_sum),
                                 free(pValidStates), free_bitset(lumped_dummy),
                                 free_bitset(dummy), free_sparse_ncolse(Q),
@@ -324,8 +329,15 @@ double * unbounded_until_lumping(const bitset *phi, const bitset *psi)
 	/* parameter is set to FALSE, because the matrix will be discarded */
 	lumped_result = unbounded_until_universal(Q, pValidStates, initial, rhs, FALSE);
 
-	/* Unlump the resulting vector */
-        result = unlump_vector(P, mtx_rows(state_space), lumped_result);
+	/* Keep the result per block or unlump it */
+        if ( NULL != ppP ) {
+                result = lumped_result;
+                *ppP = P;
+        } else {
+                result = unlump_vector(P, mtx_rows(state_space), lumped_result);
+                free(lumped_result);
+                free_partition(P);
+        }
 
 	free_bitset(EU);
 	free_bitset(AU);
@@ -333,34 +345,68 @@ double * unbounded_until_lumping(const bitset *phi, const bitset *psi)
 	free_bitset(lumped_dummy);
 	free(rhs);
 	free(pValidStates);
-	free(lumped_result);
 	free(q_row_sum);
-	free_partition(P);
         if ( err_state_iserror(free_sparse_ncolse(Q)) ) {
-                err_msg_4(err_CALLBY, "unbounded_until_lumping(%p[%d],%p[%d])",
-                        (const void *) phi, bitset_size(phi), (const void*) psi,
-                        bitset_size(psi), (free(result), NULL));
+                err_msg_5(err_CALLBY, "unbounded_until_lumping(%p[%d],%p[%d],"
+                        "%p)", (const void *) phi, bitset_size(phi),
+                        (const void *) psi, bitset_size(psi), (void *) ppP,
+                        (free(result), NULL));
         }
 
 	return result;
 }
 
+/**
+* Gets the uniformization rate of uniformization_plain(...), the maximum
+* row sum of the non-absorbing states, see ab_state_space(...).
+* @param	: bitset *n_absorbing: non-absorbing states.
+* @return	: double: the uniformization rate, 0.0 if all states are absorbing.
+*/
+static double get_uniformization_rate(const bitset *n_absorbing)
+{
+	const double * e = get_row_sums();
+	double lambda = 0.0;
+	int i = state_index_NONE;
+
+	while( (i = get_idx_next_non_zero(n_absorbing, i)) != state_index_NONE ) {
+		if( lambda < e[i] ){
+			lambda = e[i];
+		}
+	}
+	return lambda;
+}
+
+/**
+* Gets the error bound of the Poisson weights of uniformization_plain(...).
+* With the steady-state detection, half of the error goes to the tail.
+*/
+static double get_uniformization_error(void)
+{
+	return ( is_ssd_on() ? get_error_bound() / 2 : get_error_bound() );
+}
+
 /**
 * Solve the bounded until operator by uniformization, without steady-state detection
 * @param	: bitset *n_absorbing: non-absorbing states.
 * @param	: bitset *reach: goal states for instance SAT(psi), i.e the i_\psi vector.
 * @param	: double supi: sup I
+* @param	: FoxGlynn *pGivenFG: the Poisson weights of lambda*supi with the
+*		  rate of get_uniformization_rate(n_absorbing) and the error of
+*		  get_uniformization_error(), if the caller has computed them,
+*		  NULL otherwise. They are freed by the caller.
 * @return	: double *: result of the unbounded until operator for all states.
 * NOTE: 1. J.-P. Katoen, M. Kwiatkowska, G. Norman, D. Parker.
 *         Faster and symbolic CTMC model checking. In: L. de Alfaro, S. Gilmore,
 *         eds., Process algebra and probabilistic methods. LNCS Vol. 2165,
 *         Springer, Berlin, pp. 23-38, 2001.
 */
-static double * uniformization_plain(bitset *n_absorbing, double *reach, double supi)
+static double * uniformization_plain(bitset *n_absorbing, double *reach, double supi,
+		FoxGlynn *pGivenFG)
 {
         const
 	sparse *state_space = get_state_space();
-	const double eps=get_error_bound();
+	const BOOL ssd_on = is_ssd_on();
+	const double eps = get_uniformization_error();
 	const double u=get_underflow();
 	const double o=get_overflow();
 	const int size = get_state_space_size();
@@ -384,6 +430,7 @@ static double * uniformization_plain(bitset *n_absorbing, double *reach, double
           abs_local matrix*/
         int * valid_rows;
 	FoxGlynn * pFG;
+	TSSDTail tail;
 
 	/* print_mtx_sparse(state_space); */
         /* print_mtx_sparse(abs_local); */
@@ -395,9 +442,9 @@ static double * uniformization_plain(bitset *n_absorbing, double *reach, double
 	memcpy( result, reach, sizeof(double)*size );
 
 	/*Initially, vectors res = reach!*/
-	pFG = NULL;
+	pFG = pGivenFG;
 	/* printf("lambda = %1.15le, supi = %1.15le, u = %1.15le, o = %1.15le, eps = %1.15le\n",lambda, supi, u, o, eps); */
-	if( fox_glynn(lambda*supi, u, o, eps, &pFG) ) {
+	if( NULL != pFG || fox_glynn(lambda*supi, u, o, eps, &pFG) ) {
 		double * tmp_arr;
 		int * iterator;
 
@@ -446,6 +493,8 @@ static double * uniformization_plain(bitset *n_absorbing, double *reach, double
 			}
         }
 
+		init_ssd_tail(&tail, pFG->weights, pFG->left, pFG->right, i - 1);
+
 		/*Compute upto right*/
 		for( ; i <= pFG->right; i++ ) {
 			current_fg = pFG->weights[i - pFG->left];
@@ -464,6 +513,21 @@ static double * uniformization_plain(bitset *n_absorbing, double *reach, double
 			}
 			/*Flip pointers*/
 			tmp_arr = reach; reach = res; res = tmp_arr;
+			step_ssd_tail(&tail, current_fg);
+
+			/*The remaining iterates are replaced by the current one,
+			  if this costs at most eps*total_weight*/
+			if( ssd_on && i % SSD_CHECK_PERIOD == 0
+					&& is_ssd_reached(&tail, res, reach, valid_rows,
+						size, eps * pFG->total_weight) ) {
+				printf("SSD: i = %d, tail = %1.15e\n", i,
+					tail.mass / pFG->total_weight);
+				iterator = &valid_rows[1];
+				for ( j = 0 ; j < valid_rows[0] ; j++, iterator++ ) {
+					result[*iterator] += tail.mass * reach[*iterator];
+				}
+				break;
+			}
 		}
 		/*Divide with total weight*/
                 iterator = &valid_rows[1];
@@ -481,8 +545,11 @@ static double * uniformization_plain(bitset *n_absorbing, double *reach, double
                 }
 	}
 
-        /* Free the Fox-Glynn structure */
-	freeFG(pFG); pFG = NULL;
+        /* Free the Fox-Glynn structure, the given one is freed by the caller */
+	if( NULL == pGivenFG ){
+		freeFG(pFG);
+	}
+	pFG = NULL;
 
 	/*Free dummy vectors*/
 	free( valid_rows );
@@ -497,6 +564,73 @@ static double * uniformization_plain(bitset *n_absorbing, double *reach, double
 	return result;
 }
 
+/**
+* Solve the bounded until operator by Krylov subspace projection, i.e. compute
+* exp(Q*supi)*reach where the absorbing states have zero rows in Q.
+* Unlike uniformization, the number of matrix-vector products does not grow
+* with lambda*supi, which helps on stiff CTMCs with widely spread exit rates.
+* @param	: bitset *n_absorbing: non-absorbing states.
+* @param	: bitset *reach: goal states for instance SAT(psi), i.e the i_\psi vector.
+* @param	: double supi: sup I
+* @return	: double *: result of the bounded until operator for all states.
+* NOTE: 1. R.B. Sidje, W.J. Stewart. A numerical study of large sparse matrix
+*         exponentials arising in Markov chains. Computational Statistics &
+*         Data Analysis, Vol. 29, pp. 345-368, 1999.
+*/
+static double * krylov(bitset *n_absorbing, const double *reach, double supi)
+{
+        const
+	sparse *state_space = get_state_space();
+	const int size = get_state_space_size();
+        double lambda = 0.0;
+	int non_absorbing = 0;
+
+        /*diag is used to store diagonal values from the abs_local matrix*/
+        double * diag = (double *) calloc((size_t) size, sizeof(double));
+	/*result is used to store the result vector*/
+        double * result = (double *) calloc((size_t) size, sizeof(double));
+	/*Make states absorbing: not phi || psi*/
+        sparse * abs_local = ab_state_space(state_space, n_absorbing, &lambda,
+                        diag, &non_absorbing);
+        /*the array which will hold ids of valid rows from the
+          abs_local matrix*/
+        int * valid_rows = count_set(n_absorbing);
+	/*The local errors of the time steps add up to supi*tol, they are */
+	/*estimated in the norm of the result, which bounds every entry */
+	const double tol = ( supi > 0.0 ? get_error_bound() / supi : get_error_bound() );
+	int i;
+
+	/*Q = R-E(s), only the diagonal of abs_local is its own, so */
+	/*there is no need to restore the matrix afterwards*/
+        if ( NULL == diag || NULL == result || NULL == valid_rows
+                        || err_state_iserror(sub_mtx_diagonal(abs_local, diag))
+                        || ! krylov_expv(abs_local, valid_rows, supi, reach,
+                                        tol, result) )
+        {
+                err_msg_4(err_CALLBY, "krylov(%p[%d],%p,%g)",
+                        (void *) n_absorbing, bitset_size(n_absorbing),
+                        (const void *) reach, supi,
+                        (free(valid_rows), free(diag), free_abs(abs_local),
+                         free(result), NULL));
+        }
+
+	/*The projection does not preserve the probabilities exactly, the */
+	/*round-off must not flip the comparison with the probability bound */
+	for( i = 0; i < size; i++ ){
+		if( result[i] < 0.0 ){
+			result[i] = 0.0;
+		}else if( result[i] > 1.0 ){
+			result[i] = 1.0;
+		}
+	}
+
+	free( valid_rows );
+	free( diag );
+        free_abs(abs_local);
+
+	return result;
+}
+
 /**
 * Detects steady-state while uniformization for CSL logic.
 * @param: double * reach_psi an array of probabilities to reach psi states
@@ -765,7 +899,7 @@ static double * uniformization_ssd(bitset *n_absorbing, const bitset *psi, doubl
 /**
 * Solve the bounded until operator by uniformization, this method is a wrapper
 * depending on setting it either calls a plain uniformization or uses uniformization
-* with a steady-state detection
+* with a steady-state detection, or uses the Krylov subspace projection instead
 * @param: bitset *n_absorbing: non-absorbing states.
 * @param: bitset * psi: psi states for steady-state detection, may be NULL if (ssd_allowed == * FALSE)
 * @param: bitset *reach: goal states for instance SAT(psi), i.e the i_\psi vector.
@@ -773,22 +907,28 @@ static double * uniformization_ssd(bitset *n_absorbing, const bitset *psi, doubl
 * @param: BOOL ssd_allowed: true if steady state detection is allowed to be used, it does not
 *          mean that it will be used though, the latter depends on runtime
 *          settings. By default ssd is off.
+* @param: FoxGlynn *pFG: the Poisson weights computed by the caller or NULL,
+*	   see uniformization_plain(...), only used without the steady-state
+*	   detection and the Krylov method.
 * @return		: double *: result of the unbounded until operator for all states.
 * NOTE: 1. J.-P. Katoen, M. Kwiatkowska, G. Norman, D. Parker.
 *         Faster and symbolic CTMC model checking. In: L. de Alfaro, S. Gilmore,
 *         eds., Process algebra and probabilistic methods. LNCS Vol. 2165,
 *         Springer, Berlin, 2001. pp. 23-38.
 */
-static double * uniformization(bitset *n_absorbing, const bitset *psi, double *reach, double supi, BOOL ssd_allowed)
+static double * uniformization(bitset *n_absorbing, const bitset *psi, double *reach, double supi, BOOL ssd_allowed,
+		FoxGlynn *pFG)
 {
-  if( ssd_allowed && is_ssd_on() ) {
+  if( get_method_transient() == KRYLOV ) {
+	return krylov(n_absorbing, reach, supi);
+  }else if( ssd_allowed && is_ssd_on() ) {
 	if(psi == NULL) {
 		printf("ERROR: The steady-state detection is on, but psi states (for phi U[0,t] psi) are not set.\n");
                 exit(EXIT_FAILURE);
 	}
 	return uniformization_ssd(n_absorbing, psi, reach, supi);
   }else{
-	return uniformization_plain(n_absorbing, reach, supi);
+	return uniformization_plain(n_absorbing, reach, supi, pFG);
   }
 }
 
@@ -818,7 +958,7 @@ static double * bounded_until_universal(bitset *good_phi_states, const bitset *p
 	}
 	/* Do uniformization, compute probabilities, normally, without the */
 	/* optimization we would just use phi_and_not_psi instead of good_phi_states. */
-	result=uniformization(good_phi_states, psi, reach, supi, TRUE);
+	result=uniformization(good_phi_states, psi, reach, supi, TRUE, NULL);
 
 	free(reach);
 
@@ -862,9 +1002,12 @@ double * bounded_until(const bitset *phi, const bitset *psi, double supi)
 * @param: bitset *phi: SAT(phi).
 * @param: bitset *psi: SAT(psi).
 * @param: double supi: sup I
+* @param: partition **ppP: if not NULL, receives the partition and the result
+*	  is kept per block
 * @return: double *: result of the unbounded until operator for all states.
 */
-double * bounded_until_lumping(const bitset *phi, const bitset *psi, double supi)
+double * bounded_until_lumping(const bitset *phi, const bitset *psi, double supi,
+                partition ** ppP)
 {
 	sparse *original_state_space = get_state_space();
 	double *result, *lumped_result;
@@ -877,8 +1020,9 @@ double * bounded_until_lumping(const bitset *phi, const bitset *psi, double supi
 	bitset *good_phi_states = get_good_phi_states( phi, psi, original_state_space);
 
 	/* Create initial partition for bounded until formula and lump */
-	partition *P = init_partition_formula(good_phi_states, psi, FALSE);
-	sparse *Q = lump(P, original_state_space);
+	partition *P = NULL;
+	sparse *Q = lump_formula(&P, original_state_space, good_phi_states, psi,
+			FALSE);
 	bitset *lumped_good_phi_states, *lumped_psi;
 
 	/* Free the row sums vector because otherwise it will be lost */
@@ -892,15 +1036,21 @@ double * bounded_until_lumping(const bitset *phi, const bitset *psi, double supi
 
 	lumped_result = bounded_until_universal(lumped_good_phi_states, lumped_psi, supi);
 
-	/* Unlump the resulting vector */
-        result = unlump_vector(P, mtx_rows(original_state_space),lumped_result);
+	/* Keep the result per block or unlump it */
+        if ( NULL != ppP ) {
+                result = lumped_result;
+                *ppP = P;
+        } else {
+                result = unlump_vector(P, mtx_rows(original_state_space),
+                                lumped_result);
+                free(lumped_result);
+                free_partition(P);
+        }
 
 	/* Free allocated memory */
 	free_bitset(good_phi_states);
 	free_bitset(lumped_good_phi_states);
 	free_bitset(lumped_psi);
-	free(lumped_result);
-	free_partition(P);
 	/* You have to do that not to waste the allocated memory */
 	free_row_sums();
 
@@ -909,9 +1059,10 @@ double * bounded_until_lumping(const bitset *phi, const bitset *psi, double supi
 
 	/* Free the lumped state space. */
         if ( err_state_iserror(free_sparse_ncolse(Q)) ) {
-                err_msg_5(err_CALLBY, "bounded_until_lumping(%p[%d],%p[%d],%g)",
-                        (const void *) phi, bitset_size(phi), (const void*) psi,
-                        bitset_size(psi), supi, (free(result), NULL));
+                err_msg_6(err_CALLBY, "bounded_until_lumping(%p[%d],%p[%d],%g,"
+                        "%p)", (const void *) phi, bitset_size(phi),
+                        (const void *) psi, bitset_size(psi), supi,
+                        (void *) ppP, (free(result), NULL));
         }
 
 	return result;
@@ -944,16 +1095,36 @@ double * interval_until(const bitset *phi, const bitset *psi, double subi, doubl
 	/* (and reward bound 'subj' if any) equal to 0. */
 	/* NOTE: In this particular case it is smartly used, so it is safe here! */
 	bitset *good_phi_states = get_good_phi_states( phi, psi, state_space);
-	bitset *phi_and_psi;
+	bitset *phi_and_psi = and(phi,psi);
+	double lambdas[2];
+	FoxGlynn * ppFG[2] = { NULL, NULL };
 
 	/* Create the initial vector for backward computations */
         i = state_index_NONE;
         while ( (i = get_idx_next_non_zero(psi, i)) != state_index_NONE ) {
 			reach[i] = 1.0;
 	}
+
+	/* The non absorbing states of the second uniformization are the */
+	/* good_phi_states extended with phi && psi states, because */
+	/* were interested in ALL phi states which can reach a psi state */
+	or_result(good_phi_states, phi_and_psi);
+
+	/* The Poisson weights of both uniformizations come from one call, */
+	/* equal lambda*t values are computed once. A zero lambda is left */
+	/* to uniformization_plain(...), it reports the error. */
+	if( get_method_transient() != KRYLOV ) {
+		lambdas[0] = get_uniformization_rate(good_phi_states) * (supi-subi);
+		lambdas[1] = get_uniformization_rate(phi_and_psi) * subi;
+		if( lambdas[0] > 0.0 && lambdas[1] > 0.0 ) {
+			fox_glynn_multi(2, lambdas, get_underflow(), get_overflow(),
+					get_uniformization_error(), ppFG);
+		}
+	}
+
 	/* Here phi_and_not_psi is a set of non absorbing states */
 	/* printf("supi = %1.15le, subi = %1.15le, supi-subi = %1.15le\n",supi, subi, supi-subi); */
-	result2 = uniformization(good_phi_states, NULL, reach, (supi-subi), FALSE);
+	result2 = uniformization(good_phi_states, NULL, reach, (supi-subi), FALSE, ppFG[0]);
 
 	/* It seems like we can not just do another uniformization */
 	/* in a backward manner with this vector result2 */
@@ -965,14 +1136,12 @@ double * interval_until(const bitset *phi, const bitset *psi, double subi, doubl
 		}
 	}
 
-	/* Here good_phi_states is a set of non absorbing states */
-	/* This bitset is extended with phi && psi states, because */
-	/* were interested in ALL phi states which can reach a psi state */
-	phi_and_psi = and(phi,psi);
-	or_result(phi_and_psi, good_phi_states);
-	result1 = uniformization(good_phi_states, NULL, result2, subi, FALSE);
+	/* Here phi_and_psi is the extended set of non absorbing states */
+	result1 = uniformization(phi_and_psi, NULL, result2, subi, FALSE, ppFG[1]);
 
 	/* Free allocated memory */
+	freeFG(ppFG[0]);
+	freeFG(ppFG[1]);
 	free_bitset(good_phi_states);
 	free_bitset(phi_and_psi);
 	free(result2);
@@ -987,15 +1156,18 @@ double * interval_until(const bitset *phi, const bitset *psi, double subi, doubl
 * @param: bitset *psi: SAT(psi).
 * @param: double subi: sub I
 * @param: double supi: sup I
+* @param: partition **ppP: if not NULL, receives the partition and the result
+*	  is kept per block
 * @return: double *: result of the interval until operator for all states.
 */
-double * interval_until_lumping(const bitset *phi, const bitset *psi, double subi, double supi)
+double * interval_until_lumping(const bitset *phi, const bitset *psi, double subi, double supi,
+                partition ** ppP)
 {
 	sparse *original_state_space = get_state_space();
 
 	/* Create initial partition for interval until formula and lump */
-	partition *P = init_partition_formula(phi, psi, TRUE);
-	sparse *Q = lump(P, original_state_space);
+	partition *P = NULL;
+	sparse *Q = lump_formula(&P, original_state_space, phi, psi, TRUE);
 	bitset *lumped_psi, *lumped_phi;
 	double *lumped_result, *result;
 
@@ -1010,13 +1182,19 @@ double * interval_until_lumping(const bitset *phi, const bitset *psi, double sub
 
 	lumped_result = interval_until(lumped_phi, lumped_psi, subi, supi);
 
-	/* Unlump the resulting vector */
-        result = unlump_vector(P, mtx_rows(original_state_space),lumped_result);
+	/* Keep the result per block or unlump it */
+        if ( NULL != ppP ) {
+                result = lumped_result;
+                *ppP = P;
+        } else {
+                result = unlump_vector(P, mtx_rows(original_state_space),
+                                lumped_result);
+                free(lumped_result);
+                free_partition(P);
+        }
 
 	free_bitset(lumped_phi);
 	free_bitset(lumped_psi);
-	free(lumped_result);
-	free_partition(P);
 	/* You have to do that not to waste the allocated memory */
 	free_row_sums();
 
@@ -1025,10 +1203,10 @@ double * interval_until_lumping(const bitset *phi, const bitset *psi, double sub
 
 	/* Free the lumped state space. */
         if ( err_state_iserror(free_sparse_ncolse(Q)) ) {
-                err_msg_6(err_CALLBY, "interval_until_lumping(%p[%d],%p[%d],%g,"
-                        "%g)", (const void *) phi, bitset_size(phi),
+                err_msg_7(err_CALLBY, "interval_until_lumping(%p[%d],%p[%d],%g,"
+                        "%g,%p)", (const void *) phi, bitset_size(phi),
                         (const void *) psi, bitset_size(psi), subi, supi,
-                        (free(result), NULL));
+                        (void *) ppP, (free(result), NULL));
         }
 
 	return result;
@@ -60,6 +60,7 @@
 #include "transient_ctmdpi_hd_uni.h"
 
 #include "foxglynn.h"
+#include "transient_common.h"
 
 #include "runtime.h"
 
@@ -359,12 +360,15 @@ inline static void swap(double **a, double **b) {
 * @param cols see CTMDPI documentation
 * @param P_s_alpha_B P(s,alpha,B) (see paper)
 * @param B target states
+* @param ssd_error the error budget of the steady-state detection below the
+*		left bound, 0.0 if the steady-state detection is off
 */
 static double *ctmdpi_iter( const unsigned num_states, const FoxGlynn *fg, const unsigned left_end,
                                 const BOOL min, const int * row_starts,
                                 const int * choice_starts,
 				const double *non_zeros, double *q, double *q_primed, const unsigned *cols,
-				const double *P_s_alpha_B, const bitset *B) {
+				const double *P_s_alpha_B, const bitset *B,
+				const double ssd_error) {
        /* in the algorithm the main iteration is in lines 3-12. For each
 	* jump probability k starting from the right bound in the Fox-Glynn
 	* algorithm down to 1 the loop body is to be executed once. In the
@@ -430,6 +434,9 @@ static double *ctmdpi_iter( const unsigned num_states, const FoxGlynn *fg, const
 	}
 
         not_B = not(B);
+	/* the optimizing step is non-expansive, so once two iterates differ
+	 * by delta the remaining i-1 ones change the result by at most
+	 * (i-1)*delta */
 	/* now do part where we are below left bound of poisson probabilities */
 	for (; i > 0; i--) {
 		unsigned ps_index = 0;
@@ -460,6 +467,13 @@ static double *ctmdpi_iter( const unsigned num_states, const FoxGlynn *fg, const
 		/* swapping is done instead using a new q vector for
 		 * each k */
 		swap(&q, &q_primed);
+
+		if ( ssd_error > 0.0 && 0 == i % SSD_CHECK_PERIOD
+				&& ( i - 1 ) * get_max_change(q_primed, q, NULL,
+					(int) num_states) <= ssd_error ) {
+			printf("SSD: i = %u\n", i);
+			break;
+		}
 	}
 
         free_bitset(not_B);
@@ -490,7 +504,9 @@ double *transient_ctmdpi_hd_uni(const double t, const bitset *B) {
 	double E;
 	const double u = get_underflow();
 	const double o = get_overflow();
-	const double epsilon = get_error_bound();
+	/* with the steady-state detection, half of the error goes to it */
+	const double ssd_error = is_ssd_on() ? get_error_bound() / 2 : 0.0;
+	const double epsilon = get_error_bound() - ssd_error;
 	double *P_s_alpha_B;
 	/* if user typed a "<" or "<=" as comparator in the fomula, we
 	 * compute the maximal probability, for ">" or ">=" the
@@ -546,7 +562,8 @@ double *transient_ctmdpi_hd_uni(const double t, const bitset *B) {
 
 		/* start main iteration of algorithm */
 		result = ctmdpi_iter( num_states, fg, left_end, min, row_starts, choice_starts,
-					non_zeros, q, q_primed, cols, P_s_alpha_B, B );
+					non_zeros, q, q_primed, cols, P_s_alpha_B, B,
+					ssd_error );
 
 		/* line 15 in paper */
                 row = state_index_NONE;
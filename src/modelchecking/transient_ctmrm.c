@@ -58,8 +58,8 @@
 *             Model Checking Markov Reward Models with Impulse
 *             Rewards, DSN-PDS-05.
 *
-*        NOTE: This is too slow though. haven't had time to think
-*            of something better.
+*        NOTE: The recursion is done backwards, for all the initial
+*            states at once, see discretization(...).
 *    II. Uniformization based algorithm by Bruno Sericola for CSRL - U.
 *        Uses: DEF: bitset.h, sparse.h, label.h, runtime.h
 *            LIB: bitset.c, sparse.c, label.c, runtime.c
@@ -120,6 +120,9 @@
 
 #include <string.h>
 #include <math.h>
+#ifdef _OPENMP
+#       include <omp.h>
+#endif
 #ifndef isnan
 #       define isnan(x) FALSE
 #endif
@@ -250,9 +253,9 @@ static double * uniformization_qureshi_sanders( const bitset * phi,
                                                 double ** ppResultError);
 static double * discretization_wrapper( const bitset * phi, const bitset * psi,
                                         double supi, double supj);
-static double discretization( int state_local, const bitset * phi,
-                              const bitset * psi, const double m_time,
-                              const double m_reward, const double d_factor);
+static double * discretization( const bitset * phi, const bitset * psi,
+                                const double m_time, const double m_reward,
+                                const double d_factor);
 static double* ctmrm_bounded_until_universal( const bitset * phi,
                                               const bitset * psi, 
                                               double supi, double supj,
@@ -302,10 +305,13 @@ double * ctmrm_bounded_until( const bitset * phi, const bitset * psi,
 * @param ppResultError  the pointer to the array of doubles. This array will
 *                       store the errors
 *            for the resulting probabilities. (This is the return variable)
+* @param ppP if not NULL, receives the partition and the result and the errors
+*            are kept per block
 * @return the result of the until formula for all states.
 */
 double * ctmrm_bounded_until_lumping(const bitset * phi, const bitset * psi,
-                double supi, double supj, double ** ppResultError)
+                double supi, double supj, double ** ppResultError,
+                partition ** ppP)
 {
     sparse *original_state_space = get_state_space();
     double *result, *lumped_result, * pLumpedResultError = NULL;
@@ -317,10 +323,26 @@ double * ctmrm_bounded_until_lumping(const bitset * phi, const bitset * psi,
     bitset * good_phi_states = get_good_phi_states(phi, psi, original_state_space);
 
     /* Create initial partition for bounded until formula and lump */
-    partition *P = init_partition_formula(good_phi_states, psi, FALSE);
-    sparse *Q = lump(P, original_state_space);
+    partition *P = NULL;
+    sparse *Q = lump_formula(&P, original_state_space, good_phi_states, psi,
+		    FALSE);
     bitset *lumped_good_phi_states, *lumped_psi;
     double * p_old_rew, * p_new_rew;
+    sparse * p_old_rewi, * p_new_rewi = NULL;
+
+    /* Lump the impulse rewards. If they cannot be lumped, */
+    /* we have to solve the formula on the original state space */
+    if( getImpulseRewards() != NULL ){
+        p_new_rewi = change_impulse_rewards(getImpulseRewards(), P,
+                        original_state_space);
+        if( p_new_rewi == NULL ){
+            printf("Lumping: Solving the formula without lumping.\n");
+            free_partition(P);
+            (void) free_sparse_ncolse(Q);
+            free_bitset(good_phi_states);
+            return ctmrm_bounded_until(phi, psi, supi, supj, ppResultError);
+        }
+    }
 
     /* Free the row sums vector because otherwise it will be lost */
     free_row_sums();
@@ -336,30 +358,46 @@ double * ctmrm_bounded_until_lumping(const bitset * phi, const bitset * psi,
     p_new_rew = change_state_rewards(p_old_rew, P);
     setStateRewards(p_new_rew);
 
-    lumped_result = ctmrm_bounded_until(lumped_good_phi_states, lumped_psi, supi, supj, &pLumpedResultError);
+    /* Change impulse rewards */
+    p_old_rewi = exchangeImpulseRewards(p_new_rewi);
 
-    /* Unlump the resulting vector */
-    result = unlump_vector(P, mtx_rows(original_state_space), lumped_result );
+    lumped_result = ctmrm_bounded_until(lumped_good_phi_states, lumped_psi, supi, supj, &pLumpedResultError);
 
-    /* The vector of errors is only allocated when the Uniformization Qureshi-Sanders is used */
-    if( pLumpedResultError != NULL ){
-        /* Unlump the result errors vector */
-        *ppResultError = unlump_vector(P,mtx_rows(original_state_space),
-                                       pLumpedResultError);
-        /* Free the unneeded memory */
-        free( pLumpedResultError ); pLumpedResultError = NULL;
+    if( ppP != NULL ){
+        /* Keep the result and the errors per block */
+        result = lumped_result; lumped_result = NULL;
+        *ppResultError = pLumpedResultError; pLumpedResultError = NULL;
+        *ppP = P; P = NULL;
+    }else{
+        /* Unlump the resulting vector */
+        result = unlump_vector(P, mtx_rows(original_state_space), lumped_result );
+
+        /* The vector of errors is only allocated when the Uniformization Qureshi-Sanders is used */
+        if( pLumpedResultError != NULL ){
+            /* Unlump the result errors vector */
+            *ppResultError = unlump_vector(P,mtx_rows(original_state_space),
+                                           pLumpedResultError);
+            /* Free the unneeded memory */
+            free( pLumpedResultError ); pLumpedResultError = NULL;
+        }
     }
 
-    /* Restore state rewards */
+    /* Restore state and impulse rewards */
     freeStateRewards();
     setStateRewards(p_old_rew);
+    (void) exchangeImpulseRewards(p_old_rewi);
+    if( p_new_rewi != NULL ){
+        (void) free_sparse_ncolse(p_new_rewi);
+    }
 
     /* Free allocated memory */
     free_bitset(good_phi_states);
     free_bitset(lumped_good_phi_states);
     free_bitset(lumped_psi);
     free( lumped_result ); lumped_result = NULL;
-    free_partition(P);
+    if( P != NULL ){
+        free_partition(P);
+    }
     /* You have to do that not to waste the allocated memory */
     free_row_sums();
 
@@ -368,10 +406,10 @@ double * ctmrm_bounded_until_lumping(const bitset * phi, const bitset * psi,
 
     /* Free the lumped state space. */
     if ( err_state_iserror(free_sparse_ncolse(Q)) ) {
-        err_msg_7(err_CALLBY, "ctmrm_bounded_until_lumping(%p[%d],%p"
-                  "[%d],%g,%g,%p)", (const void *) phi, bitset_size(phi),
+        err_msg_8(err_CALLBY, "ctmrm_bounded_until_lumping(%p[%d],%p"
+                  "[%d],%g,%g,%p,%p)", (const void *) phi, bitset_size(phi),
                   (const void *) psi, bitset_size(psi), supi, supj,
-                  (void *) ppResultError, (free(result), NULL));
+                  (void *) ppResultError, (void *) ppP, (free(result), NULL));
     }
 
     return result;
@@ -488,8 +526,7 @@ static BOOL isDiscretizationFactorOk(void) {
 static double * discretization_wrapper(const bitset * phi, const bitset * psi,
                 double supi, double supj)
 {
-    /* Allocate the resulting vector */
-    double * result = (double *) calloc((size_t) bitset_size(phi), sizeof(double));
+    double * result = NULL;
 
     if ( isDiscretizationFactorOk() ) {
         const int size = bitset_size(phi);
@@ -500,16 +537,22 @@ static double * discretization_wrapper(const bitset * phi, const bitset * psi,
         bitset * not_phi_and_psi;
         and_result( psi, not_phi_and_psi = not( phi ) );
 
-        /* Compute probability for each state */
+        /* Perform discretization for all initial states at once */
+        result = discretization(phi, psi, supi, supj, get_d_factor());
+        if ( NULL == result ) {
+            free_bitset( not_phi_and_psi );
+            err_msg_4(err_CALLBY, "discretization_wrapper(%p[%d],%p[%d])",
+                      (const void *) phi, size, (const void *) psi,
+                      bitset_size(psi), NULL);
+        }
+
+        /* Check the probability of each state */
         for( i = 0; i < size; i++ ){
             if( get_bit_val( not_phi_and_psi , i ) ){
                 /* NOTE: The case for 's|= not Phi ^ Psi and subi == 0 and subj == 0' */
                 /* We do not support for subi>0, subj>0 case in MRMC so there is no check */
                 result[i] = 1.0;
             }else{
-                /* Perform discretization for the initial state i */
-                result[i] = discretization(i, phi, psi, supi, supj, get_d_factor());
-
                 /* Check the result for validity */
                 if ( ( result[i] < 0.0 ) ||
                      ( result[i] > 1.0 + get_error_bound() ) ||
@@ -528,279 +571,314 @@ static double * discretization_wrapper(const bitset * phi, const bitset * psi,
         }
 
         free_bitset( not_phi_and_psi );
+    } else {
+        /* Allocate the resulting vector */
+        result = (double *) calloc((size_t) bitset_size(phi), sizeof(double));
     }
 
     return result;
 }
 
 /**
-* We have this procedure here just for convenience, to avoid duplications of the source code.
-* 1. If it is the psi state then we just copy
-*    the value into the F_t_next_s_k matrix
-* 2. If it is the phi state then we increase
-*    the reward by the idx1 state reward
-* 3. If the discretized reward bound is not reached then
-*    we store the updated value into the NEW reward element
+* The pure Phi states of the discretization with their transitions, stored
+* contiguously so that the time steps do not need to search the rate and
+* impulse reward matrices.
+* num_states - the number of pure Phi states, i.e. Phi and not Psi states
+* pStates - the pure Phi states
+* pStayProb - the probability 1 - E(s)*d to stay in the state for one step
+* pStayOffset - the reward index increment r(s) of staying in the state
+* pTransBegin - the transitions of the i'th state are pTransBegin[i]...pTransBegin[i+1]-1
+* pTransState - the target state of the transition, a Phi or a Psi state
+* pTransProb - the probability R(s,s')*d of the transition in one step
+* pTransOffset - the reward index increment r(s) + i(s,s')/d of the transition
+* max_offset - the largest reward index increment of one step
 */
-inline static void accumulateRewardForStaying( const BITSET_BLOCK_TYPE psi_state_bit, const int current_state,
-                                               const int discrete_reward_state, const double prev_probability,
-                                               const double *rew_array, const int R, const double *row_sums,
-                                               const double d_factor, sparse *F_t_next_s_k){
-    if( psi_state_bit ){
-        /* In case this is the PSI state then we've reached the */
-        /* desired state and we preserve the same probability */
-        /* for this <state,reward> state as it is absorbing */
-        if ( err_state_iserror(add_mtx_val(F_t_next_s_k, current_state,
-             discrete_reward_state, prev_probability)) )
-        {
-            exit(err_macro_11(err_CALLBY,
-                 "accumulateRewardForStaying(%d,%d,%d,%g,%p,%d,"
-                 "%p,%g,%p[%dx%d])", psi_state_bit,current_state,
-                 discrete_reward_state, prev_probability,
-                 (const void *) rew_array, R,
-                 (const void *) row_sums, d_factor,
-                 (void *) F_t_next_s_k, mtx_rows(F_t_next_s_k),
-                 mtx_cols(F_t_next_s_k), EXIT_FAILURE));
+typedef struct SDiscretizationModel{
+    int num_states;
+    int * pStates;
+    double * pStayProb;
+    int * pStayOffset;
+    int * pTransBegin;
+    int * pTransState;
+    double * pTransProb;
+    int * pTransOffset;
+    int max_offset;
+} TDiscretizationModel;
+
+/**
+* Frees the arrays of the discretization model.
+* @param pModel the model
+*/
+static void freeDiscretizationModel(TDiscretizationModel * pModel)
+{
+    free( pModel->pStates );
+    free( pModel->pStayProb );
+    free( pModel->pStayOffset );
+    free( pModel->pTransBegin );
+    free( pModel->pTransState );
+    free( pModel->pTransProb );
+    free( pModel->pTransOffset );
+}
+
+/**
+* Collects the pure Phi states of the current state space and their
+* transitions into Phi or Psi states.
+* @param pModel the model to fill in
+* @param valid_states the Phi or Psi states
+* @param psi the Psi states
+* @param d_factor the discretization factor
+* @return FALSE if we run out of memory or the impulse rewards can not be read
+*/
+static BOOL buildDiscretizationModel(TDiscretizationModel * pModel,
+                const bitset * valid_states, const bitset * psi, const double d_factor)
+{
+    const sparse *pStateSpace = get_state_space();
+    const sparse *rewi_matrix = getImpulseRewards();
+    const double *row_sums = get_row_sums();
+    const double *rew_array = getStateRewards();
+    double impulse_reward = 0.0;
+    int state = -1, i = 0, num_trans = 0;
+
+    memset( pModel, 0, sizeof(TDiscretizationModel) );
+
+    /* Count the pure Phi states and their transitions */
+    while( ( state = get_idx_next_non_zero(valid_states, state) ) != -1 ){
+        if( ! get_bit_val(psi, state) ){
+            pModel->num_states++;
+            mtx_walk_row(pStateSpace, state, next_state, rate)
+            {
+                if ( get_bit_val(valid_states, next_state) && 0.0 != rate ) {
+                    num_trans++;
+                }
+            }
+            end_mtx_walk_row;
         }
-    }else{
-        int new_reward = discrete_reward_state + rew_array[current_state];
-        /* Perhaps the following check should be changed to
-           "new_reward <= R", similar to accumulateRewardForComming().
-           David N. Jansen */
-       if( new_reward < R ){
-            if ( err_state_iserror(add_mtx_val(F_t_next_s_k,
-                 current_state, new_reward,
-                 prev_probability *
-                 (1-row_sums[current_state]*d_factor))))
+    }
+
+    pModel->pStates = (int *) calloc((size_t) pModel->num_states + 1, sizeof(int));
+    pModel->pStayProb = (double *) calloc((size_t) pModel->num_states + 1, sizeof(double));
+    pModel->pStayOffset = (int *) calloc((size_t) pModel->num_states + 1, sizeof(int));
+    pModel->pTransBegin = (int *) calloc((size_t) pModel->num_states + 1, sizeof(int));
+    pModel->pTransState = (int *) calloc((size_t) num_trans + 1, sizeof(int));
+    pModel->pTransProb = (double *) calloc((size_t) num_trans + 1, sizeof(double));
+    pModel->pTransOffset = (int *) calloc((size_t) num_trans + 1, sizeof(int));
+    if ( NULL == pModel->pStates || NULL == pModel->pStayProb
+         || NULL == pModel->pStayOffset || NULL == pModel->pTransBegin
+         || NULL == pModel->pTransState || NULL == pModel->pTransProb
+         || NULL == pModel->pTransOffset )
+    {
+        return FALSE;
+    }
+
+    /* Fill in the states and their transitions */
+    num_trans = 0;
+    state = -1;
+    while( ( state = get_idx_next_non_zero(valid_states, state) ) != -1 ){
+        if( ! get_bit_val(psi, state) ){
+            pModel->pStates[i] = state;
+            pModel->pStayProb[i] = 1 - row_sums[state] * d_factor;
+            pModel->pStayOffset[i] = (int) rew_array[state];
+            if( pModel->max_offset < pModel->pStayOffset[i] ){
+                pModel->max_offset = pModel->pStayOffset[i];
+            }
+            pModel->pTransBegin[i] = num_trans;
+            mtx_walk_row(pStateSpace, state, next_state, rate)
             {
-                exit(err_macro_11(err_CALLBY,
-                        "accumulateRewardForStaying(%d,%d,%d,"
-                        "%g,%p,%d,%p,%g,%p[%dx%d])",
-                        psi_state_bit, current_state,
-                        discrete_reward_state, prev_probability,
-                        (const void *) rew_array, R,
-                        (const void *) row_sums, d_factor,
-                        (void *) F_t_next_s_k,
-                        mtx_rows(F_t_next_s_k),
-                        mtx_cols(F_t_next_s_k), EXIT_FAILURE));
+                if ( get_bit_val(valid_states, next_state) && 0.0 != rate ) {
+                    if( rewi_matrix != NULL ){
+                        /* Get the impulse reward for this transition */
+                        if ( err_state_iserror( get_mtx_val( rewi_matrix,
+                                                state, next_state,
+                                                &impulse_reward ) ) )
+                        {
+                            return FALSE;
+                        }
+                    }
+                    pModel->pTransState[num_trans] = next_state;
+                    pModel->pTransProb[num_trans] = rate * d_factor;
+                    /* WARNING: Here according to the algorithm we should do impulse_reward / d_factor */
+                    /* which yields a non integer number, I am not sure that this is safe! */
+                    pModel->pTransOffset[num_trans] = pModel->pStayOffset[i]
+                                                      + (int) ( impulse_reward / d_factor );
+                    if( pModel->max_offset < pModel->pTransOffset[num_trans] ){
+                        pModel->max_offset = pModel->pTransOffset[num_trans];
+                    }
+                    num_trans++;
+                }
             }
+            end_mtx_walk_row;
+            i++;
         }
     }
+    pModel->pTransBegin[i] = num_trans;
+
+    return TRUE;
 }
 
 /**
-* We have this procedure here just for convenience, to avoid duplications of the source code.
-* 1. Increase the reward by the prev_state state reward
-*    and the impulse reward of going from prev_state to current_state
-* 2. If the discretized reward bound is not reached
-*    then we store the updated value into the
-*    NEW reward element
+* Computes one backward step G^{m}(s,k) of the discretization for all the
+* pure Phi states and the reward indices k = 0...max_k. The rows of the
+* different states are independent, so they are computed in parallel.
+* @param pModel the pure Phi states and their transitions
+* @param G_now the array of G^{m-1}, it has to be valid up to the reward
+*               index max_k + pModel->max_offset (or R)
+* @param G_next the array of G^{m}
+* @param cols the number of reward indices, i.e. R+1
+* @param max_k the largest reward index that is still needed
 */
-inline static void accumulateRewardForComming(const int current_state, const int prev_state, const int discrete_reward_state,
-                        const double impulse_reward, const double prev_probability,
-                        const double from_prev_to_current_state_rate, const double *rew_array,
-                        const int R, const double d_factor, sparse *F_t_next_s_k){
-    /* WARNING: Here according to the algorithm we should do impulse_reward / d_factor */
-    /* which yields a non integer number, I am not sure that this is safe! */
-    int new_reward = discrete_reward_state + rew_array[prev_state] + (int) ( impulse_reward / d_factor );
-    if ( new_reward <= R ){
-        if ( err_state_iserror(add_mtx_val(F_t_next_s_k, current_state,
-             new_reward, prev_probability *
-             from_prev_to_current_state_rate * d_factor)) )
-        {
-            exit(err_macro_12(err_CALLBY,
-                    "accumulateRewardForComming(%d,%d,%d,%g,%g,%g,"
-                    "%p,%d,%g,%p[%dx%d])", current_state,prev_state,
-                    discrete_reward_state, impulse_reward,
-                    prev_probability,
-                    from_prev_to_current_state_rate,
-                    (const void *) rew_array, R, d_factor,
-                    (void *) F_t_next_s_k, mtx_rows(F_t_next_s_k),
-                    mtx_cols(F_t_next_s_k), EXIT_FAILURE));
+static void discretization_step(const TDiscretizationModel * pModel,
+                const double * G_now, double * G_next, const int cols,
+                const int max_k)
+{
+    const int R = cols - 1;
+    int i;
+
+#   ifdef _OPENMP
+#   pragma omp parallel for schedule(dynamic, 64)
+#   endif
+    for( i = 0; i < pModel->num_states; i++ ){
+        const int state = pModel->pStates[i];
+        const int stay_offset = pModel->pStayOffset[i];
+        const double stay_probability = pModel->pStayProb[i];
+        double * G_row = &G_next[state * cols];
+        const double * G_prev;
+        double probability;
+        int j, k, last_k;
+
+        /* This is the first summand where we consider the reward */
+        /* and probability of staying in the current state */
+        /* NOTE: As in the forward recursion, the new reward must be < R here */
+        last_k = ( R - 1 - stay_offset < max_k ? R - 1 - stay_offset : max_k );
+        for( k = 0; k <= last_k; k++ ){
+            G_row[k] = stay_probability * G_now[state * cols + stay_offset + k];
+        }
+        for( k = ( last_k < 0 ? 0 : last_k + 1 ); k <= max_k; k++ ){
+            G_row[k] = 0.0;
+        }
+
+        /* This is the second summand, we go through the */
+        /* valid states we can go to from the current state */
+        for( j = pModel->pTransBegin[i]; j < pModel->pTransBegin[i + 1]; j++ ){
+            probability = pModel->pTransProb[j];
+            last_k = ( R - pModel->pTransOffset[j] < max_k ? R - pModel->pTransOffset[j] : max_k );
+            if( last_k >= 0 ){
+                G_prev = &G_now[pModel->pTransState[j] * cols + pModel->pTransOffset[j]];
+                for( k = 0; k <= last_k; k++ ){
+                    G_row[k] += probability * G_prev[k];
+                }
+            }
         }
     }
 }
 
 /**
-* Solve t-r-bounded until formula in MRM using discretization.
+* Solve t-r-bounded until formula in MRM using discretization, for all
+* initial states at once.
+* The forward discretization of Tijms and Veldman computes the density
+* F^{t}(s,k) of being in state s with the discretized reward k at the
+* discretized time t for one initial state. Here we use the backward
+* formulation instead: G^{m}(s,k) is the probability to reach a Psi state
+* within m further time steps when starting in state s with the discretized
+* reward k. For the Psi states G^{m}(s,k) = 1, for the states that are
+* neither Phi nor Psi it is 0, and for the other states
+*   G^{m}(s,k) = (1 - E(s)*d) * G^{m-1}(s, k + r(s))
+*              + sum_{s'} R(s,s')*d * G^{m-1}(s', k + r(s) + i(s,s')/d)
+* where the terms whose reward index exceeds the discretized reward bound
+* are dropped, exactly as in the forward recursion. The probability for the
+* initial state s is then G^{T-1}(s, r(s)).
+* G^{m} and G^{m-1} are kept in two dense rows x (R+1) arrays that are
+* allocated once and swapped after every time step, so the whole
+* computation costs O(T*R*nnz) for all the states together. As a path can
+* only gain a bounded reward per step, G^{m} is only needed for the reward
+* indices up to max r(s) + (T-1-m) * (the largest increment of one step),
+* the other entries are not computed.
 * NOTE: The test for 'd > 1/E(s)' is done in the discretization_wrapper(...) method
-* @param: int state: the starting state.
 * @param: bitset *phi: satisfaction relation for phi formula.
 * @param: bitset *psi: satisfaction relation for psi formula.
-* @param: double supi: upper time bound
-* @param: double supj: upper reward bound
+* @param: double m_time: upper time bound
+* @param: double m_reward: upper reward bound
 * @param: double d_factor: d factor.
-* @param: BOOL testForError: TRUE if we are goinf to check for 'd > 1/E(s)'
-* @param: BOOL *pError: Is TRUE if 'd > 1/E(s)', in this
-*                 case we do not start computations at all.
-* @return: double: result of the until formula for one state.
+* @return: double *: result of the until formula for all states, or NULL
+*                    if we run out of memory.
 */
-static double discretization( int state_local, const bitset * phi,
-                              const bitset * psi, const double m_time,
-                              const double m_reward, const double d_factor)
+static double * discretization( const bitset * phi, const bitset * psi,
+                                const double m_time, const double m_reward,
+                                const double d_factor)
 {
     /* Shouldn't this be (int) (m_reward / d_factor) and
        (int) (m_time / d_factor), respectively? David N. Jansen. */
     const int R = (int) m_reward / d_factor, T = (int) m_time / d_factor,
               rows = bitset_size(phi);
-    const sparse *pStateSpace = get_state_space();
-    const sparse *rewi_matrix = getImpulseRewards();
-    const double *row_sums = get_row_sums();
+    /* The reward index runs through 0...R, that makes R+1 columns */
+    const int cols = R + 1;
     const double *rew_array = getStateRewards();
 
     /* NOTE: We do not make states absording here in an explicit manner! */
     /* What is done is using the valid_states set and then checking */
     /* for PSI states. In PSI states all the rewards are ZERO!!!! */
-
-    int current_state, prev_state;
     bitset *valid_states = or(phi, psi);
 
-    sparse *F_t_now_s_k, *F_t_next_s_k;
-    int t;
-    double from_prev_to_current_state_rate, total_prob = 0.0,
-           impulse_reward = 0.0;
-    BITSET_BLOCK_TYPE psi_state_bit;
-
-    /* Allocate the F_t_now_s_k matrix */
-    /* correction of an MRMC bug: the matrix has to have columns 0...R, that
-       makes R+1 columns. See also the second allocate_sparse_matrix() call
-       a few lines below. David N. Jansen */
-    F_t_now_s_k = allocate_sparse_matrix(rows, R + 1);  /* TODO: change into
-            allocate_sparse_matrix_ncols, it will give some speedup */
-    if ( NULL == F_t_now_s_k
-        /* Iterate through time: */
-        /* The initial value is for time t == 1 */
-        || err_state_iserror(set_mtx_val(F_t_now_s_k,
-                        state_local,(int)rew_array[state_local],
-                        1 / d_factor)) )
-    {
-        err_msg_8(err_CALLBY, "discretization(%d,%p[%d],%p[%d],%g,%g,"
-                "%g)", state_local, (const void*) phi, bitset_size(phi),
-                (const void *) psi, bitset_size(psi), m_time, m_reward,
-                d_factor,
-                (NULL == F_t_now_s_k
-                        || (free_mtx_sparse(F_t_now_s_k), FALSE),
-                free_bitset(valid_states), NAN));
+    TDiscretizationModel model;
+    double *G_now = (double *) calloc((size_t) rows * cols, sizeof(double));
+    double *G_next = (double *) calloc((size_t) rows * cols, sizeof(double));
+    double *result = (double *) calloc((size_t) rows, sizeof(double));
+    double *G_tmp;
+    int t, k, state, reward_index, max_reward_index = 0, max_k;
+
+    if ( ! buildDiscretizationModel(&model, valid_states, psi, d_factor)
+         || NULL == G_now || NULL == G_next || NULL == result ) {
+        free( G_now ); free( G_next ); free( result );
+        freeDiscretizationModel( &model );
+        free_bitset( valid_states );
+        err_msg_5(err_CALLBY, "discretization(%p[%d],%p[%d],%g)",
+                  (const void *) phi, rows, (const void *) psi,
+                  bitset_size(psi), d_factor, NULL);
     }
-    /* Compute F^{t}(s,k) */
-    for( t = 2; t <= T; t++ ){
-        /* Allocate the F_t_next_s_k matrix */
-        F_t_next_s_k = allocate_sparse_matrix(rows, R + 1);
-        if ( NULL == F_t_next_s_k ) {
-                err_msg_8(err_CALLBY, "discretization(%d,%p[%d],%p[%d],"
-                        "%g,%g,%g)", state_local, (const void*) phi,
-                        bitset_size(phi), (const void *) psi,
-                        bitset_size(psi),m_time,m_reward,d_factor,
-                        (free_mtx_sparse(F_t_now_s_k),
-                        free_bitset(valid_states), NAN));
-        }
 
-        /* Iterate through the valid states, i.row_sums. or(phi, psi) states */
-        /* For F^{t}(current_state,k) */
-        current_state = -1;
-        while( ( current_state = get_idx_next_non_zero(valid_states, current_state) ) != -1 ){
-            /* Iterate through the set rewards of the current_state row: */
-            /* This is the first summand where we consider the reward */
-            /* and probability of staying in the current state */
-            psi_state_bit = get_bit_val(psi, current_state);
-            mtx_walk_row(F_t_now_s_k, (const int) current_state,
-                                    discrete_reward_state,
-                                    prev_probability)
-            {
-                accumulateRewardForStaying(psi_state_bit, current_state, discrete_reward_state, prev_probability, rew_array, R, row_sums, d_factor, F_t_next_s_k);
-            }
-            end_mtx_walk_row;
-
-            /* Iterate through phi and psi states again */
-            /* This is the second summand, we go through the */
-            /* states from which we can come to the current state */
-            prev_state = -1;
-            while( ( prev_state = get_idx_next_non_zero(valid_states, prev_state) ) != -1 ){
-                psi_state_bit = get_bit_val( psi, prev_state );
-                if ( err_state_iserror(get_mtx_val(pStateSpace,
-                     prev_state, current_state,
-                     &from_prev_to_current_state_rate
-                    )) )
-                {
-                    err_msg_8(err_CALLBY, "discretization("
-                            "%d,%p[%d],%p[%d],%g,%g,%g)",
-                            state_local, (const void *) phi,
-                            bitset_size(phi),
-                            (const void *) psi,
-                            bitset_size(psi), m_time,
-                            m_reward, d_factor,
-                            (free_mtx_sparse(F_t_next_s_k),
-                            free_mtx_sparse(F_t_now_s_k),
-                            free_bitset(valid_states),NAN));
-                }
-
-                if ( ! psi_state_bit && 0.0 != from_prev_to_current_state_rate)
-                {
-                    /* For the pure phi state prev_state from which there */
-                    /* is a transition to state current_state */
-                    if( rewi_matrix != NULL ){
-                        /* Get the impulse reward for this transition */
-                        if ( err_state_iserror( get_mtx_val( rewi_matrix,
-                                                             prev_state,
-                                                             current_state,
-                                                             &impulse_reward ) ) )
-                        {
-                                err_msg_8( err_CALLBY, "discretization(%d,%p"
-                                           "[%d],%p[%d],%g,%g,%g)",
-                                           state_local, (const void *) phi,
-                                           bitset_size(phi), (const void *) psi,
-                                           bitset_size(psi), m_time, m_reward,
-                                           d_factor, (free_mtx_sparse( F_t_next_s_k),
-                                           free_mtx_sparse( F_t_now_s_k),free_bitset
-                                           (valid_states), NAN));
-                        }
-                    }
-                    /* Iterate through the prev_state row and: */
-                    mtx_walk_row(F_t_now_s_k, (const int) prev_state, discrete_reward_state, prev_probability)
-                    {
-                        accumulateRewardForComming(current_state, prev_state, discrete_reward_state, impulse_reward, prev_probability,
-                                        from_prev_to_current_state_rate, rew_array, R, d_factor, F_t_next_s_k);
-                    }
-                    end_mtx_walk_row;
-                }
-            }
+    /* The Psi states are absorbing and good in both arrays, */
+    /* the states that are neither Phi nor Psi stay zero */
+    state = -1;
+    while( ( state = get_idx_next_non_zero(psi, state) ) != -1 ){
+        for( k = 0; k < cols; k++ ){
+            G_now[state * cols + k] = 1.0;
+            G_next[state * cols + k] = 1.0;
+        }
+    }
+    for( state = 0; state < rows; state++ ){
+        if( max_reward_index < (int) rew_array[state] ){
+            max_reward_index = (int) rew_array[state];
         }
+    }
 
-        /* Free the old matrix!!! */
-        if ( err_state_iserror(free_mtx_sparse(F_t_now_s_k)) ) {
-                err_msg_8(err_CALLBY, "discretization(%d,%p[%d],%p[%d],"
-                        "%g,%g,%g)", state_local, (const void*) phi,
-                        bitset_size(phi), (const void *) psi,
-                        bitset_size(psi),m_time,m_reward,d_factor,
-                        (free_mtx_sparse(F_t_next_s_k),
-                        free_bitset(valid_states), NAN));
+    /* Compute G^{m}(s,k) for m = t-1 = 1...T-1 */
+    for( t = 2; t <= T; t++ ){
+        /* The reward indices reachable from the initial ones in T-t steps */
+        if( max_reward_index >= R
+            || (double) ( T - t ) * model.max_offset >= R - max_reward_index ){
+            max_k = R;
+        } else {
+            max_k = max_reward_index + ( T - t ) * model.max_offset;
         }
-        F_t_now_s_k = F_t_next_s_k;    /* SWAP the F_t_now_s_k and F_t_next_s_k matrices!!! */
-        F_t_next_s_k = NULL;
+        discretization_step( &model, G_now, G_next, cols, max_k );
+
+        /* SWAP the G_now and G_next arrays!!! */
+        G_tmp = G_now; G_now = G_next; G_next = G_tmp;
     }
 
-    /* Obtain the total probability by summing up resulting probabilities over all psi sates */
-    current_state = -1;
-    /* For all Psi states */
-    while( ( current_state = get_idx_next_non_zero(psi, current_state) ) != -1 ){
-        /* For all rewards from 1 to R */
-        mtx_walk_row(F_t_now_s_k, (const int) current_state,
-                        discrete_reward_state, prev_probability)
-        {
-            total_prob += prev_probability * d_factor;
+    /* The probability for every initial state s is G^{T-1}(s, r(s)) */
+    for( state = 0; state < rows; state++ ){
+        reward_index = (int) rew_array[state];
+        if( reward_index <= R ){
+            result[state] = G_now[state * cols + reward_index];
         }
-        end_mtx_walk_row;
     }
+
     /* Free allocated memory */
-    free_bitset(valid_states);
-    if ( err_state_iserror(free_mtx_sparse(F_t_now_s_k)) ) {
-            err_msg_8(err_CALLBY, "discretization(%d,%p[%d],%p[%d],%g,%g,"
-                    "%g)", state_local, (const void*) phi, bitset_size(phi),
-                    (const void *) psi, bitset_size(psi), m_time, m_reward,
-                    d_factor, NAN);
-    }
-    F_t_now_s_k = NULL;
-    return total_prob;
+    free( G_now );
+    free( G_next );
+    freeDiscretizationModel( &model );
+    free_bitset( valid_states );
+    return result;
 }
 
 /***********************************************************************************/
@@ -810,7 +888,6 @@ static double discretization( int state_local, const bitset * phi,
   /* GLOBAL */
 static double maxPoi;
 static int *index_;
-static double *omIteration;
 static double *Poisson;
 static double *pathErr;
   /* GLOBAL */
@@ -903,67 +980,75 @@ static double *get_dsr(const double *rew_array, const bitset *valid_states, cons
 /**
 * All indices less than pivot are in G,
 * pivot and greater indices are in L.
+* The values of the cols elements of G are updated in pOmIteration.
 */
-static void omIt(int number_of_distinct_state_rewards, const int * tmp_k,
-                double r_dash, int j, int pivot, int cols,
-                const double * distinct_state_rewards_array)
+static void omIt(const int * tmp_k, double r_dash, int j, int pivot,
+                const double * distinct_state_rewards_array, double * pOmIteration)
 {
-    double prevValue = 1.0, val_i, val_j;
-    int * tempG = (int *) calloc((size_t) number_of_distinct_state_rewards, sizeof(int)), count, i;
-
-    for(count=0; count<cols;count++) {
-        for(i=0;i<pivot;i++)
-        {
-            if(tempG[i]<tmp_k[i])
-            {
-                tempG[i]++;
-                val_i = distinct_state_rewards_array[i];
-                val_j = distinct_state_rewards_array[j];
-                omIteration[count] = ((val_i-r_dash)/(val_i-val_j))*omIteration[count]+((r_dash-val_j)/(val_i-val_j))*prevValue;
-                prevValue = omIteration[count];
-                break;
-            }
+    double prevValue = 1.0, val_i, val_j = distinct_state_rewards_array[j];
+    int count = 0, i, c;
+
+    /* The elements of G, in the ascending order of their indices */
+    for(i=0;i<pivot;i++) {
+        val_i = distinct_state_rewards_array[i];
+        for(c=0;c<tmp_k[i];c++,count++) {
+            pOmIteration[count] = ((val_i-r_dash)/(val_i-val_j))*pOmIteration[count]+((r_dash-val_j)/(val_i-val_j))*prevValue;
+            prevValue = pOmIteration[count];
         }
     }
-    free(tempG);
-    tempG=NULL;
 }
 
-double omega(const int * tmp_k, double r_dash, int pivot,
+/**
+* Computes the uniform order statistics probability for the given k-vector.
+* @param pOmIteration the zero initialized values of the elements of G,
+*        the size is cols, they are updated here and can be used to
+*        continue the computation for the larger k-vectors, see omIt(...).
+*/
+static double omega_iteration(const int * tmp_k, double r_dash, int pivot,
                 int number_of_distinct_state_rewards,
-                const double * distinct_state_rewards_array)
+                const double * distinct_state_rewards_array,
+                double * pOmIteration)
 {
-    int cols = 0, rows=0, count, *tempL, j;
+    int cols = 0, rows=0, count, c, j;
     for(count=pivot;count<number_of_distinct_state_rewards;count++) {
         rows+=tmp_k[count];
     }
     for(count=0;count<pivot;count++) {
         cols+=tmp_k[count];
     }
-    if(rows!=0 && cols==0) {
+    if(cols==0) {
         return 1.0;
-    } else { 
-        if (rows==0 && cols!=0) {
+    } else {
+        if (rows==0) {
             return 0.0;
         }
     }
-    tempL = (int *) calloc((size_t) number_of_distinct_state_rewards,
-                    sizeof(int));
-    omIteration = (double *) calloc((size_t) cols, sizeof(double));
-    for(count=0; count<rows;count++)
-    {
-        for(j=pivot;j<number_of_distinct_state_rewards;j++)
-        {
-            if(tempL[j]<tmp_k[j])
-            {
-                tempL[j]++;
-                omIt(number_of_distinct_state_rewards, tmp_k, r_dash, j, pivot, cols, distinct_state_rewards_array);
-                break;
-            }
+    /* The elements of L, in the ascending order of their indices */
+    for(j=pivot;j<number_of_distinct_state_rewards;j++) {
+        for(c=0;c<tmp_k[j];c++) {
+            omIt(tmp_k, r_dash, j, pivot, distinct_state_rewards_array, pOmIteration);
         }
     }
-    free(tempL); tempL=NULL;
-    return omIteration[cols-1];
+    return pOmIteration[cols-1];
+}
+
+/**
+* Computes the uniform order statistics probability for the given k-vector.
+*/
+double omega(const int * tmp_k, double r_dash, int pivot,
+                int number_of_distinct_state_rewards,
+                const double * distinct_state_rewards_array)
+{
+    int cols = 0, count;
+    double * pOmIteration, om;
+    for(count=0;count<pivot;count++) {
+        cols+=tmp_k[count];
+    }
+    pOmIteration = (double *) calloc((size_t) cols + 1, sizeof(double));
+    om = omega_iteration(tmp_k, r_dash, pivot, number_of_distinct_state_rewards,
+                    distinct_state_rewards_array, pOmIteration);
+    free(pOmIteration);
+    return om;
 }
 
 /**
@@ -983,16 +1068,224 @@ double omega(const int * tmp_k, double r_dash, int pivot,
 *        ci = di = ri
 *      all indices less than pivot are in G
 *      pivot and all indices greater than pivot are in L
+*      The rewards are in the descending order, so the pivot is found by
+*      the binary search.
 */
 static int findPivot(double r_dash, const double *distinct_state_rewards_array, int number_of_distinct_state_rewards)
 {
-    int i=0;
-    for(;i<number_of_distinct_state_rewards;i++) {
-        if(distinct_state_rewards_array[i]<=r_dash) {
-            break;
+    int lower=0, upper=number_of_distinct_state_rewards, middle;
+    while(lower<upper) {
+        middle = (lower+upper)/2;
+        if(distinct_state_rewards_array[middle]<=r_dash) {
+            upper = middle;
+        } else {
+            lower = middle+1;
         }
     }
-    return i;
+    return lower;
+}
+
+/**
+* The memoized omega values of one k-vector and accumulated impulse reward.
+* The path length n is extended by visits to the state with the smallest
+* reward, pOm[i] is the omega value for the k-vector with its last element
+* increased by i.
+* pNext - the next entry in the same bucket of the hash table
+* hash - the hash value of k and acir, see get_kj_hash(...)
+* acir - the accumulated impulse reward
+* k - the k-vector
+* pivot - the pivot for acir, see findPivot(...)
+* cols - the number of elements of G
+* pOmIteration - the values of the cols elements of G after pOm[num-1]
+* pOm - the omega values computed so far
+* num - the number of the omega values computed so far
+*/
+typedef struct SOmegaEntry{
+    struct SOmegaEntry * pNext;
+    unsigned long hash;
+    double acir;
+    int * k;
+    int pivot;
+    int cols;
+    double * pOmIteration;
+    double * pOm;
+    int num;
+} TOmegaEntry;
+
+/**
+* The hash table of the memoized omega values, for a fixed time
+* and reward bound, keyed by the k-vector and the accumulated
+* impulse reward.
+* ndsr - the number of distinct state-based rewards
+* num_entries - the number of entries
+* num_buckets - the size of the hash table, a power of two
+* ppBuckets - the hash table
+*/
+typedef struct SOmegaCache{
+    int ndsr;
+    int num_entries;
+    int num_buckets;
+    TOmegaEntry ** ppBuckets;
+} TOmegaCache;
+
+/* The initial size of the hash table of the omega cache */
+#define OMEGA_CACHE_BUCKETS 1024
+
+/**
+* Creates an empty omega cache.
+* @param ndsr the number of distinct state-based rewards
+* @return the new cache
+*/
+static TOmegaCache * get_new_omega_cache(int ndsr)
+{
+    TOmegaCache * pCache = (TOmegaCache *) calloc((size_t) 1, sizeof(TOmegaCache));
+    if( NULL == pCache ){
+        exit(err_macro_0(err_MEMORY, "get_new_omega_cache()", EXIT_FAILURE));
+    }
+    pCache->ndsr = ndsr;
+    pCache->num_buckets = OMEGA_CACHE_BUCKETS;
+    pCache->ppBuckets = (TOmegaEntry **) calloc((size_t) pCache->num_buckets,
+                    sizeof(TOmegaEntry *));
+    if( NULL == pCache->ppBuckets ){
+        exit(err_macro_0(err_MEMORY, "get_new_omega_cache()", EXIT_FAILURE));
+    }
+    return pCache;
+}
+
+/**
+* Frees the omega cache and all its entries.
+*/
+static void free_omega_cache(TOmegaCache * pCache)
+{
+    int i;
+    for( i = 0; i < pCache->num_buckets; i++ ){
+        TOmegaEntry * pEntry = pCache->ppBuckets[i], * pNext;
+        while( pEntry != NULL ){
+            pNext = pEntry->pNext;
+            free(pEntry->k);
+            free(pEntry->pOmIteration);
+            free(pEntry->pOm);
+            free(pEntry);
+            pEntry = pNext;
+        }
+    }
+    free(pCache->ppBuckets);
+    free(pCache);
+}
+
+/**
+* Doubles the size of the hash table of the omega cache.
+*/
+static void grow_omega_cache(TOmegaCache * pCache)
+{
+    const int num_buckets = 2 * pCache->num_buckets;
+    TOmegaEntry ** ppBuckets = (TOmegaEntry **) calloc((size_t) num_buckets,
+                    sizeof(TOmegaEntry *));
+    int i;
+
+    if( NULL == ppBuckets ){
+        exit(err_macro_0(err_MEMORY, "grow_omega_cache()", EXIT_FAILURE));
+    }
+    for( i = 0; i < pCache->num_buckets; i++ ){
+        TOmegaEntry * pEntry = pCache->ppBuckets[i], * pNext;
+        while( pEntry != NULL ){
+            const int b = (int) (pEntry->hash & (unsigned long) (num_buckets - 1));
+            pNext = pEntry->pNext;
+            pEntry->pNext = ppBuckets[b];
+            ppBuckets[b] = pEntry;
+            pEntry = pNext;
+        }
+    }
+    free(pCache->ppBuckets);
+    pCache->ppBuckets = ppBuckets;
+    pCache->num_buckets = num_buckets;
+}
+
+/**
+* Finds the omega cache entry of the k-vector and the accumulated impulse
+* reward, a new entry without omega values is added if there is none.
+* @param r_dash the reward bound for acir, see uniformization_qureshi_sanders(...)
+* @return the entry
+*/
+static TOmegaEntry * get_omega_entry(TOmegaCache * pCache, const int * k,
+                double acir, double r_dash,
+                const double * distinct_state_rewards_array)
+{
+    const int ndsr = pCache->ndsr;
+    const unsigned long hash = get_kj_hash(ndsr, k, acir);
+    TOmegaEntry ** ppBucket = &pCache->ppBuckets[hash & (unsigned long) (pCache->num_buckets - 1)];
+    TOmegaEntry * pEntry;
+    int i;
+
+    for( pEntry = *ppBucket; pEntry != NULL; pEntry = pEntry->pNext ){
+        if( pEntry->hash == hash && pEntry->acir == acir
+            && memcmp(pEntry->k, k, ndsr * sizeof(int)) == 0 ){
+            return pEntry;
+        }
+    }
+
+    pEntry = (TOmegaEntry *) calloc((size_t) 1, sizeof(TOmegaEntry));
+    if( NULL == pEntry ){
+        exit(err_macro_0(err_MEMORY, "get_omega_entry()", EXIT_FAILURE));
+    }
+    pEntry->k = (int *) malloc((size_t) ndsr * sizeof(int));
+    if( NULL == pEntry->k ){
+        exit(err_macro_0(err_MEMORY, "get_omega_entry()", EXIT_FAILURE));
+    }
+    memcpy(pEntry->k, k, ndsr * sizeof(int));
+    pEntry->hash = hash;
+    pEntry->acir = acir;
+    pEntry->pivot = findPivot(r_dash, distinct_state_rewards_array, ndsr);
+    for( i = 0; i < pEntry->pivot; i++ ){
+        pEntry->cols += k[i];
+    }
+    pEntry->pNext = *ppBucket;
+    *ppBucket = pEntry;
+    if( ++pCache->num_entries > pCache->num_buckets ){
+        grow_omega_cache(pCache);
+    }
+    return pEntry;
+}
+
+/**
+* Makes sure that the cache entry has at least num omega values.
+* NOTE: Different entries can be extended concurrently.
+* @param pEntry the cache entry
+* @param num the number of omega values needed
+* @param r_dash the reward bound for the entry's acir
+*/
+static void extend_omega_entry(TOmegaEntry * pEntry, int num, double r_dash,
+                int number_of_distinct_state_rewards,
+                const double * distinct_state_rewards_array)
+{
+    if( pEntry->num >= num ){
+        return;
+    }
+    pEntry->pOm = (double *) realloc(pEntry->pOm, (size_t) num * sizeof(double));
+    if( NULL == pEntry->pOm ){
+        exit(err_macro_0(err_MEMORY, "extend_omega_entry()", EXIT_FAILURE));
+    }
+    if( pEntry->num == 0 ){
+        pEntry->pOmIteration = (double *) calloc((size_t) pEntry->cols + 1, sizeof(double));
+        if( NULL == pEntry->pOmIteration ){
+            exit(err_macro_0(err_MEMORY, "extend_omega_entry()", EXIT_FAILURE));
+        }
+        pEntry->pOm[pEntry->num++] = omega_iteration(pEntry->k, r_dash, pEntry->pivot,
+                        number_of_distinct_state_rewards,
+                        distinct_state_rewards_array, pEntry->pOmIteration);
+    }
+    while( pEntry->num < num ){
+        if( pEntry->cols > 0 ){
+            /* The smallest reward is in L, so the k-vector need not be updated */
+            omIt(pEntry->k, r_dash, number_of_distinct_state_rewards-1,
+                            pEntry->pivot, distinct_state_rewards_array,
+                            pEntry->pOmIteration);
+            pEntry->pOm[pEntry->num] = pEntry->pOmIteration[pEntry->cols-1];
+        }else{
+            pEntry->pOm[pEntry->num] = pEntry->pOm[pEntry->num-1];
+        }
+        pEntry->num++;
+    }
 }
 
 /**
@@ -1052,6 +1345,83 @@ static void errorBounds(const int n, const double prob, double *tot_err, const d
 /* static */
 /* int recursion_level = 0; */
 
+/**
+* A subtree of the depth first path generation, a unit of work
+* of the parallel path generation.
+* k - the k-vector of the path leading to the root of the subtree
+* n - the length of this path
+* state - the root state of the subtree
+* p - the probability of the path
+* r_impulse - the accumulated impulse reward of the path
+* tot_err - the error of the paths discarded in the subtree
+*/
+typedef struct SDfpgTask{
+    int * k;
+    int n;
+    int state;
+    double p;
+    double r_impulse;
+    double tot_err;
+} TDfpgTask;
+
+/**
+* The subtrees collected for the parallel depth first path generation.
+* split_depth - the path length at which the subtrees start
+* ndsr - the number of distinct state-based rewards
+* num - the number of subtrees
+* capacity - the allocated number of subtrees
+* pTasks - the subtrees in the depth first order
+*/
+typedef struct SDfpgTasks{
+    int split_depth;
+    int ndsr;
+    int num;
+    int capacity;
+    TDfpgTask * pTasks;
+} TDfpgTasks;
+
+/* The longest path length at which the parallel path generation forms the subtrees */
+#define DFPG_SPLIT_DEPTH 6
+/* The number of subtrees that are explored in parallel before they are merged */
+#define DFPG_BATCH_SIZE 256
+/* The number of subtrees per thread and batch slot that may be collected */
+#define DFPG_TASKS_FACTOR 4
+
+/**
+* Adds a subtree to the collected ones.
+* @param pTasks the subtrees
+* @param k the k-vector of the path leading to the root of the subtree
+* @param n the length of this path
+* @param state the root state of the subtree
+* @param p the probability of the path
+* @param r_impulse the accumulated impulse reward of the path
+*/
+static void add_dfpg_task(TDfpgTasks * pTasks, const int * k, int n, int state,
+                double p, double r_impulse)
+{
+    TDfpgTask * pTask;
+
+    if( pTasks->num == pTasks->capacity ){
+        pTasks->capacity = pTasks->capacity > 0 ? 2 * pTasks->capacity : 64;
+        pTasks->pTasks = (TDfpgTask *) realloc(pTasks->pTasks,
+                        (size_t) pTasks->capacity * sizeof(TDfpgTask));
+        if( NULL == pTasks->pTasks ){
+            exit(err_macro_0(err_MEMORY, "add_dfpg_task()", EXIT_FAILURE));
+        }
+    }
+    pTask = &pTasks->pTasks[pTasks->num++];
+    memset(pTask, 0, sizeof(TDfpgTask));
+    pTask->k = (int *) malloc((size_t) pTasks->ndsr * sizeof(int));
+    if( NULL == pTask->k ){
+        exit(err_macro_0(err_MEMORY, "add_dfpg_task()", EXIT_FAILURE));
+    }
+    memcpy(pTask->k, k, pTasks->ndsr * sizeof(int));
+    pTask->n = n;
+    pTask->state = state;
+    pTask->p = p;
+    pTask->r_impulse = r_impulse;
+}
+
 /**
 * @param: w - Probability Threshold
 * @param: double supi: upper time bound
@@ -1065,12 +1435,15 @@ static void errorBounds(const int n, const double prob, double *tot_err, const d
 *        length. So, it is necessary to stop the computation at some point. This is
 *        where "w" - probability threshold - comes in, only paths whose probability
 *        is more than 'w' are considered in the computation.
+* @param: TDfpgTasks *pTasks: if not NULL then the paths are not explored
+*        deeper than pTasks->split_depth, their ends are collected in pTasks.
 * NOTE: depth first path generation
 */
 static void dfpg(int * global_k, const sparse * abs_local,
                 const sparse * rewi_matrix, int n, int state_local,
         double p, double r_impulse, double w, double lambda, double supi, double supj,
-        int *psize, double *tot_err, kjstruc *kjstruct, const bitset *psi)
+        int *psize, double *tot_err, kjstruc *kjstruct, const bitset *psi,
+        TDfpgTasks *pTasks)
 {
     double pr;
 
@@ -1079,6 +1452,15 @@ static void dfpg(int * global_k, const sparse * abs_local,
     maxPoisson(n, lambda, supi, psize);
     pr = p*Poisson[n];
     /*printf("pr=%lf\n",pr);*/
+
+    /* When collecting the subtrees, every path that reaches the split */
+    /* depth or ends before it becomes the root of a subtree */
+    if( pTasks != NULL && ( n == pTasks->split_depth || supj < r_impulse
+                            || pr < w || get_bit_val(psi, state_local) ) )
+    {
+        add_dfpg_task(pTasks, global_k, n, state_local, p, r_impulse);
+        return;
+    }
     /*TODO:
      * Where is the check for s |= not Phi /\ not Psi ?
      * Why do we check for supj < r_impulse here?
@@ -1131,7 +1513,7 @@ static void dfpg(int * global_k, const sparse * abs_local,
                 dfpg(global_k, abs_local, rewi_matrix, n+1, col,
                                 p * vall, r_impulse + value, w,
                                 lambda, supi, supj, psize,
-                                tot_err, kjstruct, psi);
+                                tot_err, kjstruct, psi, pTasks);
                 /* recursion_level--; */
 
                 global_k[kIndex]--;
@@ -1162,7 +1544,7 @@ static void dfpg(int * global_k, const sparse * abs_local,
                 dfpg(global_k, abs_local, rewi_matrix, n + 1,
                         state_local, p * val, r_impulse + value,
                         w, lambda, supi, supj, psize, tot_err,
-                        kjstruct, psi);
+                        kjstruct, psi, pTasks);
                 /* recursion_level--; */
 
                 global_k[kIndex]--;
@@ -1173,6 +1555,114 @@ static void dfpg(int * global_k, const sparse * abs_local,
                     recursion_level); */
 }
 
+#ifdef _OPENMP
+/**
+* Chooses the path length at which the parallel path generation forms the
+* subtrees. The number of subtrees grows as b^depth, where b is the largest
+* number of successors of a state, all of them are collected before the
+* first batch is explored. Thus the depth is the largest one, up to
+* DFPG_SPLIT_DEPTH, for which b^depth does not exceed DFPG_TASKS_FACTOR
+* subtrees per thread and batch slot, but at least 1.
+* @param abs_local the uniformized matrix the paths are generated in
+* @return the split depth
+*/
+static int get_dfpg_split_depth(const sparse * abs_local)
+{
+    const double max_tasks = (double) DFPG_TASKS_FACTOR *
+                    (double) omp_get_max_threads() * (double) DFPG_BATCH_SIZE;
+    int i, depth, branching = 1;
+    double num_tasks;
+
+    for( i = 0; i < mtx_rows(abs_local); i++ ){
+        /* The successors and the state itself through the diagonal */
+        if( mtx_next_num(abs_local, i) + 1 > branching ){
+            branching = mtx_next_num(abs_local, i) + 1;
+        }
+    }
+    num_tasks = (double) branching;
+    for( depth = 1; depth < DFPG_SPLIT_DEPTH
+                    && num_tasks * branching <= max_tasks; depth++ ){
+        num_tasks *= branching;
+    }
+    return depth;
+}
+
+/**
+* The parallel depth first path generation. The paths of length
+* split_depth are collected first, the subtrees below them are then
+* explored in parallel, in batches. Every subtree of a batch gets its own
+* KJ structure and error, they are merged into kjstruct and tot_err in the
+* depth first order. Thus the paths are stored in the same order as by the
+* sequential dfpg(...), only the probabilities of the paths that are found
+* in several subtrees are summed up in a different order.
+* NOTE: The Poisson probabilities for all the reachable path lengths have
+*       to be computed before, see the caller, because maxPoisson(...)
+*       reallocates the global arrays.
+* @param: split_depth the path length at which the subtrees start,
+*         see get_dfpg_split_depth(...)
+* @param: the other parameters are the same as for dfpg(...)
+*/
+static void dfpg_parallel(int split_depth, int * global_k, const sparse * abs_local,
+                const sparse * rewi_matrix, int state_local,
+        double w, double lambda, double supi, double supj,
+        int *psize, double *tot_err, kjstruc *kjstruct, const bitset *psi)
+{
+    const int ndsr = kjstruct->ndsr;
+    TDfpgTasks tasks;
+    kjstruc ** ppBatch;
+    int i, first, last;
+
+    memset(&tasks, 0, sizeof(TDfpgTasks));
+    tasks.split_depth = split_depth;
+    tasks.ndsr = ndsr;
+
+    /* Collect the subtrees */
+    dfpg(global_k, abs_local, rewi_matrix, 0, state_local, 1.0, 0.0, w,
+                    lambda, supi, supj, psize, tot_err, kjstruct, psi, &tasks);
+
+    ppBatch = (kjstruc **) calloc((size_t) DFPG_BATCH_SIZE, sizeof(kjstruc *));
+    if( NULL == ppBatch ){
+        exit(err_macro_0(err_MEMORY, "dfpg_parallel()", EXIT_FAILURE));
+    }
+    for( first = 0; first < tasks.num; first = last ){
+        last = first + DFPG_BATCH_SIZE < tasks.num ? first + DFPG_BATCH_SIZE : tasks.num;
+
+        /* Explore the subtrees, each one has its own k-vector and KJ structure */
+        #pragma omp parallel for schedule(dynamic, 1)
+        for( i = first; i < last; i++ ){
+            TDfpgTask * pTask = &tasks.pTasks[i];
+            kjstruc * pKJ = ppBatch[i - first];
+            if( pKJ == NULL ){
+                pKJ = ppBatch[i - first] = get_new_kjstruc(ndsr);
+            }else{
+                reset_kjstorage(pKJ);
+            }
+            dfpg(pTask->k, abs_local, rewi_matrix, pTask->n, pTask->state,
+                            pTask->p, pTask->r_impulse, w, lambda, supi, supj,
+                            psize, &pTask->tot_err, pKJ, psi, NULL);
+        }
+
+        /* Merge them in the depth first order */
+        for( i = first; i < last; i++ ){
+            kjnode * trav;
+            for( trav = ppBatch[i - first]->kjnodes; trav != NULL; trav = trav->next ){
+                add_new_kjnode(kjstruct, trav->k, trav->acir, trav->prob);
+            }
+            *tot_err += tasks.pTasks[i].tot_err;
+            free(tasks.pTasks[i].k);
+        }
+    }
+
+    for( i = 0; i < DFPG_BATCH_SIZE; i++ ){
+        if( ppBatch[i] != NULL ){
+            free_kjstorage(ppBatch[i]);
+        }
+    }
+    free(ppBatch);
+    free(tasks.pTasks);
+}
+#endif
+
 /**
 * Solve t-r-bounded until formula (phi U[0, supi][0, supj] psi) in MRM without impulse rewards
 * using uniformization by qureshi & sanders.
@@ -1201,6 +1691,11 @@ static double * uniformization_qureshi_sanders(const bitset * phi,
     int ki, non_absorbing, psize;
     double lambda, total_prob, tot_err;
     kjstruc *kjstruct;
+    TOmegaCache *pOmegaCache;
+    /* The omega cache entries of the paths and the numbers of their omega values */
+    TOmegaEntry **ppEntries = NULL;
+    int *pSteps = NULL;
+    int num_paths_alloc = 0, j;
     double * diag;
     sparse * abs_local;
     /* Stores the resulting probabilities */
@@ -1208,6 +1703,9 @@ static double * uniformization_qureshi_sanders(const bitset * phi,
     /* Stores the errors of the resulting probabilities */
     double *pResultError;
     int * global_k;
+#ifdef _OPENMP
+    int split_depth = DFPG_SPLIT_DEPTH;
+#endif
 
     valid_states = not(psi);
     and_result(phi, valid_states);  /* Remains Constant after this */
@@ -1268,13 +1766,31 @@ static double * uniformization_qureshi_sanders(const bitset * phi,
 
         /*print_mtx_sparse(abs_local);
         printf("lambda = %f, w = %f\n", lambda, w);*/
+        /* The paths of all the states are merged in one arena */
+        kjstruct = get_new_kjstruc(number_of_distinct_state_rewards);
+        /* The omega values are shared by the paths of all the states */
+        pOmegaCache = get_new_omega_cache(number_of_distinct_state_rewards);
+#ifdef _OPENMP
+        /* The parallel path generation only reads the Poisson probabilities. */
+        /* A path of length n is not extended if Poisson[n] < w, so once the */
+        /* probabilities decrease, the first such n is the longest path length */
+        if( w > 0.0 ){
+            int n = 0;
+            maxPoisson(n, lambda, supi, &psize);
+            while( n <= lambda * supi || Poisson[n] >= w ){
+                maxPoisson(++n, lambda, supi, &psize);
+            }
+            split_depth = get_dfpg_split_depth(abs_local);
+        }
+#endif
         for ( ki = 0 ; ki < rows ; ki++ )
         {
             int kIndex;
             kjnode *trav;
 
             total_prob = 0.0; tot_err = 0.0;
-            kjstruct = get_new_kjstruc(number_of_distinct_state_rewards);
+            /* The nodes of the previous state are dropped at once */
+            reset_kjstorage(kjstruct);
             /* Store the state reward index in the array of distinct state rewards */
             kIndex = index_[ki];
 
@@ -1283,57 +1799,98 @@ static double * uniformization_qureshi_sanders(const bitset * phi,
 
             /* print_mtx_sparse(abs_local); */
             global_k[kIndex]++;
-            dfpg(global_k, abs_local, rewi_matrix, 0, ki, 1.0,
-                            0.0, w, lambda, supi, supj, &psize,
-                            &tot_err, kjstruct, psi);
+#ifdef _OPENMP
+            if( w > 0.0 ){
+                dfpg_parallel(split_depth, global_k, abs_local, rewi_matrix, ki,
+                                w, lambda, supi, supj, &psize,
+                                &tot_err, kjstruct, psi);
+            }else
+#endif
+            {
+                dfpg(global_k, abs_local, rewi_matrix, 0, ki, 1.0,
+                                0.0, w, lambda, supi, supj, &psize,
+                                &tot_err, kjstruct, psi, NULL);
+            }
             global_k[kIndex]--;     /* This does not do a thing !!!!! */
 
             /* testMaxPoisson(lambda, supi, &psize); */
             /* print_kjstorage(kjstruct); */
-            trav = kjstruct->kjnodes;
-            while(trav!=NULL)
+            /* Find the omega cache entries of the paths and the number */
+            /* of the omega values each path needs */
+            if( kjstruct->num_nodes > num_paths_alloc ){
+                num_paths_alloc = kjstruct->num_nodes;
+                ppEntries = (TOmegaEntry **) realloc(ppEntries,
+                                (size_t) num_paths_alloc * sizeof(TOmegaEntry *));
+                pSteps = (int *) realloc(pSteps, (size_t) num_paths_alloc * sizeof(int));
+                if( NULL == ppEntries || NULL == pSteps ){
+                    exit(err_macro_0(err_MEMORY, "uniformization_qureshi_sanders()",
+                                    EXIT_FAILURE));
+                }
+            }
+            for( trav = kjstruct->kjnodes, j = 0; trav != NULL; trav = trav->next, j++ )
             {
                 double r_dash = supj/supi-trav->acir/supi;
-                int pivot = findPivot(r_dash, distinct_state_rewards_array, number_of_distinct_state_rewards);
                 int i, n=0;
-                int * tmp_k=trav->k;
                 double pr;
-                double om;
-                int cols;
 
                 for(i=0; i<number_of_distinct_state_rewards; i++)
-                    n+=tmp_k[i];
+                    n+=trav->k[i];
                 --n;
                 maxPoisson(n, lambda, supi, &psize);
                 pr = trav->prob *  Poisson[n];
-                om = omega(tmp_k, r_dash, pivot, number_of_distinct_state_rewards, distinct_state_rewards_array);
-                cols = 0;
-                for(i=0; i<pivot; i++) {
-                    cols+=tmp_k[i];
-                }
+                pSteps[j] = 0;
                 while(pr>=w && r_dash>=0.0)
                 {
-                    total_prob += pr * (om);
-                    tmp_k[number_of_distinct_state_rewards-1]++;
+                    pSteps[j]++;
+                    pr = pr * ((lambda*supi)/++n);
+                }
+                ppEntries[j] = pSteps[j] > 0 ? get_omega_entry(pOmegaCache,
+                                trav->k, trav->acir, r_dash,
+                                distinct_state_rewards_array) : NULL;
+            }
+
+            /* Compute the missing omega values, the paths have */
+            /* distinct k-vectors and rewards, thus distinct entries */
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic, 16)
+#endif
+            for( j = 0; j < kjstruct->num_nodes; j++ )
+            {
+                if( ppEntries[j] != NULL ){
+                    extend_omega_entry(ppEntries[j], pSteps[j],
+                                    supj/supi-ppEntries[j]->acir/supi,
+                                    number_of_distinct_state_rewards,
+                                    distinct_state_rewards_array);
+                }
+            }
+
+            for( trav = kjstruct->kjnodes, j = 0; trav != NULL; trav = trav->next, j++ )
+            {
+                int i, n=0, step;
+                double pr;
+
+                for(i=0; i<number_of_distinct_state_rewards; i++)
+                    n+=trav->k[i];
+                --n;
+                pr = trav->prob *  Poisson[n];
+                for( step = 0; step < pSteps[j]; step++ )
+                {
+                    total_prob += pr * ppEntries[j]->pOm[step];
                     pr = pr * ((lambda*supi)/++n);
-                    if(pr>=w && cols>0)
-                    {
-                        omIt(number_of_distinct_state_rewards, tmp_k, r_dash, number_of_distinct_state_rewards-1, pivot, cols, distinct_state_rewards_array);
-                        om = omIteration[cols-1];
-                    }
                 }
                 errorBounds(n, trav->prob, &tot_err, lambda, supi, &psize);
-                trav=trav->next;
-                free(omIteration); omIteration=NULL;
             }
-            free_kjstorage(kjstruct);
-            kjstruct=NULL;
             /* NOTE: indexes of states from the user point of view start from 1 */
             /* printf("State = %d, Probabilty = %e, Error Bound = %e \n", ki+1, total_prob, tot_err); */
             if( tot_err >= 0.1 ) printf("WARNING: The Probability Threshold w = %e is to big!\n", tot_err);
             result[ki] = total_prob;
             pResultError[ki] = tot_err;
         }
+        free_kjstorage(kjstruct);
+        kjstruct=NULL;
+        free_omega_cache(pOmegaCache);
+        free(ppEntries);
+        free(pSteps);
 
         /*Reset the matrix to its original state
         NOTE: operations on diagonals are not required */
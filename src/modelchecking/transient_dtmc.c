@@ -172,9 +172,12 @@ double * dtmc_unbounded_until(const bitset *phi, const bitset *psi)
 * Solve the unbounded until operator for all states for DTMC with lumping.
 * @param		: bitset *phi: SAT(phi).
 * @param		: bitset *psi: SAT(psi).
+* @param		: partition **ppP: if not NULL, receives the partition and
+*			  the result is kept per block
 * @return		: double *: result of unbounded until operator for all states.
 */
-double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi)
+double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi,
+                partition ** ppP)
 {
         const
 	sparse *state_space = get_state_space();
@@ -192,8 +195,8 @@ double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi)
                         || (AU = get_always_until(state_space, phi, psi, EU))
                                         == NULL
 	/* create initial partition for unbounded until formula and lump */
-                        || (P = init_partition_formula(EU, AU, FALSE)) == NULL
-                        || (pP = lump(P, state_space)) == NULL
+                        || (pP = lump_formula(&P, state_space, EU, AU, FALSE))
+                                        == NULL
 
         /* not(not(EU) or AU) = EU and not(AU) */
                         || (dummy = not(AU)) == NULL
@@ -208,9 +211,9 @@ double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi)
                         || (rhs = (double*)calloc((size_t) mtx_rows(pP),
                                         sizeof(double))) == NULL )
         {
-                err_msg_4(error_str, "dtmc_unbounded_until_lumping(%p[%d],%p["
-                        "%d])", (const void *) phi, bitset_size(phi),
-                        (const void *) psi, bitset_size(psi),
+                err_msg_5(error_str, "dtmc_unbounded_until_lumping(%p[%d],%p["
+                        "%d],%p)", (const void *) phi, bitset_size(phi),
+                        (const void *) psi, bitset_size(psi), (void *) ppP,
                         ((void) (NULL == EU || (free_bitset(EU),
                            NULL == AU || (free_bitset(AU),
                               NULL == P || (free_partition(P),
@@ -232,11 +235,11 @@ double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi)
                                     && (lumped_id = part_lump_state_block(P, B))
                                                 == state_index_ERROR) )
                 {
-                        exit(err_macro_4(err_CALLBY,
-                                "dtmc_unbounded_until_lumping(%p[%d],%p[%d])",
-                                (const void *) phi, bitset_size(phi),
+                        exit(err_macro_5(err_CALLBY,
+                                "dtmc_unbounded_until_lumping(%p[%d],%p[%d],"
+                                "%p)", (const void *) phi, bitset_size(phi),
                                 (const void *) psi, bitset_size(psi),
-                                EXIT_FAILURE));
+                                (void *) ppP, EXIT_FAILURE));
                 }
                 if ( state_index_NONE != lumped_id ) {
                         rhs[lumped_id] = 1.0;
@@ -248,21 +251,26 @@ double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi)
 	/* solve (I-P)x = i_Psi */
 	lumped_result = unbounded_until_universal(pP, pValidStates, initial, rhs, FALSE);
 
-	/* transform result vector */
-	result = unlump_vector(P, size, lumped_result);
+	/* Keep the result per block or transform it */
+        if ( NULL != ppP ) {
+                result = lumped_result;
+                *ppP = P;
+        } else {
+                result = unlump_vector(P, size, lumped_result);
+                free(lumped_result);
+                free_partition(P);
+        }
 
 	free(rhs);
-	free(lumped_result);
 	free_bitset(EU);
 	free_bitset(AU);
 	free_bitset(dummy);
 	free_bitset(lumped_dummy);
-	free_partition(P);
 	free(pValidStates);
         if ( err_state_iserror(free_sparse_ncolse(pP)) ) {
-                err_msg_4(err_CALLBY, "dtmc_unbounded_until_lumping(%p[%d],%p"
-                        "[%d])", (const void *) phi, bitset_size(phi),
-                        (const void *) psi, bitset_size(psi),
+                err_msg_5(err_CALLBY, "dtmc_unbounded_until_lumping(%p[%d],%p"
+                        "[%d],%p)", (const void *) phi, bitset_size(phi),
+                        (const void *) psi, bitset_size(psi), (void *) ppP,
                         (free(result), NULL));
         }
 
@@ -281,6 +289,8 @@ double * dtmc_unbounded_until_lumping(const bitset *phi, const bitset *psi)
 */
 static void dtmc_bounded_until_universal(sparse *pP, double **ppInOutData, double supi)
 {
+	const BOOL ssd_on = is_ssd_on();
+	const int steps = (int) supi;
 	int i;
 	double *result_2, *pTmp;
 	double * result_1 = *ppInOutData; /* Access the data-array pointer value */
@@ -298,6 +308,15 @@ static void dtmc_bounded_until_universal(sparse *pP, double **ppInOutData, doubl
 		pTmp = result_1;
 		result_1 = result_2;
 		result_2 = pTmp;
+
+		/*Q^supi*i_psi differs from the current iterate by at most
+		  (supi-i)*||Q^i*i_psi - Q^(i-1)*i_psi||*/
+		if( ssd_on && i % SSD_CHECK_PERIOD == 0
+				&& ( steps - i ) * get_max_change(result_2, result_1,
+					NULL, mtx_rows(pP)) <= get_error_bound() ) {
+			printf("SSD: i = %d\n", i);
+			break;
+		}
 	}
 
 	/* Free allocated memory */
@@ -373,9 +392,12 @@ double * dtmc_bounded_until(const bitset *phi, const bitset *psi, double supi)
 * @param		: bitset *phi: SAT(phi).
 * @param		: bitset *psi: SAT(psi).
 * @param		: double supi: sup I should contain the Natural number
+* @param		: partition **ppP: if not NULL, receives the partition and
+*			  the result is kept per block
 * @return		: double *: result of the unbounded until operator for all states.
 */
-double * dtmc_bounded_until_lumping(const bitset *phi, const bitset *psi, double supi)
+double * dtmc_bounded_until_lumping(const bitset *phi, const bitset *psi, double supi,
+                partition ** ppP)
 {
         const
 	sparse * state_space = get_state_space();
@@ -388,8 +410,8 @@ double * dtmc_bounded_until_lumping(const bitset *phi, const bitset *psi, double
 	bitset *good_phi_states = get_good_phi_states( phi, psi, state_space);
 
 	/* create initial partition for bounded until formula and lump */
-	partition *P = init_partition_formula(good_phi_states, psi, FALSE);
-	sparse *Q = lump(P, state_space);
+	partition *P = NULL;
+	sparse *Q = lump_formula(&P, state_space, good_phi_states, psi, FALSE);
 
 	/*init lumped_result with i_psi*/
         double * lumped_result = (double *) calloc((size_t) mtx_rows(Q),
@@ -404,10 +426,11 @@ double * dtmc_bounded_until_lumping(const bitset *phi, const bitset *psi, double
                                     && (lumped_id = part_lump_state_block(P, B))
                                                 == state_index_ERROR) )
                 {
-                        err_msg_5(err_CALLBY,
-                                "dtmc_bounded_until_lumping(%p[%d],%p[%d],%g)",
-                                (const void *) phi, bitset_size(phi),
+                        err_msg_6(err_CALLBY,
+                                "dtmc_bounded_until_lumping(%p[%d],%p[%d],%g,"
+                                "%p)", (const void *) phi, bitset_size(phi),
                                 (const void *) psi, bitset_size(psi), supi,
+                                (void *) ppP,
                                 (free_bitset(good_phi_states),free_partition(P),
                                 free_sparse_ncolse(Q), free(lumped_result),
                                 NULL));
@@ -422,18 +445,23 @@ double * dtmc_bounded_until_lumping(const bitset *phi, const bitset *psi, double
 	/*Compute Q^supi*i_psi*/
 	dtmc_bounded_until_universal(Q, &lumped_result, supi);
 
-	/* transform result vector */
-        result = unlump_vector(P, mtx_rows(state_space), lumped_result);
+	/* Keep the result per block or transform it */
+        if ( NULL != ppP ) {
+                result = lumped_result;
+                *ppP = P;
+        } else {
+                result = unlump_vector(P, mtx_rows(state_space), lumped_result);
+                free(lumped_result);
+                free_partition(P);
+        }
 
 	/* Free allocated memory */
-	free(lumped_result);
-	free_partition(P);
 	free_bitset(good_phi_states);
         if ( err_state_iserror(free_sparse_ncolse(Q)) ) {
-                err_msg_5(err_CALLBY, "dtmc_bounded_until_lumping(%p[%d],%p"
-                        "[%d],%g)", (const void *) phi, bitset_size(phi),
+                err_msg_6(err_CALLBY, "dtmc_bounded_until_lumping(%p[%d],%p"
+                        "[%d],%g,%p)", (const void *) phi, bitset_size(phi),
                         (const void *) psi, bitset_size(psi), supi,
-                        (free(result), NULL));
+                        (void *) ppP, (free(result), NULL));
         }
 
 	return result;
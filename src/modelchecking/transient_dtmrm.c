@@ -275,6 +275,8 @@ double * dtmrm_bounded_until(const bitset * phi, const bitset * psi,
 * @param: double supi: upper time bound
 * @param: double subj: lower reward bound
 * @param: double supj: upper reward bound
+* @param: partition **ppP: if not NULL, receives the partition and the result
+*	  is kept per block
 * @return: double *: result of the N-J-bounded until operator for all states.
 * NOTE: see (slightly modified path_graph):
 *	1. S. Andova, H. Hermanns and J.-P. Katoen.
@@ -282,7 +284,8 @@ double * dtmrm_bounded_until(const bitset * phi, const bitset * psi,
 *	FORMATS 2003, LNCS, Vol. 2791, Springer, pp. 88 - 103, 2003.
 */
 double * dtmrm_bounded_until_lumping(const bitset * phi, const bitset * psi,
-                double subi, double supi, double subj, double supj)
+                double subi, double supi, double subj, double supj,
+                partition ** ppP)
 {
 	sparse *original_state_space = get_state_space();
 	double *result, *lumped_result;
@@ -300,8 +303,8 @@ double * dtmrm_bounded_until_lumping(const bitset * phi, const bitset * psi,
 	}
 
 	/* Create initial partition for bounded until formula and lump */
-	P = init_partition_formula( ( good_phi_states != NULL ? good_phi_states : phi ) , psi, FALSE);
-	Q = lump(P, original_state_space);
+	Q = lump_formula(&P, original_state_space,
+			( good_phi_states != NULL ? good_phi_states : phi ), psi, FALSE);
 
 	/* Free the row sums vector because otherwise it will be lost */
 	free_row_sums();
@@ -319,8 +322,16 @@ double * dtmrm_bounded_until_lumping(const bitset * phi, const bitset * psi,
 
 	lumped_result = dtmrm_bounded_until(lumped_phi, lumped_psi, subi, supi, subj, supj);
 
-	/* Unlump the resulting vector */
-        result = unlump_vector(P, mtx_rows(original_state_space),lumped_result);
+	/* Keep the result per block or unlump it */
+        if ( NULL != ppP ) {
+                result = lumped_result;
+                lumped_result = NULL;
+                *ppP = P;
+                P = NULL;
+        } else {
+                result = unlump_vector(P, mtx_rows(original_state_space),
+                                lumped_result);
+        }
 
 	/* Restore state rewards */
 	freeStateRewards();
@@ -333,15 +344,18 @@ double * dtmrm_bounded_until_lumping(const bitset * phi, const bitset * psi,
 	}
 	free_bitset(lumped_psi);
 	free(lumped_result);
-	free_partition(P);
+        if ( NULL != P ) {
+                free_partition(P);
+        }
 	/* You have to do that not to waste the allocated memory */
 	free_row_sums();
 	/* Free the lumped state space. */
         if ( err_state_iserror(free_sparse_ncolse(Q)) ) {
-                err_msg_8(err_CALLBY, "dtmrm_bounded_until_lumping(%p[%d],%p"
-                        "[%d],%g,%g,%g,%g)", (const void*)phi, bitset_size(phi),
-                        (const void *) psi, bitset_size(psi), subi, supi, subj,
-                        supj, (free(result), NULL));
+                err_msg_9(err_CALLBY, "dtmrm_bounded_until_lumping(%p[%d],%p"
+                        "[%d],%g,%g,%g,%g,%p)", (const void*)phi,
+                        bitset_size(phi), (const void *) psi, bitset_size(psi),
+                        subi, supi, subj, supj, (void *) ppP,
+                        (free(result), NULL));
         }
 
 	/* Restore the original state space, NOTE: resets the row_sums! */
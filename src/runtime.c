@@ -51,6 +51,7 @@
 
 #include "simulation_utils.h"
 #include "simulation.h"
+#include "simulation_common.h"
 #include "rand_num_generator.h"
 
 #include <float.h>
@@ -115,7 +116,11 @@ static double *row_sums = NULL;
 static double * pRewards = NULL;
 static double error_bound=1e-6;
 static int method_path=GS, method_steady=GS;
+static int method_transient=UNIFORM;
 static int method_bscc=REC;
+static int method_lumping=LUMP_SPLITTER;
+static BOOL lump_reuse_on = TRUE;
+static BOOL lump_weak_on = FALSE;
 static int method_until_rewards=DTV;
 static int max_iterations=1000000;
 static double un=DBL_MIN, ov=DBL_MAX;
@@ -202,8 +207,11 @@ void * get_formula_tree_result(void) {
 * This function sets the state space for global access.
 * @param space the state space
 * WARNING: If space == NULL then the row sums are freed using the free_row_sums() method.
+* NOTE: The simulation model of the old state space is freed.
 */
 void set_state_space(sparse *space){
+	/* The simulation model was derived from the old state space */
+	freeSimulationModel();
 	state_space = space;
 	/* WARNING: In principle set_state_space should not be called with a NULL parameter */
 	/* This has to be done only if we want to reset the matrix*/
@@ -378,6 +386,19 @@ void setImpulseRewards(sparse * _pImpulseRewards)
 	set_method_until_rewards(UQS);
 }
 
+/**
+* Replace the impulse rewards temporarily, e.g. by the lumped ones. Unlike
+* setImpulseRewards() this does not change the method for the until formula.
+* @param sparse* _pImpulseRewards the new impulse rewards
+* @return the previous impulse rewards
+*/
+sparse * exchangeImpulseRewards(sparse * _pImpulseRewards)
+{
+	sparse * pOld = pImpulseRewards;
+	pImpulseRewards = _pImpulseRewards;
+	return pOld;
+}
+
 /**
 * This method is used to free the impulse reward structure.
 */
@@ -661,6 +682,28 @@ int get_method_path(void)
 	return method_path;
 }
 
+/*****************************************************************************
+name		: set_method_transient
+role		: set the method for the time-bounded until of CTMCs.
+@param          : int: method_transient
+remark		: should be either UNIFORM or KRYLOV
+******************************************************************************/
+void set_method_transient(int _method_transient)
+{
+	method_transient = _method_transient;
+}
+
+/*****************************************************************************
+name		: get_method_transient
+role		: get method_transient
+@param		:
+@return         : int: method_transient
+******************************************************************************/
+int get_method_transient(void)
+{
+	return method_transient;
+}
+
 /*****************************************************************************
 name		: set_method_steady
 role		: set method_steady for global access.
@@ -770,6 +813,65 @@ int get_method_bscc(void)
 	return method_bscc;
 }
 
+/************************************************************************************/
+/******************************THE LUMPING SETTINGS**********************************/
+/************************************************************************************/
+
+/**
+* Set method for the partition refinement in lumping
+* @param the method to be set
+* NOTE: The method should be either LUMP_SPLITTER or LUMP_SIGNATURE
+*/
+void set_method_lumping(int _method_lumping)
+{
+	method_lumping = _method_lumping;
+}
+
+/**
+* Get method for the partition refinement in lumping
+* @return the method, either LUMP_SPLITTER or LUMP_SIGNATURE
+*/
+int get_method_lumping(void)
+{
+	return method_lumping;
+}
+
+/**
+* This method is used to switch on and off the reuse of the quotient w.r.t. the
+* labelling for formula-dependent lumping (see lump_formula() in lump.h).
+* @param _on_off TRUE for reusing the quotient, otherwise FALSE.
+*/
+void set_lump_reuse(BOOL _on_off)
+{
+	lump_reuse_on = _on_off;
+}
+
+/**
+* @return TRUE if the quotient w.r.t. the labelling is reused, otherwise FALSE
+*/
+BOOL is_lump_reuse_on(void)
+{
+	return lump_reuse_on;
+}
+
+/**
+* This method is used to switch on and off weak bisimulation lumping. It only
+* has an effect for CTMCs and CMRMs, see lump() in lump.h.
+* @param _on_off TRUE for weak bisimulation, FALSE for ordinary lumpability.
+*/
+void set_lump_weak(BOOL _on_off)
+{
+	lump_weak_on = _on_off;
+}
+
+/**
+* @return TRUE if lumping computes weak bisimulation, otherwise FALSE
+*/
+BOOL is_lump_weak_on(void)
+{
+	return lump_weak_on;
+}
+
 /************************************************************************************/
 /***************************THE STEADY-STATE DETECTION SETTINGS**********************/
 /************************************************************************************/
@@ -917,17 +1019,17 @@ inline void print_run_mode(BOOL logic, BOOL extra){
 */
 void print_runtime_info(void) {
 	int mp  = get_method_path();
+	int mt  = get_method_transient();
 	int ms  = get_method_steady();
 	int mur = get_method_until_rewards();
 	int mb  = get_method_bscc();
+	int ml  = get_method_lumping();
 
 	printf(" ---General settings:\n");
 	print_run_mode( TRUE, FALSE );
 	print_run_mode( FALSE, TRUE );
 	printf(" M. C. simulation\t = %s\n", (isSimulationOn() ? "ON":"OFF" ) );
-	if( isRunMode(CTMC_MODE) || isRunMode(CMRM_MODE) ){
-		printf(" Steady-state detection\t = %s\n", (is_ssd_on() ? "ON":"OFF"));
-	}
+	printf(" Steady-state detection\t = %s\n", (is_ssd_on() ? "ON":"OFF"));
 	printf(" Method Path\t\t = ");
 	switch(mp){
 		case GJ:
@@ -941,6 +1043,21 @@ void print_runtime_info(void) {
                                 "print_runtime_info: illegal Method Path\n");
                         exit(EXIT_FAILURE);
 	}
+	if( isRunMode(CTMC_MODE) ){
+		printf(" Method Transient\t = ");
+		switch(mt){
+			case UNIFORM:
+				printf("Uniformization\n");
+				break;
+			case KRYLOV:
+				printf("Krylov\n");
+				break;
+                        default:
+                                fprintf(stderr, "print_runtime_info: "
+                                        "illegal Method Transient\n");
+                                exit(EXIT_FAILURE);
+		}
+	}
 	printf(" Method Steady\t\t = ");
 	switch(ms){
 		case GJ:
@@ -985,6 +1102,27 @@ void print_runtime_info(void) {
                                 "print_runtime_info: illegal Method BSCC\n");
                         exit(EXIT_FAILURE);
 	}
+	if( isRunMode(F_IND_LUMP_MODE) || isRunMode(F_DEP_LUMP_MODE) ){
+		printf(" Method Lumping\t\t = ");
+		switch(ml){
+			case LUMP_SPLITTER:
+				printf("Splitter\n");
+				break;
+			case LUMP_SIGNATURE:
+				printf("Signature\n");
+				break;
+                        default:
+                                fprintf(stderr, "print_runtime_info: "
+                                        "illegal Method Lumping\n");
+                                exit(EXIT_FAILURE);
+		}
+		if( isRunMode(F_DEP_LUMP_MODE) ){
+			printf(" Lumping quotient reuse\t = %s\n", (is_lump_reuse_on() ? "ON":"OFF"));
+		}
+		if( isRunMode(CTMC_MODE) || isRunMode(CMRM_MODE) ){
+			printf(" Weak bisim. lumping\t = %s\n", (is_lump_weak_on() ? "ON":"OFF"));
+		}
+	}
 	printf(" Results printing\t = %s\n", (isPrintingOn()? "ON":"OFF") );
 	printf("\n");
 
@@ -1150,6 +1288,22 @@ void print_state( const bitset * pBitset, const int index, const char * name ){
 	printf("\n");
 }
 
+/**
+* This gives the partition a vector of state values is kept over: the one of
+* the formula dependent lumping if the values have one, otherwise the one of
+* the formula independent lumping, if it was done.
+* @param pResultPartition the partition of the formula dependent lumping or NULL
+* @return the partition or NULL if the values are given for every state
+*/
+static const partition * get_result_partition(
+                const partition * pResultPartition)
+{
+        if ( NULL != pResultPartition ) {
+                return pResultPartition;
+        }
+        return isRunMode(F_IND_LUMP_MODE) ? getPartition() : NULL;
+}
+
 /**
 * This method is used for printing the errors of state probabilities
 * Depending whether there was lumping done or not to the
@@ -1158,19 +1312,23 @@ void print_state( const bitset * pBitset, const int index, const char * name ){
 * @param size the size of the probability-error vector
 * @param pErrorValues the vector of probability errors
 * @param pName the name string
+* @param pResultPartition the partition of the formula dependent lumping if the
+*	values are kept per block, NULL otherwise
 */
-void print_error_probs( const int size, const double * pErrorValues, const char * pName ){
-        const partition * P_local = getPartition();
+void print_error_probs( const int size, const double * pErrorValues, const char * pName,
+                        const partition * pResultPartition ){
+        const partition * P_local = get_result_partition(pResultPartition);
 
 	printf("%s: ", pName);
-        if ( isRunMode(F_IND_LUMP_MODE) && NULL != P_local ) {
+        if ( NULL != P_local ) {
                 print_error_probs_partition(P_local, pErrorValues);
 	}else{
                 if ( err_state_iserror(print_pattern_vec_double("%1.2e", size,
                                 pErrorValues)) )
-                        exit(err_macro_3(err_CALLBY, "print_error_probs(%d,%p,"
-                                "\"%s\")", size, (const void *) pErrorValues,
-                                pName, EXIT_FAILURE));
+                        exit(err_macro_4(err_CALLBY, "print_error_probs(%d,%p,"
+                                "\"%s\",%p)", size, (const void *) pErrorValues,
+                                pName, (const void *) pResultPartition,
+                                EXIT_FAILURE));
 	}
 	printf("\n");
 }
@@ -1184,15 +1342,18 @@ void print_error_probs( const int size, const double * pErrorValues, const char
 * @param name the bitset name string
 * @param error_bound the error bound for all probabilities
 * @param pErrorBounds the error bounds for all probabilities
+* @param pResultPartition the partition of the formula dependent lumping if the
+*	values are kept per block, NULL otherwise
 * NOTE: Either we have pErrorBounds != NULL, or the error bound is defined by error_bound
 */
 void print_state_probs(int size, const double * probs, const char * name,
                         const double error_bound_local,
-			const double * pErrorBounds ){
-        const partition * P_local = getPartition();
+			const double * pErrorBounds,
+                        const partition * pResultPartition ){
+        const partition * P_local = get_result_partition(pResultPartition);
 
 	printf("%s: ", name);
-        if ( isRunMode(F_IND_LUMP_MODE) && NULL != P_local ) {
+        if ( NULL != P_local ) {
                 print_state_probs_partition(P_local, probs, error_bound_local,
                                 pErrorBounds);
 	}else{
@@ -1202,10 +1363,11 @@ void print_state_probs(int size, const double * probs, const char * name,
                                 error_bound_local, size, pErrorBounds));
                 if ( err_state_iserror(print_pattern_vec_double(buffer, size,
                                                 probs)) )
-                        exit(err_macro_5(err_CALLBY, "print_state_probs(%d,%p,"
-                                "\"%s\",%g,%p)", size, (const void *) probs,
+                        exit(err_macro_6(err_CALLBY, "print_state_probs(%d,%p,"
+                                "\"%s\",%g,%p,%p)", size, (const void *) probs,
                                 name, error_bound_local,
-                                (const void *) pErrorBounds, EXIT_FAILURE));
+                                (const void *) pErrorBounds,
+                                (const void *) pResultPartition, EXIT_FAILURE));
 	}
 	printf("\n");
 }
@@ -1219,16 +1381,19 @@ void print_state_probs(int size, const double * probs, const char * name,
 * @param name the bitset name string
 * @param error_bound the error bound for the given state probability
 * @param pErrorBounds the error bounds for all probabilities
+* @param pResultPartition the partition of the formula dependent lumping if the
+*	values are kept per block, NULL otherwise
 * NOTE: Either we have pErrorBounds != NULL, or the error bound is defined by error_bound
 */
 inline void print_state_prob( const int index, const int size, const double * probs, const char * name,
                                 const double error_bound_local,
-                                const double * pErrorBounds)
+                                const double * pErrorBounds,
+                                const partition * pResultPartition)
 {
-        const partition * P_local = getPartition();
+        const partition * P_local = get_result_partition(pResultPartition);
 
 	printf( "%s[%d] = ", name, index + 1 );
-        if ( isRunMode(F_IND_LUMP_MODE) && NULL != P_local ) {
+        if ( NULL != P_local ) {
                 print_state_prob_partition(P_local, index, probs,
                                 error_bound_local, pErrorBounds);
 	}else{
@@ -68,6 +68,49 @@ kjnode *get_new_kjnode(int ndsr)
 	return new_node;
 }
 
+/* The number of nodes in one arena block */
+#define KJ_BLOCK_SIZE 1024
+/* The initial size of the hash table, a power of two */
+#define KJ_INITIAL_BUCKETS 256
+
+/*****************************************************************************
+name            : kj_out_of_memory
+role            : reports that we ran out of memory and exits.
+@param          : const char *where: the function name.
+remark          :
+******************************************************************************/
+static void kj_out_of_memory(const char *where)
+{
+	printf("ERROR: We've run out of memory in %s.\n", where);
+	exit(EXIT_FAILURE);
+}
+
+/*****************************************************************************
+name            : get_kj_hash
+role            : computes the hash value of a k vector and an accumulated
+		  impulse reward.
+@param          : int ndsr: number of distinct state-based reward rates
+@param          : int *k: the k vector.
+@param          : double acir: the accumulated impulse reward.
+@return         : unsigned long: the hash value.
+remark          : FNV-1a over the k vector and the bytes of acir.
+******************************************************************************/
+unsigned long get_kj_hash(int ndsr, const int *k, double acir)
+{
+	unsigned long hash = 2166136261UL;
+	const unsigned char *bytes = (const unsigned char *) &acir;
+	size_t i;
+
+	/* The two zeroes are equal, but have different bytes */
+	if(acir == 0.0)
+		acir = 0.0;
+	for(i = 0; i < (size_t) ndsr; i++)
+		hash = (hash ^ (unsigned long) k[i]) * 16777619UL;
+	for(i = 0; i < sizeof(double); i++)
+		hash = (hash ^ bytes[i]) * 16777619UL;
+	return hash;
+}
+
 /*****************************************************************************
 name            : get_new_kjstruc
 role            : create and get a new KJ-struc - contains a list of KJ-nodes.
@@ -78,11 +121,86 @@ remark          :
 kjstruc *get_new_kjstruc(int ndsr)
 {
         kjstruc * new_kjstruc = (kjstruc *) calloc((size_t) 1, sizeof(kjstruc));
+	if(new_kjstruc == NULL)
+		kj_out_of_memory("get_new_kjstruc");
 	new_kjstruc->ndsr = ndsr;
 	new_kjstruc->kjnodes = NULL;
+	new_kjstruc->last = NULL;
+	new_kjstruc->num_buckets = KJ_INITIAL_BUCKETS;
+	new_kjstruc->buckets = (kjnode **) calloc((size_t) KJ_INITIAL_BUCKETS, sizeof(kjnode *));
+	if(new_kjstruc->buckets == NULL)
+		kj_out_of_memory("get_new_kjstruc");
 	return new_kjstruc;
 }
 
+/*****************************************************************************
+name            : allocate_kjnode
+role            : takes a new KJ node from the arena of a KJ structure.
+@param          : kjstruc *kj: the KJ structure.
+@return         : kjnode *: the node, its k vector has ndsr elements.
+remark          : The blocks left over by reset_kjstorage are used first.
+******************************************************************************/
+static kjnode *allocate_kjnode(kjstruc *kj)
+{
+	kjblock *block = kj->current;
+	kjnode *node;
+
+	if(block == NULL || block->used == KJ_BLOCK_SIZE)
+	{
+		if(block != NULL && block->next != NULL)
+		{
+			block = block->next;
+		}
+		else
+		{
+			kjblock *new_block = (kjblock *) calloc((size_t) 1, sizeof(kjblock));
+			if(new_block == NULL)
+				kj_out_of_memory("allocate_kjnode");
+			new_block->nodes = (kjnode *) calloc((size_t) KJ_BLOCK_SIZE, sizeof(kjnode));
+			new_block->ks = (int *) calloc((size_t) KJ_BLOCK_SIZE * kj->ndsr + 1, sizeof(int));
+			if(new_block->nodes == NULL || new_block->ks == NULL)
+				kj_out_of_memory("allocate_kjnode");
+			if(block == NULL)
+				kj->blocks = new_block;
+			else
+				block->next = new_block;
+			block = new_block;
+		}
+		block->used = 0;
+		kj->current = block;
+	}
+
+	node = &block->nodes[block->used];
+	node->k = &block->ks[block->used * kj->ndsr];
+	block->used++;
+	return node;
+}
+
+/*****************************************************************************
+name            : grow_kj_buckets
+role            : doubles the hash table of a KJ structure.
+@param          : kjstruc *kj: the KJ structure.
+remark          :
+******************************************************************************/
+static void grow_kj_buckets(kjstruc *kj)
+{
+	const int num_buckets = 2 * kj->num_buckets;
+	kjnode **buckets = (kjnode **) calloc((size_t) num_buckets, sizeof(kjnode *));
+	kjnode *node;
+
+	if(buckets == NULL)
+		kj_out_of_memory("grow_kj_buckets");
+	for(node = kj->kjnodes; node != NULL; node = node->next)
+	{
+		kjnode **bucket = &buckets[node->hash & (unsigned long) (num_buckets - 1)];
+		node->hash_next = *bucket;
+		*bucket = node;
+	}
+	free(kj->buckets);
+	kj->buckets = buckets;
+	kj->num_buckets = num_buckets;
+}
+
 /*****************************************************************************
 name            : add_new_kjnode
 role            : add a new KJ node to a KJ structure.
@@ -90,55 +208,65 @@ role            : add a new KJ node to a KJ structure.
 @param		: int *k: the new k vector, its values are just copyed here.
 @param		: double acir: the accumulated impulse reward on a given path.
 @param		: double prob: the prob. of the path repr. by given k & acir.
-remark          :
+remark          : The node with the same k vector and acir is found through
+		  the hash table, the new nodes are appended to the list.
 ******************************************************************************/
 void add_new_kjnode(kjstruc *kj, int *k, double acir, double prob)
 {
-	int ndsr = kj->ndsr, i, found;
-	kjnode *kjnodep=kj->kjnodes, *pkjnode=kjnodep;
-
-	/* Search for the same reward value in a list.
-           If one found and it has the same k array then
-           add probability*/
+	const int ndsr = kj->ndsr;
+	const unsigned long hash = get_kj_hash(ndsr, k, acir);
+	kjnode **bucket = &kj->buckets[hash & (unsigned long) (kj->num_buckets - 1)];
+	kjnode *kjnodep;
 
-	while(kjnodep!=NULL)
+	/* Search for the same reward value and k array in the bucket,
+	   if one is found then add probability */
+	for(kjnodep = *bucket; kjnodep != NULL; kjnodep = kjnodep->hash_next)
 	{
-		if(kjnodep->acir==acir)
+		if(kjnodep->hash == hash && kjnodep->acir == acir
+		   && memcmp(kjnodep->k, k, ndsr * sizeof(int)) == 0)
 		{
-			found=1;
-			for(i=0;i<ndsr;i++)
-				if(k[i]!=kjnodep->k[i])
-					found=0;
-			/* completely matched */
-			if(found==1)
-			{
-				kjnodep->prob+=prob;
-				return; /* The job is done */
-			}
+			kjnodep->prob += prob;
+			return; /* The job is done */
 		}
-		pkjnode=kjnodep;
-		kjnodep=kjnodep->next;
 	}
 
         /*If the corresponding reward was not found or if the
           k array is different for it then add a new entry*/
+	kjnodep = allocate_kjnode(kj);
+	/* Copy the array data */
+	memcpy(kjnodep->k, k, ndsr * sizeof(int));
+	kjnodep->acir = acir;
+	kjnodep->prob = prob;
+	kjnodep->hash = hash;
+	kjnodep->next = NULL;
+	kjnodep->hash_next = *bucket;
+	*bucket = kjnodep;
+	if(kj->last == NULL)
+		kj->kjnodes = kjnodep;
+	else
+		kj->last->next = kjnodep;
+	kj->last = kjnodep;
 
-	if(kj->kjnodes==NULL)
-	{
-		kj->kjnodes = get_new_kjnode(ndsr);
-		/* Copy the array data */
-		memcpy(kj->kjnodes->k, k, ndsr * sizeof(int) );
-		kj->kjnodes->acir=acir;
-		kj->kjnodes->prob=prob;
-	}
-        else
-        {
-                pkjnode->next = get_new_kjnode(ndsr);
-		/* Copy the array data */
-		memcpy(pkjnode->next->k, k, ndsr * sizeof(int) );
-		pkjnode->next->acir=acir;
-                pkjnode->next->prob=prob;
-        }
+	if(++kj->num_nodes > kj->num_buckets)
+		grow_kj_buckets(kj);
+}
+
+/*****************************************************************************
+name            : reset_kjstorage
+role            : removes all KJ nodes from a given KJ-structure, the
+		  memory of the nodes is kept for the new ones.
+@param          : kjstruc *: the KJ structure to be emptied.
+remark          :
+******************************************************************************/
+void reset_kjstorage(kjstruc *kj)
+{
+	memset(kj->buckets, 0, kj->num_buckets * sizeof(kjnode *));
+	kj->kjnodes = NULL;
+	kj->last = NULL;
+	kj->num_nodes = 0;
+	kj->current = kj->blocks;
+	if(kj->current != NULL)
+		kj->current->used = 0;
 }
 
 /*****************************************************************************
@@ -149,14 +277,16 @@ remark          :
 ******************************************************************************/
 void free_kjstorage(kjstruc *kj)
 {
-	kjnode *kjn = kj->kjnodes, *to_free;
-	while(kjn!=NULL)
+	kjblock *block = kj->blocks, *to_free;
+	while(block!=NULL)
 	{
-		to_free=kjn;
-		kjn=kjn->next;
-		free(to_free->k);
+		to_free=block;
+		block=block->next;
+		free(to_free->nodes);
+		free(to_free->ks);
 		free(to_free);
 	}
+	free(kj->buckets);
 	kj->kjnodes=NULL;
 	free(kj);
 }
@@ -43,7 +43,8 @@
 *
 *	Source description: This is a simple ds for path graph gen. for
 *		DTMRMs
-*		NOT SMART AT ALL - using a hashmap might be better for
+*		The rewards of a state are found through a hash index
+*		once the state has more than a few of them, for
 *		detatils see (NOTE: slightly modified path_graph):
 *		1. S. Andova, H. Hermanns and J.-P. Katoen.
 *		Discrete-time rewards model-checked.
@@ -55,6 +56,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* Up to this number of elements the rewards of a state are searched linearly */
+#define PG_LINEAR_SEARCH_LIMIT 8
 
 /* Create an array of length size of path graph nodes. Indexes of array correspond to the state ids */
 path_graph* get_new_path_graph(int size)
@@ -63,10 +68,77 @@ path_graph* get_new_path_graph(int size)
 	path_graph* pg;
         pg = (path_graph *) calloc((size_t) size, sizeof(path_graph));
 	for(i=0;i<size;i++)
-		{pg[i].num=0;pg[i].pge=NULL;}
+		{pg[i].num=0;pg[i].pge=NULL;pg[i].capacity=0;pg[i].index_size=0;pg[i].index=NULL;}
 	return pg;
 }
 
+/* The hash value of a reward, FNV-1a over its bytes */
+static unsigned long get_reward_hash(double reward)
+{
+	unsigned long hash = 2166136261UL;
+	const unsigned char *bytes = (const unsigned char *) &reward;
+	size_t i;
+
+	/* The two zeroes are equal, but have different bytes */
+	if(reward == 0.0)
+		reward = 0.0;
+	for(i = 0; i < sizeof(double); i++)
+		hash = (hash ^ bytes[i]) * 16777619UL;
+	return hash;
+}
+
+/* Find the slot of the reward in the index of the path graph node, */
+/* it is either the slot of the reward or an empty one */
+static int find_index_slot(const path_graph *node, double reward)
+{
+	const unsigned long mask = (unsigned long) (node->index_size - 1);
+	unsigned long slot = get_reward_hash(reward) & mask;
+
+	while(node->index[slot] != 0 && node->pge[node->index[slot] - 1].reward != reward)
+		slot = (slot + 1) & mask;
+	return (int) slot;
+}
+
+/* (Re)build the index of the path graph node, it is made at least twice */
+/* as big as the pge array */
+static void build_index(path_graph *node)
+{
+	int i, size = node->index_size > 0 ? node->index_size : 4 * PG_LINEAR_SEARCH_LIMIT;
+
+	while(size < 2 * node->capacity)
+		size *= 2;
+	if(size != node->index_size)
+	{
+		free(node->index);
+		node->index = (int *) malloc(size * sizeof(int));
+		if(node->index == NULL)
+		{
+			printf("ERROR: We've run out of memory in build_index.\n");
+			exit(EXIT_FAILURE);
+		}
+		node->index_size = size;
+	}
+	memset(node->index, 0, size * sizeof(int));
+	for(i=0; i<node->num; i++)
+		node->index[find_index_slot(node, node->pge[i].reward)] = i + 1;
+}
+
+/* Find the position of the reward in the pge array of the path graph node, or -1 */
+static int find_reward(const path_graph *node, double reward)
+{
+	int i;
+	if(node->index != NULL)
+	{
+		return node->index[find_index_slot(node, reward)] - 1;
+	}
+	for(i=0; i<node->num; i++)
+	{
+		if(node->pge[i].reward==reward)
+			return i;
+	}
+	return -1;
+}
+
 /**
 * Insert a new (reward,prob) into a path graph node of some state
 *@param pg     : a path graph pointer
@@ -76,74 +148,66 @@ path_graph* get_new_path_graph(int size)
 */
 void insert_into_pg(path_graph *pg, int state, double reward, double prob)
 {
-	int i, num = pg[state].num, found=0;
-	path_graph_ele *trav=pg[state].pge;
+	path_graph *node = &pg[state];
+	const int l = find_reward(node, reward);
 
-	/*First for a given state look for the reward
-          if there is such then increase probability*/
-	for(i=0; i<num; i++, trav++)
+	/* If the state has this reward then just increase the probability */
+	if(l >= 0)
 	{
-		/* If the state has this reward then just increase the probability */
-		if(trav->reward==reward)
-		{
-			trav->prob+=prob;
-			found=1;
-		}
+		node->pge[l].prob+=prob;
+		return;
 	}
-	/* if there was no such reward then insert a new path graph element */
-	if(found==0)
+
+	/* if there was no such reward then insert a new path graph element, */
+	/* the array grows geometrically */
+	if(node->num == node->capacity)
 	{
-		++pg[state].num;
-		pg[state].pge=(path_graph_ele *)realloc(pg[state].pge, pg[state].num*sizeof(path_graph_ele));
-		trav=pg[state].pge;
-		trav[pg[state].num-1].reward=reward;
-		trav[pg[state].num-1].prob=prob;
+		node->capacity = node->capacity > 0 ? 2 * node->capacity : 4;
+		node->pge=(path_graph_ele *)realloc(node->pge, node->capacity*sizeof(path_graph_ele));
+		if(node->pge == NULL)
+		{
+			printf("ERROR: We've run out of memory in insert_into_pg.\n");
+			exit(EXIT_FAILURE);
+		}
+		if(node->index != NULL)
+			build_index(node);
 	}
+	node->pge[node->num].reward=reward;
+	node->pge[node->num].prob=prob;
+	++node->num;
+
+	if(node->index != NULL)
+		node->index[find_index_slot(node, reward)] = node->num;
+	else if(node->num > PG_LINEAR_SEARCH_LIMIT)
+		build_index(node);
 }
 
 /* Delete a path graph element l for the given state */
 int delete_from_pg(path_graph *pg, int state, int l)
 {
-	int num = pg[state].num;
-	path_graph_ele *trav=pg[state].pge;
+	path_graph *node = &pg[state];
+	int num = node->num;
+	path_graph_ele *trav=node->pge;
 	if(l<num)
 	{
 		/* decrease the number of elements */
-		pg[state].num=pg[state].num-1;
-		num=pg[state].num;
-		/* shift elements to the left */
+		node->num=node->num-1;
+		num=node->num;
+		/* shift elements to the left, the memory is kept */
+		/* so that the pointers into the pge array stay valid */
 		for(;l<num;l++)
 			trav[l]=trav[l+1];
-		/* reallocate memory */
-		if(num>0)
-                {
-			pg[state].pge=(path_graph_ele *)realloc(pg[state].pge, num*sizeof(path_graph_ele));
-                }
-		else
-		{
-			free(pg[state].pge);
-			pg[state].pge=NULL;
-		}
+		/* the positions have changed */
+		if(node->index != NULL)
+			build_index(node);
 	}
 	return num;
 }
 
-/* SLOW */
 double get_prob(const path_graph * pg, int state, double reward)
 {
-	int i, num = pg[state].num;
-	double ret_val=0.0;
-        const
-	path_graph_ele *trav=pg[state].pge;
-	for(i=0; i<num; i++, trav++)
-        {
-		if(trav->reward==reward)
-		{
-			ret_val=trav->prob;
-			break;	/* there can be only one such reward in trav  */
-		}
-        }
-	return ret_val;
+	const int l = find_reward(&pg[state], reward);
+	return l >= 0 ? pg[state].pge[l].prob : 0.0;
 }
 
 /* For Iterations */
@@ -173,6 +237,8 @@ void free_path_graph(path_graph *pg, int size)
 				free(pg[i].pge);
 				pg[i].pge=NULL;
 			}
+			free(pg[i].index);
+			pg[i].index=NULL;
                 }
 		free(pg);
 	}
@@ -83,8 +83,7 @@ static inline void initializeSampleVectorBase(PTSampleVec pSampleVecBase, const
 * We set "curr_simulation_depth" to zero.
 * We set "sum_good" to zero.
 * We set "sum_trans" to "sample_size".
-* We allocate "pTransStateInd" and "pObservationsVec" of size "sample_size".
-* We set "pTransStateInd" to all ones.
+* We allocate "pObservationsVec" of size "sample_size".
 * We fill "pObservationsVec" with "initial_state".
 * @param sample_size the initial sample size
 * @param initial_state the initial observation.
@@ -110,14 +109,14 @@ inline PTSampleVecUntil allocateSampleVectorUntil( const int sample_size, const
 
                 pSampleVecUntil->pObservationsVec = (int*) calloc(
                                 (size_t) sample_size, sizeof(int));
+		if ( NULL == pSampleVecUntil->pObservationsVec && sample_size > 0 ) {
+			exit(err_macro_2(err_MEMORY, "allocateSampleVectorUntil(%d,%d)",
+					sample_size, initial_state, EXIT_FAILURE));
+		}
 		/* Can't use memset here since "initial_state" is an integer */
 		for( i = 0; i < sample_size; i++ ){
 			pSampleVecUntil->pObservationsVec[i] = initial_state;
 		}
-
-		pSampleVecUntil->pTransStateInd = get_new_bitset( sample_size );
-		/* Sets all bits, including unused bits of the last block, to one! */
-		fill_bitset_one( pSampleVecUntil->pTransStateInd );
 	ELSE_SAFETY
 		printf("ERROR: We've run out of memory.\n");
                 exit(EXIT_FAILURE);
@@ -158,9 +157,7 @@ inline PTSampleVecIntUntil allocateSampleVectorIntUntil( const int sample_size,
 * steady-state simulations CTMC:
 * We set "initial_state" to "initial_state".
 * We set "curr_reg_cycles" to reg_cycles.
-* We set "pRegenerationPoints" to all zeros.
-* We set "pTimeObservationsVec" to all zeros.
-* We set "pGoodObservationsVec" to all zeros.
+* We set "cycleStats" to reg_cycles cycles with all times zero.
 * @param reg_cycles the initial number of regeneration cycles.
 * @param initial_state the regeneration point (the state index).
 * @return the newly-created sample vector.
@@ -173,13 +170,8 @@ inline PTSampleVecSteady allocateSampleVectorSteady(const int reg_cycles, const
 		/* Initialize the sample base */
 		initializeSampleVectorBase( (PTSampleVec) pSampleVecSteady, reg_cycles, initial_state );
 
-		/* As no regeneration cycle was calculated yet, we allocate an array filled with 0 */
-                pSampleVecSteady->pTimeObservationsVec = (double *) calloc(
-                                (size_t) reg_cycles, sizeof(double));
-
-		/* As no regeneration cycle was calculated yet, we allocate an array filled with 0 */
-                pSampleVecSteady->pGoodObservationsVec = (double *) calloc(
-                                (size_t) reg_cycles, sizeof(double));
+		/* As no regeneration cycle was calculated yet, all times are 0 */
+		pSampleVecSteady->cycleStats.cycles = reg_cycles;
 	ELSE_SAFETY
 		printf("ERROR: We've run out of memory.\n");
                 exit(EXIT_FAILURE);
@@ -235,7 +227,7 @@ static int extendSampleVectorBase(PTSampleVec pSampleVecBase,
 */
 inline void extendSampleVectorUntil( PTSampleVecUntil pSampleVecUntil, const int new_sample_size ){
 	int i = 0;
-	bitset * temp_pTransStateInd;
+	int * temp_pObservationsVec;
 
 	/* Cast to the parent structure which contains initial_state and curr_sample_size */
 	PTSampleVec pSampleVecUntilBase = (PTSampleVec) pSampleVecUntil;
@@ -243,24 +235,21 @@ inline void extendSampleVectorUntil( PTSampleVecUntil pSampleVecUntil, const int
 	/* NOTE: Safety assertions are done inside extendSampleVectorBase  */
 	const int old_sample_size = extendSampleVectorBase( pSampleVecUntilBase, new_sample_size, "PTSampleVecUntil" );
 	const int initial_state = pSampleVecUntilBase->initial_state;
+	const int old_sum_trans = pSampleVecUntil->sum_trans;
 
-	/* Add extra observations */
-	pSampleVecUntil->pObservationsVec = ( int* ) realloc( pSampleVecUntil->pObservationsVec,
-								new_sample_size * sizeof( int ) );
-	for( i = old_sample_size; i < new_sample_size ; i++){
-		pSampleVecUntil->pObservationsVec[i] = initial_state;
-	}
-
-	/* Add the new transient states */
+	/* Add the new transient observations after the old ones */
 	pSampleVecUntil->sum_trans += new_sample_size - old_sample_size;
-	temp_pTransStateInd = bs_extend(pSampleVecUntil->pTransStateInd,
-			new_sample_size, TRUE);
-	if ( (bitset *) NULL == temp_pTransStateInd ) {
+	temp_pObservationsVec = ( int* ) realloc( pSampleVecUntil->pObservationsVec,
+							pSampleVecUntil->sum_trans * sizeof( int ) );
+	if ( NULL == temp_pObservationsVec ) {
                 exit(err_macro_2(err_MEMORY, "extendSampleVectorUntil(%p,%d)",
 				(void *) pSampleVecUntil, new_sample_size,
                                 EXIT_FAILURE));
 	}
-	pSampleVecUntil->pTransStateInd = temp_pTransStateInd;
+	pSampleVecUntil->pObservationsVec = temp_pObservationsVec;
+	for( i = old_sum_trans; i < pSampleVecUntil->sum_trans ; i++){
+		pSampleVecUntil->pObservationsVec[i] = initial_state;
+	}
 }
 
 /**
@@ -286,22 +275,52 @@ inline void extendSampleVectorIntUntil( PTSampleVecIntUntil pSampleVecIntUntil,
 * @return the newly-created sample vector.
 */
 inline void extendSampleVectorSteady( PTSampleVecSteady pSampleVecSteady, const int new_reg_cycles ){
-	/* Cast to the parent structure which contains initial_state and curr_sample_size */
-	PTSampleVec pSampleVecSteadyBase = (PTSampleVec) pSampleVecSteady;
+	/* NOTE: The new cycles are added to the statistics when they are simulated */
+	extendSampleVectorBase( (PTSampleVec) pSampleVecSteady, new_reg_cycles, "PTSampleVecSteady" );
+}
 
-	/* NOTE: Safety assertions are done inside extendSampleVectorBase  */
-	const int old_reg_cycles = extendSampleVectorBase( pSampleVecSteadyBase, new_reg_cycles, "PTSampleVecSteady" );
-
-	/* Add extra regeneration cycles */
-	pSampleVecSteady->pTimeObservationsVec = ( double* ) realloc( pSampleVecSteady->pTimeObservationsVec,
-								new_reg_cycles * sizeof( double ) );
-	/* Set the newly added array elements to zero */
-	memset( &pSampleVecSteady->pTimeObservationsVec[old_reg_cycles], 0, (new_reg_cycles - old_reg_cycles) * sizeof( double ) );
-
-	pSampleVecSteady->pGoodObservationsVec = ( double* ) realloc( pSampleVecSteady->pGoodObservationsVec,
-								new_reg_cycles * sizeof( double ) );
-	/* Set the newly added array elements to zero */
-	memset( &pSampleVecSteady->pGoodObservationsVec[old_reg_cycles], 0, (new_reg_cycles - old_reg_cycles) * sizeof( double ) );
+/**
+* This method adds one regeneration cycle to the statistics.
+* @param pCycleStats the statistics
+* @param time the expected time spent in the cycle
+* @param good the expected time spent in "good" states in the cycle
+*/
+inline void addCycleStats( TCycleStats * pCycleStats, const double time, const double good ){
+	const double delta_time = time - pCycleStats->mean_time;
+	const double delta_good = good - pCycleStats->mean_good;
+
+	pCycleStats->cycles++;
+	pCycleStats->mean_time += delta_time / pCycleStats->cycles;
+	pCycleStats->mean_good += delta_good / pCycleStats->cycles;
+	/* NOTE: One deviation is taken from the old and one from the new mean */
+	pCycleStats->m2_time += delta_time * ( time - pCycleStats->mean_time );
+	pCycleStats->m2_good += delta_good * ( good - pCycleStats->mean_good );
+	pCycleStats->co_time_good += delta_time * ( good - pCycleStats->mean_good );
+}
+
+/**
+* This method adds the regeneration cycles of one statistics to another.
+* The moments are combined as in the parallel variant of Welford's method.
+* @param pCycleStats the statistics to add to
+* @param pOtherStats the statistics to be added
+*/
+inline void mergeCycleStats( TCycleStats * pCycleStats, const TCycleStats * pOtherStats ){
+	const int cycles = pCycleStats->cycles + pOtherStats->cycles;
+	const double delta_time = pOtherStats->mean_time - pCycleStats->mean_time;
+	const double delta_good = pOtherStats->mean_good - pCycleStats->mean_good;
+	double weight;
+
+	if( pOtherStats->cycles > 0 ){
+		/* The weight of the deviations of the means */
+		weight = ( (double) pCycleStats->cycles ) * pOtherStats->cycles / cycles;
+
+		pCycleStats->mean_time += delta_time * pOtherStats->cycles / cycles;
+		pCycleStats->mean_good += delta_good * pOtherStats->cycles / cycles;
+		pCycleStats->m2_time += pOtherStats->m2_time + delta_time * delta_time * weight;
+		pCycleStats->m2_good += pOtherStats->m2_good + delta_good * delta_good * weight;
+		pCycleStats->co_time_good += pOtherStats->co_time_good + delta_time * delta_good * weight;
+		pCycleStats->cycles = cycles;
+	}
 }
 
 /****************************************************************************/
@@ -318,9 +337,6 @@ inline void freeSampleVectorUntil( PTSampleVecUntil pSampleVecUntil ){
 		if( pSampleVecUntil->pObservationsVec != NULL ){
 			free( pSampleVecUntil->pObservationsVec );
 		}
-		if( pSampleVecUntil->pTransStateInd != NULL ){
-			free_bitset( pSampleVecUntil->pTransStateInd );
-		}
 		free( pSampleVecUntil );
 	}
 }
@@ -343,12 +359,6 @@ inline void freeSampleVectorIntUntil( PTSampleVecIntUntil pSampleVecIntUntil ){
 */
 inline void freeSampleVectorSteady ( PTSampleVecSteady pSampleVecSteady ){
 	if (pSampleVecSteady != NULL ){
-		if( pSampleVecSteady->pTimeObservationsVec != NULL ){
-			free( pSampleVecSteady->pTimeObservationsVec );
-		}
-		if( pSampleVecSteady->pGoodObservationsVec != NULL ){
-			free( pSampleVecSteady->pGoodObservationsVec );
-		}
 		free( pSampleVecSteady);
 	}
 }
@@ -385,15 +395,13 @@ inline void printSampleVectorUntil( PTSampleVecUntil pSampleVecUntil ){
 		printf( "\tsum_trans = %d\n", pSampleVecUntil->sum_trans );
 		printf( "\tpObservationsVec :\n\t\t" );
                 if ( err_state_iserror(print_vec_int(
-                                        pSampleVecUntilBase->curr_sample_size,
+                                        pSampleVecUntil->sum_trans,
                                         pSampleVecUntil->pObservationsVec)) )
                 {
                         exit(err_macro_1(err_CALLBY, "printSampleVectorUntil("
                                 "%p)", (void *) pSampleVecUntil, EXIT_FAILURE));
                 }
 		printf( "\tWARNING: For getting an external (a user-level) state index do +1.\n" );
-		printf( "\tpTransStateInd :\n\t\t" );
-		print_bitset_states( pSampleVecUntil->pTransStateInd );
 		printf( "\n" );
 	} else {
 		printf( "\tWARNING: Trying to print the NULL pointer of type PTSampleVecUntil.\n" );
@@ -420,26 +428,15 @@ inline void printSampleVectorIntUntil( PTSampleVecIntUntil pSampleVecIntUntil ){
 * @param pSampleVecSteady the sample-vector to be printed
 */
 inline void printSampleVectorSteady( PTSampleVecSteady pSampleVecSteady ){
-	PTSampleVec pSampleVecSteadyBase = (PTSampleVec) pSampleVecSteady;
 	if( pSampleVecSteady != NULL ){
 		printSampleVector( (PTSampleVec) pSampleVecSteady, "PTSampleVecSteady");
-
-                if ( err_state_iserror(print_vec_double(
-                                pSampleVecSteadyBase->curr_sample_size,
-                                pSampleVecSteady->pTimeObservationsVec)) )
-                {
-                        exit(err_macro_1(err_CALLBY, "printSampleVectorSteady("
-                                "%p)", (void*) pSampleVecSteady, EXIT_FAILURE));
-                }
+		printf( "\tcycles = %d\n", pSampleVecSteady->cycleStats.cycles );
+		printf( "\tmean_time = %e, mean_good = %e\n", pSampleVecSteady->cycleStats.mean_time,
+			pSampleVecSteady->cycleStats.mean_good );
+		printf( "\tm2_time = %e, m2_good = %e, co_time_good = %e\n",
+			pSampleVecSteady->cycleStats.m2_time, pSampleVecSteady->cycleStats.m2_good,
+			pSampleVecSteady->cycleStats.co_time_good );
 		printf( "\n" );
-                if ( err_state_iserror(print_vec_double(
-                                pSampleVecSteadyBase->curr_sample_size,
-                                pSampleVecSteady->pGoodObservationsVec)) )
-                {
-                        exit(err_macro_1(err_CALLBY, "printSampleVectorSteady("
-                                "%p)", (void*) pSampleVecSteady, EXIT_FAILURE));
-                }
-		printf( "\n\n" );
 	} else {
 		printf( "\tWARNING: Trying to print the NULL pointer of type PTSampleVecSteady.\n" );
 	}
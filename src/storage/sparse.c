@@ -1481,6 +1481,63 @@ err_state multiply_mtx_MV(/*@observer@*/ /*@i1@*/ /*@null@*/ const sparse * pM,
         return err_OK;
 }
 
+/*****************************************************************************
+name		: multiply_mtx_MV_acc
+role		: multiply a matrix with a vector and add weighted copies of
+		  the result to accumulators, in one pass over the matrix.
+@param		: sparse * pM: operand matrix.
+@param		: double *vec: The operand vector.
+@param		: double *res: The resulting vector, res = pM * vec.
+@param		: int num_acc: the number of accumulators.
+@param		: double *weights: the weights of the accumulators.
+@param		: double **acc: the accumulators, acc[a] += weights[a] * res.
+@return         : err_ERROR: fail, err_OK: success
+remark		: size should be correct. The rows are independent, so they
+		  are computed in parallel if OpenMP is enabled.
+******************************************************************************/
+err_state multiply_mtx_MV_acc(
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const sparse * pM,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const double * vec,
+                /*@out@*/ /*@i1@*/ /*@null@*/ double * res, int num_acc,
+                /*@observer@*/ /*@i1@*/ /*@null@*/ const double * weights,
+                /*@i1@*/ /*@null@*/ double ** acc)
+{
+        int row, rows;
+
+        if ( NULL == pM || NULL == vec || NULL == res || 0 > num_acc
+                        || ( 0 < num_acc && ( NULL == weights || NULL == acc ) ) )
+        {
+                /*@-mustdefine@*/
+                err_msg_8(err_PARAM,
+                                "multiply_mtx_MV_acc(%p[%dx%d],%p,%p,%d,%p,%p)",
+                                (const void *)pM, NULL != pM ? mtx_rows(pM) : 0,
+                                NULL != pM ? mtx_cols(pM) : 0, (const void*)vec,
+                                (void *) res, num_acc, (const void *) weights,
+                                (void *) acc, err_ERROR);
+                /*@=mustdefine@*/
+        }
+
+        rows = mtx_rows(pM);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 256)
+#endif
+        for ( row = 0 ; row < rows ; row++ ) {
+                double result = 0.0;
+                int a;
+
+                mtx_walk_row(pM, row, col, val)
+                {
+                        result += vec[col] * val;
+                }
+                end_mtx_walk_row;
+                res[row] = result;
+                for ( a = 0 ; a < num_acc ; a++ ) {
+                        acc[a][row] += weights[a] * result;
+                }
+        }
+        return err_OK;
+}
+
 /*****************************************************************************
 name		: multiply_mtx_cer_MV
 role		: multiply certain rows of a matrix with a vector.
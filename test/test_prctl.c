@@ -0,0 +1,175 @@
+/**
+*	WARNING: Do Not Remove This Section
+*
+*	MRMC is a model checker for discrete-time and continuous-time Markov
+*	reward models. It supports reward extensions of PCTL and CSL (PRCTL
+*	and CSRL), and allows for the automated verification of properties
+*	concerning long-run and instantaneous rewards as well as cumulative
+*	rewards.
+*
+*	Copyright (C) RWTH Aachen, 2008-2009.
+*
+*	This program is free software; you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License
+*	as published by the Free Software Foundation; either version 2
+*	of the License, or (at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program; if not, write to the Free Software
+*	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*	MA  02110-1301, USA.
+*
+*	Main contact:
+*		Lehrstuhl für Informatik 2, RWTH Aachen University
+*		Ahornstrasse 55, 52074 Aachen, Germany
+*		E-mail: info@mrmc-tool.org
+*
+*	Source description: Tests the reward sweep of the C and Y formulas in
+*		PRCTL: the closed-form tail of the (discounted) Y formula has to
+*		give the truncated sum sum_{k<steps} discount^k*P^k*rho.
+*	Run by: make test
+*/
+
+#include "prctl.h"
+
+#include "runtime.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* The number of states of the test model */
+#define TEST_SIZE 3
+
+/* The error bound of the sweep */
+#define TEST_ERROR 1e-10
+
+/**
+* Computes sum_{k<steps} discount^k*P^k*rho for all states, step by step.
+* @param pP the transition probability matrix
+* @param pRewards the state rewards rho
+* @param steps the number of steps
+* @param discount the discount
+* @param pSum the sum, TEST_SIZE elements
+*/
+static void truncated_sum(const sparse * pP, const double * pRewards, int steps,
+		double discount, double * pSum)
+{
+	double iterate[TEST_SIZE], next[TEST_SIZE];
+	double factor = 1.0;
+	int i, k;
+
+	for( i = 0; i < TEST_SIZE; i++ ){
+		iterate[i] = pRewards[i];
+		pSum[i] = 0.0;
+	}
+	for( k = 0; k < steps; k++ ){
+		for( i = 0; i < TEST_SIZE; i++ ){
+			pSum[i] += factor * iterate[i];
+		}
+		if( err_state_iserror(multiply_mtx_MV(pP, iterate, next)) ){
+			printf("ERROR: truncated_sum(): The matrix-vector product failed.\n");
+			exit(EXIT_FAILURE);
+		}
+		for( i = 0; i < TEST_SIZE; i++ ){
+			iterate[i] = next[i];
+		}
+		factor *= discount;
+	}
+}
+
+/**
+* Compares yf_discounted(...) with the truncated sum. The closed-form tail
+* may only cost the error bound relative to max|rho|*sum_{k<steps} discount^k.
+* @param pP the transition probability matrix, it is the current state space
+* @param pRewards the state rewards, they are the current state rewards
+* @param pPhi all states
+* @param steps the number of steps
+* @param discount the discount
+* @return TRUE if the values agree
+*/
+static BOOL check_yf(const sparse * pP, const double * pRewards,
+		const bitset * pPhi, int steps, double discount)
+{
+	double expected[TEST_SIZE];
+	double * pResult = yf_discounted(steps, pPhi, discount);
+	double max_reward = 0.0, bound, diff, max_diff = 0.0;
+	int i;
+
+	truncated_sum(pP, pRewards, steps, discount, expected);
+	for( i = 0; i < TEST_SIZE; i++ ){
+		if( fabs(pRewards[i]) > max_reward ){
+			max_reward = fabs(pRewards[i]);
+		}
+		diff = fabs(pResult[i] - expected[i]);
+		if( diff > max_diff ){
+			max_diff = diff;
+		}
+	}
+	bound = TEST_ERROR * max_reward * ( 1.0 == discount ? (double) steps
+			: ( 1.0 - pow(discount, (double) steps) ) / ( 1.0 - discount ) );
+	/* Allow for the rounding of the long sums */
+	bound += 1e-12 * max_reward * (double) steps;
+	printf("Y[%d,%g]: max. difference %e, allowed %e: %s\n", steps, discount,
+		max_diff, bound, max_diff <= bound ? "OK" : "FAILED");
+	free(pResult);
+	return max_diff <= bound;
+}
+
+int main(void)
+{
+	int ncolse[TEST_SIZE] = { 2, 2, 1 };
+	double * pRewards = (double *) calloc((size_t) TEST_SIZE, sizeof(double));
+	bitset * pPhi = get_new_bitset(TEST_SIZE);
+	sparse * pP = allocate_sparse_matrix_ncolse(TEST_SIZE, TEST_SIZE, ncolse);
+	BOOL passed = TRUE;
+
+	if( NULL == pRewards || NULL == pPhi || NULL == pP
+	    || err_state_iserror(fill_bitset_one(pPhi)) ){
+		printf("ERROR: The test model could not be allocated.\n");
+		return EXIT_FAILURE;
+	}
+
+	/* A DMRM that converges slowly to the absorbing state 2 */
+	set_mtx_val_ncolse(pP, 0, 0, 0.9);
+	set_mtx_val_ncolse(pP, 0, 1, 0.1);
+	set_mtx_val_ncolse(pP, 1, 0, 0.05);
+	set_mtx_val_ncolse(pP, 1, 2, 0.95);
+	set_mtx_val_ncolse(pP, 2, 2, 1.0);
+	pRewards[0] = 2.0;
+	pRewards[1] = 5.0;
+	pRewards[2] = 1.0;
+
+	addRunMode(DMRM_MODE);
+	set_state_space(pP);
+	setStateRewards(pRewards);
+	set_error_bound(TEST_ERROR);
+
+	/* Short sweeps end exactly at the epoch */
+	passed = check_yf(pP, pRewards, pPhi, 0, 1.0) && passed;
+	passed = check_yf(pP, pRewards, pPhi, 3, 1.0) && passed;
+	passed = check_yf(pP, pRewards, pPhi, 3, 0.5) && passed;
+	/* Long sweeps stop at the fixpoint or once the discounted tail is */
+	/* small, the closed-form tail adds the remaining steps */
+	passed = check_yf(pP, pRewards, pPhi, 2000, 1.0) && passed;
+	passed = check_yf(pP, pRewards, pPhi, 2000, 0.9) && passed;
+	passed = check_yf(pP, pRewards, pPhi, 2000, 0.999) && passed;
+	/* Later epochs continue the sweep of the earlier ones */
+	passed = check_yf(pP, pRewards, pPhi, 5000, 0.999) && passed;
+
+	/* The iterates are a fixpoint from the start, the tail is exact */
+	pRewards[0] = pRewards[1] = pRewards[2] = 3.0;
+	free_reward_sweep();
+	passed = check_yf(pP, pRewards, pPhi, 100000, 1.0) && passed;
+	passed = check_yf(pP, pRewards, pPhi, 100000, 0.99) && passed;
+
+	free_reward_sweep();
+	free_bitset(pPhi);
+	printf("%s\n", passed ? "PASSED" : "FAILED");
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}